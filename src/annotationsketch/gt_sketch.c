@@ -22,10 +22,13 @@
 #include "core/cstr_api.h"
 #include "core/fileutils_api.h"
 #include "core/gtdatapath.h"
+#include "core/fa.h"
 #include "core/option_api.h"
 #include "core/output_file_api.h"
 #include "core/ma.h"
+#include "core/parseutils_api.h"
 #include "core/splitter.h"
+#include "core/timer_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "core/versionfunc.h"
@@ -46,6 +49,7 @@
 #include "annotationsketch/image_info.h"
 #include "annotationsketch/layout.h"
 #include "annotationsketch/style.h"
+#include "annotationsketch/tile_renderer.h"
 
 typedef struct {
   bool pipe,
@@ -56,9 +60,10 @@ typedef struct {
        unsafe,
        force,
        use_streams;
-  GtStr *seqid, *format, *stylefile, *input;
+  GtStr *seqid, *format, *stylefile, *input, *tiles;
   GtUword start,
-                end;
+                end,
+                benchmark;
   unsigned int width;
 } GtSketchArguments;
 
@@ -69,6 +74,7 @@ static void* gt_sketch_arguments_new(void)
   arguments->format = gt_str_new();
   arguments->input = gt_str_new();
   arguments->stylefile = gt_str_new();
+  arguments->tiles = gt_str_new();
   return arguments;
 }
 
@@ -80,6 +86,7 @@ static void gt_sketch_arguments_delete(void *tool_arguments)
   gt_str_delete(arguments->format);
   gt_str_delete(arguments->input);
   gt_str_delete(arguments->stylefile);
+  gt_str_delete(arguments->tiles);
   gt_free(arguments);
 }
 
@@ -87,7 +94,7 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
 {
   GtSketchArguments *arguments = tool_arguments;
   GtOptionParser *op;
-  GtOption *option, *option2;
+  GtOption *option, *option2, *tiles_option;
   static const char *formats[] = { "png",
 #ifdef CAIRO_HAS_PDF_SURFACE
     "pdf",
@@ -131,6 +138,21 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, option);
   gt_option_hide_default(option);
 
+  /* -tiles */
+  tiles_option = gt_option_new_filename("tiles", "render the tiles listed in "
+                                        "the given file in parallel instead "
+                                        "of a single image (no image_file "
+                                        "argument is given then, without "
+                                        "GFF3 files the annotation is read "
+                                        "from stdin), each line "
+                                        "contains a sequence region "
+                                        "identifier, a start and an end "
+                                        "position and the name of the image "
+                                        "file, separated by tabs",
+                                        arguments->tiles);
+  gt_option_parser_add_option(op, tiles_option);
+  gt_option_exclude(tiles_option, option);
+
   /* -start */
   option = gt_option_new_uword_min("start", "start position\n"
                                          "default: first region start",
@@ -146,6 +168,8 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
   gt_option_imply(option, option2);
   gt_option_imply(option2, option);
   gt_option_hide_default(option2);
+  gt_option_exclude(tiles_option, option);
+  gt_option_exclude(tiles_option, option2);
 
   /* -width */
   option = gt_option_new_uint_min("width", "target image width (in pixel)",
@@ -198,12 +222,23 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
                               &arguments->showrecmaps, false);
   gt_option_is_development_option(option);
   gt_option_parser_add_option(op, option);
+  gt_option_exclude(tiles_option, option);
 
   /* -streams */
   option = gt_option_new_bool("streams", "use streams to write data to file",
                               &arguments->use_streams, false);
   gt_option_is_development_option(option);
   gt_option_parser_add_option(op, option);
+  gt_option_exclude(tiles_option, option);
+
+  /* -benchmark */
+  option = gt_option_new_uword("benchmark", "lay out and render the image the "
+                               "given number of times before writing it and "
+                               "report the time needed for it",
+                               &arguments->benchmark, 0);
+  gt_option_is_development_option(option);
+  gt_option_parser_add_option(op, option);
+  gt_option_exclude(tiles_option, option);
 
   /* -v */
   option = gt_option_new_verbose(&arguments->verbose);
@@ -214,21 +249,24 @@ static GtOptionParser* gt_sketch_option_parser_new(void *tool_arguments)
                               &arguments->force, false);
   gt_option_parser_add_option(op, option);
 
-  gt_option_parser_set_min_args(op, 1);
-
   return op;
 }
 
-static int gt_sketch_arguments_check(GT_UNUSED int rest_argc,
+static int gt_sketch_arguments_check(int rest_argc,
                                      void *tool_arguments,
-                                     GT_UNUSED GtError *err)
+                                     GtError *err)
 {
   GtSketchArguments *arguments = tool_arguments;
   int had_err = 0;
   gt_error_check(err);
   gt_assert(arguments);
 
-  if (arguments->start != GT_UNDEF_UWORD &&
+  /* in tile mode the image files are given in the tile file */
+  if (!gt_str_length(arguments->tiles) && rest_argc < 1) {
+    gt_error_set(err, "missing image_file argument");
+    had_err = -1;
+  }
+  if (!had_err && arguments->start != GT_UNDEF_UWORD &&
       arguments->end != GT_UNDEF_UWORD &&
       !(arguments->start < arguments->end)) {
     gt_error_set(err, "start of query range ("GT_WU") must be before "
@@ -240,6 +278,56 @@ static int gt_sketch_arguments_check(GT_UNUSED int rest_argc,
   return had_err;
 }
 
+static GtGraphicsOutType gt_sketch_output_type(const GtSketchArguments
+                                               *arguments)
+{
+  if (strcmp(gt_str_get(arguments->format), "pdf") == 0)
+    return GT_GRAPHICS_PDF;
+  if (strcmp(gt_str_get(arguments->format), "ps") == 0)
+    return GT_GRAPHICS_PS;
+  if (strcmp(gt_str_get(arguments->format), "svg") == 0)
+    return GT_GRAPHICS_SVG;
+  return GT_GRAPHICS_PNG;
+}
+
+static int gt_sketch_benchmark(GtDiagram *d, GtStyle *sty,
+                               const GtSketchArguments *arguments,
+                               GtError *err)
+{
+  GtLayout *l;
+  GtCanvas *canvas;
+  GtTimer *timer;
+  GtUword i, height;
+  int had_err = 0;
+  gt_error_check(err);
+
+  timer = gt_timer_new();
+  gt_timer_start(timer);
+  for (i = 0; !had_err && i < arguments->benchmark; i++) {
+    canvas = NULL;
+    if (!(l = gt_layout_new(d, arguments->width, sty, err)))
+      had_err = -1;
+    if (!had_err)
+      had_err = gt_layout_get_height(l, &height, err);
+    if (!had_err && !(canvas = gt_canvas_cairo_file_new(sty, GT_GRAPHICS_PNG,
+                                                        arguments->width,
+                                                        height, NULL, err))) {
+      had_err = -1;
+    }
+    if (!had_err)
+      had_err = gt_layout_sketch(l, canvas, err);
+    gt_canvas_delete(canvas);
+    gt_layout_delete(l);
+  }
+  if (!had_err) {
+    printf("# TIME rendering "GT_WU" times: ", arguments->benchmark);
+    gt_timer_show_formatted(timer, GT_WD".%06ld seconds real, "
+                            GT_WD"s user, "GT_WD"s system\n", stdout);
+  }
+  gt_timer_delete(timer);
+  return had_err;
+}
+
 /* this track selector function is used to disregard file names in track
    identifiers */
 static void flattened_file_track_selector(GtBlock *block, GtStr *result,
@@ -250,6 +338,77 @@ static void flattened_file_track_selector(GtBlock *block, GtStr *result,
   gt_str_append_cstr(result, gt_block_get_type(block));
 }
 
+/* reads the tile file given with -tiles and renders the listed tiles */
+static int gt_sketch_render_tiles(GtFeatureIndex *features, GtStyle *sty,
+                                  const GtSketchArguments *arguments,
+                                  GtError *err)
+{
+  GtTileRenderer *tr;
+  GtSplitter *splitter;
+  GtStr *line;
+  GtRange range;
+  FILE *fp;
+  const char *filename = gt_str_get(arguments->tiles);
+  char **tokens;
+  unsigned int line_number = 0;
+  bool has_seqid;
+  int had_err = 0;
+  gt_error_check(err);
+
+  if (!(fp = gt_fa_fopen(filename, "r", err)))
+    return -1;
+  tr = gt_tile_renderer_new(features, sty, arguments->width,
+                            gt_sketch_output_type(arguments));
+  if (arguments->flattenfiles)
+    gt_tile_renderer_set_track_selector_func(tr, flattened_file_track_selector,
+                                             NULL);
+  splitter = gt_splitter_new();
+  line = gt_str_new();
+  while (!had_err && gt_str_read_next_line(line, fp) != EOF) {
+    line_number++;
+    if (gt_str_length(line) == 0 || gt_str_get(line)[0] == '#') {
+      gt_str_reset(line);
+      continue;
+    }
+    gt_splitter_reset(splitter);
+    gt_splitter_split(splitter, gt_str_get(line), gt_str_length(line), '\t');
+    if (gt_splitter_size(splitter) != 4UL) {
+      gt_error_set(err, "line %u in file \"%s\" does not contain 4 "
+                        "tab separated fields", line_number, filename);
+      had_err = -1;
+    }
+    if (!had_err) {
+      tokens = gt_splitter_get_tokens(splitter);
+      had_err = gt_parse_range(&range, tokens[1], tokens[2], line_number,
+                               filename, err);
+    }
+    if (!had_err) {
+      had_err = gt_feature_index_has_seqid(features, &has_seqid, tokens[0],
+                                           err);
+    }
+    if (!had_err && !has_seqid) {
+      gt_error_set(err, "sequence region '%s' (line %u in file \"%s\") does "
+                        "not exist in GFF input file", tokens[0], line_number,
+                        filename);
+      had_err = -1;
+    }
+    if (!had_err)
+      gt_tile_renderer_add_tile(tr, tokens[0], &range, tokens[3]);
+    gt_str_reset(line);
+  }
+  if (!had_err) {
+    if (arguments->verbose)
+      fprintf(stderr, "# of tiles: "GT_WU"\n",
+              gt_tile_renderer_num_of_tiles(tr));
+    had_err = gt_tile_renderer_render(tr, err);
+  }
+  gt_str_delete(line);
+  gt_splitter_delete(splitter);
+  gt_tile_renderer_delete(tr);
+  gt_fa_fclose(fp);
+  return had_err;
+}
+
 static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
                               void *tool_arguments, GT_UNUSED GtError *err)
 {
@@ -261,7 +420,7 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
                *sort_stream = NULL,
                *last_stream;
   GtFeatureIndex *features = NULL;
-  const char *file;
+  const char *file = NULL;
   char *seqid = NULL;
   GtRange qry_range, sequence_region_range;
   GtArray *results = NULL;
@@ -272,7 +431,7 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
   GtImageInfo* ii = NULL;
   GtCanvas *canvas = NULL;
   GtUword height;
-  bool has_seqid;
+  bool has_seqid, tiles = gt_str_length(arguments->tiles) > 0;
   int had_err = 0;
   gt_error_check(err);
   gt_assert(arguments);
@@ -288,11 +447,12 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
     gt_str_append_cstr(defaultstylefile, "/sketch/default.style");
   }
 
-  file = argv[parsed_args];
+  /* in tile mode the image files are given in the tile file */
+  if (!tiles)
+    file = argv[parsed_args++];
   if (!had_err) {
     /* create feature index */
     features = gt_feature_index_memory_new();
-    parsed_args++;
 
     /* create an input stream */
     if (strcmp(gt_str_get(arguments->input), "gff") == 0)
@@ -342,7 +502,11 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
     gt_node_stream_delete(in_stream);
   }
 
-  if (!had_err) {
+  /* the index is only queried from now on */
+  if (!had_err)
+    gt_feature_index_memory_compact(features);
+
+  if (!had_err && !tiles) {
     had_err = gt_feature_index_has_seqid(features,
                                          &has_seqid,
                                          gt_str_get(arguments->seqid),
@@ -350,29 +514,29 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
   }
 
   /* if seqid is empty, take first one added to index */
-  if (!had_err && strcmp(gt_str_get(arguments->seqid),"") == 0) {
+  if (!had_err && !tiles && strcmp(gt_str_get(arguments->seqid),"") == 0) {
     seqid = gt_feature_index_get_first_seqid(features, err);
     if (seqid == NULL) {
       gt_error_set(err, "GFF input file must contain a sequence region!");
       had_err = -1;
     }
   }
-  else if (!had_err && !has_seqid) {
+  else if (!had_err && !tiles && !has_seqid) {
     gt_error_set(err, "sequence region '%s' does not exist in GFF input file",
                  gt_str_get(arguments->seqid));
     had_err = -1;
   }
-  else if (!had_err)
-    seqid = gt_str_get(arguments->seqid);
+  else if (!had_err && !tiles)
+    seqid = gt_cstr_dup(gt_str_get(arguments->seqid));
 
   results = gt_array_new(sizeof (GtGenomeNode*));
-  if (!had_err) {
+  if (!had_err && !tiles) {
     had_err = gt_feature_index_get_range_for_seqid(features,
                                                    &sequence_region_range,
                                                    seqid,
                                                    err);
   }
-  if (!had_err) {
+  if (!had_err && !tiles) {
     qry_range.start = (arguments->start == GT_UNDEF_UWORD ?
                          sequence_region_range.start :
                          arguments->start);
@@ -406,40 +570,25 @@ static int gt_sketch_runner(int argc, const char **argv, int parsed_args,
       had_err = gt_style_load_file(sty, gt_str_get(arguments->stylefile), err);
   }
 
-  if (!had_err) {
+  if (!had_err && tiles)
+    had_err = gt_sketch_render_tiles(features, sty, arguments, err);
+  else if (!had_err) {
     /* create and write image file */
     if (!(d = gt_diagram_new(features, seqid, &qry_range, sty, err)))
       had_err = -1;
     if (!had_err && arguments->flattenfiles)
       gt_diagram_set_track_selector_func(d, flattened_file_track_selector,
                                          NULL);
+    if (!had_err && arguments->benchmark)
+      had_err = gt_sketch_benchmark(d, sty, arguments, err);
     if (had_err || !(l = gt_layout_new(d, arguments->width, sty, err)))
       had_err = -1;
     if (!had_err)
       had_err = gt_layout_get_height(l, &height, err);
     if (!had_err) {
       ii = gt_image_info_new();
-
-      if (strcmp(gt_str_get(arguments->format),"pdf")==0) {
-        canvas = gt_canvas_cairo_file_new(sty, GT_GRAPHICS_PDF,
-                                          arguments->width,
-                                          height, ii, err);
-      }
-      else if (strcmp(gt_str_get(arguments->format),"ps")==0) {
-        canvas = gt_canvas_cairo_file_new(sty, GT_GRAPHICS_PS,
-                                          arguments->width,
-                                          height, ii, err);
-      }
-      else if (strcmp(gt_str_get(arguments->format),"svg")==0) {
-        canvas = gt_canvas_cairo_file_new(sty, GT_GRAPHICS_SVG,
-                                          arguments->width,
-                                          height, ii, err);
-      }
-      else {
-        canvas = gt_canvas_cairo_file_new(sty, GT_GRAPHICS_PNG,
-                                          arguments->width,
-                                          height, ii, err);
-      }
+      canvas = gt_canvas_cairo_file_new(sty, gt_sketch_output_type(arguments),
+                                        arguments->width, height, ii, err);
       if (!canvas)
         had_err = -1;
       if (!had_err) {
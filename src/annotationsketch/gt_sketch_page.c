@@ -277,6 +277,8 @@ static int gt_sketch_page_runner(GT_UNUSED int argc,
   {
     /* get features */
     had_err = gt_feature_index_add_gff3file(features, argv[parsed_args+1], err);
+    if (!had_err)
+      gt_feature_index_memory_compact(features);
      if (!had_err && gt_str_length(arguments->seqid) == 0) {
       seqid = gt_feature_index_get_first_seqid(features, err);
       if (seqid == NULL)
@@ -73,15 +73,246 @@ static char *gt_default_format_style =
   "  }\n"
   "}";
 
+typedef struct GtStyleCache GtStyleCache;
+
 struct GtStyle
 {
   lua_State *L;
   GtUword reference_count;
   GtRWLock *lock, *clone_lock;
-  bool unsafe;
+  bool unsafe,
+       cache_disabled;
+  GtStyleCache *cache; /* snapshot of the style values, NULL if invalid */
   char *filename;
 };
 
+/* A snapshot of a style value, which answers all queries for it except for
+   callback functions, which are evaluated in the Lua state. */
+typedef struct {
+  char *section, /* NULL for an empty slot */
+       *key;
+  GtColor color;
+  double num;
+  char *str;
+  bool is_function,
+       has_color,
+       has_num,
+       has_str,
+       has_bool,
+       boolval;
+} GtStyleCacheEntry;
+
+/* Open addressing hash table of the snapshot entries, indexed by section and
+   key, so that a query needs a single lookup. */
+struct GtStyleCache {
+  GtStyleCacheEntry *entries;
+  GtUword mask,
+          nofentries;
+};
+
+static GtUword style_cache_hash(const char *section, const char *key)
+{
+  const unsigned char *c;
+  GtUword h = 0xdeadbeef;
+  for (c = (const unsigned char*) section; *c; c++)
+    h ^= (h << 5) + (h >> 2) + *c;
+  h ^= (h << 5) + (h >> 2) + '.';
+  for (c = (const unsigned char*) key; *c; c++)
+    h ^= (h << 5) + (h >> 2) + *c;
+  return h;
+}
+
+static GtStyleCache* style_cache_new(void)
+{
+  GtStyleCache *cache = gt_malloc(sizeof *cache);
+  cache->mask = 255UL;
+  cache->nofentries = 0;
+  cache->entries = gt_calloc((size_t) cache->mask + 1,
+                             sizeof (GtStyleCacheEntry));
+  return cache;
+}
+
+static void style_cache_delete(GtStyleCache *cache)
+{
+  GtUword i;
+  if (!cache) return;
+  for (i = 0; i <= cache->mask; i++) {
+    if (cache->entries[i].section) {
+      gt_free(cache->entries[i].section);
+      gt_free(cache->entries[i].key);
+      gt_free(cache->entries[i].str);
+    }
+  }
+  gt_free(cache->entries);
+  gt_free(cache);
+}
+
+static GtStyleCacheEntry* style_cache_find(const GtStyleCache *cache,
+                                           const char *section,
+                                           const char *key)
+{
+  GtStyleCacheEntry *entry;
+  GtUword i = style_cache_hash(section, key) & cache->mask;
+  while ((entry = cache->entries + i)->section) {
+    if (!strcmp(entry->key, key) && !strcmp(entry->section, section))
+      return entry;
+    i = (i + 1) & cache->mask;
+  }
+  return entry;
+}
+
+/* Returns a new empty entry for <key> in <section>, which must not be in
+   <cache> yet. */
+static GtStyleCacheEntry* style_cache_add(GtStyleCache *cache,
+                                          const char *section,
+                                          const char *key)
+{
+  GtStyleCacheEntry *entry;
+  if (2 * (cache->nofentries + 1) > cache->mask + 1) {
+    GtStyleCacheEntry *old_entries = cache->entries;
+    GtUword i, old_mask = cache->mask;
+    cache->mask = 2 * cache->mask + 1;
+    cache->entries = gt_calloc((size_t) cache->mask + 1,
+                               sizeof (GtStyleCacheEntry));
+    for (i = 0; i <= old_mask; i++) {
+      if (old_entries[i].section) {
+        *style_cache_find(cache, old_entries[i].section, old_entries[i].key) =
+          old_entries[i];
+      }
+    }
+    gt_free(old_entries);
+  }
+  entry = style_cache_find(cache, section, key);
+  gt_assert(!entry->section);
+  entry->section = gt_cstr_dup(section);
+  entry->key = gt_cstr_dup(key);
+  cache->nofentries++;
+  return entry;
+}
+
+/* Fills <entry> from the value on top of the Lua stack, which is interpreted
+   like the gt_style_get_*() functions do. */
+static void style_cache_entry_set(GtStyleCacheEntry *entry, lua_State *L)
+{
+  if (lua_isfunction(L, -1)) {
+    entry->is_function = true;
+    return;
+  }
+  if (lua_istable(L, -1)) {
+    entry->has_color = true;
+    entry->color.red = entry->color.green = entry->color.blue =
+      entry->color.alpha = 0.5;
+    lua_getfield(L, -1, "red");
+    if (lua_isnumber(L, -1))
+      entry->color.red = lua_tonumber(L, -1);
+    lua_pop(L, 1);
+    lua_getfield(L, -1, "green");
+    if (lua_isnumber(L, -1))
+      entry->color.green = lua_tonumber(L, -1);
+    lua_pop(L, 1);
+    lua_getfield(L, -1, "blue");
+    if (lua_isnumber(L, -1))
+      entry->color.blue = lua_tonumber(L, -1);
+    lua_pop(L, 1);
+    lua_getfield(L, -1, "alpha");
+    if (lua_isnumber(L, -1))
+      entry->color.alpha = lua_tonumber(L, -1);
+    lua_pop(L, 1);
+  }
+  if (lua_isnumber(L, -1)) {
+    entry->has_num = true;
+    entry->num = lua_tonumber(L, -1);
+  }
+  if (lua_isboolean(L, -1)) {
+    entry->has_bool = true;
+    entry->boolval = lua_toboolean(L, -1);
+  }
+  if (lua_isstring(L, -1)) {
+    /* convert a copy, lua_tostring() changes numbers on the stack */
+    lua_pushvalue(L, -1);
+    entry->has_str = true;
+    entry->str = gt_cstr_dup(lua_tostring(L, -1));
+    lua_pop(L, 1);
+  }
+}
+
+/* Builds the snapshot of all sections of the style table, if it is not valid.
+   Values inherited through metatables cannot be enumerated, in this case no
+   snapshot is built and all queries are answered from the Lua state.
+   Must be called with the write lock of <sty> held. */
+static void style_cache_build(GtStyle *sty)
+{
+  const char *section;
+  bool cacheable = true;
+  int stack_size;
+  gt_assert(sty);
+  if (sty->cache || sty->cache_disabled)
+    return;
+  stack_size = lua_gettop(sty->L);
+  lua_getglobal(sty->L, "style");
+  if (!lua_istable(sty->L, -1) || lua_getmetatable(sty->L, -1)) {
+    /* pops the metatable, if any, together with the style table */
+    lua_settop(sty->L, stack_size);
+    return;
+  }
+  sty->cache = style_cache_new();
+  lua_pushnil(sty->L);
+  while (cacheable && lua_next(sty->L, -2)) {
+    /* only string keys are found by lua_getfield() */
+    if (lua_type(sty->L, -2) == LUA_TSTRING && lua_istable(sty->L, -1)) {
+      if (lua_getmetatable(sty->L, -1)) {
+        lua_pop(sty->L, 1);
+        cacheable = false;
+      }
+      else {
+        section = lua_tostring(sty->L, -2);
+        lua_pushnil(sty->L);
+        while (lua_next(sty->L, -2)) {
+          if (lua_type(sty->L, -2) == LUA_TSTRING) {
+            style_cache_entry_set(style_cache_add(sty->cache, section,
+                                                  lua_tostring(sty->L, -2)),
+                                  sty->L);
+          }
+          lua_pop(sty->L, 1);
+        }
+      }
+    }
+    lua_pop(sty->L, 1);
+  }
+  lua_settop(sty->L, stack_size);
+  if (!cacheable) {
+    style_cache_delete(sty->cache);
+    sty->cache = NULL;
+  }
+}
+
+/* Invalidates the snapshot after the style table has been changed.
+   Must be called with the write lock of <sty> held. */
+static void style_cache_invalidate(GtStyle *sty)
+{
+  gt_assert(sty);
+  style_cache_delete(sty->cache);
+  sty->cache = NULL;
+}
+
+/* Returns <true> if the value of <key> in <section> can be taken from the
+   snapshot of <sty>. <*entry> is then set to its entry, or to NULL if the value
+   is not set. Returns <false> if there is no valid snapshot or the value is a
+   callback function. Must be called with the lock of <sty> held. */
+static bool style_cache_get(const GtStyle *sty, const char *section,
+                            const char *key, const GtStyleCacheEntry **entry)
+{
+  gt_assert(sty && section && key && entry);
+  if (!sty->cache)
+    return false;
+  *entry = style_cache_find(sty->cache, section, key);
+  if (!(*entry)->section) {
+    *entry = NULL;
+    return true;
+  }
+  return !(*entry)->is_function;
+}
+
 static void style_lua_new_table(lua_State *L, const char *key)
 {
   lua_pushstring(L, key);
@@ -156,6 +387,8 @@ GtStyle* gt_style_new_with_state(lua_State *L)
   sty = gt_calloc(1, sizeof (GtStyle));
   sty->L = L;
   sty->unsafe = true;
+  /* the Lua state is shared, its style table can be changed directly */
+  sty->cache_disabled = true;
   sty->lock = gt_rwlock_new();
   return sty;
 }
@@ -237,6 +470,7 @@ int gt_style_load_file(GtStyle *sty, const char *filename, GtError *err)
   gt_rwlock_unlock(sty->lock);
   gt_rwlock_wrlock(sty->lock);
   sty->filename = gt_cstr_dup(filename);
+  style_cache_invalidate(sty);
   gt_log_log("Trying to load style file: %s...", filename);
   if (luaL_loadfile(sty->L, filename) || lua_pcall(sty->L, 0, 0, 0)) {
     gt_error_set(err, "cannot run style file: %s", lua_tostring(sty->L, -1));
@@ -322,15 +556,26 @@ GtStyleQueryStatus gt_style_get_color_with_track(const GtStyle *sty,
 #ifndef NDEBUG
   int stack_size;
 #endif
+  const GtStyleCacheEntry *entry;
   int i = 0;
   gt_assert(sty && section && key && color);
   gt_error_check(err);
+  /* set default colors */
+  color->red = 0.5; color->green = 0.5; color->blue = 0.5; color->alpha = 0.5;
+  gt_rwlock_rdlock(sty->lock);
+  if (style_cache_get(sty, section, key, &entry)) {
+    gt_rwlock_unlock(sty->lock);
+    if (!entry || !entry->has_color)
+      return GT_STYLE_QUERY_NOT_SET;
+    *color = entry->color;
+    return GT_STYLE_QUERY_OK;
+  }
+  gt_rwlock_unlock(sty->lock);
   gt_rwlock_wrlock(sty->lock);
+  style_cache_build((GtStyle*) sty);
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
-  /* set default colors */
-  color->red = 0.5; color->green = 0.5; color->blue = 0.5; color->alpha = 0.5;
   /* get section */
   i = style_find_section_for_getting(sty, section);
   /* could not get section, return default */
@@ -415,6 +660,7 @@ void gt_style_set_color(GtStyle *sty, const char *section, const char *key,
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
+  style_cache_invalidate(sty);
   i = style_find_section_for_setting(sty, section);
   lua_getfield(sty->L, -1, key);
   i++;
@@ -450,10 +696,23 @@ GtStyleQueryStatus gt_style_get_str_with_track(const GtStyle *sty,
 #ifndef NDEBUG
   int stack_size;
 #endif
+  const GtStyleCacheEntry *entry;
   int i = 0;
   gt_assert(sty && key && section);
   gt_error_check(err);
+  gt_rwlock_rdlock(sty->lock);
+  if (style_cache_get(sty, section, key, &entry)) {
+    if (!entry || !entry->has_str) {
+      gt_rwlock_unlock(sty->lock);
+      return GT_STYLE_QUERY_NOT_SET;
+    }
+    gt_str_set(text, entry->str);
+    gt_rwlock_unlock(sty->lock);
+    return GT_STYLE_QUERY_OK;
+  }
+  gt_rwlock_unlock(sty->lock);
   gt_rwlock_wrlock(sty->lock);
+  style_cache_build((GtStyle*) sty);
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
@@ -525,6 +784,7 @@ void gt_style_set_str(GtStyle *sty, const char *section, const char *key,
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
+  style_cache_invalidate(sty);
   i = style_find_section_for_setting(sty, section);
   lua_pushstring(sty->L, key);
   lua_pushstring(sty->L, gt_str_get(value));
@@ -544,10 +804,23 @@ GtStyleQueryStatus gt_style_get_num_with_track(const GtStyle *sty,
 #ifndef NDEBUG
   int stack_size;
 #endif
+  const GtStyleCacheEntry *entry;
   int i = 0;
   gt_assert(sty && key && section && val);
   gt_error_check(err);
+  gt_rwlock_rdlock(sty->lock);
+  if (style_cache_get(sty, section, key, &entry)) {
+    if (!entry || !entry->has_num) {
+      gt_rwlock_unlock(sty->lock);
+      return GT_STYLE_QUERY_NOT_SET;
+    }
+    *val = entry->num;
+    gt_rwlock_unlock(sty->lock);
+    return GT_STYLE_QUERY_OK;
+  }
+  gt_rwlock_unlock(sty->lock);
   gt_rwlock_wrlock(sty->lock);
+  style_cache_build((GtStyle*) sty);
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
@@ -624,6 +897,7 @@ void gt_style_set_num(GtStyle *sty, const char *section, const char *key,
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
+  style_cache_invalidate(sty);
   i = style_find_section_for_setting(sty, section);
   lua_pushstring(sty->L, key);
   lua_pushnumber(sty->L, number);
@@ -643,10 +917,23 @@ GtStyleQueryStatus gt_style_get_bool_with_track(const GtStyle *sty,
 #ifndef NDEBUG
   int stack_size;
 #endif
+  const GtStyleCacheEntry *entry;
   int i = 0;
   gt_assert(sty && key && section);
   gt_error_check(err);
+  gt_rwlock_rdlock(sty->lock);
+  if (style_cache_get(sty, section, key, &entry)) {
+    if (!entry || !entry->has_bool) {
+      gt_rwlock_unlock(sty->lock);
+      return GT_STYLE_QUERY_NOT_SET;
+    }
+    *val = entry->boolval;
+    gt_rwlock_unlock(sty->lock);
+    return GT_STYLE_QUERY_OK;
+  }
+  gt_rwlock_unlock(sty->lock);
   gt_rwlock_wrlock(sty->lock);
+  style_cache_build((GtStyle*) sty);
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
@@ -718,6 +1005,7 @@ void gt_style_set_bool(GtStyle *sty, const char *section, const char *key,
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
+  style_cache_invalidate(sty);
   i = style_find_section_for_setting(sty, section);
   lua_pushstring(sty->L, key);
   lua_pushboolean(sty->L, val);
@@ -737,6 +1025,7 @@ void gt_style_unset(GtStyle *sty, const char *section, const char *key)
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);
 #endif
+  style_cache_invalidate(sty);
   lua_getglobal(sty->L, "style");
   if (!lua_isnil(sty->L, -1)) {
     gt_assert(lua_istable(sty->L, -1));
@@ -794,6 +1083,7 @@ int gt_style_load_str(GtStyle *sty, GtStr *instr, GtError *err)
 #ifndef NDEBUG
   stack_size = lua_gettop(sty->L);;
 #endif
+  style_cache_invalidate(sty);
   if (luaL_loadbuffer(sty->L, gt_str_get(instr), gt_str_length(instr), "str") ||
       lua_pcall(sty->L, 0, 0, 0)) {
     gt_error_set(err, "cannot run style buffer: %s",
@@ -938,6 +1228,33 @@ int gt_style_unit_test(GtError *err)
                                    testerr) != GT_STYLE_QUERY_ERROR);
   gt_ensure((strcmp(gt_str_get(str),"")==0));
 
+  /* changes are visible after the values have been queried */
+  gt_ensure(gt_style_get_color(new_sty, "foo", "fill", &tmpcol, NULL,
+                               testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(gt_color_equals(&tmpcol, &col2));
+  gt_style_unset(new_sty, "foo", "fill");
+  gt_ensure(gt_style_get_color(new_sty, "foo", "fill", &tmpcol, NULL,
+                               testerr) == GT_STYLE_QUERY_NOT_SET);
+  gt_ensure(gt_color_equals(&tmpcol, &defcol));
+
+  /* callbacks are evaluated, static values are taken from the snapshot */
+  gt_str_set(sty_buffer, "style = { cb = { num = function() return 7 end,"
+                         " numstr = \"8\" } }");
+  gt_ensure(gt_style_load_str(new_sty, sty_buffer, testerr) == 0);
+  gt_ensure(gt_style_get_num(new_sty, "cb", "num", &num, NULL,
+                             testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(num == 7.0);
+  gt_ensure(gt_style_get_num(new_sty, "cb", "numstr", &num, NULL,
+                             testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(num == 8.0);
+  gt_str_reset(str);
+  gt_ensure(gt_style_get_str(new_sty, "cb", "numstr", str, NULL,
+                             testerr) == GT_STYLE_QUERY_OK);
+  gt_ensure(strcmp(gt_str_get(str), "8") == 0);
+  gt_ensure(gt_style_get_bool(new_sty, "cb", "numstr", &val, NULL,
+                              testerr) == GT_STYLE_QUERY_NOT_SET);
+  gt_ensure(!gt_error_is_set(testerr));
+
   /* mem cleanup */
   gt_error_delete(testerr);
   gt_str_delete(test1);
@@ -960,6 +1277,7 @@ void gt_style_delete_without_state(GtStyle *sty)
     return;
   }
   gt_free(sty->filename);
+  style_cache_delete(sty->cache);
   gt_rwlock_unlock(sty->lock);
   gt_rwlock_delete(sty->lock);
   gt_rwlock_delete(sty->clone_lock);
@@ -0,0 +1,207 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "annotationsketch/canvas_api.h"
+#include "annotationsketch/canvas_cairo_file.h"
+#include "annotationsketch/diagram.h"
+#include "annotationsketch/layout.h"
+#include "annotationsketch/tile_renderer.h"
+#include "core/array.h"
+#include "core/ma.h"
+#include "core/multithread_api.h"
+#include "core/str.h"
+#include "core/thread_api.h"
+#include "extended/feature_index.h"
+
+typedef struct {
+  GtStr *seqid,
+        *filename;
+  GtRange range;
+} GtTile;
+
+struct GtTileRenderer {
+  GtFeatureIndex *feature_index;
+  GtStyle *style;
+  GtArray *tiles;
+  GtTrackSelectorFunc select_func;
+  void *select_data;
+  GtGraphicsOutType type;
+  unsigned int width;
+};
+
+typedef struct {
+  GtTileRenderer *tile_renderer;
+  GtMutex *mutex;
+  GtUword next_tile;
+  bool failed;
+  GtError *err;
+} GtTileRendererThreadInfo;
+
+GtTileRenderer* gt_tile_renderer_new(GtFeatureIndex *feature_index,
+                                     GtStyle *style, unsigned int width,
+                                     GtGraphicsOutType type)
+{
+  GtTileRenderer *tile_renderer;
+  gt_assert(feature_index && style && width > 0);
+  tile_renderer = gt_calloc(1, sizeof *tile_renderer);
+  tile_renderer->feature_index = gt_feature_index_ref(feature_index);
+  tile_renderer->style = gt_style_ref(style);
+  tile_renderer->tiles = gt_array_new(sizeof (GtTile));
+  tile_renderer->width = width;
+  tile_renderer->type = type;
+  return tile_renderer;
+}
+
+void gt_tile_renderer_set_track_selector_func(GtTileRenderer *tile_renderer,
+                                              GtTrackSelectorFunc func,
+                                              void *data)
+{
+  gt_assert(tile_renderer);
+  tile_renderer->select_func = func;
+  tile_renderer->select_data = data;
+}
+
+void gt_tile_renderer_add_tile(GtTileRenderer *tile_renderer,
+                               const char *seqid, const GtRange *range,
+                               const char *filename)
+{
+  GtTile tile;
+  gt_assert(tile_renderer && seqid && range && filename);
+  gt_assert(range->start <= range->end);
+  tile.seqid = gt_str_new_cstr(seqid);
+  tile.filename = gt_str_new_cstr(filename);
+  tile.range = *range;
+  gt_array_add(tile_renderer->tiles, tile);
+}
+
+GtUword gt_tile_renderer_num_of_tiles(const GtTileRenderer *tile_renderer)
+{
+  gt_assert(tile_renderer);
+  return gt_array_size(tile_renderer->tiles);
+}
+
+/* renders a single <tile> the same way as the single image mode of
+   <gt sketch> does */
+static int tile_renderer_render_tile(GtTileRenderer *tile_renderer,
+                                     GtTile *tile, GtError *err)
+{
+  GtDiagram *d;
+  GtLayout *l = NULL;
+  GtCanvas *canvas = NULL;
+  GtUword height;
+  int had_err = 0;
+  gt_error_check(err);
+
+  if (!(d = gt_diagram_new(tile_renderer->feature_index,
+                           gt_str_get(tile->seqid), &tile->range,
+                           tile_renderer->style, err))) {
+    return -1;
+  }
+  if (tile_renderer->select_func) {
+    gt_diagram_set_track_selector_func(d, tile_renderer->select_func,
+                                       tile_renderer->select_data);
+  }
+  if (!(l = gt_layout_new(d, tile_renderer->width, tile_renderer->style,
+                          err))) {
+    had_err = -1;
+  }
+  if (!had_err)
+    had_err = gt_layout_get_height(l, &height, err);
+  if (!had_err && !(canvas = gt_canvas_cairo_file_new(tile_renderer->style,
+                                                      tile_renderer->type,
+                                                      tile_renderer->width,
+                                                      height, NULL, err))) {
+    had_err = -1;
+  }
+  if (!had_err)
+    had_err = gt_layout_sketch(l, canvas, err);
+  if (!had_err) {
+    had_err = gt_canvas_cairo_file_to_file((GtCanvasCairoFile*) canvas,
+                                           gt_str_get(tile->filename), err);
+  }
+  gt_canvas_delete(canvas);
+  gt_layout_delete(l);
+  gt_diagram_delete(d);
+  return had_err;
+}
+
+static void* tile_renderer_thread_func(void *data)
+{
+  GtTileRendererThreadInfo *info = data;
+  GtTile *tile;
+  GtError *err;
+  gt_assert(info);
+
+  err = gt_error_new();
+  while (true) {
+    gt_mutex_lock(info->mutex);
+    if (info->failed ||
+        info->next_tile == gt_array_size(info->tile_renderer->tiles)) {
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+    tile = gt_array_get(info->tile_renderer->tiles, info->next_tile++);
+    gt_mutex_unlock(info->mutex);
+
+    if (tile_renderer_render_tile(info->tile_renderer, tile, err)) {
+      /* report the first error, the other threads stop after their current
+         tile */
+      gt_mutex_lock(info->mutex);
+      if (!info->failed) {
+        info->failed = true;
+        gt_error_set(info->err, "%s", gt_error_get(err));
+      }
+      gt_mutex_unlock(info->mutex);
+      break;
+    }
+  }
+  gt_error_delete(err);
+  return NULL;
+}
+
+int gt_tile_renderer_render(GtTileRenderer *tile_renderer, GtError *err)
+{
+  GtTileRendererThreadInfo info;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(tile_renderer);
+
+  info.tile_renderer = tile_renderer;
+  info.mutex = gt_mutex_new();
+  info.next_tile = 0;
+  info.failed = false;
+  info.err = err;
+  had_err = gt_multithread(tile_renderer_thread_func, &info, err);
+  if (!had_err && info.failed)
+    had_err = -1;
+  gt_mutex_delete(info.mutex);
+  return had_err;
+}
+
+void gt_tile_renderer_delete(GtTileRenderer *tile_renderer)
+{
+  GtUword i;
+  if (!tile_renderer) return;
+  for (i = 0; i < gt_array_size(tile_renderer->tiles); i++) {
+    GtTile *tile = gt_array_get(tile_renderer->tiles, i);
+    gt_str_delete(tile->seqid);
+    gt_str_delete(tile->filename);
+  }
+  gt_array_delete(tile_renderer->tiles);
+  gt_style_delete(tile_renderer->style);
+  gt_feature_index_delete(tile_renderer->feature_index);
+  gt_free(tile_renderer);
+}
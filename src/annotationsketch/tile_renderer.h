@@ -0,0 +1,71 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef TILE_RENDERER_H
+#define TILE_RENDERER_H
+
+#include "annotationsketch/diagram_api.h"
+#include "annotationsketch/graphics_api.h"
+#include "annotationsketch/style_api.h"
+#include "core/error_api.h"
+#include "core/range_api.h"
+#include "extended/feature_index_api.h"
+
+/* A <GtTileRenderer> renders a batch of image files (``tiles''), each showing
+   a range of a sequence region, from a common <GtFeatureIndex> and
+   <GtStyle>. The tiles are rendered in <gt_jobs> parallel threads, each tile
+   with its own <GtDiagram>, <GtLayout> and <GtCanvas>. The feature index and
+   the style are only read while rendering and must not be changed in the
+   meantime. Each file is identical to the one rendered by the single image
+   code path of <gt sketch>. */
+typedef struct GtTileRenderer GtTileRenderer;
+
+/* Creates a new <GtTileRenderer> which renders the features from
+   <feature_index> with style <style> into images of <width> pixels in format
+   <type>. */
+GtTileRenderer* gt_tile_renderer_new(GtFeatureIndex *feature_index,
+                                     GtStyle *style, unsigned int width,
+                                     GtGraphicsOutType type);
+
+/* Uses <func> (with <data> passed to it) to assign blocks to tracks in all
+   diagrams created by <tile_renderer>. */
+void            gt_tile_renderer_set_track_selector_func(GtTileRenderer
+                                                         *tile_renderer,
+                                                         GtTrackSelectorFunc
+                                                         func,
+                                                         void *data);
+
+/* Adds a tile showing <range> of sequence region <seqid> to <tile_renderer>,
+   which is written to file <filename>. */
+void            gt_tile_renderer_add_tile(GtTileRenderer *tile_renderer,
+                                          const char *seqid,
+                                          const GtRange *range,
+                                          const char *filename);
+
+/* Returns the number of tiles added to <tile_renderer>. */
+GtUword         gt_tile_renderer_num_of_tiles(const GtTileRenderer
+                                              *tile_renderer);
+
+/* Renders all tiles added to <tile_renderer> and writes them to their files.
+   Returns 0 on success. Otherwise -1 is returned, <err> is set to the first
+   error which occurred and tiles not yet started are skipped. */
+int             gt_tile_renderer_render(GtTileRenderer *tile_renderer,
+                                        GtError *err);
+
+/* Deletes <tile_renderer>. */
+void            gt_tile_renderer_delete(GtTileRenderer *tile_renderer);
+
+#endif
@@ -0,0 +1,84 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/atomic.h"
+#include "core/object_lock.h"
+
+void gt_atomic_uint_inc_func(unsigned int *ptr)
+{
+  gt_object_lock_enter(ptr);
+  (*ptr)++;
+  gt_object_lock_leave(ptr);
+}
+
+unsigned int gt_atomic_uint_fetch_dec_func(unsigned int *ptr)
+{
+  unsigned int value;
+  gt_object_lock_enter(ptr);
+  value = (*ptr)--;
+  gt_object_lock_leave(ptr);
+  return value;
+}
+
+GtUword gt_atomic_uword_add_fetch_func(GtUword *ptr, GtUword value)
+{
+  GtUword result;
+  gt_object_lock_enter(ptr);
+  result = (*ptr += value);
+  gt_object_lock_leave(ptr);
+  return result;
+}
+
+void gt_atomic_uword_store_func(GtUword *ptr, GtUword value)
+{
+  gt_object_lock_enter(ptr);
+  *ptr = value;
+  gt_object_lock_leave(ptr);
+}
+
+bool gt_atomic_uword_cas_func(GtUword *ptr, GtUword expected,
+                              GtUword desired)
+{
+  bool swapped = false;
+  gt_object_lock_enter(ptr);
+  if (*ptr == expected) {
+    *ptr = desired;
+    swapped = true;
+  }
+  gt_object_lock_leave(ptr);
+  return swapped;
+}
+
+void gt_atomic_uword_max(GtUword *ptr, GtUword value)
+{
+#if defined(GT_THREADS_ENABLED) && defined(__ATOMIC_RELAXED)
+  GtUword current = __atomic_load_n(ptr, __ATOMIC_RELAXED);
+  while (current < value &&
+         !__atomic_compare_exchange_n(ptr, &current, value, 1,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    /* <current> has been updated, try again */ ;
+#elif defined(GT_THREADS_ENABLED) && defined(__GNUC__)
+  GtUword current = *ptr;
+  while (current < value &&
+         !__sync_bool_compare_and_swap(ptr, current, value))
+    current = *ptr;
+#else
+  gt_object_lock_enter(ptr);
+  if (*ptr < value)
+    *ptr = value;
+  gt_object_lock_leave(ptr);
+#endif
+}
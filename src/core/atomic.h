@@ -0,0 +1,145 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef ATOMIC_H
+#define ATOMIC_H
+
+#include <stdbool.h>
+#include "core/types_api.h"
+
+/* Atomic operations on <unsigned int> counters (e.g., reference counts) and
+   <GtUword> sizes which are shared between threads. GCC and Clang builtins are
+   used if available, otherwise the value is protected by a lock from
+   core/object_lock.h. Without GT_THREADS_ENABLED the operations are not
+   atomic. */
+
+#ifdef GT_THREADS_ENABLED
+#if defined(__ATOMIC_RELAXED)
+/* Increments the counter at <ptr>. */
+#define gt_atomic_uint_inc(ptr) \
+        ((void) __atomic_add_fetch(ptr, 1U, __ATOMIC_RELAXED))
+/* Decrements the counter at <ptr> and returns its previous value. If the
+   previous value is 0, the counter wraps around. */
+#define gt_atomic_uint_fetch_dec(ptr) \
+        __atomic_fetch_sub(ptr, 1U, __ATOMIC_ACQ_REL)
+#elif defined(__GNUC__)
+#define gt_atomic_uint_inc(ptr) \
+        ((void) __sync_add_and_fetch(ptr, 1U))
+#define gt_atomic_uint_fetch_dec(ptr) \
+        __sync_fetch_and_sub(ptr, 1U)
+#else
+#define gt_atomic_uint_inc(ptr) \
+        gt_atomic_uint_inc_func(ptr)
+#define gt_atomic_uint_fetch_dec(ptr) \
+        gt_atomic_uint_fetch_dec_func(ptr)
+#endif
+#else
+#define gt_atomic_uint_inc(ptr) \
+        ((void) ++*(ptr))
+#define gt_atomic_uint_fetch_dec(ptr) \
+        ((*(ptr))--)
+#endif
+
+#ifdef GT_THREADS_ENABLED
+#if defined(__ATOMIC_RELAXED)
+/* Adds <value> to the size at <ptr> and returns the new size. */
+#define gt_atomic_uword_add_fetch(ptr, value) \
+        __atomic_add_fetch(ptr, value, __ATOMIC_RELAXED)
+/* Subtracts <value> from the size at <ptr>. */
+#define gt_atomic_uword_sub(ptr, value) \
+        ((void) __atomic_sub_fetch(ptr, value, __ATOMIC_RELAXED))
+/* Returns the size at <ptr>. */
+#define gt_atomic_uword_load(ptr) \
+        __atomic_load_n(ptr, __ATOMIC_RELAXED)
+#elif defined(__GNUC__)
+#define gt_atomic_uword_add_fetch(ptr, value) \
+        __sync_add_and_fetch(ptr, value)
+#define gt_atomic_uword_sub(ptr, value) \
+        ((void) __sync_sub_and_fetch(ptr, value))
+#define gt_atomic_uword_load(ptr) \
+        __sync_add_and_fetch(ptr, 0)
+#else
+#define gt_atomic_uword_add_fetch(ptr, value) \
+        gt_atomic_uword_add_fetch_func(ptr, value)
+#define gt_atomic_uword_sub(ptr, value) \
+        ((void) gt_atomic_uword_add_fetch_func(ptr, -(GtUword) (value)))
+#define gt_atomic_uword_load(ptr) \
+        gt_atomic_uword_add_fetch_func(ptr, 0)
+#endif
+#else
+#define gt_atomic_uword_add_fetch(ptr, value) \
+        (*(ptr) += (value))
+#define gt_atomic_uword_sub(ptr, value) \
+        ((void) (*(ptr) -= (value)))
+#define gt_atomic_uword_load(ptr) \
+        (*(ptr))
+#endif
+
+#ifdef GT_THREADS_ENABLED
+#if defined(__ATOMIC_SEQ_CST)
+/* Sets the size at <ptr> to <value>. In contrast to the operations above,
+   this store and <gt_atomic_uword_load_ordered()> are sequentially consistent,
+   they order the memory accesses around them. */
+#define gt_atomic_uword_store(ptr, value) \
+        __atomic_store_n(ptr, value, __ATOMIC_SEQ_CST)
+/* Returns the size at <ptr>, see <gt_atomic_uword_store()>. */
+#define gt_atomic_uword_load_ordered(ptr) \
+        __atomic_load_n(ptr, __ATOMIC_SEQ_CST)
+#elif defined(__GNUC__)
+#define gt_atomic_uword_store(ptr, value) \
+        (__sync_synchronize(), *(volatile GtUword*) (ptr) = (value), \
+         __sync_synchronize())
+#define gt_atomic_uword_load_ordered(ptr) \
+        __sync_add_and_fetch(ptr, 0)
+#else
+#define gt_atomic_uword_store(ptr, value) \
+        gt_atomic_uword_store_func(ptr, value)
+#define gt_atomic_uword_load_ordered(ptr) \
+        gt_atomic_uword_add_fetch_func(ptr, 0)
+#endif
+#else
+#define gt_atomic_uword_store(ptr, value) \
+        ((void) (*(ptr) = (value)))
+#define gt_atomic_uword_load_ordered(ptr) \
+        (*(ptr))
+#endif
+
+#ifdef GT_THREADS_ENABLED
+#if defined(__GNUC__)
+/* Sets the size at <ptr> to <desired> if it equals <expected> and returns
+   true, otherwise returns false. Sequentially consistent like
+   <gt_atomic_uword_store()>. */
+#define gt_atomic_uword_cas(ptr, expected, desired) \
+        __sync_bool_compare_and_swap(ptr, expected, desired)
+#else
+#define gt_atomic_uword_cas(ptr, expected, desired) \
+        gt_atomic_uword_cas_func(ptr, expected, desired)
+#endif
+#else
+#define gt_atomic_uword_cas(ptr, expected, desired) \
+        gt_atomic_uword_cas_func(ptr, expected, desired)
+#endif
+
+void         gt_atomic_uint_inc_func(unsigned int *ptr);
+unsigned int gt_atomic_uint_fetch_dec_func(unsigned int *ptr);
+GtUword      gt_atomic_uword_add_fetch_func(GtUword *ptr, GtUword value);
+void         gt_atomic_uword_store_func(GtUword *ptr, GtUword value);
+bool         gt_atomic_uword_cas_func(GtUword *ptr, GtUword expected,
+                                      GtUword desired);
+/* Sets the size at <ptr> to <value>, if <value> is larger. */
+void         gt_atomic_uword_max(GtUword *ptr, GtUword value);
+
+#endif
@@ -24,6 +24,7 @@
 #include "core/log_api.h"
 #include "core/ma.h"
 #include "core/queue.h"
+#include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
 
@@ -141,6 +142,39 @@ void gt_desc_buffer_reset(GtDescBuffer *db)
   db->dirty = false;
 }
 
+/* returns the position of the next '\0' in <src> which was appended by
+   <gt_desc_buffer_finish()> */
+static GtUword gt_desc_buffer_next_end(GtDescBuffer *src)
+{
+  GtUword startpos;
+  while (gt_queue_size(src->startqueue) > 0) {
+    startpos = (GtUword) gt_queue_get(src->startqueue);
+    if (startpos > 0)
+      return startpos - 1;
+  }
+  return src->finished ? src->length - 1 : GT_UNDEF_UWORD;
+}
+
+void gt_desc_buffer_move(GtDescBuffer *dest, GtDescBuffer *src)
+{
+  GtUword i, end;
+  gt_assert(dest && src && dest != src);
+  end = gt_desc_buffer_next_end(src);
+  for (i = 0; i < src->length; i++) {
+    if (i == end) {
+      gt_desc_buffer_finish(dest);
+      end = gt_desc_buffer_next_end(src);
+    }
+    else
+      gt_desc_buffer_append_char(dest, src->buf[i]);
+  }
+  gt_assert(gt_queue_size(src->startqueue) == 0);
+  gt_queue_add(src->startqueue, (void*) 0);
+  src->length = src->curlength = 0;
+  src->finished = src->seen_whitespace = false;
+  src->dirty = true;
+}
+
 GtUword gt_desc_buffer_max_length(GtDescBuffer *db)
 {
   gt_assert(db);
@@ -243,5 +277,30 @@ int gt_desc_buffer_unit_test(GtError *err)
   gt_ensure(gt_desc_buffer_length(s) == 12);
   gt_desc_buffer_delete(s);
 
+  if (!had_err) {
+    GtDescBuffer *t = gt_desc_buffer_new();
+    s = gt_desc_buffer_new();
+    gt_desc_buffer_set_clip_at_whitespace(s);
+    for (j = 0; j < 3; j++) {
+      for (i = 0; i < strlen(strs[j]); i++)
+        gt_desc_buffer_append_char(t, strs[j][i]);
+      gt_desc_buffer_append_char(t, ' ');
+      gt_desc_buffer_append_char(t, 'x');
+      if (j == 1)
+        gt_desc_buffer_move(s, t);
+      gt_desc_buffer_finish(t);
+    }
+    gt_desc_buffer_move(s, t);
+    gt_ensure(gt_desc_buffer_length(t) == 0);
+    gt_ensure(gt_desc_buffer_max_length(s) == 4);
+    for (j = 0; j < 3; j++) {
+      ret = gt_desc_buffer_get_next(s);
+      gt_ensure(strcmp(ret, strs[j]) == 0);
+    }
+    gt_ensure(gt_desc_buffer_length(s) == 12);
+    gt_desc_buffer_delete(t);
+    gt_desc_buffer_delete(s);
+  }
+
   return had_err;
 }
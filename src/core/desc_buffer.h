@@ -38,6 +38,10 @@ void          gt_desc_buffer_append_char(GtDescBuffer *db, char c);
 void          gt_desc_buffer_finish(GtDescBuffer *db);
 /* Reset <db> to length 0. */
 void          gt_desc_buffer_reset(GtDescBuffer *db);
+/* Appends the characters and description ends recorded in <src> to <dest> as
+   if they had been passed to <dest> directly, then empties <src>. <src> must
+   not have been read with <gt_desc_buffer_get_next()>. */
+void          gt_desc_buffer_move(GtDescBuffer *dest, GtDescBuffer *src);
 /* Returns the maximum length of any description passed through <db>. */
 GtUword gt_desc_buffer_max_length(GtDescBuffer *db);
 /* Decrease the reference count for <db> or delete it, if this was the last
@@ -53,12 +53,15 @@
 #include "core/ma_api.h"
 #include "core/mapspec.h"
 #include "core/mathsupport.h"
+#include "core/md5_batcher.h"
 #include "core/md5_encoder_api.h"
 #include "core/minmax.h"
 #include "core/progressbar.h"
 #include "core/sequence_buffer_fasta.h"
 #include "core/sequence_buffer_plain.h"
+#include "core/sequence_buffer_readahead.h"
 #include "core/str.h"
+#include "core/thread_api.h"
 #include "core/timer_api.h"
 #include "core/types_api.h"
 #include "core/undef_api.h"
@@ -4524,7 +4527,11 @@ static GtEncseq *files2encodedsequence(const GtStrArray *filenametab,
                            true);
     }
     gt_sequence_buffer_set_symbolmap(fb, gt_alphabet_symbolmap(alphabet));
-    if (encodedseqfunctab[(int) sat].fillposition.function(encseq,
+    /* with multiple threads the input is parsed in the background */
+    if (gt_jobs > 1U && !(fb = gt_sequence_buffer_readahead_new(fb, err)))
+      haserr = true;
+    if (!haserr &&
+        encodedseqfunctab[(int) sat].fillposition.function(encseq,
                                                            ssptaboutinfo,
                                                            fb, err) != 0)
       haserr = true;
@@ -5272,13 +5279,17 @@ static int countnumberofexceptionranges(const GtAlphabet *alpha,
     gt_assert(gt_error_is_set(err));
     had_err = -1;
   }
+  if (!had_err) {
+    gt_sequence_buffer_set_symbolmap(fb, gt_alphabet_symbolmap(alpha));
+    if (gt_jobs > 1U && !(fb = gt_sequence_buffer_readahead_new(fb, err)))
+      had_err = -1;
+  }
   if (!had_err) {
     int retval;
     char cc;
     bool in_range = false;
     GtUchar charcode;
 
-    gt_sequence_buffer_set_symbolmap(fb, gt_alphabet_symbolmap(alpha));
     for (currentpos = 0; /* Nothing */; currentpos++) {
       retval = gt_sequence_buffer_next_with_original(fb, &charcode, &cc, err);
       if (retval > 0) {
@@ -5314,6 +5325,20 @@ static int countnumberofexceptionranges(const GtAlphabet *alpha,
   return had_err;
 }
 
+/* Adds the characters collected in <md5_blockbuf> to the MD5 sum of the
+   current sequence, see encseq_charproc.gen. */
+#define GT_ENCSEQ_MD5_ADD_BLOCK\
+        ((md5enc != NULL)\
+          ? gt_md5_encoder_add_block(md5enc, md5_blockbuf, md5_blockcount)\
+          : gt_md5_batcher_add(md5batcher, md5_blockbuf, md5_blockcount))
+
+static int encseq_md5_write(GT_UNUSED GtUword seqnum, const char *md5,
+                            void *data, GT_UNUSED GtError *err)
+{
+  gt_xfwrite(md5, sizeof (char), (size_t) 33, (FILE*) data);
+  return 0;
+}
+
 static int gt_inputfiles2sequencekeyvalues(const char *indexname,
                                            GtUword *totallength,
                                            GtSpecialcharinfo *specialcharinfo,
@@ -5359,6 +5384,7 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
   GtDiscDistri *distspecialrangelength = NULL, *distwildcardrangelength = NULL;
   GtDescBuffer *descqueue = NULL;
   GtMD5Encoder *md5enc = NULL;
+  GtMD5Batcher *md5batcher = NULL;
   char *desc,
        md5_blockbuf[64],
        md5_outbuf[33];
@@ -5412,12 +5438,22 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
     if (descqueue != NULL)
       gt_sequence_buffer_set_desc_buffer(fb, descqueue);
     gt_sequence_buffer_set_chardisttab(fb, characterdistribution);
+    /* with multiple threads the input is parsed in the background */
+    if (gt_jobs > 1U && !(fb = gt_sequence_buffer_readahead_new(fb, err)))
+      haserr = true;
     distspecialrangelength = gt_disc_distri_new();
     distwildcardrangelength = gt_disc_distri_new();
     originaldistribution = gt_calloc((size_t) UCHAR_MAX,
                                      sizeof (GtUword));
-    if (md5fp != NULL)
-      md5enc = gt_md5_encoder_new();
+    if (!haserr && md5fp != NULL) {
+      /* with multiple threads the MD5 sums are computed in the background */
+      if (gt_jobs > 1U) {
+        if (!(md5batcher = gt_md5_batcher_new(encseq_md5_write, md5fp, err)))
+          haserr = true;
+      }
+      else
+        md5enc = gt_md5_encoder_new();
+    }
     for (currentpos = 0; !haserr; currentpos++) {
 #if !(defined (_LP64) || defined (_WIN64))
 #define MAXSFXLENFOR32BIT 4294000000UL
@@ -5467,6 +5503,13 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
             gt_md5_encoder_finish(md5enc, md5_output, md5_outbuf);
             gt_xfwrite(md5_outbuf, sizeof (char), (size_t) 33, md5fp);
           }
+          else if (md5batcher != NULL) {
+            gt_md5_batcher_add(md5batcher, md5_blockbuf, md5_blockcount);
+            if (gt_md5_batcher_finish_sequence(md5batcher, err) != 0 ||
+                gt_md5_batcher_flush(md5batcher, err) != 0) {
+              haserr = true;
+            }
+          }
           if (equallength->defined) {
             if (equallength->valueunsignedlong > 0) {
               if (lengthofcurrentsequence != equallength->valueunsignedlong) {
@@ -5489,6 +5532,7 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
       }
     }
     gt_md5_encoder_delete(md5enc);
+    gt_md5_batcher_delete(md5batcher);
   }
   if (!haserr) {
     alphabet_to_key_values(alpha, NULL, &lengthofalphadef, NULL,
@@ -5599,6 +5643,7 @@ static void sequence2specialcharinfo(GtSpecialcharinfo *specialcharinfo,
   GtDiscDistri *distspecialrangelength,
                *distwildcardrangelength;
   GtMD5Encoder *md5enc = NULL;
+  GtMD5Batcher *md5batcher = NULL;
   char md5_blockbuf[64];
   GT_UNUSED char md5_outbuf[33];
   unsigned char md5_output[16];
@@ -28,29 +28,43 @@ void gt_fasta_show_entry(const char *description, const char *sequence,
                                   width, outfp);
 }
 
+/* writes the characters <from> to <to> (exclusively) of the concatenation of
+   <sequence> and <suffix> */
+static void show_range(const char *sequence, GtUword sequence_length,
+                       const char *suffix, GtUword from, GtUword to,
+                       GtFile *outfp)
+{
+  if (from < sequence_length) {
+    GtUword end = to < sequence_length ? to : sequence_length;
+    gt_file_xwrite(outfp, (char*) sequence + from, (size_t) (end - from));
+    from = end;
+  }
+  if (from < to) {
+    gt_file_xwrite(outfp, (char*) suffix + from - sequence_length,
+                   (size_t) (to - from));
+  }
+}
+
 void gt_fasta_show_entry_with_suffix(const char *description,
                                      const char *sequence,
                                      GtUword sequence_length,
                                      const char *suffix, GtUword width,
                                      GtFile *outfp)
 {
-  GtUword i, current_length, suffix_length;
+  GtUword i, total_length, line_length;
   gt_assert(sequence);
   gt_file_xfputc(GT_FASTA_SEPARATOR, outfp);
   if (description)
     gt_file_xfputs(description, outfp);
   gt_file_xfputc('\n', outfp);
-  suffix_length = suffix ? strlen(suffix) : 0;
-  for (i = 0, current_length = 0; i < sequence_length + suffix_length;
-       i++, current_length++) {
-    if (width && current_length == width) {
+  total_length = sequence_length + (suffix ? strlen(suffix) : 0);
+  /* write whole lines at once instead of single characters */
+  for (i = 0; i < total_length; i += line_length) {
+    if (width && i > 0)
       gt_file_xfputc('\n', outfp);
-      current_length = 0;
-    }
-    if (i < sequence_length)
-      gt_file_xfputc(sequence[i], outfp);
-    else
-      gt_file_xfputc(suffix[i-sequence_length], outfp);
+    line_length = width && width < total_length - i ? width
+                                                    : total_length - i;
+    show_range(sequence, sequence_length, suffix, i, i + line_length, outfp);
   }
   gt_file_xfputc('\n', outfp);
 }
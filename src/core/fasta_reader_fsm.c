@@ -15,6 +15,7 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "core/fasta_reader_fsm.h"
 #include "core/fasta_reader_rep.h"
 #include "core/fasta_separator.h"
@@ -23,6 +24,7 @@ struct GtFastaReaderFSM {
   const GtFastaReader parent_instance;
   GtStr *sequence_filename;
   GtFile *sequence_file;
+  bool is_stdin;
 };
 
 typedef enum {
@@ -35,6 +37,53 @@ typedef enum {
 #define gt_fasta_reader_fsm_cast(FR)\
         gt_fasta_reader_cast(gt_fasta_reader_fsm_class(), FR)
 
+/* Append <len> characters of <line> to <str>, skipping the characters <skip1>
+   and <skip2>. */
+static void gt_fasta_reader_fsm_append(GtStr *str, const char *line,
+                                       GtUword len, char skip1, char skip2)
+{
+  const char *end = line + len;
+  while (line < end) {
+    const char *run = line;
+    while (run < end && *run != skip1 && *run != skip2)
+      run++;
+    gt_str_append_cstr_nt(str, line, (GtUword) (run - line));
+    line = run + 1;
+  }
+}
+
+/* Append the sequence characters of <len> characters of <line> to <sequence>
+   and pass the sequence to <proc_sequence_part> whenever <BUFSIZ> characters
+   have been collected. */
+static int gt_fasta_reader_fsm_append_sequence(GtStr *sequence,
+                                               const char *line, GtUword len,
+                                               GtFastaReaderProcSequencePart
+                                               proc_sequence_part,
+                                               void *data, GtError *err)
+{
+  const char *end = line + len;
+  int had_err = 0;
+  while (!had_err && line < end) {
+    GtUword room;
+    const char *run;
+    if (gt_str_length(sequence) == BUFSIZ) {
+      had_err = proc_sequence_part(gt_str_get(sequence),
+                                   gt_str_length(sequence), data, err);
+      gt_str_reset(sequence);
+      continue;
+    }
+    room = BUFSIZ - gt_str_length(sequence);
+    for (run = line; run < end && (GtUword) (run - line) < room &&
+                     *run != ' ' && *run != '\r'; run++)
+      /* Nothing */ ;
+    gt_str_append_cstr_nt(sequence, line, (GtUword) (run - line));
+    line = run;
+    if (line < end && (*line == ' ' || *line == '\r'))
+      line++;
+  }
+  return had_err;
+}
+
 static int gt_fasta_reader_fsm_run(GtFastaReader *fasta_reader,
                                    GtFastaReaderProcDescription
                                    proc_description,
@@ -45,9 +94,10 @@ static int gt_fasta_reader_fsm_run(GtFastaReader *fasta_reader,
                                    void *data, GtError *err)
 {
   GtFastaReaderFSM *fr = gt_fasta_reader_fsm_cast(fasta_reader);
-  unsigned char cc;
+  const char *block, *ptr, *end, *newline;
+  size_t blocklen;
   GtFastaReaderState state = EXPECTING_SEPARATOR;
-  GtUword sequence_length = 0, line_counter = 1;
+  GtUword sequence_length = 0, line_counter = 1, len;
   GtStr *description, *sequence;
   int had_err = 0;
 
@@ -62,24 +112,38 @@ static int gt_fasta_reader_fsm_run(GtFastaReader *fasta_reader,
   gt_assert(proc_description || proc_sequence_part || proc_sequence_length);
 
   /* rewind sequence file (to allow multiple calls) */
-  if (fr->sequence_file)
+  if (!fr->is_stdin)
     gt_file_xrewind(fr->sequence_file);
 
-  /* reading */
-  while (!had_err && gt_file_xread(fr->sequence_file, &cc, 1) != 0) {
-    switch (state) {
-      case EXPECTING_SEPARATOR:
-        if (cc != GT_FASTA_SEPARATOR) {
-          gt_error_set(err,
+  /* reading: the input is scanned blockwise, the lines of a block are
+     located with memchr(3) */
+  while (!had_err &&
+         (blocklen = gt_file_xread_block(fr->sequence_file, &block)) != 0) {
+    end = block + blocklen;
+    for (ptr = block; !had_err && ptr < end; /* Nothing */) {
+      switch (state) {
+        case EXPECTING_SEPARATOR:
+          if (*ptr != GT_FASTA_SEPARATOR) {
+            gt_error_set(err,
                     "the first character of fasta file \"%s\" has to be '%c'",
                     gt_str_get(fr->sequence_filename), GT_FASTA_SEPARATOR);
-          had_err = -1;
-        }
-        else
-          state = READING_DESCRIPTION;
-        break;
-      case READING_DESCRIPTION:
-        if (cc == '\n') {
+            had_err = -1;
+          }
+          else {
+            ptr++;
+            state = READING_DESCRIPTION;
+          }
+          break;
+        case READING_DESCRIPTION:
+          newline = memchr(ptr, '\n', (size_t) (end - ptr));
+          len = (GtUword) ((newline ? newline : end) - ptr);
+          if (proc_description)
+            gt_fasta_reader_fsm_append(description, ptr, len, '\r', '\r');
+          if (!newline) {
+            ptr = end;
+            break;
+          }
+          ptr = newline + 1;
           if (proc_description) {
             had_err = proc_description(gt_str_get(description),
                                        gt_str_length(description), data, err);
@@ -91,22 +155,17 @@ static int gt_fasta_reader_fsm_run(GtFastaReader *fasta_reader,
             line_counter++;
             state = READING_SEQUENCE_AFTER_NEWLINE;
           }
-        }
-        else if (proc_description && cc != '\r')
-          gt_str_append_char(description, cc);
-        break;
-      case READING_SEQUENCE_AFTER_NEWLINE:
-        if (cc == GT_FASTA_SEPARATOR) {
-          if (!sequence_length) {
-            gt_assert(line_counter);
-            gt_error_set(err, "empty sequence after description given in line "
-                              ""GT_WU"", line_counter - 1);
-            had_err = -1;
-            break;
-          }
-          else {
-            if (proc_sequence_part) {
-              gt_assert(gt_str_length(sequence));
+          break;
+        case READING_SEQUENCE_AFTER_NEWLINE:
+          if (*ptr == GT_FASTA_SEPARATOR) {
+            if (!sequence_length) {
+              gt_assert(line_counter);
+              gt_error_set(err, "empty sequence after description given in "
+                                "line "GT_WU"", line_counter - 1);
+              had_err = -1;
+              break;
+            }
+            if (proc_sequence_part && gt_str_length(sequence)) {
               had_err = proc_sequence_part(gt_str_get(sequence),
                                            gt_str_length(sequence), data, err);
             }
@@ -117,31 +176,30 @@ static int gt_fasta_reader_fsm_run(GtFastaReader *fasta_reader,
               had_err = proc_sequence_length(sequence_length, data, err);
             if (had_err)
               break;
+            ptr++;
             state = READING_DESCRIPTION;
-            continue;
+            break;
           }
-        }
-        /*@fallthrough@*/
-      case READING_SEQUENCE:
-        if (cc == '\n') {
-          line_counter++;
-          state = READING_SEQUENCE_AFTER_NEWLINE;
-        }
-        else {
-          sequence_length++;
+          state = READING_SEQUENCE;
+          /*@fallthrough@*/
+        case READING_SEQUENCE:
+          newline = memchr(ptr, '\n', (size_t) (end - ptr));
+          len = (GtUword) ((newline ? newline : end) - ptr);
+          sequence_length += len;
           if (proc_sequence_part) {
-            if (gt_str_length(sequence) == BUFSIZ) {
-              had_err = proc_sequence_part(gt_str_get(sequence),
-                                           gt_str_length(sequence), data, err);
-              if (had_err)
-                break;
-              gt_str_reset(sequence);
-            }
-            if (cc != ' ' && cc != '\r')
-              gt_str_append_char(sequence, cc);
+            had_err = gt_fasta_reader_fsm_append_sequence(sequence, ptr, len,
+                                                          proc_sequence_part,
+                                                          data, err);
           }
-        }
-        break;
+          if (newline) {
+            line_counter++;
+            state = READING_SEQUENCE_AFTER_NEWLINE;
+            ptr = newline + 1;
+          }
+          else
+            ptr = end;
+          break;
+      }
     }
   }
 
@@ -168,8 +226,7 @@ static int gt_fasta_reader_fsm_run(GtFastaReader *fasta_reader,
           had_err = -1;
         }
         else {
-          if (proc_sequence_part) {
-            gt_assert(gt_str_length(sequence));
+          if (proc_sequence_part && gt_str_length(sequence)) {
             had_err = proc_sequence_part(gt_str_get(sequence),
                                          gt_str_length(sequence), data, err);
           }
@@ -210,7 +267,17 @@ GtFastaReader* gt_fasta_reader_fsm_new(GtStr *sequence_filename)
     gt_fasta_reader_fsm->sequence_file =
       gt_file_xopen(gt_str_get(sequence_filename), "r");
   }
-  else
+  else {
     gt_fasta_reader_fsm->sequence_filename = gt_str_new_cstr("stdin");
+    gt_fasta_reader_fsm->sequence_file = gt_file_xopen(NULL, "r");
+    gt_fasta_reader_fsm->is_stdin = true;
+  }
   return fr;
 }
+
+void gt_fasta_reader_fsm_use_mmap(GtFastaReader *fr)
+{
+  GtFastaReaderFSM *gt_fasta_reader_fsm = gt_fasta_reader_fsm_cast(fr);
+  if (!gt_fasta_reader_fsm->is_stdin)
+    (void) gt_file_use_mmap(gt_fasta_reader_fsm->sequence_file);
+}
@@ -21,11 +21,13 @@
 #include "core/fasta_reader.h"
 #include "core/str.h"
 
-/* implements the ``fasta reader'' interface with a finite state machine
-   (for educational purposes, the recursive descent parser is much faster) */
+/* implements the ``fasta reader'' interface with a finite state machine which
+   scans the input blockwise */
 typedef struct GtFastaReaderFSM GtFastaReaderFSM;
 
 const GtFastaReaderClass* gt_fasta_reader_fsm_class(void);
 GtFastaReader*            gt_fasta_reader_fsm_new(GtStr *sequence_filename);
+/* Read the (uncompressed) sequence file of <fr> via a memory map. */
+void                      gt_fasta_reader_fsm_use_mmap(GtFastaReader *fr);
 
 #endif
@@ -18,6 +18,7 @@
 #include <stdio.h>
 #include <string.h>
 #include "core/cstr_api.h"
+#include "core/dynalloc.h"
 #include "core/fa.h"
 #include "core/ma.h"
 #include "core/xansi_api.h"
@@ -31,13 +32,26 @@ struct GtFile {
     gzFile gzfile;
     BZFILE *bzfile;
   } fileptr;
+  GtFile *next; /* read after the buffer of a file created from a buffer */
   char *orig_path,
        *orig_mode,
-       unget_char;
+       unget_char,
+       *readblock,
+       *linebuf;
+  void *map;
+  size_t maplength,
+         readpos,
+         readlen,
+         linebufsize;
   bool is_stdin,
-       unget_used;
+       is_buffer,
+       unget_used,
+       mmap_requested, /* set by gt_file_use_mmap() */
+       use_mmap;       /* map the rest of the file at the next block read */
 };
 
+#define GT_FILE_READBLOCKSIZE ((size_t) 1 << 16)
+
 GtFileMode gt_file_mode_determine(const char *path)
 {
   size_t path_length;
@@ -106,6 +120,7 @@ GtFile* gt_file_open(GtFileMode file_mode, const char *path, const char *mode,
           gt_file_delete_without_handle(file);
           return NULL;
         }
+        file->orig_path = gt_cstr_dup(path);
         break;
       case GT_FILE_MODE_GZIP:
         file->fileptr.gzfile = gt_fa_gzopen(path, mode, err);
@@ -145,6 +160,7 @@ GtFile* gt_file_xopen_file_mode(GtFileMode file_mode, const char *path,
     switch (file_mode) {
       case GT_FILE_MODE_UNCOMPRESSED:
         file->fileptr.file = gt_fa_xfopen(path, mode);
+        file->orig_path = gt_cstr_dup(path);
         break;
       case GT_FILE_MODE_GZIP:
         file->fileptr.gzfile = gt_fa_xgzopen(path, mode);
@@ -181,6 +197,22 @@ GtFile* gt_file_new_from_fileptr(FILE *fp)
   return file;
 }
 
+GtFile* gt_file_new_from_buffer(char *buffer, size_t length, GtFile *next)
+{
+  GtFile *file;
+  gt_assert(buffer || !length);
+  file = gt_calloc(1, sizeof (GtFile));
+  file->mode = GT_FILE_MODE_UNCOMPRESSED;
+  file->is_buffer = true;
+  file->next = next;
+  /* the buffer is reused as read buffer once it has been consumed */
+  if (length < GT_FILE_READBLOCKSIZE)
+    buffer = gt_realloc(buffer, GT_FILE_READBLOCKSIZE);
+  file->readblock = buffer;
+  file->readlen = length;
+  return file;
+}
+
 GtFileMode gt_file_mode(const GtFile *file)
 {
   gt_assert(file);
@@ -195,6 +227,10 @@ int gt_file_xfgetc(GtFile *file)
       c = file->unget_char;
       file->unget_used = false;
     }
+    else if (file->readpos < file->readlen)
+      c = (unsigned char) file->readblock[file->readpos++];
+    else if (file->is_buffer)
+      c = file->next ? gt_file_xfgetc(file->next) : EOF;
     else {
       switch (file->mode) {
         case GT_FILE_MODE_UNCOMPRESSED:
@@ -350,10 +386,12 @@ void gt_file_xfputs(const char *cstr, GtFile *file)
   }
 }
 
-int gt_file_xread(GtFile *file, void *buf, size_t nbytes)
+static int gt_file_xread_unbuffered(GtFile *file, void *buf, size_t nbytes)
 {
   int rval = -1;
-  if (file) {
+  if (file && file->is_buffer)
+    rval = file->next ? gt_file_xread(file->next, buf, nbytes) : 0;
+  else if (file) {
     switch (file->mode) {
       case GT_FILE_MODE_UNCOMPRESSED:
         rval = gt_xfread(buf, 1, nbytes, file->fileptr.file);
@@ -372,6 +410,162 @@ int gt_file_xread(GtFile *file, void *buf, size_t nbytes)
   return rval;
 }
 
+int gt_file_xread(GtFile *file, void *buf, size_t nbytes)
+{
+  char *cbuf = buf;
+  size_t buffered = 0;
+  /* deliver characters left over from gt_file_unget_char() and
+     gt_file_xread_line() first */
+  if (file && nbytes > 0 && file->unget_used) {
+    cbuf[buffered++] = file->unget_char;
+    file->unget_used = false;
+  }
+  if (file && file->readpos < file->readlen && buffered < nbytes) {
+    size_t len = file->readlen - file->readpos;
+    if (len > nbytes - buffered)
+      len = nbytes - buffered;
+    memcpy(cbuf + buffered, file->readblock + file->readpos, len);
+    file->readpos += len;
+    buffered += len;
+  }
+  if (buffered == nbytes)
+    return (int) buffered;
+  return (int) buffered + gt_file_xread_unbuffered(file, cbuf + buffered,
+                                                   nbytes - buffered);
+}
+
+static size_t gt_file_xread_mapped_block(GtFile *file, const char **block)
+{
+  GtWord offset;
+  gt_assert(file->mode == GT_FILE_MODE_UNCOMPRESSED && !file->map);
+  file->use_mmap = false; /* map the remaining file only once */
+  offset = ftell(file->fileptr.file);
+  if (offset < 0 ||
+      !(file->map = gt_fa_mmap_read(file->orig_path, &file->maplength, NULL)))
+    return 0;
+  if (file->maplength <= (size_t) offset) {
+    gt_fa_xmunmap(file->map);
+    file->map = NULL;
+    return 0;
+  }
+  /* keep the file position in sync with the consumed part of the map */
+  gt_xfseek(file->fileptr.file, (GtWord) file->maplength, SEEK_SET);
+  *block = (const char*) file->map + offset;
+  return file->maplength - (size_t) offset;
+}
+
+size_t gt_file_xread_block(GtFile *file, const char **block)
+{
+  size_t len;
+  gt_assert(file && block);
+  if (file->unget_used) {
+    file->unget_used = false;
+    *block = &file->unget_char;
+    return 1;
+  }
+  if (file->map) {
+    /* the previous block was the mapped rest of the file */
+    gt_fa_xmunmap(file->map);
+    file->map = NULL;
+  }
+  if (file->readpos < file->readlen) {
+    /* the rest of a block partially consumed by gt_file_xread_line() */
+    *block = file->readblock + file->readpos;
+    len = file->readlen - file->readpos;
+    file->readpos = file->readlen;
+    return len;
+  }
+  if (file->use_mmap && (len = gt_file_xread_mapped_block(file, block)) > 0)
+    return len;
+  if (!file->readblock)
+    file->readblock = gt_malloc(GT_FILE_READBLOCKSIZE);
+  *block = file->readblock;
+  return (size_t) gt_file_xread_unbuffered(file, file->readblock,
+                                           GT_FILE_READBLOCKSIZE);
+}
+
+/* Append <len> characters of <cstr> to the line buffer of <file>, which
+   already contains <linelen> characters. */
+static void gt_file_append_to_linebuf(GtFile *file, size_t linelen,
+                                      const char *cstr, size_t len)
+{
+  if (linelen + len + 1 > file->linebufsize) {
+    file->linebuf = gt_dynalloc(file->linebuf, &file->linebufsize,
+                                linelen + len + 1);
+  }
+  memcpy(file->linebuf + linelen, cstr, len);
+}
+
+int gt_file_xread_line(GtFile *file, char **line, GtUword *length)
+{
+  size_t linelen = 0;
+  gt_assert(file && line && length);
+  if (file->unget_used) {
+    file->unget_used = false;
+    gt_file_append_to_linebuf(file, linelen, &file->unget_char, 1);
+    linelen++;
+    if (file->unget_char == '\n') {
+      file->linebuf[0] = '\0';
+      *line = file->linebuf;
+      *length = 0;
+      return 0;
+    }
+  }
+  for (;;) {
+    char *start, *newline;
+    size_t available, len;
+    if (file->readpos == file->readlen) {
+      int rval;
+      if (!file->readblock)
+        file->readblock = gt_malloc(GT_FILE_READBLOCKSIZE);
+      rval = gt_file_xread_unbuffered(file, file->readblock,
+                                      GT_FILE_READBLOCKSIZE);
+      file->readpos = file->readlen = 0;
+      if (rval <= 0)
+        return EOF; /* an unterminated last line is discarded */
+      file->readlen = (size_t) rval;
+    }
+    start = file->readblock + file->readpos;
+    available = file->readlen - file->readpos;
+    newline = memchr(start, '\n', available);
+    if (newline == NULL) {
+      /* the line continues in the next block, save the part read so far */
+      gt_file_append_to_linebuf(file, linelen, start, available);
+      linelen += available;
+      file->readpos = file->readlen;
+      continue;
+    }
+    len = (size_t) (newline - start);
+    file->readpos += len + 1;
+    if (linelen == 0) {
+      /* the complete line is contained in the block: no copy necessary */
+      *line = start;
+    }
+    else {
+      gt_file_append_to_linebuf(file, linelen, start, len);
+      len += linelen;
+      *line = file->linebuf;
+    }
+    /* remove the carriage return of a Windows newline */
+    if (len > 0 && (*line)[len-1] == '\r')
+      len--;
+    (*line)[len] = '\0';
+    *length = (GtUword) len;
+    return 0;
+  }
+}
+
+bool gt_file_use_mmap(GtFile *file)
+{
+  gt_assert(file);
+  if (file->mode != GT_FILE_MODE_UNCOMPRESSED || file->is_stdin ||
+      !file->orig_path) {
+    return false;
+  }
+  file->mmap_requested = file->use_mmap = true;
+  return true;
+}
+
 void gt_file_xwrite(GtFile *file, void *buf, size_t nbytes)
 {
   if (!file) {
@@ -394,7 +588,16 @@ void gt_file_xwrite(GtFile *file, void *buf, size_t nbytes)
 
 void gt_file_xrewind(GtFile *file)
 {
-  gt_assert(file);
+  gt_assert(file && !file->is_buffer);
+  file->unget_used = false;
+  file->readpos = file->readlen = 0;
+  if (file->map) {
+    gt_fa_xmunmap(file->map);
+    file->map = NULL;
+  }
+  /* the map is released after the mapped block has been consumed, so the
+     request has to be restored independently of it */
+  file->use_mmap = file->mmap_requested;
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
       rewind(file->fileptr.file);
@@ -412,6 +615,10 @@ void gt_file_xrewind(GtFile *file)
 void gt_file_delete_without_handle(GtFile *file)
 {
   if (!file) return;
+  if (file->map)
+    gt_fa_xmunmap(file->map);
+  gt_free(file->readblock);
+  gt_free(file->linebuf);
   gt_free(file->orig_path);
   gt_free(file->orig_mode);
   gt_free(file);
@@ -420,6 +627,11 @@ void gt_file_delete_without_handle(GtFile *file)
 void gt_file_delete(GtFile *file)
 {
   if (!file) return;
+  if (file->is_buffer) {
+    gt_file_delete(file->next);
+    gt_file_delete_without_handle(file);
+    return;
+  }
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
         if (!file->is_stdin)
@@ -18,8 +18,10 @@
 #ifndef FILE_H
 #define FILE_H
 
+#include <stdbool.h>
 #include <stdlib.h>
 #include "core/file_api.h"
+#include "core/types_api.h"
 
 typedef enum {
   GT_FILE_MODE_UNCOMPRESSED,
@@ -56,6 +58,13 @@ GtFile*     gt_file_xopen_file_mode(GtFileMode file_mode, const char *path,
    automatically via gt_file_mode_determine(path). */
 GtFile*     gt_file_xopen(const char *path, const char *mode);
 
+/* Create a new GtFile object which reads the first <length> characters of
+   <buffer> and, afterwards, the remaining content of <next> (if not NULL).
+   Takes ownership of <buffer> (which must have been allocated with
+   gt_malloc()) and of <next>. Such a file can only be read from. */
+GtFile*     gt_file_new_from_buffer(char *buffer, size_t length,
+                                    GtFile *next);
+
 /* Returns the mode of the given <file>. */
 GtFileMode  gt_file_mode(const GtFile *file);
 
@@ -63,4 +72,27 @@ GtFileMode  gt_file_mode(const GtFile *file);
    Can only be used once at a time. */
 void        gt_file_unget_char(GtFile *file, char c);
 
+/* Make the next block of input from <file> available in <*block> and return
+   its length (0 at end-of-file). The block stays valid until the next read
+   operation on <file>. It is read into an internal buffer of <file> or, if
+   gt_file_use_mmap() has been called, it is the memory mapped remainder of
+   the file. */
+size_t      gt_file_xread_block(GtFile *file, const char **block);
+
+/* Let gt_file_xread_block() map the remainder of <file> into memory instead
+   of reading it blockwise. Returns <false> if <file> is not an uncompressed
+   file with a path (e.g., <stdin>), in which case buffered reading is used.
+   If mapping fails later, gt_file_xread_block() also falls back to buffered
+   reading. */
+bool        gt_file_use_mmap(GtFile *file);
+
+/* Read the next line from <file>. <*line> is set to the '\0'-terminated line
+   without its newline ("\n" or "\r\n") and <*length> to its length. The line
+   points into the read buffer of <file> and is only copied if it spans two
+   blocks of the buffer. It can be modified in place and stays valid until the
+   next read operation on <file>. Returns 0 if a line was read and <EOF>
+   otherwise (like gt_str_read_next_line_generic() a last line which is not
+   terminated by a newline is not returned). */
+int         gt_file_xread_line(GtFile *file, char **line, GtUword *length);
+
 #endif
@@ -44,6 +44,10 @@
  *                            hashtable setup to store elements of type
  *                            keytag_valuetag_map_entry, start_size is
  *                            initially determined
+ * keytag_valuetag_gt_hashmap_new_concurrent: function constructing a
+ *                            hashtable for concurrent insertions and
+ *                            lookups (see gt_hashtable_new_concurrent),
+ *                            start_size is initially determined
  * keytag_valuetag_gt_hashmap_delete: destructor function corresponding
  *                            to above new
  * keytag_valuetag_gt_hashmap_get: return pointer to value of hashmap
@@ -55,6 +59,11 @@
  *                            hashmap, if no element with key is present
  *                            yet, or update the value of an element
  *                            which compares equal wrt key
+ * keytag_valuetag_gt_hashmap_insert: insert given key and value into the
+ *                            hashmap, if no element with key is present
+ *                            yet, returns 1 in this case and 0
+ *                            otherwise (safe to be called concurrently
+ *                            for hashmaps constructed by _new_concurrent)
  * keytag_valuetag_gt_hashmap_foreach: loops over all entries in hashmap
  *                            and calls visitor function passed by
  *                            function pointer
@@ -98,6 +107,14 @@
                                             size_log);        \
   }                                                           \
                                                               \
+  /*@unused@*/ static inline                                  \
+  GtHashtable * keytag##_##valuetag##_gt_hashmap_new_concurrent(\
+                                                unsigned short size_log)  \
+  {                                                           \
+    return gt_hashtable_new_concurrent_with_start_size(       \
+                         keytag##_##valuetag##_hashtype, size_log);       \
+  }                                                           \
+                                                              \
   /*@unused@*/ static inline void                             \
   keytag##_##valuetag##_gt_hashmap_delete(GtHashtable *ht)    \
   {                                                           \
@@ -139,6 +156,16 @@
     }                                                         \
   }                                                           \
                                                               \
+  /*@unused@*/ static inline int                              \
+  keytag##_##valuetag##_gt_hashmap_insert(GtHashtable *ht,    \
+                                    const keytype key,        \
+                                    valuetype value)          \
+  {                                                           \
+    keytag##_##valuetag##_map_entry map_entry                 \
+      = { (keytype)key, value };                              \
+    return gt_hashtable_add(ht, &map_entry);                  \
+  }                                                           \
+                                                              \
   /*@unused@*/ static inline void*                            \
   keytag##_##valuetag##_gt_hashmap_add_and_return_storage(GtHashtable *ht,  \
                                     const keytype key,        \
@@ -22,9 +22,12 @@
 #endif
 #include <string.h>
 #include "core/array.h"
+#include "core/atomic.h"
 #include "core/cstr_api.h"
 #include "core/hashtable.h"
 #include "core/ma.h"
+#include "core/minmax.h"
+#include "core/multithread_api.h"
 #include "core/qsort_r.h"
 #include "core/thread_api.h"
 #include "core/types_api.h"
@@ -73,8 +76,36 @@ struct GtHashtable
   GtRWLock *lock;
   GtUword reference_count;
   bool no_ma;
+  /* concurrent mode: open addressing with linear probing in the last of
+     <num_of_generations> tables, see gt_ht_concurrent_add() */
+  bool concurrent;
+  struct GtHtConcurrentTable **generations;
+  GtUword num_of_generations;
 };
 
+/* table of the concurrent mode, <states> holds the state of each slot */
+typedef struct GtHtConcurrentTable
+{
+  void *table;
+  GtUword *states,
+          fill,          /* number of elements */
+          next_chunk,    /* first slot not yet claimed for moving */
+          moved,         /* number of slots moved to the next generation */
+          complete;      /* all elements of the previous generation moved */
+  htsize_t table_mask, high_fill;
+  unsigned short size_log;
+} GtHtConcurrentTable;
+
+enum {
+  CONCURRENT_EMPTY = 0,
+  CONCURRENT_BUSY,       /* claimed by an inserting thread, not yet written */
+  CONCURRENT_FULL,
+  CONCURRENT_MOVED       /* content moved to the next generation */
+};
+
+/* number of slots a thread moves to the next generation at once */
+#define CONCURRENT_CHUNK 1024UL
+
 static inline void *
 gt_ht_elem_ptr(const GtHashtable *ht, htsize_t idx)
 {
@@ -87,6 +118,12 @@ gt_ht_cp_elem(GtHashtable *ht, htsize_t dest_idx, const void *src)
   memcpy(gt_ht_elem_ptr(ht, dest_idx), src, ht->table_info.elem_size);
 }
 
+static inline htsize_t
+gt_ht_elem_hash_idx(const GtHashtable *ht, const void *elem)
+{
+  return ht->table_info.keyhash(elem) & ht->table_mask;
+}
+
 static void
 gt_ht_resize(GtHashtable *ht, unsigned short new_size_log);
 
@@ -133,6 +170,9 @@ gt_ht_init(GtHashtable *ht, HashElemInfo table_info, unsigned short size_log,
   ht->current_fill = 0;
   ht->reference_count = 0;
   ht->table = ht->links.table = NULL;
+  ht->concurrent = false;
+  ht->generations = NULL;
+  ht->num_of_generations = 0;
   gt_ht_reinit(ht, table_info, size_log, high_mul, low_mul);
 }
 
@@ -192,6 +232,282 @@ GtHashtable* gt_hashtable_new_with_start_size(HashElemInfo table_info,
   return ht;
 }
 
+/*
+ * concurrent mode
+ */
+static GtHtConcurrentTable*
+gt_ht_concurrent_table_new(const GtHashtable *ht, unsigned short size_log)
+{
+  GtHtConcurrentTable *t = gt_calloc((size_t) 1, sizeof (*t));
+  htsize_t table_size;
+  gt_assert(size_log < sizeof (htsize_t) * CHAR_BIT);
+  t->size_log = size_log;
+  t->table_mask = (table_size = 1 << size_log) - 1;
+  t->high_fill = (GtUint64)ht->high_fill_mul * table_size / FILL_DIVISOR;
+  t->table = gt_malloc(ht->table_info.elem_size * table_size);
+  t->states = gt_calloc((size_t) table_size, sizeof (*t->states));
+  return t;
+}
+
+static void
+gt_ht_concurrent_table_delete(GtHtConcurrentTable *t)
+{
+  gt_free(t->table);
+  gt_free(t->states);
+  gt_free(t);
+}
+
+static void
+gt_ht_concurrent_init(GtHashtable *ht, unsigned short size_log)
+{
+  ht->generations = gt_calloc(sizeof (htsize_t) * CHAR_BIT,
+                              sizeof (*ht->generations));
+  ht->generations[0] = gt_ht_concurrent_table_new(ht, size_log);
+  ht->generations[0]->complete = 1UL;
+  ht->num_of_generations = 1UL;
+}
+
+static void
+gt_ht_concurrent_destruct(GtHashtable *ht)
+{
+  GtUword g;
+  for (g = 0; g < ht->num_of_generations; g++)
+    gt_ht_concurrent_table_delete(ht->generations[g]);
+  gt_free(ht->generations);
+  ht->generations = NULL;
+  ht->num_of_generations = 0;
+}
+
+/* the last generation, which holds all elements if no thread inserts */
+static inline GtHtConcurrentTable*
+gt_ht_concurrent_last(const GtHashtable *ht)
+{
+  return ht->generations[ht->num_of_generations - 1];
+}
+
+static inline void *
+gt_ht_concurrent_elem_ptr(const GtHashtable *ht, const GtHtConcurrentTable *t,
+                          htsize_t idx)
+{
+  return (char *)t->table + ht->table_info.elem_size * idx;
+}
+
+GtHashtable* gt_hashtable_new_concurrent_with_start_size(HashElemInfo
+                                                         table_info,
+                                                         unsigned short
+                                                         size_log)
+{
+  GtHashtable *ht = gt_calloc((size_t) 1, sizeof (*ht));
+  ht->lock = gt_rwlock_new();
+  ht->no_ma = false;
+  ht->table_info = table_info;
+  ht->high_fill_mul = DEFAULT_HIGH_MUL;
+  ht->low_fill_mul = DEFAULT_LOW_MUL;
+  ht->concurrent = true;
+  gt_ht_concurrent_init(ht, size_log < MIN_SIZE_LOG ? MIN_SIZE_LOG : size_log);
+  return ht;
+}
+
+GtHashtable* gt_hashtable_new_concurrent(HashElemInfo table_info)
+{
+  return gt_hashtable_new_concurrent_with_start_size(table_info, MIN_SIZE_LOG);
+}
+
+/* Waits until a slot claimed by another thread has been written. */
+static inline GtUword
+gt_ht_concurrent_wait(GtHtConcurrentTable *t, htsize_t idx)
+{
+  GtUword state;
+  while ((state = gt_atomic_uword_load_ordered(t->states + idx))
+         == CONCURRENT_BUSY)
+    /* the element is being copied */ ;
+  return state;
+}
+
+/* Inserts <elem> into <t> without locking. A free slot is claimed by
+   switching it from empty to busy, the element is copied and the slot is
+   marked as full. A thread which finds a busy slot waits until it is full,
+   because it might hold an element equal to its own.
+   Returns 1 if <elem> was inserted, 0 if it was already present and -1 if
+   <t> is full or its elements are being moved to the next generation. */
+static int
+gt_ht_concurrent_insert(GtHashtable *ht, GtHtConcurrentTable *t,
+                        const void *elem, void **stor_ptr)
+{
+  htsize_t idx = ht->table_info.keyhash(elem) & t->table_mask, probes;
+  for (probes = 0; probes <= t->table_mask; probes++)
+  {
+    GtUword state = gt_atomic_uword_load_ordered(t->states + idx);
+    if (state == CONCURRENT_EMPTY)
+    {
+      if (gt_atomic_uword_cas(t->states + idx, CONCURRENT_EMPTY,
+                              CONCURRENT_BUSY))
+      {
+        memcpy(gt_ht_concurrent_elem_ptr(ht, t, idx), elem,
+               ht->table_info.elem_size);
+        gt_atomic_uword_store(t->states + idx, CONCURRENT_FULL);
+        (void) gt_atomic_uword_add_fetch(&t->fill, 1);
+        if (stor_ptr)
+          *stor_ptr = gt_ht_concurrent_elem_ptr(ht, t, idx);
+        return 1;
+      }
+      /* another thread claimed the slot first */
+    }
+    state = gt_ht_concurrent_wait(t, idx);
+    if (state == CONCURRENT_MOVED)
+      return -1;
+    if (state == CONCURRENT_FULL
+        && !ht->table_info.cmp(elem, gt_ht_concurrent_elem_ptr(ht, t, idx)))
+    {
+      if (stor_ptr)
+        *stor_ptr = gt_ht_concurrent_elem_ptr(ht, t, idx);
+      return 0;
+    }
+    idx = (idx + 1) & t->table_mask;
+  }
+  return -1;
+}
+
+/* Sets <*moved> if the elements of <t> are being moved to the next
+   generation, in this case the result is undefined. */
+static void*
+gt_ht_concurrent_get(GtHashtable *ht, GtHtConcurrentTable *t, const void *elem,
+                     bool *moved)
+{
+  htsize_t idx = ht->table_info.keyhash(elem) & t->table_mask, probes;
+  *moved = false;
+  for (probes = 0; probes <= t->table_mask; probes++)
+  {
+    GtUword state = gt_ht_concurrent_wait(t, idx);
+    if (state == CONCURRENT_EMPTY)
+      return NULL;
+    if (state == CONCURRENT_MOVED)
+    {
+      *moved = true;
+      return NULL;
+    }
+    if (!ht->table_info.cmp(elem, gt_ht_concurrent_elem_ptr(ht, t, idx)))
+      return gt_ht_concurrent_elem_ptr(ht, t, idx);
+    idx = (idx + 1) & t->table_mask;
+  }
+  return NULL;
+}
+
+/* Moves the elements of generation <g> to generation <g>+1. Every thread
+   which arrives here claims chunks of slots until all slots are claimed, and
+   then waits for the other threads to finish their chunks. A slot is frozen
+   by switching it from empty or full to moved, so that no thread inserts into
+   it afterwards. */
+static void
+gt_ht_concurrent_migrate(GtHashtable *ht, GtUword g)
+{
+  GtHtConcurrentTable *from = ht->generations[g],
+                      *to = ht->generations[g + 1];
+  GtUword start, end, i, size = (GtUword) from->table_mask + 1;
+  if (gt_atomic_uword_load_ordered(&to->complete))
+    return;
+  while ((start = gt_atomic_uword_add_fetch(&from->next_chunk,
+                                            CONCURRENT_CHUNK)
+                  - CONCURRENT_CHUNK) < size)
+  {
+    end = MIN(start + CONCURRENT_CHUNK, size);
+    for (i = start; i < end; i++)
+    {
+      if (gt_atomic_uword_cas(from->states + i, CONCURRENT_EMPTY,
+                              CONCURRENT_MOVED))
+        continue;
+      if (gt_ht_concurrent_wait(from, (htsize_t) i) == CONCURRENT_FULL)
+      {
+#ifndef NDEBUG
+        int ins_count =
+#endif
+          gt_ht_concurrent_insert(ht, to,
+                                  gt_ht_concurrent_elem_ptr(ht, from,
+                                                            (htsize_t) i),
+                                  NULL);
+        gt_assert(ins_count == 1);
+        gt_atomic_uword_store(from->states + i, CONCURRENT_MOVED);
+      }
+    }
+    (void) gt_atomic_uword_add_fetch(&from->moved, end - start);
+  }
+  while (gt_atomic_uword_load_ordered(&from->moved) < size)
+    /* another thread moves a chunk */ ;
+  gt_atomic_uword_store(&to->complete, 1UL);
+}
+
+/* Returns the last complete generation and stores its number in <*g>. */
+static GtHtConcurrentTable*
+gt_ht_concurrent_current(GtHashtable *ht, GtUword *g)
+{
+  GtUword last = gt_atomic_uword_load_ordered(&ht->num_of_generations) - 1;
+  GtHtConcurrentTable *t = ht->generations[last];
+  if (!gt_atomic_uword_load_ordered(&t->complete))
+    gt_ht_concurrent_migrate(ht, last - 1);
+  *g = last;
+  return t;
+}
+
+/* Makes sure that generation <g>+1 exists and moves the elements of
+   generation <g> to it. Only creating the new table takes the table lock. */
+static void
+gt_ht_concurrent_grow(GtHashtable *ht, GtUword g)
+{
+  if (gt_atomic_uword_load_ordered(&ht->num_of_generations) == g + 1)
+  {
+    gt_rwlock_wrlock(ht->lock);
+    if (ht->num_of_generations == g + 1)
+    {
+      ht->generations[g + 1]
+        = gt_ht_concurrent_table_new(ht, ht->generations[g]->size_log + 1);
+      gt_atomic_uword_store(&ht->num_of_generations, g + 2);
+    }
+    gt_rwlock_unlock(ht->lock);
+  }
+  gt_ht_concurrent_migrate(ht, g);
+}
+
+/* Inserts into the current generation without taking a lock, so that any
+   number of threads can insert and look up elements at the same time. If the
+   table gets too full, the inserting thread creates a table of twice the size
+   as the next generation, unless another thread did so already. All threads
+   which then access the table help to move its elements to the next
+   generation, and retry their operation there when all elements are moved.
+   The tables of earlier generations are kept until the hashtable is reset or
+   deleted, because other threads may still read them. */
+static int
+gt_ht_concurrent_add(GtHashtable *ht, const void *elem, void **stor_ptr)
+{
+  GtHtConcurrentTable *t;
+  GtUword g;
+  int insert_count;
+  while (1)
+  {
+    t = gt_ht_concurrent_current(ht, &g);
+    if (gt_atomic_uword_load(&t->fill) < t->high_fill
+        && (insert_count = gt_ht_concurrent_insert(ht, t, elem, stor_ptr)) >= 0)
+      return insert_count;
+    gt_ht_concurrent_grow(ht, g);
+  }
+}
+
+static void*
+gt_ht_concurrent_lookup(GtHashtable *ht, const void *elem)
+{
+  GtHtConcurrentTable *t;
+  GtUword g;
+  void *stored;
+  bool moved;
+  while (1)
+  {
+    t = gt_ht_concurrent_current(ht, &g);
+    stored = gt_ht_concurrent_get(ht, t, elem, &moved);
+    if (!moved)
+      return stored;
+    gt_ht_concurrent_grow(ht, g);
+  }
+}
+
 static int
 gt_ht_insert(GtHashtable *ht, const void *elem, void **stor_ptr);
 
@@ -239,12 +555,6 @@ gt_ht_resize(GtHashtable *ht, unsigned short new_size_log)
   }
 }
 
-static inline htsize_t
-gt_ht_elem_hash_idx(const GtHashtable *ht, const void *elem)
-{
-  return ht->table_info.keyhash(elem) & ht->table_mask;
-}
-
 #define gt_ht_traverse_list_of_key(ht, elem, pre_loop, in_loop, post_loop) \
   do {                                                                     \
     GtHashtable *htref = (ht);                                             \
@@ -283,6 +593,8 @@ gt_ht_traverse_list_of_key_debug(GtHashtable *ht, const void *elem)
 void* gt_hashtable_get(GtHashtable *ht, const void *elem)
 {
   gt_assert(ht);
+  if (ht->concurrent)
+    return gt_ht_concurrent_lookup(ht, elem);
   gt_rwlock_wrlock(ht->lock);
 #if TJ_DEBUG > 1
   gt_ht_traverse_list_of_key_debug(ht, elem);
@@ -301,6 +613,8 @@ int gt_hashtable_add(GtHashtable *ht, const void *elem)
 {
   int insert_count;
   gt_assert(ht && elem);
+  if (ht->concurrent)
+    return gt_ht_concurrent_add(ht, elem, NULL);
   gt_rwlock_wrlock(ht->lock);
   if (ht->current_fill + 1 > ht->high_fill)
     gt_ht_resize(ht, ht->table_size_log + 1);
@@ -314,6 +628,8 @@ int gt_hashtable_add_with_storage_ptr(GtHashtable *ht, const void *elem,
 {
   int insert_count;
   gt_assert(ht && elem);
+  if (ht->concurrent)
+    return gt_ht_concurrent_add(ht, elem, stor_ptr);
   gt_rwlock_wrlock(ht->lock);
   if (ht->current_fill + 1 > ht->high_fill)
     gt_ht_resize(ht, ht->table_size_log + 1);
@@ -400,6 +716,8 @@ int gt_hashtable_remove(GtHashtable *ht, const void *elem)
   htsize_t remove_pos;
   int rval = 0;
   gt_assert(ht && elem);
+  /* removal would break the probe sequences of the concurrent mode */
+  gt_assert(!ht->concurrent);
   gt_rwlock_wrlock(ht->lock);
   remove_pos = gt_ht_remove(ht, elem);
   if (remove_pos != free_mark)
@@ -490,11 +808,47 @@ int gt_hashtable_foreach_in_default_order(GtHashtable *ht, Elemvisitfunc iter,
   return gt_hashtable_foreach_ordered(ht, iter, data, ht->table_info.cmp, err);
 }
 
+/* in concurrent mode only CONTINUE_ITERATION and STOP_ITERATION are
+   supported */
+static int gt_ht_concurrent_foreach(GtHashtable *ht, Elemvisitfunc visitor,
+                                    void *data, GtError *err, bool lock)
+{
+  GtHtConcurrentTable *t;
+  htsize_t i;
+  int had_err = 0;
+  if (lock) {
+    gt_rwlock_wrlock(ht->lock);
+  }
+  t = gt_ht_concurrent_last(ht);
+  for (i = 0; !had_err && i <= t->table_mask; ++i)
+  {
+    if (t->states[i] == CONCURRENT_FULL)
+    {
+      switch (visitor(gt_ht_concurrent_elem_ptr(ht, t, i), data, err))
+      {
+      case CONTINUE_ITERATION:
+        break;
+      case STOP_ITERATION:
+        had_err = -1;
+        break;
+      default:
+        gt_assert(0);
+      }
+    }
+  }
+  if (lock) {
+    gt_rwlock_unlock(ht->lock);
+  }
+  return had_err;
+}
+
 static int gt_hashtable_foreach_g(GtHashtable *ht, Elemvisitfunc visitor,
                                   void *data, GtError *err, bool lock)
 {
   htsize_t i, table_size = ht->table_mask + 1, deletion_count = 0;
   jmp_buf env;
+  if (ht->concurrent)
+    return gt_ht_concurrent_foreach(ht, visitor, data, err, lock);
   if (lock) {
     gt_rwlock_wrlock(ht->lock);
   }
@@ -603,7 +957,10 @@ size_t gt_hashtable_fill(GtHashtable *ht)
 {
   size_t rval;
   gt_assert(ht);
-  rval = ht->current_fill;
+  if (ht->concurrent)
+    rval = gt_atomic_uword_load(&gt_ht_concurrent_last(ht)->fill);
+  else
+    rval = ht->current_fill;
   return rval;
 }
 
@@ -624,12 +981,35 @@ size_t gt_hashtable_fill(GtHashtable *ht)
       }                                                         \
   } while (0)
 
+/* frees the elements of the last generation, the earlier generations only
+   hold moved copies */
+static void gt_ht_concurrent_free_elems(GtHashtable *ht,
+                                        FreeFuncWData free_elem_with_data)
+{
+  GtHtConcurrentTable *t = gt_ht_concurrent_last(ht);
+  htsize_t i;
+  for (i = 0; i <= t->table_mask; ++i)
+  {
+    if (t->states[i] == CONCURRENT_FULL)
+      free_elem_with_data(gt_ht_concurrent_elem_ptr(ht, t, i),
+                          ht->table_info.table_data);
+  }
+}
+
 void gt_hashtable_reset(GtHashtable *ht)
 {
   gt_assert(ht);
   FreeFuncWData free_elem_with_data;
   gt_rwlock_wrlock(ht->lock);
   free_elem_with_data = ht->table_info.free_op.free_elem_with_data;
+  if (ht->concurrent) {
+    if (free_elem_with_data)
+      gt_ht_concurrent_free_elems(ht, free_elem_with_data);
+    gt_ht_concurrent_destruct(ht);
+    gt_ht_concurrent_init(ht, MIN_SIZE_LOG);
+    gt_rwlock_unlock(ht->lock);
+    return;
+  }
   if (free_elem_with_data)
     gt_ht_internal_foreach(ht, free_elem_with_data(elem, table_data));
   ht->current_fill = 0;
@@ -660,7 +1040,11 @@ void gt_hashtable_delete(GtHashtable *ht)
   gt_rwlock_unlock(ht->lock);
   gt_rwlock_wrlock(ht->lock);
   free_elem_with_data = ht->table_info.free_op.free_elem_with_data;
-  if (free_elem_with_data)
+  if (ht->concurrent) {
+    if (free_elem_with_data)
+      gt_ht_concurrent_free_elems(ht, free_elem_with_data);
+    gt_ht_concurrent_destruct(ht);
+  } else if (free_elem_with_data)
     gt_ht_internal_foreach(ht, free_elem_with_data(elem, table_data));
   gt_ht_destruct(ht);
   if (ht->table_info.table_data_free)
@@ -911,6 +1295,82 @@ gt_hashtable_test(HashElemInfo table_info)
   return had_err;
 }
 
+#define CONCURRENT_TEST_KEYS 10000UL
+
+struct concurrent_test_data
+{
+  GtHashtable *ht;
+  GtUword next_thread,
+          inserted;
+};
+
+/* every thread inserts all keys, starting at a different offset */
+static void* gt_hashtable_concurrent_test_thread(void *data)
+{
+  struct concurrent_test_data *td = data;
+  GtUword i, key, offset, inserted = 0;
+  offset = gt_atomic_uword_add_fetch(&td->next_thread, 1) * 997;
+  for (i = 0; i < CONCURRENT_TEST_KEYS; i++) {
+    key = ((i + offset) % CONCURRENT_TEST_KEYS) * 7;
+    inserted += gt_hashtable_add(td->ht, &key);
+    /* keys inserted by this thread must be visible immediately */
+    if (!gt_hashtable_get(td->ht, &key))
+      return NULL;
+  }
+  (void) gt_atomic_uword_add_fetch(&td->inserted, inserted);
+  return NULL;
+}
+
+static enum iterator_op
+gt_hashtable_concurrent_test_sum(void *elem, void *data, GT_UNUSED GtError *err)
+{
+  *(GtUword *)data += *(GtUword *)elem;
+  return CONTINUE_ITERATION;
+}
+
+static int
+gt_hashtable_concurrent_test(GtError *err)
+{
+  static const HashElemInfo
+    hash_ul = { gt_ht_ul_elem_hash, { NULL }, sizeof (GtUword),
+                gt_ht_ul_elem_cmp, NULL, NULL };
+  struct concurrent_test_data td;
+  GtUword i, key, sum = 0;
+  int had_err;
+  td.ht = gt_hashtable_new_concurrent(hash_ul);
+  td.next_thread = td.inserted = 0;
+  had_err = gt_multithread(gt_hashtable_concurrent_test_thread, &td, err);
+  if (!had_err) {
+    do {
+      /* each key has been inserted exactly once */
+      my_ensure(had_err, td.inserted == CONCURRENT_TEST_KEYS);
+      my_ensure(had_err, gt_hashtable_fill(td.ht) == CONCURRENT_TEST_KEYS);
+      for (i = 0; !had_err && i < CONCURRENT_TEST_KEYS; i++) {
+        key = i * 7;
+        my_ensure(had_err, gt_hashtable_get(td.ht, &key) &&
+                           *(GtUword *)gt_hashtable_get(td.ht, &key) == key);
+        key = i * 7 + 1;
+        my_ensure(had_err, !gt_hashtable_get(td.ht, &key));
+      }
+      if (had_err)
+        break;
+      my_ensure(had_err, !gt_hashtable_foreach(td.ht,
+                                               gt_hashtable_concurrent_test_sum,
+                                               &sum, err));
+      my_ensure(had_err, sum == 7 * (CONCURRENT_TEST_KEYS - 1)
+                                  * CONCURRENT_TEST_KEYS / 2);
+      gt_hashtable_reset(td.ht);
+      my_ensure(had_err, gt_hashtable_fill(td.ht) == 0);
+      key = 7;
+      my_ensure(had_err, !gt_hashtable_get(td.ht, &key));
+    } while (0);
+    if (had_err && !gt_error_is_set(err))
+      gt_error_set(err, "concurrent hashtable test failed");
+  }
+  gt_hashtable_delete(td.ht);
+  return had_err;
+}
+
 int gt_hashtable_unit_test(GT_UNUSED GtError *err)
 {
   int had_err;
@@ -929,5 +1389,9 @@ int gt_hashtable_unit_test(GT_UNUSED GtError *err)
   if (!had_err)
     had_err = gt_hashtable_test(hash_ptr);
 
+  /* concurrent insertions and lookups */
+  if (!had_err)
+    had_err = gt_hashtable_concurrent_test(err);
+
   return had_err;
 }
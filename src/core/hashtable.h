@@ -69,6 +69,32 @@ GtHashtable* gt_hashtable_new_no_ma(HashElemInfo table_info);
 GtHashtable* gt_hashtable_ref(GtHashtable*);
 GtHashtable* gt_hashtable_new_with_start_size(HashElemInfo htype,
                                               unsigned short size_log);
+/**
+ * @brief create a hashtable which allows concurrent insertions and
+ * lookups from multiple threads
+ *
+ * The elements are stored by open addressing, each slot is claimed
+ * with an atomic compare-and-swap, gt_hashtable_add() and
+ * gt_hashtable_get() take no lock. To grow, a table of twice the
+ * size is created (under the table lock) and all threads which
+ * access the hashtable move chunks of elements into it before they
+ * continue, so they wait for each other while the table grows.
+ * The outgrown tables are only freed by gt_hashtable_reset() and
+ * gt_hashtable_delete(), i.e., up to twice the memory of the
+ * current table is used. Elements are copied with memcpy() and
+ * compared with the cmp function of <table_info>, they must not be
+ * modified after insertion. gt_hashtable_remove() is not supported,
+ * gt_hashtable_foreach*() visitors may only return
+ * CONTINUE_ITERATION or STOP_ITERATION and must not run
+ * concurrently to insertions. Pointers to stored elements (as
+ * returned by gt_hashtable_get()) stay valid until the hashtable is
+ * reset or deleted.
+ */
+GtHashtable* gt_hashtable_new_concurrent(HashElemInfo table_info);
+GtHashtable* gt_hashtable_new_concurrent_with_start_size(HashElemInfo
+                                                         table_info,
+                                                         unsigned short
+                                                         size_log);
 void*        gt_hashtable_get(GtHashtable*, const void *elem);
 /**
  * @return 1 if add succeeded, 0 if elem is already in table.
@@ -31,6 +31,7 @@
 #include "core/init_api.h"
 #include "core/log.h"
 #include "core/ma.h"
+#include "core/object_lock.h"
 #include "core/option_api.h"
 #include "core/showtime.h"
 #include "core/spacepeak.h"
@@ -101,6 +102,9 @@ void gt_lib_init(void)
 {
   const char *bookkeeping;
   bookkeeping = getenv("GT_MEM_BOOKKEEPING");
+  /* the object locks are used by the atomic operations of the allocator on
+     platforms without atomic builtins */
+  gt_object_lock_init();
   gt_ma_init(bookkeeping && !strcmp(bookkeeping, "on"));
   proc_env_options();
   if (spacepeak && !(bookkeeping && !strcmp(bookkeeping, "on")))
@@ -153,6 +157,7 @@ int gt_lib_clean(void)
   gt_combinatorics_clean();
   gt_rval = gt_ma_check_space_leak();
   gt_ma_clean();
+  gt_object_lock_clean();
 #ifdef HAVE_MYSQL
   mysql_library_end();
 #endif
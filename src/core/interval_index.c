@@ -0,0 +1,255 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "core/assert_api.h"
+#include "core/ensure.h"
+#include "core/intbits.h"
+#include "core/interval_index.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/range.h"
+
+/* subtrees up to this height are scanned linearly during a query */
+#define GT_INTERVAL_INDEX_SCAN_HEIGHT  3U
+
+typedef struct {
+  GtUword start,
+          end,
+          max; /* maximal end position in the subtree rooted here */
+  void *data;
+} GtIntervalIndexEntry;
+
+typedef struct {
+  GtUword pos;
+  unsigned int height;
+  bool left_done;
+} GtIntervalIndexStackElem;
+
+struct GtIntervalIndex {
+  GtIntervalIndexEntry *entries;
+  GtUword nofentries,
+          allocated;
+  unsigned int root_height;
+  bool prepared;
+};
+
+GtIntervalIndex* gt_interval_index_new(void)
+{
+  GtIntervalIndex *interval_index = gt_calloc(1, sizeof *interval_index);
+  return interval_index;
+}
+
+void gt_interval_index_add(GtIntervalIndex *interval_index, void *data,
+                           GtUword start, GtUword end)
+{
+  GtIntervalIndexEntry *entry;
+  gt_assert(interval_index && !interval_index->prepared && start <= end);
+  if (interval_index->nofentries == interval_index->allocated) {
+    interval_index->allocated = interval_index->allocated
+                                ? 2 * interval_index->allocated : 64UL;
+    interval_index->entries = gt_realloc(interval_index->entries,
+                                         sizeof (GtIntervalIndexEntry) *
+                                         interval_index->allocated);
+  }
+  entry = interval_index->entries + interval_index->nofentries++;
+  entry->start = start;
+  entry->end = end;
+  entry->max = end;
+  entry->data = data;
+}
+
+static int interval_index_entry_compare(const void *a, const void *b)
+{
+  const GtIntervalIndexEntry *ea = a, *eb = b;
+  if (ea->start != eb->start)
+    return ea->start < eb->start ? -1 : 1;
+  if (ea->end != eb->end)
+    return ea->end < eb->end ? -1 : 1;
+  return 0;
+}
+
+/* The sorted array is an implicit tree: the entries at the positions whose
+   <h> lowest bits are set (and bit <h> is not) form the level of height <h>,
+   the children of the node at position <pos> are at <pos> -/+ 2^(h-1). The
+   rightmost path may leave the array, so the maximal end position of the
+   last existing subtree is carried along in <last_max>. */
+void gt_interval_index_prepare(GtIntervalIndex *interval_index)
+{
+  GtIntervalIndexEntry *entries;
+  GtUword i, n, last_pos = 0, last_max = 0;
+  unsigned int h;
+
+  gt_assert(interval_index && !interval_index->prepared);
+  entries = interval_index->entries;
+  n = interval_index->nofentries;
+  interval_index->prepared = true;
+  if (n == 0)
+    return;
+  qsort(entries, (size_t) n, sizeof (GtIntervalIndexEntry),
+        interval_index_entry_compare);
+  for (i = 0; i < n; i += 2) {
+    entries[i].max = entries[i].end;
+    last_pos = i;
+    last_max = entries[i].max;
+  }
+  for (h = 1U; (1UL << h) <= n; h++) {
+    GtUword half = 1UL << (h - 1), step = half << 2;
+    for (i = (half << 1) - 1; i < n; i += step) {
+      GtUword max_left = entries[i - half].max,
+              max_right = i + half < n ? entries[i + half].max : last_max;
+      entries[i].max = entries[i].end;
+      if (max_left > entries[i].max)
+        entries[i].max = max_left;
+      if (max_right > entries[i].max)
+        entries[i].max = max_right;
+    }
+    last_pos = ((last_pos >> h) & 1UL) ? last_pos - half : last_pos + half;
+    if (last_pos < n && entries[last_pos].max > last_max)
+      last_max = entries[last_pos].max;
+  }
+  interval_index->root_height = h - 1;
+}
+
+GtUword gt_interval_index_size(const GtIntervalIndex *interval_index)
+{
+  gt_assert(interval_index);
+  return interval_index->nofentries;
+}
+
+void gt_interval_index_find_all_overlapping(const GtIntervalIndex
+                                            *interval_index,
+                                            GtUword start, GtUword end,
+                                            GtArray *results)
+{
+  GtIntervalIndexStackElem stack[2 * GT_INTWORDSIZE], elem;
+  const GtIntervalIndexEntry *entries;
+  GtUword i, n;
+  void *data;
+  unsigned int top = 0;
+
+  gt_assert(interval_index && interval_index->prepared && start <= end);
+  gt_assert(results);
+  entries = interval_index->entries;
+  n = interval_index->nofentries;
+  if (n == 0)
+    return;
+  /* top down traversal, which reports the overlapping entries from left to
+     right */
+  stack[top].pos = (1UL << interval_index->root_height) - 1;
+  stack[top].height = interval_index->root_height;
+  stack[top++].left_done = false;
+  while (top > 0) {
+    elem = stack[--top];
+    if (elem.height <= GT_INTERVAL_INDEX_SCAN_HEIGHT) {
+      /* small subtree, scan all of its entries */
+      GtUword first = (elem.pos >> elem.height) << elem.height,
+              last = first + (1UL << (elem.height + 1)) - 1;
+      if (last > n)
+        last = n;
+      for (i = first; i < last && entries[i].start <= end; i++) {
+        if (start <= entries[i].end) {
+          data = entries[i].data;
+          gt_array_add(results, data);
+        }
+      }
+    }
+    else if (!elem.left_done) {
+      GtUword left = elem.pos - (1UL << (elem.height - 1));
+      stack[top].pos = elem.pos;
+      stack[top].height = elem.height;
+      stack[top++].left_done = true;
+      /* the left child may lie behind the end of the array, its subtree is
+         then partially filled */
+      if (left >= n || entries[left].max >= start) {
+        stack[top].pos = left;
+        stack[top].height = elem.height - 1;
+        stack[top++].left_done = false;
+      }
+    }
+    else if (elem.pos < n && entries[elem.pos].start <= end) {
+      if (start <= entries[elem.pos].end) {
+        data = entries[elem.pos].data;
+        gt_array_add(results, data);
+      }
+      stack[top].pos = elem.pos + (1UL << (elem.height - 1));
+      stack[top].height = elem.height - 1;
+      stack[top++].left_done = false;
+    }
+  }
+}
+
+void gt_interval_index_delete(GtIntervalIndex *interval_index)
+{
+  if (!interval_index) return;
+  gt_free(interval_index->entries);
+  gt_free(interval_index);
+}
+
+int gt_interval_index_unit_test(GtError *err)
+{
+  GtIntervalIndex *interval_index;
+  GtRange *ranges, qrange, *res_rng, *prev_rng;
+  GtArray *res;
+  GtUword i, j, numofranges, numofhits;
+  int had_err = 0, run,
+      max_basepos = 90000, width = 700, query_width = 5000;
+
+  gt_error_check(err);
+  res = gt_array_new(sizeof (GtRange*));
+  /* different sizes, to cover (in)complete implicit trees */
+  for (run = 0; !had_err && run < 8; run++) {
+    numofranges = run < 4 ? (GtUword) run : gt_rand_max(3000UL);
+    ranges = gt_malloc(sizeof (GtRange) * (numofranges + 1));
+    interval_index = gt_interval_index_new();
+    for (i = 0; i < numofranges; i++) {
+      ranges[i].start = gt_rand_max(max_basepos);
+      ranges[i].end = ranges[i].start + gt_rand_max(width);
+      gt_interval_index_add(interval_index, ranges + i, ranges[i].start,
+                            ranges[i].end);
+    }
+    gt_interval_index_prepare(interval_index);
+    gt_ensure(gt_interval_index_size(interval_index) == numofranges);
+
+    for (i = 0; !had_err && i < 2000UL; i++) {
+      qrange.start = gt_rand_max(max_basepos);
+      qrange.end = qrange.start + gt_rand_max(query_width);
+      gt_array_reset(res);
+      gt_interval_index_find_all_overlapping(interval_index, qrange.start,
+                                             qrange.end, res);
+      /* compare with a linear search */
+      numofhits = 0;
+      for (j = 0; j < numofranges; j++) {
+        if (gt_range_overlap(ranges + j, &qrange))
+          numofhits++;
+      }
+      gt_ensure(gt_array_size(res) == numofhits);
+      prev_rng = NULL;
+      for (j = 0; !had_err && j < gt_array_size(res); j++) {
+        res_rng = *(GtRange**) gt_array_get(res, j);
+        gt_ensure(gt_range_overlap(res_rng, &qrange));
+        if (prev_rng)
+          gt_ensure(gt_range_compare(prev_rng, res_rng) <= 0);
+        prev_rng = res_rng;
+      }
+    }
+    gt_interval_index_delete(interval_index);
+    gt_free(ranges);
+  }
+  gt_array_delete(res);
+  return had_err;
+}
@@ -0,0 +1,62 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef INTERVAL_INDEX_H
+#define INTERVAL_INDEX_H
+
+#include "core/array_api.h"
+#include "core/error_api.h"
+#include "core/types_api.h"
+
+/* The <GtIntervalIndex> is a static alternative to the <GtIntervalTree> for
+   read-mostly data. All intervals are stored in a single array sorted by
+   start position, which is interpreted as an implicit binary search tree
+   whose nodes are augmented with the maximal end position of their subtree.
+   Once prepared, the index cannot be changed. */
+typedef struct GtIntervalIndex GtIntervalIndex;
+
+/* Creates a new, empty <GtIntervalIndex>. */
+GtIntervalIndex* gt_interval_index_new(void);
+
+/* Adds the interval from <start> to <end> with the associated <data> to
+   <interval_index>, which must not have been prepared yet. The <data> is not
+   owned by the index. */
+void             gt_interval_index_add(GtIntervalIndex *interval_index,
+                                       void *data, GtUword start, GtUword end);
+
+/* Sorts the intervals and computes the augmented end positions. Has to be
+   called once after all intervals have been added and before the first
+   query. */
+void             gt_interval_index_prepare(GtIntervalIndex *interval_index);
+
+/* Returns the number of intervals in <interval_index>. */
+GtUword          gt_interval_index_size(const GtIntervalIndex *interval_index);
+
+/* Adds the data pointers of all intervals in the prepared <interval_index>
+   which overlap the query range (from <start> to <end>) to <results>, ordered
+   by the start and end positions of the intervals. */
+void             gt_interval_index_find_all_overlapping(const GtIntervalIndex
+                                                        *interval_index,
+                                                        GtUword start,
+                                                        GtUword end,
+                                                        GtArray *results);
+
+/* Deletes <interval_index>. */
+void             gt_interval_index_delete(GtIntervalIndex *interval_index);
+
+int              gt_interval_index_unit_test(GtError *err);
+
+#endif
@@ -16,6 +16,7 @@
 */
 
 #include <string.h>
+#include "core/file.h"
 #include "core/io.h"
 #include "core/ma.h"
 
@@ -23,7 +24,12 @@ struct GtIO {
   GtFile *fp;
   GtStr *path;
   GtUword line_number;
-  bool line_start;
+  const char *block; /* current block of <fp>, see gt_file_xread_block() */
+  size_t blocklen,
+         blockpos;
+  char unget_char;
+  bool line_start,
+       unget_used;
 };
 
 GtIO* gt_io_new(const char *path, const char *mode)
@@ -32,7 +38,7 @@ GtIO* gt_io_new(const char *path, const char *mode)
   gt_assert(mode);
   /* XXX: only the read mode has been implemented */
   gt_assert(!strcmp(mode, "r"));
-  io = gt_malloc(sizeof *io);
+  io = gt_calloc(1, sizeof *io);
   io->fp = gt_file_xopen(path, mode);
   io->path = path ? gt_str_new_cstr(path) : gt_str_new_cstr("stdin");
   io->line_number = 1;
@@ -52,7 +58,20 @@ int gt_io_get_char(GtIO *io, char *c)
 {
   int cc;
   gt_assert(io && c);
-  cc = gt_file_xfgetc(io->fp);
+  if (io->unget_used) {
+    cc = io->unget_char;
+    io->unget_used = false;
+  }
+  else {
+    if (io->blockpos == io->blocklen) {
+      io->blocklen = gt_file_xread_block(io->fp, &io->block);
+      io->blockpos = 0;
+    }
+    if (io->blockpos < io->blocklen)
+      cc = (unsigned char) io->block[io->blockpos++];
+    else
+      cc = EOF;
+  }
   if (cc == '\n') {
     io->line_number++;
     io->line_start = true;
@@ -68,7 +87,9 @@ int gt_io_get_char(GtIO *io, char *c)
 void gt_io_unget_char(GtIO *io, char c)
 {
   gt_assert(io);
-  gt_file_unget_char(io->fp, c);
+  gt_assert(!io->unget_used); /* only one char can be unget at a time */
+  io->unget_char = c;
+  io->unget_used = true;
 }
 
 bool gt_io_line_start(const GtIO *io)
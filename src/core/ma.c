@@ -18,6 +18,7 @@
 #include <errno.h>
 #include <string.h>
 #include "core/array_api.h"
+#include "core/atomic.h"
 #include "core/compat.h"
 #include "core/hashmap.h"
 #include "core/ma.h"
@@ -28,18 +29,30 @@
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
 
-/* the memory allocator class */
+/* must be a power of two */
+#define GT_MA_NUMOFSHARDS 64U
+
+/* The allocated pointers are distributed over shards by their address, each
+   protected by a lock of its own. Thus threads allocating and freeing memory
+   in parallel rarely wait for each other. As memory is often freed by another
+   thread than the one which allocated it, the shards are not per thread. */
 typedef struct {
   GtHashmap *allocated_pointer;
+  GtMutex *lock;
+  GtUint64 mallocevents;
+} MAShard;
+
+/* the memory allocator class */
+typedef struct {
+  MAShard shards[GT_MA_NUMOFSHARDS];
   bool bookkeeping,
        global_space_peak;
-  GtUint64 mallocevents;
+  /* modified atomically, without holding any lock */
   GtUword current_size,
                 max_size;
 } MA;
 
 static MA *ma = NULL;
-static GtMutex *bookkeeping_lock = NULL;
 
 typedef struct {
   size_t size;
@@ -103,131 +116,137 @@ static void ma_info_free(MAInfo *mainfo)
 
 void gt_ma_init(bool bookkeeping)
 {
+  unsigned int i;
   gt_assert(!ma);
   ma = xcalloc(1, sizeof (MA), 0, __FILE__, __LINE__);
   gt_assert(!ma->bookkeeping);
-  ma->allocated_pointer = gt_hashmap_new_no_ma(GT_HASH_DIRECT, NULL,
-                                               (GtFree) ma_info_free);
+  for (i = 0; i < GT_MA_NUMOFSHARDS; i++) {
+    ma->shards[i].allocated_pointer =
+      gt_hashmap_new_no_ma(GT_HASH_DIRECT, NULL, (GtFree) ma_info_free);
+    ma->shards[i].lock = gt_mutex_new();
+  }
   /* MA is ready to use */
   ma->bookkeeping = bookkeeping;
-  bookkeeping_lock = gt_mutex_new();
   ma->global_space_peak = false;
 }
 
+static MAShard* get_shard(MA *ma, const void *ptr)
+{
+  GtUword addr = (GtUword) ptr;
+  gt_assert(ma);
+  /* the lowest bits are zero due to the alignment of allocated memory */
+  addr ^= addr >> 12;
+  return ma->shards + ((addr >> 4) & (GT_MA_NUMOFSHARDS - 1));
+}
+
 static void add_size(MA* ma, GtUword size)
 {
   gt_assert(ma);
-  ma->current_size += size;
+  gt_atomic_uword_max(&ma->max_size,
+                      gt_atomic_uword_add_fetch(&ma->current_size, size));
   if (ma->global_space_peak)
     gt_spacepeak_add(size);
-  if (ma->current_size > ma->max_size)
-    ma->max_size = ma->current_size;
 }
 
 static void subtract_size(MA *ma, GtUword size)
 {
   gt_assert(ma);
-  gt_assert(ma->current_size >= size);
-  ma->current_size -= size;
+  gt_atomic_uword_sub(&ma->current_size, size);
   if (ma->global_space_peak)
     gt_spacepeak_free(size);
 }
 
-void* gt_malloc_mem(size_t size, const char *src_file, int src_line)
+static void add_pointer(MA *ma, void *mem, size_t size, const char *src_file,
+                        int src_line)
+{
+  MAShard *shard = get_shard(ma, mem);
+  MAInfo *mainfo;
+  mainfo = xmalloc(sizeof *mainfo, gt_atomic_uword_load(&ma->current_size),
+                   src_file, src_line);
+  mainfo->size = size;
+  mainfo->src_file = src_file;
+  mainfo->src_line = src_line;
+  gt_mutex_lock(shard->lock);
+  shard->mallocevents++;
+  gt_hashmap_add(shard->allocated_pointer, mem, mainfo);
+  gt_mutex_unlock(shard->lock);
+  add_size(ma, size);
+}
+
+static void remove_pointer(MA *ma, void *ptr, GT_UNUSED const char *src_file,
+                             GT_UNUSED int src_line)
 {
+  MAShard *shard = get_shard(ma, ptr);
   MAInfo *mainfo;
+  size_t size;
+  gt_mutex_lock(shard->lock);
+  mainfo = gt_hashmap_get(shard->allocated_pointer, ptr);
+#ifndef NDEBUG
+  if (!mainfo) {
+    fprintf(stderr, "bug: double free() attempted on line %d in file "
+            "\"%s\"\n", src_line, src_file);
+    exit(GT_EXIT_PROGRAMMING_ERROR);
+  }
+#endif
+  gt_assert(mainfo);
+  size = mainfo->size;
+  gt_hashmap_remove(shard->allocated_pointer, ptr);
+  gt_mutex_unlock(shard->lock);
+  subtract_size(ma, size);
+}
+
+void* gt_malloc_mem(size_t size, const char *src_file, int src_line)
+{
   void *mem;
   gt_assert(ma);
   if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
-    ma->mallocevents++;
-    mainfo = xmalloc(sizeof *mainfo, ma->current_size, src_file, src_line);
-    mainfo->size = size;
-    mainfo->src_file = src_file;
-    mainfo->src_line = src_line;
-    mem = xmalloc(size, ma->current_size, src_file, src_line);
-    gt_hashmap_add(ma->allocated_pointer, mem, mainfo);
-    add_size(ma, size);
-    gt_mutex_unlock(bookkeeping_lock);
+    mem = xmalloc(size, gt_atomic_uword_load(&ma->current_size), src_file,
+                  src_line);
+    add_pointer(ma, mem, size, src_file, src_line);
     return mem;
   }
-  return xmalloc(size, ma->current_size, src_file, src_line);
+  return xmalloc(size, 0, src_file, src_line);
 }
 
 void* gt_calloc_mem(size_t nmemb, size_t size, const char *src_file,
                     int src_line)
 {
-  MAInfo *mainfo;
   void *mem;
   gt_assert(ma);
   if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
-    ma->mallocevents++;
-    mainfo = xmalloc(sizeof *mainfo, ma->current_size, src_file, src_line);
-    mainfo->size = nmemb * size;
-    mainfo->src_file = src_file;
-    mainfo->src_line = src_line;
-    mem = xcalloc(nmemb, size, ma->current_size, src_file, src_line);
-    gt_hashmap_add(ma->allocated_pointer, mem, mainfo);
-    add_size(ma, nmemb * size);
-    gt_mutex_unlock(bookkeeping_lock);
+    mem = xcalloc(nmemb, size, gt_atomic_uword_load(&ma->current_size),
+                  src_file, src_line);
+    add_pointer(ma, mem, nmemb * size, src_file, src_line);
     return mem;
   }
-  return xcalloc(nmemb, size, ma->current_size, src_file, src_line);
+  return xcalloc(nmemb, size, 0, src_file, src_line);
 }
 
 void* gt_realloc_mem(void *ptr, size_t size, const char *src_file, int src_line)
 {
-  MAInfo *mainfo;
   void *mem;
   gt_assert(ma);
   if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
-    ma->mallocevents++;
-    if (ptr) {
-      mainfo = gt_hashmap_get(ma->allocated_pointer, ptr);
-      gt_assert(mainfo);
-      subtract_size(ma, mainfo->size);
-      gt_hashmap_remove(ma->allocated_pointer, ptr);
-    }
-    mainfo = xmalloc(sizeof *mainfo, ma->current_size, src_file, src_line);
-    mainfo->size = size;
-    mainfo->src_file = src_file;
-    mainfo->src_line = src_line;
-    mem = xrealloc(ptr, size, ma->current_size, src_file, src_line);
-    gt_hashmap_add(ma->allocated_pointer, mem, mainfo);
-    add_size(ma, size);
-    gt_mutex_unlock(bookkeeping_lock);
+    /* <ptr> is removed before it is reallocated, as its address may be
+       returned by a parallel allocation as soon as it has been freed */
+    if (ptr)
+      remove_pointer(ma, ptr, src_file, src_line);
+    mem = xrealloc(ptr, size, gt_atomic_uword_load(&ma->current_size),
+                   src_file, src_line);
+    add_pointer(ma, mem, size, src_file, src_line);
     return mem;
   }
-  return xrealloc(ptr, size, ma->current_size, src_file, src_line);
+  return xrealloc(ptr, size, 0, src_file, src_line);
 }
 
 void gt_free_mem(void *ptr, GT_UNUSED const char *src_file,
                  GT_UNUSED int src_line)
 {
-  MAInfo *mainfo;
   gt_assert(ma);
   if (ptr == NULL) return;
-  if (ma->bookkeeping) {
-    gt_mutex_lock(bookkeeping_lock);
-#ifndef NDEBUG
-    if (!gt_hashmap_get(ma->allocated_pointer, ptr)) {
-      fprintf(stderr, "bug: double free() attempted on line %d in file "
-              "\"%s\"\n", src_line, src_file);
-      exit(GT_EXIT_PROGRAMMING_ERROR);
-    }
-#endif
-    mainfo = gt_hashmap_get(ma->allocated_pointer, ptr);
-    gt_assert(mainfo);
-    subtract_size(ma, mainfo->size);
-    gt_hashmap_remove(ma->allocated_pointer, ptr);
-    free(ptr);
-    gt_mutex_unlock(bookkeeping_lock);
-  }
-  else {
-    free(ptr);
-  }
+  if (ma->bookkeeping)
+    remove_pointer(ma, ptr, src_file, src_line);
+  free(ptr);
 }
 
 void gt_free_func(void *ptr)
@@ -267,34 +286,44 @@ void gt_ma_disable_global_spacepeak(void)
 GtUword gt_ma_get_space_peak(void)
 {
   gt_assert(ma);
-  return ma->max_size;
+  return gt_atomic_uword_load(&ma->max_size);
 }
 
 GtUword gt_ma_get_space_current(void)
 {
   gt_assert(ma);
-  return ma->current_size;
+  return gt_atomic_uword_load(&ma->current_size);
 }
 
 void gt_ma_show_space_peak(FILE *fp)
 {
+  GtUint64 mallocevents = 0;
+  unsigned int i;
   gt_assert(ma);
+  for (i = 0; i < GT_MA_NUMOFSHARDS; i++) {
+    gt_mutex_lock(ma->shards[i].lock);
+    mallocevents += ma->shards[i].mallocevents;
+    gt_mutex_unlock(ma->shards[i].lock);
+  }
   fprintf(fp, "# space peak in megabytes: %.2f (in "GT_LLU" events)\n",
-          GT_MEGABYTES(ma->max_size),
-          ma->mallocevents);
+          GT_MEGABYTES(gt_ma_get_space_peak()),
+          mallocevents);
 }
 
 int gt_ma_check_space_leak(void)
 {
   CheckSpaceLeakInfo info;
   GT_UNUSED int had_err;
+  unsigned int i;
   gt_assert(ma);
-  gt_mutex_lock(bookkeeping_lock);
   info.has_leak = false;
-  had_err = gt_hashmap_foreach(ma->allocated_pointer, check_space_leak, &info,
-                               NULL);
-  gt_assert(!had_err); /* cannot happen, check_space_leak() is sane */
-  gt_mutex_unlock(bookkeeping_lock);
+  for (i = 0; i < GT_MA_NUMOFSHARDS; i++) {
+    gt_mutex_lock(ma->shards[i].lock);
+    had_err = gt_hashmap_foreach(ma->shards[i].allocated_pointer,
+                                 check_space_leak, &info, NULL);
+    gt_assert(!had_err); /* cannot happen, check_space_leak() is sane */
+    gt_mutex_unlock(ma->shards[i].lock);
+  }
   if (info.has_leak)
     return -1;
   return 0;
@@ -321,22 +350,26 @@ static int print_allocation(GT_UNUSED void *key, void *value,
 void gt_ma_show_allocations(FILE *outfp)
 {
   GT_UNUSED int had_err;
+  unsigned int i;
   gt_assert(ma);
-  gt_mutex_lock(bookkeeping_lock);
-  had_err = gt_hashmap_foreach(ma->allocated_pointer, print_allocation,
-                               outfp, NULL);
-  gt_mutex_unlock(bookkeeping_lock);
-  gt_assert(!had_err); /* cannot happen, print_allocation() is sane */
+  for (i = 0; i < GT_MA_NUMOFSHARDS; i++) {
+    gt_mutex_lock(ma->shards[i].lock);
+    had_err = gt_hashmap_foreach(ma->shards[i].allocated_pointer,
+                                 print_allocation, outfp, NULL);
+    gt_mutex_unlock(ma->shards[i].lock);
+    gt_assert(!had_err); /* cannot happen, print_allocation() is sane */
+  }
 }
 
 void gt_ma_clean(void)
 {
+  unsigned int i;
   gt_assert(ma);
-  gt_mutex_lock(bookkeeping_lock);
   ma->bookkeeping = false;
-  gt_hashmap_delete(ma->allocated_pointer);
-  gt_mutex_unlock(bookkeeping_lock);
-  gt_mutex_delete(bookkeeping_lock);
+  for (i = 0; i < GT_MA_NUMOFSHARDS; i++) {
+    gt_hashmap_delete(ma->shards[i].allocated_pointer);
+    gt_mutex_delete(ma->shards[i].lock);
+  }
   free(ma);
   ma = NULL;
 }
@@ -0,0 +1,331 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/dynalloc.h"
+#include "core/ma.h"
+#include "core/md5_batcher.h"
+#include "core/md5_encoder_api.h"
+#include "core/thread_api.h"
+
+/* number of characters after which a batch is handed to the workers, this is
+   also the length from which on a sequence is hashed on the calling thread */
+#define GT_MD5_BATCHER_BATCHSIZE  ((GtUword) 1 << 20)
+/* maximal number of sequences in a batch */
+#define GT_MD5_BATCHER_MAXSEQS    ((GtUword) 1 << 14)
+#define GT_MD5_BATCHER_BATCHESPERJOB 2
+#define GT_MD5_BATCHER_MD5LEN     33
+
+typedef enum {
+  GT_MD5_BATCH_FREE,      /* empty or being filled */
+  GT_MD5_BATCH_SUBMITTED, /* waiting for a worker */
+  GT_MD5_BATCH_COMPUTING,
+  GT_MD5_BATCH_DONE       /* sums computed, but not reported yet */
+} GtMD5BatchState;
+
+typedef struct {
+  char *chars,
+       *md5s;        /* GT_MD5_BATCHER_MD5LEN characters per sequence */
+  size_t allocated;
+  GtUword length,
+          *seqends,  /* end offsets of the sequences in <chars> */
+          numofseqs,
+          firstseqnum;
+  bool *computed;    /* sum was computed while the sequence was added */
+  GtMD5BatchState state;
+} GtMD5Batch;
+
+struct GtMD5Batcher {
+  GtMD5BatcherFunc func;
+  void *data;
+  GtMD5Batch *batches;
+  GtUword numofbatches,
+          current,   /* index of the batch being filled */
+          seqstart,  /* offset of the current sequence in the current batch */
+          nextseqnum;
+  GtMD5Encoder *encoder;
+  bool longseq;      /* the current sequence is hashed with <encoder> */
+  GtThread **workers;
+  unsigned int numofworkers;
+  GtMutex *mutex;
+  GtCond *submitted,
+         *done;
+  bool stop;
+};
+
+static void md5_batch_compute(GtMD5Batch *batch, GtMD5Encoder *encoder)
+{
+  unsigned char output[16];
+  GtUword i, pos, end;
+  for (i = 0; i < batch->numofseqs; i++) {
+    if (batch->computed[i])
+      continue;
+    pos = i > 0 ? batch->seqends[i-1] : 0;
+    end = batch->seqends[i];
+    /* all but the last block have to be full */
+    for (/* Nothing */; end - pos > 64UL; pos += 64UL)
+      gt_md5_encoder_add_block(encoder, batch->chars + pos, 64UL);
+    gt_md5_encoder_add_block(encoder, batch->chars + pos, end - pos);
+    gt_md5_encoder_finish(encoder, output,
+                          batch->md5s + i * GT_MD5_BATCHER_MD5LEN);
+    gt_md5_encoder_reset(encoder);
+  }
+}
+
+static void* md5_batcher_worker(void *data)
+{
+  GtMD5Batcher *mb = data;
+  GtMD5Encoder *encoder = gt_md5_encoder_new();
+  GtMD5Batch *batch;
+  GtUword i;
+  gt_mutex_lock(mb->mutex);
+  for (;;) {
+    /* take the oldest submitted batch */
+    batch = NULL;
+    for (i = 0; i < mb->numofbatches; i++) {
+      if (mb->batches[i].state == GT_MD5_BATCH_SUBMITTED &&
+          (batch == NULL || mb->batches[i].firstseqnum < batch->firstseqnum)) {
+        batch = mb->batches + i;
+      }
+    }
+    if (batch != NULL) {
+      batch->state = GT_MD5_BATCH_COMPUTING;
+      gt_mutex_unlock(mb->mutex);
+      md5_batch_compute(batch, encoder);
+      gt_mutex_lock(mb->mutex);
+      batch->state = GT_MD5_BATCH_DONE;
+      gt_cond_broadcast(mb->done);
+      continue;
+    }
+    if (mb->stop)
+      break;
+    gt_cond_wait(mb->submitted, mb->mutex);
+  }
+  gt_mutex_unlock(mb->mutex);
+  gt_md5_encoder_delete(encoder);
+  return NULL;
+}
+
+GtMD5Batcher* gt_md5_batcher_new(GtMD5BatcherFunc func, void *data,
+                                 GtError *err)
+{
+  GtMD5Batcher *mb;
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(func);
+  mb = gt_calloc((size_t) 1, sizeof *mb);
+  mb->func = func;
+  mb->data = data;
+  mb->encoder = gt_md5_encoder_new();
+#ifdef GT_THREADS_ENABLED
+  if (gt_jobs > 1U)
+    mb->numofworkers = gt_jobs;
+#endif
+  mb->numofbatches = mb->numofworkers > 0
+                     ? (GtUword) GT_MD5_BATCHER_BATCHESPERJOB * mb->numofworkers
+                     : 1UL;
+  mb->batches = gt_calloc((size_t) mb->numofbatches, sizeof *mb->batches);
+  for (i = 0; i < mb->numofbatches; i++) {
+    GtMD5Batch *batch = mb->batches + i;
+    batch->chars = gt_dynalloc(NULL, &batch->allocated,
+                               (size_t) GT_MD5_BATCHER_BATCHSIZE);
+    batch->md5s = gt_malloc(sizeof *batch->md5s * GT_MD5_BATCHER_MAXSEQS *
+                            GT_MD5_BATCHER_MD5LEN);
+    batch->seqends = gt_malloc(sizeof *batch->seqends *
+                               GT_MD5_BATCHER_MAXSEQS);
+    batch->computed = gt_malloc(sizeof *batch->computed *
+                                GT_MD5_BATCHER_MAXSEQS);
+    batch->state = GT_MD5_BATCH_FREE;
+  }
+  if (mb->numofworkers > 0) {
+    mb->mutex = gt_mutex_new();
+    mb->submitted = gt_cond_new();
+    mb->done = gt_cond_new();
+    mb->workers = gt_calloc((size_t) mb->numofworkers, sizeof *mb->workers);
+    for (i = 0; !had_err && i < mb->numofworkers; i++) {
+      if (!(mb->workers[i] = gt_thread_new(md5_batcher_worker, mb, err)))
+        had_err = -1;
+    }
+  }
+  if (had_err) {
+    gt_md5_batcher_delete(mb);
+    return NULL;
+  }
+  return mb;
+}
+
+/* Hashes all but the last block of the long sequence at the end of
+   <batch>, the last block is kept because it has to be passed to the encoder
+   last. */
+static void md5_batcher_hash_long_sequence(GtMD5Batcher *mb, GtMD5Batch *batch)
+{
+  GtUword pos;
+  for (pos = mb->seqstart; batch->length - pos > 64UL; pos += 64UL)
+    gt_md5_encoder_add_block(mb->encoder, batch->chars + pos, 64UL);
+  memmove(batch->chars + mb->seqstart, batch->chars + pos,
+          (size_t) (batch->length - pos));
+  batch->length = mb->seqstart + (batch->length - pos);
+}
+
+void gt_md5_batcher_add(GtMD5Batcher *mb, const char *chars, GtUword len)
+{
+  GtMD5Batch *batch;
+  gt_assert(mb && (chars || len == 0));
+  batch = mb->batches + mb->current;
+  if ((size_t) (batch->length + len) > batch->allocated) {
+    batch->chars = gt_dynalloc(batch->chars, &batch->allocated,
+                               (size_t) (batch->length + len));
+  }
+  memcpy(batch->chars + batch->length, chars, (size_t) len);
+  batch->length += len;
+  if (!mb->longseq &&
+      batch->length - mb->seqstart > GT_MD5_BATCHER_BATCHSIZE) {
+    mb->longseq = true;
+  }
+  if (mb->longseq)
+    md5_batcher_hash_long_sequence(mb, batch);
+}
+
+static int md5_batcher_report(GtMD5Batcher *mb, GtMD5Batch *batch,
+                              GtError *err)
+{
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+  if (mb->numofworkers > 0) {
+    gt_mutex_lock(mb->mutex);
+    while (batch->state != GT_MD5_BATCH_DONE)
+      gt_cond_wait(mb->done, mb->mutex);
+    gt_mutex_unlock(mb->mutex);
+  }
+  gt_assert(batch->state == GT_MD5_BATCH_DONE);
+  for (i = 0; !had_err && i < batch->numofseqs; i++) {
+    had_err = mb->func(batch->firstseqnum + i,
+                       batch->md5s + i * GT_MD5_BATCHER_MD5LEN, mb->data, err);
+  }
+  batch->state = GT_MD5_BATCH_FREE;
+  batch->numofseqs = 0;
+  batch->length = 0;
+  return had_err;
+}
+
+/* Hands the current batch to the workers and continues with the next one,
+   whose sums are reported first if necessary. */
+static int md5_batcher_submit(GtMD5Batcher *mb, GtError *err)
+{
+  GtMD5Batch *batch = mb->batches + mb->current;
+  int had_err = 0;
+  gt_error_check(err);
+  if (mb->numofworkers > 0) {
+    gt_mutex_lock(mb->mutex);
+    batch->state = GT_MD5_BATCH_SUBMITTED;
+    gt_cond_signal(mb->submitted);
+    gt_mutex_unlock(mb->mutex);
+  }
+  else {
+    md5_batch_compute(batch, mb->encoder);
+    batch->state = GT_MD5_BATCH_DONE;
+  }
+  mb->current = (mb->current + 1) % mb->numofbatches;
+  batch = mb->batches + mb->current;
+  if (batch->state != GT_MD5_BATCH_FREE)
+    had_err = md5_batcher_report(mb, batch, err);
+  batch->firstseqnum = mb->nextseqnum;
+  mb->seqstart = 0;
+  return had_err;
+}
+
+int gt_md5_batcher_finish_sequence(GtMD5Batcher *mb, GtError *err)
+{
+  GtMD5Batch *batch;
+  GtUword seqnum;
+  gt_error_check(err);
+  gt_assert(mb);
+  batch = mb->batches + mb->current;
+  gt_assert(batch->numofseqs < GT_MD5_BATCHER_MAXSEQS);
+  seqnum = batch->numofseqs++;
+  if (mb->longseq) {
+    unsigned char output[16];
+    gt_md5_encoder_add_block(mb->encoder, batch->chars + mb->seqstart,
+                             batch->length - mb->seqstart);
+    gt_md5_encoder_finish(mb->encoder, output,
+                          batch->md5s + seqnum * GT_MD5_BATCHER_MD5LEN);
+    gt_md5_encoder_reset(mb->encoder);
+    batch->length = mb->seqstart;
+    batch->computed[seqnum] = true;
+    mb->longseq = false;
+  }
+  else
+    batch->computed[seqnum] = false;
+  batch->seqends[seqnum] = batch->length;
+  mb->seqstart = batch->length;
+  mb->nextseqnum++;
+  if (batch->length >= GT_MD5_BATCHER_BATCHSIZE ||
+      batch->numofseqs == GT_MD5_BATCHER_MAXSEQS) {
+    return md5_batcher_submit(mb, err);
+  }
+  return 0;
+}
+
+int gt_md5_batcher_flush(GtMD5Batcher *mb, GtError *err)
+{
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(mb && !mb->longseq &&
+            mb->seqstart == mb->batches[mb->current].length);
+  if (mb->batches[mb->current].numofseqs > 0)
+    had_err = md5_batcher_submit(mb, err);
+  /* the batches after the current one are the oldest */
+  for (i = 1; !had_err && i < mb->numofbatches; i++) {
+    GtMD5Batch *batch = mb->batches + (mb->current + i) % mb->numofbatches;
+    if (batch->state != GT_MD5_BATCH_FREE)
+      had_err = md5_batcher_report(mb, batch, err);
+  }
+  return had_err;
+}
+
+void gt_md5_batcher_delete(GtMD5Batcher *mb)
+{
+  GtUword i;
+  if (!mb) return;
+  if (mb->numofworkers > 0) {
+    gt_mutex_lock(mb->mutex);
+    mb->stop = true;
+    gt_cond_broadcast(mb->submitted);
+    gt_mutex_unlock(mb->mutex);
+    for (i = 0; i < mb->numofworkers; i++) {
+      if (mb->workers[i] != NULL) {
+        gt_thread_join(mb->workers[i]);
+        gt_thread_delete(mb->workers[i]);
+      }
+    }
+    gt_free(mb->workers);
+    gt_cond_delete(mb->done);
+    gt_cond_delete(mb->submitted);
+    gt_mutex_delete(mb->mutex);
+  }
+  for (i = 0; i < mb->numofbatches; i++) {
+    gt_free(mb->batches[i].chars);
+    gt_free(mb->batches[i].md5s);
+    gt_free(mb->batches[i].seqends);
+    gt_free(mb->batches[i].computed);
+  }
+  gt_free(mb->batches);
+  gt_md5_encoder_delete(mb->encoder);
+  gt_free(mb);
+}
@@ -0,0 +1,57 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef MD5_BATCHER_H
+#define MD5_BATCHER_H
+
+#include "core/error_api.h"
+#include "core/types_api.h"
+
+/* A <GtMD5Batcher> computes the MD5 sums of a series of sequences in
+   <gt_jobs> many worker threads. The sequences are collected in batches, the
+   sums are reported in the order in which the sequences were added.
+   The characters are hashed as they are added, no case conversion takes
+   place. Sequences longer than a batch are hashed on the calling thread while
+   they are added, so the memory consumption does not depend on the sequence
+   lengths. With <gt_jobs> == 1 or without thread support all sums are computed
+   on the calling thread. */
+typedef struct GtMD5Batcher GtMD5Batcher;
+
+/* Is called for each sequence with its number <seqnum> (counting from 0) and
+   its MD5 sum <md5> as a \0-terminated string of 32 hexadecimal digits. */
+typedef int (*GtMD5BatcherFunc)(GtUword seqnum, const char *md5, void *data,
+                                GtError *err);
+
+/* Returns a new <GtMD5Batcher> which passes the sums and <data> to <func>.
+   Returns NULL and sets <err> if the worker threads could not be created. */
+GtMD5Batcher* gt_md5_batcher_new(GtMD5BatcherFunc func, void *data,
+                                 GtError *err);
+/* Appends the <len> characters at <chars> to the current sequence. */
+void          gt_md5_batcher_add(GtMD5Batcher *md5_batcher, const char *chars,
+                                 GtUword len);
+/* Finishes the current sequence, the next call of <gt_md5_batcher_add()>
+   starts a new one. <func> may be called for earlier sequences, its
+   error code is returned. */
+int           gt_md5_batcher_finish_sequence(GtMD5Batcher *md5_batcher,
+                                             GtError *err);
+/* Waits until the sums of all finished sequences have been computed and
+   reported. Returns the error code of <func>. */
+int           gt_md5_batcher_flush(GtMD5Batcher *md5_batcher, GtError *err);
+/* Deletes <md5_batcher>, sums of sequences which have not been flushed are
+   not reported. */
+void          gt_md5_batcher_delete(GtMD5Batcher *md5_batcher);
+
+#endif
@@ -15,12 +15,14 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include "core/atomic.h"
 #include "core/fa.h"
 #include "core/fileutils_api.h"
 #include "core/hashmap_api.h"
 #include "core/ma.h"
 #include "core/md5_fingerprint_api.h"
 #include "core/md5_tab.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/xansi_api.h"
 
@@ -59,16 +61,75 @@ static bool read_fingerprints(GtMD5Tab *md5_tab,
   return reading_succeeded;
 }
 
+/* number of sequences a thread fingerprints at a time */
+#define MD5_TAB_CHUNK_SIZE  256
+
+typedef struct {
+  char **md5_fingerprints;
+  void *seqs;
+  GtGetSeqFunc get_seq;
+  GtGetSeqLenFunc get_seq_len;
+  GtUword num_of_seqs,
+          next_chunk;
+} MD5TabThreadInfo;
+
+static void* add_fingerprints_thread(void *data)
+{
+  MD5TabThreadInfo *info = data;
+  GtUword i, start, end;
+  gt_assert(info);
+  for (;;) {
+    start = gt_atomic_uword_add_fetch(&info->next_chunk, MD5_TAB_CHUNK_SIZE)
+            - MD5_TAB_CHUNK_SIZE;
+    if (start >= info->num_of_seqs)
+      break;
+    end = start + MD5_TAB_CHUNK_SIZE;
+    if (end > info->num_of_seqs)
+      end = info->num_of_seqs;
+    for (i = start; i < end; i++) {
+      info->md5_fingerprints[i] =
+        gt_md5_fingerprint(info->get_seq(info->seqs, i),
+                           info->get_seq_len(info->seqs, i));
+    }
+  }
+  return NULL;
+}
+
 static void add_fingerprints(char **md5_fingerprints, void *seqs,
                              GtGetSeqFunc get_seq, GtGetSeqLenFunc get_seq_len,
                              GtUword num_of_seqs)
 {
-  GtUword i;
+  MD5TabThreadInfo info;
+  GtThread **threads;
+  unsigned int i, num_of_threads = 0;
   gt_assert(md5_fingerprints && seqs && get_seq && get_seq_len);
-  for (i = 0; i < num_of_seqs; i++) {
-    md5_fingerprints[i] = gt_md5_fingerprint(get_seq(seqs, i),
-                                             get_seq_len(seqs, i));
+  info.md5_fingerprints = md5_fingerprints;
+  info.seqs = seqs;
+  info.get_seq = get_seq;
+  info.get_seq_len = get_seq_len;
+  info.num_of_seqs = num_of_seqs;
+  info.next_chunk = 0;
+  threads = gt_malloc(sizeof *threads * gt_jobs);
+  if (gt_jobs > 1 && num_of_seqs > MD5_TAB_CHUNK_SIZE) {
+    /* the first access can trigger the loading of the sequences, make sure it
+       happens before the other threads are started */
+    (void) get_seq(seqs, 0);
+    for (i = 1; i < gt_jobs; i++) {
+      /* if a thread cannot be created, the remaining work is distributed among
+         the threads started so far */
+      if (!(threads[num_of_threads] = gt_thread_new(add_fingerprints_thread,
+                                                    &info, NULL))) {
+        break;
+      }
+      num_of_threads++;
+    }
+  }
+  (void) add_fingerprints_thread(&info);
+  for (i = 0; i < num_of_threads; i++) {
+    gt_thread_join(threads[i]);
+    gt_thread_delete(threads[i]);
   }
+  gt_free(threads);
 }
 
 static void dump_md5_fingerprints(char **md5_fingerprints,
@@ -36,7 +36,11 @@ typedef GtUword     (*GtGetSeqLenFunc)(void *seqs, GtUword index);
    "<sequence_file><GT_MD5TAB_FILE_SUFFIX>"), if it exists or written to it, if
    it doesn't exist. If <use_cache_file> is <false>, no cache file is read or
    written. If <use_file_locking> is <true>, file locking is used to access the
-   cache file (recommended). */
+   cache file (recommended).
+   If the MD5 sums have to be computed and <gt_jobs> is larger than 1, this is
+   done in <gt_jobs> many threads. <get_seq> and <get_seq_len> are then called
+   concurrently, except for the first call of <get_seq>, which happens before
+   the threads are started (e.g., to load the sequences on demand). */
 GtMD5Tab*     gt_md5_tab_new(const char *sequence_file, void *seqs,
                              GtGetSeqFunc get_seq, GtGetSeqLenFunc get_seq_len,
                              GtUword num_of_seqs, bool use_cache_file,
@@ -0,0 +1,63 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/assert_api.h"
+#include "core/object_lock.h"
+#include "core/thread_api.h"
+#include "core/types_api.h"
+
+/* must be a power of two */
+#define GT_OBJECT_LOCK_NUMOFLOCKS 256U
+
+static GtMutex *gt_object_locks[GT_OBJECT_LOCK_NUMOFLOCKS];
+
+void gt_object_lock_init(void)
+{
+  unsigned int i;
+  for (i = 0; i < GT_OBJECT_LOCK_NUMOFLOCKS; i++)
+    gt_object_locks[i] = gt_mutex_new();
+}
+
+void gt_object_lock_clean(void)
+{
+  unsigned int i;
+  for (i = 0; i < GT_OBJECT_LOCK_NUMOFLOCKS; i++) {
+    gt_mutex_delete(gt_object_locks[i]);
+    gt_object_locks[i] = NULL;
+  }
+}
+
+static GtMutex* gt_object_lock_get(const void *obj)
+{
+  GtUword addr = (GtUword) obj;
+  /* the lowest bits are zero due to the alignment of allocated objects */
+  addr ^= addr >> 12;
+  return gt_object_locks[(addr >> 4) & (GT_OBJECT_LOCK_NUMOFLOCKS - 1)];
+}
+
+void gt_object_lock_enter_func(const void *obj)
+{
+  GtMutex *lock = gt_object_lock_get(obj);
+  gt_assert(lock);
+  gt_mutex_lock(lock);
+}
+
+void gt_object_lock_leave_func(const void *obj)
+{
+  GtMutex *lock = gt_object_lock_get(obj);
+  gt_assert(lock);
+  gt_mutex_unlock(lock);
+}
@@ -0,0 +1,50 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef OBJECT_LOCK_H
+#define OBJECT_LOCK_H
+
+/* A table of locks shared by objects which are too space critical to carry a
+   lock of their own (e.g., genome nodes). The lock of an object is selected by
+   its address, so different objects may share a lock. Therefore, an object
+   lock must not be held while the lock of another object is acquired. */
+
+/* Initializes the table of object locks. */
+void    gt_object_lock_init(void);
+/* Cleans the static resources of the object lock table. */
+void    gt_object_lock_clean(void);
+
+/* Marks the beginning of a critical section for the object at <obj>. */
+#ifdef GT_THREADS_ENABLED
+#define gt_object_lock_enter(obj) \
+        gt_object_lock_enter_func(obj)
+void    gt_object_lock_enter_func(const void *obj);
+#else
+#define gt_object_lock_enter(obj) \
+        ((void) 0)
+#endif
+
+/* Marks the end of a critical section for the object at <obj>. */
+#ifdef GT_THREADS_ENABLED
+#define gt_object_lock_leave(obj) \
+        gt_object_lock_leave_func(obj)
+void    gt_object_lock_leave_func(const void *obj);
+#else
+#define gt_object_lock_leave(obj) \
+        ((void) 0)
+#endif
+
+#endif
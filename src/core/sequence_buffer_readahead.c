@@ -0,0 +1,222 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/desc_buffer.h"
+#include "core/ma.h"
+#include "core/sequence_buffer_embl.h"
+#include "core/sequence_buffer_readahead.h"
+#include "core/sequence_buffer_rep.h"
+#include "core/thread_api.h"
+
+/* number of buffer contents which are read ahead */
+#define GT_READAHEAD_CHUNKS 16
+
+typedef struct {
+  unsigned char outbuf[OUTBUFSIZE],
+                outbuforig[OUTBUFSIZE];
+  GtUword nextfree,
+          fileindex;
+  GtUint64 counter;
+  GtDescBuffer *descptr;
+  bool complete;
+  int retval;
+} GtReadaheadChunk;
+
+struct GtSequenceBufferReadahead {
+  const GtSequenceBuffer parent_instance;
+  GtSequenceBuffer *inner;
+  GtReadaheadChunk *chunks;
+  GtUword head,  /* index of the next chunk to be consumed */
+          filled,
+          fileindex;
+  GtError *readerr;
+  GtThread *reader;
+  GtMutex *mutex;
+  GtCond *chunk_filled,
+         *chunk_consumed;
+  bool quit;
+};
+
+#define gt_sequence_buffer_readahead_cast(SB)\
+        gt_sequence_buffer_cast(gt_sequence_buffer_readahead_class(), SB)
+
+static void* gt_sequence_buffer_readahead_thread(void *data)
+{
+  GtSequenceBufferReadahead *sbr = data;
+  GtSequenceBufferMembers *innerpvt = sbr->inner->pvt;
+  GtReadaheadChunk *chunk;
+  bool last;
+
+  do {
+    gt_mutex_lock(sbr->mutex);
+    while (sbr->filled == (GtUword) GT_READAHEAD_CHUNKS && !sbr->quit)
+      gt_cond_wait(sbr->chunk_consumed, sbr->mutex);
+    if (sbr->quit) {
+      gt_mutex_unlock(sbr->mutex);
+      break;
+    }
+    chunk = sbr->chunks + (sbr->head + sbr->filled) % GT_READAHEAD_CHUNKS;
+    gt_mutex_unlock(sbr->mutex);
+
+    /* the descriptions are collected with the chunk they belong to */
+    if (innerpvt->descptr != NULL)
+      innerpvt->descptr = chunk->descptr;
+    chunk->retval = gt_sequence_buffer_advance(sbr->inner, sbr->readerr);
+    if (chunk->retval == 0) {
+      chunk->nextfree = innerpvt->nextfree;
+      memcpy(chunk->outbuf, innerpvt->outbuf, (size_t) chunk->nextfree);
+      memcpy(chunk->outbuforig, innerpvt->outbuforig,
+             (size_t) chunk->nextfree);
+      chunk->complete = innerpvt->complete;
+    }
+    chunk->fileindex = gt_sequence_buffer_get_file_index(sbr->inner);
+    chunk->counter = innerpvt->counter;
+    last = chunk->retval != 0 || chunk->complete || chunk->nextfree == 0;
+
+    gt_mutex_lock(sbr->mutex);
+    sbr->filled++;
+    gt_cond_signal(sbr->chunk_filled);
+    gt_mutex_unlock(sbr->mutex);
+  } while (!last);
+  return NULL;
+}
+
+static int gt_sequence_buffer_readahead_advance(GtSequenceBuffer *sb,
+                                                GtError *err)
+{
+  GtSequenceBufferReadahead *sbr;
+  GtSequenceBufferMembers *pvt;
+  GtReadaheadChunk *chunk;
+
+  gt_error_check(err);
+  sbr = gt_sequence_buffer_readahead_cast(sb);
+  pvt = sb->pvt;
+  gt_mutex_lock(sbr->mutex);
+  while (sbr->filled == 0)
+    gt_cond_wait(sbr->chunk_filled, sbr->mutex);
+  chunk = sbr->chunks + sbr->head;
+  gt_mutex_unlock(sbr->mutex);
+
+  sbr->fileindex = chunk->fileindex;
+  if (pvt->descptr != NULL)
+    gt_desc_buffer_move(pvt->descptr, chunk->descptr);
+  if (chunk->retval != 0) {
+    /* the reader thread has stopped, the chunk is kept */
+    gt_error_set(err, "%s", gt_error_get(sbr->readerr));
+    return chunk->retval;
+  }
+  memcpy(pvt->outbuf, chunk->outbuf, (size_t) chunk->nextfree);
+  memcpy(pvt->outbuforig, chunk->outbuforig, (size_t) chunk->nextfree);
+  pvt->nextfree = chunk->nextfree;
+  pvt->complete = chunk->complete;
+  pvt->counter = chunk->counter;
+
+  gt_mutex_lock(sbr->mutex);
+  sbr->head = (sbr->head + 1) % GT_READAHEAD_CHUNKS;
+  sbr->filled--;
+  gt_cond_signal(sbr->chunk_consumed);
+  gt_mutex_unlock(sbr->mutex);
+  return 0;
+}
+
+static GtUword
+gt_sequence_buffer_readahead_get_file_index(GtSequenceBuffer *sb)
+{
+  GtSequenceBufferReadahead *sbr;
+  gt_assert(sb);
+  sbr = gt_sequence_buffer_readahead_cast(sb);
+  return sbr->fileindex;
+}
+
+static void gt_sequence_buffer_readahead_free(GtSequenceBuffer *sb)
+{
+  GtSequenceBufferReadahead *sbr;
+  GtUword i;
+  gt_assert(sb);
+  sbr = gt_sequence_buffer_readahead_cast(sb);
+  if (sbr->reader != NULL) {
+    gt_mutex_lock(sbr->mutex);
+    sbr->quit = true;
+    gt_cond_signal(sbr->chunk_consumed);
+    gt_mutex_unlock(sbr->mutex);
+    gt_thread_join(sbr->reader);
+    gt_thread_delete(sbr->reader);
+  }
+  for (i = 0; i < (GtUword) GT_READAHEAD_CHUNKS; i++)
+    gt_desc_buffer_delete(sbr->chunks[i].descptr);
+  gt_free(sbr->chunks);
+  gt_cond_delete(sbr->chunk_consumed);
+  gt_cond_delete(sbr->chunk_filled);
+  gt_mutex_delete(sbr->mutex);
+  gt_error_delete(sbr->readerr);
+  gt_sequence_buffer_delete(sbr->inner);
+}
+
+const GtSequenceBufferClass* gt_sequence_buffer_readahead_class(void)
+{
+  static const GtSequenceBufferClass sbc = {
+                                    sizeof (GtSequenceBufferReadahead),
+                                    gt_sequence_buffer_readahead_advance,
+                                    gt_sequence_buffer_readahead_get_file_index,
+                                    gt_sequence_buffer_readahead_free };
+  return &sbc;
+}
+
+GtSequenceBuffer* gt_sequence_buffer_readahead_new(GtSequenceBuffer *inner,
+                                                   GtError *err)
+{
+#ifdef GT_THREADS_ENABLED
+  GtSequenceBuffer *sb;
+  GtSequenceBufferReadahead *sbr;
+  GtUword i;
+
+  gt_error_check(err);
+  gt_assert(inner);
+  /* the EMBL parser inspects the descriptions collected so far, so they
+     cannot be collected per chunk */
+  if (inner->pvt->descptr != NULL &&
+      inner->c_class == gt_sequence_buffer_embl_class()) {
+    return inner;
+  }
+  sb = gt_sequence_buffer_create(gt_sequence_buffer_readahead_class());
+  sbr = gt_sequence_buffer_readahead_cast(sb);
+  sbr->inner = inner;
+  sbr->chunks = gt_calloc((size_t) GT_READAHEAD_CHUNKS, sizeof *sbr->chunks);
+  if (inner->pvt->descptr != NULL) {
+    sb->pvt->descptr = inner->pvt->descptr;
+    for (i = 0; i < (GtUword) GT_READAHEAD_CHUNKS; i++)
+      sbr->chunks[i].descptr = gt_desc_buffer_new();
+    inner->pvt->descptr = sbr->chunks[0].descptr;
+  }
+  sb->pvt->filenametab = inner->pvt->filenametab;
+  sb->pvt->symbolmap = inner->pvt->symbolmap;
+  sbr->readerr = gt_error_new();
+  sbr->mutex = gt_mutex_new();
+  sbr->chunk_filled = gt_cond_new();
+  sbr->chunk_consumed = gt_cond_new();
+  sbr->reader = gt_thread_new(gt_sequence_buffer_readahead_thread, sbr, err);
+  if (sbr->reader == NULL) {
+    gt_sequence_buffer_delete(sb);
+    return NULL;
+  }
+  return sb;
+#else
+  gt_error_check(err);
+  gt_assert(inner);
+  return inner;
+#endif
+}
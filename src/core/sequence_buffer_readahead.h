@@ -0,0 +1,43 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef SEQUENCE_BUFFER_READAHEAD_H
+#define SEQUENCE_BUFFER_READAHEAD_H
+
+#include "core/error_api.h"
+#include "core/sequence_buffer.h"
+
+/* A <GtSequenceBufferReadahead> delivers the contents of another
+   <GtSequenceBuffer>, which is advanced in a separate thread while the
+   characters of the previous buffer contents are consumed. The symbol map,
+   file length table and character distribution table have to be set on the
+   inner buffer before it is wrapped; the tables are filled by the reader
+   thread and must not be inspected before the wrapper has reported the end of
+   the input. A description buffer set on the inner buffer is moved to the
+   wrapper and filled on the consuming thread. */
+typedef struct GtSequenceBufferReadahead GtSequenceBufferReadahead;
+
+const GtSequenceBufferClass* gt_sequence_buffer_readahead_class(void);
+/* Returns a new <GtSequenceBuffer> reading ahead in <sb>, which it takes
+   ownership of. Without thread support, or if <sb> is an EMBL buffer with a
+   description buffer, <sb> itself is returned. Returns NULL
+   and sets <err> if the reader thread could not be created, <sb> is deleted
+   in this case. */
+GtSequenceBuffer*            gt_sequence_buffer_readahead_new(
+                                                           GtSequenceBuffer *sb,
+                                                           GtError *err);
+
+#endif
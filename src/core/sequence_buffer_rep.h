@@ -70,5 +70,6 @@ struct GtSequenceBufferMembers {
 GtSequenceBuffer* gt_sequence_buffer_create(const GtSequenceBufferClass*);
 void*             gt_sequence_buffer_cast(const GtSequenceBufferClass*,
                                           GtSequenceBuffer*);
+int               gt_sequence_buffer_advance(GtSequenceBuffer*, GtError*);
 
 #endif
@@ -16,16 +16,16 @@
 */
 
 #include <stdio.h>
+#include "core/atomic.h"
 #include "core/spacepeak.h"
 #include "core/ma.h"
 #include "core/spacecalc.h"
-#include "core/thread_api.h"
 
+/* the sizes are modified atomically, without holding a lock */
 typedef struct
 {
   GtUword current,
                 max;
-  GtMutex *mutex;
 } GtSpacepeakLogger;
 
 static GtSpacepeakLogger *peaklogger = NULL;
@@ -36,42 +36,35 @@ void gt_spacepeak_init(void)
   peaklogger = malloc(sizeof (GtSpacepeakLogger));
   peaklogger->current = gt_ma_get_space_current();
   peaklogger->max = 0;
-  peaklogger->mutex = gt_mutex_new();
 }
 
 void gt_spacepeak_add(GtUword size)
 {
   gt_assert(peaklogger);
-  gt_mutex_lock(peaklogger->mutex);
-  peaklogger->current += size;
-  if (peaklogger->current > peaklogger->max)
-    peaklogger->max = peaklogger->current;
-  gt_mutex_unlock(peaklogger->mutex);
+  gt_atomic_uword_max(&peaklogger->max,
+                      gt_atomic_uword_add_fetch(&peaklogger->current, size));
 }
 
 void gt_spacepeak_free(GtUword size)
 {
-  gt_assert(peaklogger && size <= peaklogger->current);
-  gt_mutex_lock(peaklogger->mutex);
-  peaklogger->current -= size;
-  gt_mutex_unlock(peaklogger->mutex);
+  gt_assert(peaklogger);
+  gt_atomic_uword_sub(&peaklogger->current, size);
 }
 GtUword gt_spacepeak_get_space_peak(void)
 {
   gt_assert(peaklogger);
-  return peaklogger->max;
+  return gt_atomic_uword_load(&peaklogger->max);
 }
 
 void gt_spacepeak_show_space_peak(FILE *outfp)
 {
   gt_assert(peaklogger);
   fprintf(outfp, "# combined space peak in megabytes: %.2f\n",
-          GT_MEGABYTES(peaklogger->max));
+          GT_MEGABYTES(gt_spacepeak_get_space_peak()));
 }
 
 void gt_spacepeak_clean()
 {
   if (!peaklogger) return;
-  gt_mutex_delete(peaklogger->mutex);
   free(peaklogger);
 }
@@ -18,6 +18,7 @@
 #include <math.h>
 #include <string.h>
 #include "core/assert_api.h"
+#include "core/atomic.h"
 #include "core/cstr_api.h"
 #include "core/dynalloc.h"
 #include "core/ensure.h"
@@ -223,7 +224,7 @@ GtStr* gt_str_clone(const GtStr *s)
 GtStr* gt_str_ref(GtStr *s)
 {
   if (!s) return NULL;
-  s->reference_count++; /* increase the reference counter */
+  gt_atomic_uint_inc(&s->reference_count); /* increase the reference counter */
   return s;
 }
 
@@ -434,10 +435,10 @@ int gt_str_unit_test(GtError *err)
 void gt_str_delete(GtStr *s)
 {
   if (!s) return;           /* return without action if 's' is NULL */
-  if (s->reference_count) { /* there are multiple references to this string */
-    s->reference_count--;   /* decrement the reference counter */
-    return;                 /* return without freeing the object */
-  }
+  /* decrement the reference counter, if there are multiple references to
+     this string, return without freeing the object */
+  if (gt_atomic_uint_fetch_dec(&s->reference_count))
+    return;
   gt_free(s->cstr);         /* free the stored the C string */
   gt_free(s);               /* free the actual string object */
 }
@@ -146,6 +146,50 @@ void gt_mutex_unlock_func(GtMutex *mutex)
   gt_assert(!rval);
 }
 
+GtCond* gt_cond_new(void)
+{
+  GtCond *cond;
+  GT_UNUSED int rval;
+  cond = thread_xmalloc(sizeof (pthread_cond_t), __FILE__, __LINE__);
+  /* initialize condition variable with default attributes */
+  rval = pthread_cond_init((pthread_cond_t*) cond, NULL);
+  gt_assert(!rval);
+  return cond;
+}
+
+void gt_cond_delete(GtCond *cond)
+{
+  GT_UNUSED int rval;
+  if (!cond) return;
+  rval = pthread_cond_destroy((pthread_cond_t*) cond);
+  gt_assert(!rval);
+  free(cond);
+}
+
+void gt_cond_wait_func(GtCond *cond, GtMutex *mutex)
+{
+  GT_UNUSED int rval;
+  gt_assert(cond && mutex);
+  rval = pthread_cond_wait((pthread_cond_t*) cond, (pthread_mutex_t*) mutex);
+  gt_assert(!rval);
+}
+
+void gt_cond_signal_func(GtCond *cond)
+{
+  GT_UNUSED int rval;
+  gt_assert(cond);
+  rval = pthread_cond_signal((pthread_cond_t*) cond);
+  gt_assert(!rval);
+}
+
+void gt_cond_broadcast_func(GtCond *cond)
+{
+  GT_UNUSED int rval;
+  gt_assert(cond);
+  rval = pthread_cond_broadcast((pthread_cond_t*) cond);
+  gt_assert(!rval);
+}
+
 #else
 
 GtThread* gt_thread_new(GtThreadFunc function, void *data,
@@ -179,6 +223,16 @@ void gt_mutex_delete(GT_UNUSED GtMutex *mutex)
   return;
 }
 
+GtCond* gt_cond_new(void)
+{
+  return NULL;
+}
+
+void gt_cond_delete(GT_UNUSED GtCond *cond)
+{
+  return;
+}
+
 #endif
 
 void gt_thread_delete(GtThread *thread)
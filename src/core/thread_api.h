@@ -30,6 +30,9 @@ typedef struct GtThread GtThread;
 typedef struct GtRWLock GtRWLock;
 /* The <GtMutex> class represents a simple mutex structure. */
 typedef struct GtMutex GtMutex;
+/* The <GtCond> class represents a condition variable, which is always used
+   together with a <GtMutex>. */
+typedef struct GtCond GtCond;
 
 /* A function to be multithreaded. */
 typedef void* (*GtThreadFunc)(void *data);
@@ -108,4 +111,43 @@ void      gt_mutex_unlock_func(GtMutex *mutex);
           ((void) 0)
 #endif
 
+/* Return a new <GtCond*> object. */
+GtCond*   gt_cond_new(void);
+
+/* Delete the given <cond>. */
+void      gt_cond_delete(GtCond *cond);
+
+#ifdef GT_THREADS_ENABLED
+/* Atomically unlock the given <mutex> (which must be locked by the calling
+   thread) and wait until <cond> is signaled. The <mutex> is locked again
+   before this function returns. As spurious wakeups are possible, the waited
+   for condition has to be checked again afterwards. */
+#define   gt_cond_wait(cond, mutex) \
+          gt_cond_wait_func(cond, mutex)
+void      gt_cond_wait_func(GtCond *cond, GtMutex *mutex);
+#else
+#define   gt_cond_wait(cond, mutex) \
+          ((void) 0)
+#endif
+
+#ifdef GT_THREADS_ENABLED
+/* Wake up at least one of the threads waiting for <cond>. */
+#define   gt_cond_signal(cond) \
+          gt_cond_signal_func(cond)
+void      gt_cond_signal_func(GtCond *cond);
+#else
+#define   gt_cond_signal(cond) \
+          ((void) 0)
+#endif
+
+#ifdef GT_THREADS_ENABLED
+/* Wake up all threads waiting for <cond>. */
+#define   gt_cond_broadcast(cond) \
+          gt_cond_broadcast_func(cond)
+void      gt_cond_broadcast_func(GtCond *cond);
+#else
+#define   gt_cond_broadcast(cond) \
+          ((void) 0)
+#endif
+
 #endif
@@ -50,10 +50,36 @@
 #include "extended/rdb_sqlite_api.h"
 #include "extended/rdb_visitor_rep.h"
 
+/* number of feature nodes inserted per transaction in bulk-load mode */
+#define GT_ANNO_DB_GFFLIKE_BULK_LOAD_BATCH_SIZE  100000UL
+
+/* the SQLite connection settings changed for a bulk load, with their values
+   during the load */
+static const char *gfflike_bulk_load_pragmas[][2] = {
+  { "synchronous",  "OFF" },
+  { "journal_mode", "MEMORY" },
+  { "temp_store",   "MEMORY" },
+  { "cache_size",   "512000" }
+};
+
+#define GT_ANNO_DB_GFFLIKE_NOF_BULK_LOAD_PRAGMAS \
+        (sizeof (gfflike_bulk_load_pragmas) / \
+         sizeof (gfflike_bulk_load_pragmas[0]))
+
+/* the values of the bulk-load pragmas before the load */
+typedef struct {
+  char values[GT_ANNO_DB_GFFLIKE_NOF_BULK_LOAD_PRAGMAS][32];
+  bool saved;
+} GFFlikeSavedPragmas;
+
 struct GtAnnoDBGFFlike {
   const GtAnnoDBSchema parent_instance;
   GtRDB *db;
   GtRDBVisitor *visitor;
+  GFFlikeSavedPragmas saved_pragmas;
+  bool bulk_load,
+       bulk_load_transactions; /* set by the setup visitor if the backend
+                                  supports the transaction statements */
 };
 
 typedef struct {
@@ -61,6 +87,11 @@ typedef struct {
   GtAnnoDBGFFlike *annodb;
 } GFFlikeSetupVisitor;
 
+typedef struct {
+  const GtRDBVisitor parent_instance;
+  GFFlikeSavedPragmas saved_pragmas; /* restored before creating the indexes */
+} GFFlikeIndexVisitor;
+
 typedef struct {
   const GtFeatureIndex parent_instance;
   GtHashmap *node_to_parent_array,
@@ -76,12 +107,18 @@ typedef struct {
   GtRDBStmt *stmts[GT_PSTMT_NOF_STATEMENTS];
   GtFeatureNodeObserver *obs;
   GtRDB *db;
+  GtRDBVisitor *index_visitor;
   GtMutex *dblock;
-  bool transaction_lock;
+  GtUword bulk_load_nodes; /* nodes inserted in the current transaction */
+  bool transaction_lock,
+       bulk_load,
+       bulk_load_transactions,
+       in_transaction;
 } GtFeatureIndexGFFlike;
 
 const GtAnnoDBSchemaClass* gt_anno_db_gfflike_class(void);
 static const GtRDBVisitorClass* gfflike_setup_visitor_class(void);
+static const GtRDBVisitorClass* gfflike_index_visitor_class(void);
 static const GtFeatureIndexClass* feature_index_gfflike_class(void);
 
 #define anno_db_gfflike_cast(V)\
@@ -90,6 +127,9 @@ static const GtFeatureIndexClass* feature_index_gfflike_class(void);
 #define gfflike_setup_visitor_cast(V)\
         gt_rdb_visitor_cast(gfflike_setup_visitor_class(), V)
 
+#define gfflike_index_visitor_cast(V)\
+        gt_rdb_visitor_cast(gfflike_index_visitor_class(), V)
+
 #define feature_index_gfflike_cast(V)\
         gt_feature_index_cast(feature_index_gfflike_class(), V)
 
@@ -299,6 +339,72 @@ static int anno_db_gfflike_create_indexes_sqlite(GtRDBSqlite *db, GtError *err)
   return 0;
 }
 
+/* sets the pragma <name> to <value> */
+static int anno_db_gfflike_set_pragma_sqlite(GtRDBSqlite *db, const char *name,
+                                             const char *value, GtError *err)
+{
+  GtRDBStmt *stmt;
+  GtStr *query;
+  int had_err = 0;
+  gt_assert(db && name && value);
+
+  query = gt_str_new_cstr("PRAGMA ");
+  gt_str_append_cstr(query, name);
+  gt_str_append_char(query, '=');
+  gt_str_append_cstr(query, value);
+  stmt = gt_rdb_prepare((GtRDB*) db, gt_str_get(query), 0, err);
+  if (!stmt || gt_rdb_stmt_exec(stmt, err) < 0)
+    had_err = -1;
+  gt_rdb_stmt_delete(stmt);
+  gt_str_delete(query);
+  return had_err;
+}
+
+/* tunes the connection for loading features: the journal is only kept in
+   memory and the data is not synced to disk after each transaction. The
+   previous settings are stored in <saved>. */
+static int anno_db_gfflike_bulk_load_pragmas_sqlite(GtRDBSqlite *db,
+                                                    GFFlikeSavedPragmas *saved,
+                                                    GtError *err)
+{
+  GtRDBStmt *stmt;
+  GtStr *query, *value;
+  GtUword i;
+  int had_err = 0;
+  gt_assert(db && saved);
+
+  query = gt_str_new();
+  value = gt_str_new();
+  for (i = 0; !had_err && i < GT_ANNO_DB_GFFLIKE_NOF_BULK_LOAD_PRAGMAS; i++) {
+    gt_str_set(query, "PRAGMA ");
+    gt_str_append_cstr(query, gfflike_bulk_load_pragmas[i][0]);
+    stmt = gt_rdb_prepare((GtRDB*) db, gt_str_get(query), 0, err);
+    if (!stmt || gt_rdb_stmt_exec(stmt, err) != 0 ||
+        gt_rdb_stmt_get_string(stmt, 0, value, err)) {
+      if (!gt_error_is_set(err)) {
+        gt_error_set(err, "could not read pragma %s",
+                     gfflike_bulk_load_pragmas[i][0]);
+      }
+      had_err = -1;
+    }
+    else {
+      (void) snprintf(saved->values[i], sizeof (saved->values[i]), "%s",
+                      gt_str_get(value));
+    }
+    gt_rdb_stmt_delete(stmt);
+  }
+  saved->saved = !had_err;
+  for (i = 0; !had_err && i < GT_ANNO_DB_GFFLIKE_NOF_BULK_LOAD_PRAGMAS; i++) {
+    had_err = anno_db_gfflike_set_pragma_sqlite(db,
+                                                gfflike_bulk_load_pragmas[i][0],
+                                                gfflike_bulk_load_pragmas[i][1],
+                                                err);
+  }
+  gt_str_delete(value);
+  gt_str_delete(query);
+  return had_err;
+}
+
 static int anno_db_gfflike_validate_mysql(GtRDBMySQL *db, GtError *err,
                                           bool *check)
 {
@@ -546,9 +652,10 @@ static int anno_db_gfflike_create_indexes_mysql(GtRDBMySQL *db, GtError *err)
   return 0;
 }
 
-int anno_db_gfflike_init_sqlite(GT_UNUSED GtRDBVisitor *rdbv, GtRDBSqlite *db,
+int anno_db_gfflike_init_sqlite(GtRDBVisitor *rdbv, GtRDBSqlite *db,
                                 GtError *err)
 {
+  GFFlikeSetupVisitor *sv = gfflike_setup_visitor_cast(rdbv);
   GtCstrTable *cst = NULL;
   GtStrArray *arr = NULL;
   bool check = true;
@@ -579,15 +686,55 @@ int anno_db_gfflike_init_sqlite(GT_UNUSED GtRDBVisitor *rdbv, GtRDBSqlite *db,
     had_err = -1;
   }
   if (!had_err) {
-    had_err = anno_db_gfflike_create_indexes_sqlite(db, err);
+    if (sv->annodb->bulk_load) {
+      /* the indexes are created after loading */
+      had_err = anno_db_gfflike_bulk_load_pragmas_sqlite(db,
+                                                     &sv->annodb->saved_pragmas,
+                                                         err);
+      sv->annodb->bulk_load_transactions = true;
+    }
+    else
+      had_err = anno_db_gfflike_create_indexes_sqlite(db, err);
   }
 
   return had_err;
 }
 
-int anno_db_gfflike_init_mysql(GT_UNUSED GtRDBVisitor *rdbv, GtRDBMySQL *db,
+/* restores the connection settings changed for the bulk load before the
+   indexes are created */
+static int anno_db_gfflike_create_indexes_visit_sqlite(GtRDBVisitor *rdbv,
+                                                       GtRDBSqlite *db,
+                                                       GtError *err)
+{
+  GFFlikeIndexVisitor *iv = gfflike_index_visitor_cast(rdbv);
+  GtUword i;
+  int had_err = 0;
+  if (iv->saved_pragmas.saved) {
+    for (i = 0; !had_err && i < GT_ANNO_DB_GFFLIKE_NOF_BULK_LOAD_PRAGMAS;
+         i++) {
+      had_err = anno_db_gfflike_set_pragma_sqlite(db,
+                                               gfflike_bulk_load_pragmas[i][0],
+                                                  iv->saved_pragmas.values[i],
+                                                  err);
+    }
+  }
+  if (!had_err)
+    had_err = anno_db_gfflike_create_indexes_sqlite(db, err);
+  return had_err;
+}
+
+static int anno_db_gfflike_create_indexes_visit_mysql(GT_UNUSED GtRDBVisitor
+                                                      *rdbv,
+                                                      GtRDBMySQL *db,
+                                                      GtError *err)
+{
+  return anno_db_gfflike_create_indexes_mysql(db, err);
+}
+
+int anno_db_gfflike_init_mysql(GtRDBVisitor *rdbv, GtRDBMySQL *db,
                                GtError *err)
 {
+  GFFlikeSetupVisitor *sv = gfflike_setup_visitor_cast(rdbv);
   GtCstrTable *cst = NULL;
   GtStrArray *arr = NULL;
   bool check = true;
@@ -616,7 +763,9 @@ int anno_db_gfflike_init_mysql(GT_UNUSED GtRDBVisitor *rdbv, GtRDBMySQL *db,
     gt_error_set(err, "corrupt database schema: tables are missing");
     had_err = -1;
   }
-  if (!had_err) {
+  /* in bulk-load mode the indexes are created after loading, the features are
+     inserted with autocommit (BEGIN cannot be a prepared statement here) */
+  if (!had_err && !sv->annodb->bulk_load) {
     had_err = anno_db_gfflike_create_indexes_mysql(db, err);
   }
 
@@ -641,6 +790,55 @@ DEFINE_HASHMAP(GtUword, ul, GtFeatureNode*, node, gt_ht_ul_elem_hash,
                gt_ht_ul_elem_cmp, NULL_DESTRUCTOR, NULL_DESTRUCTOR, static,
                inline)
 
+/* starts a transaction for the following insertions in bulk-load mode, if none
+   is open */
+static int bulk_load_begin(GtFeatureIndexGFFlike *fi, GtError *err)
+{
+  int had_err = 0;
+  gt_assert(fi);
+  if (fi->bulk_load_transactions && !fi->in_transaction) {
+    gt_rdb_stmt_reset(fi->stmts[GT_PSTMT_BEGIN_TRANSACTION], err);
+    if (gt_rdb_stmt_exec(fi->stmts[GT_PSTMT_BEGIN_TRANSACTION], err) < 0)
+      had_err = -1;
+    else
+      fi->in_transaction = true;
+  }
+  return had_err;
+}
+
+/* commits the transaction opened by <bulk_load_begin()> */
+static int bulk_load_commit(GtFeatureIndexGFFlike *fi, GtError *err)
+{
+  int had_err = 0;
+  gt_assert(fi);
+  if (fi->in_transaction) {
+    fi->in_transaction = false;
+    fi->bulk_load_nodes = 0;
+    gt_rdb_stmt_reset(fi->stmts[GT_PSTMT_COMMIT_TRANSACTION], err);
+    if (gt_rdb_stmt_exec(fi->stmts[GT_PSTMT_COMMIT_TRANSACTION], err) < 0)
+      had_err = -1;
+  }
+  return had_err;
+}
+
+int gt_feature_index_gfflike_finish_bulk_load(GtFeatureIndex *gfi,
+                                              GtError *err)
+{
+  GtFeatureIndexGFFlike *fi;
+  int had_err = 0;
+  gt_error_check(err);
+  fi = feature_index_gfflike_cast(gfi);
+  if (!fi->bulk_load)
+    return 0;
+  gt_mutex_lock(fi->dblock);
+  fi->bulk_load = false;
+  had_err = bulk_load_commit(fi, err);
+  if (!had_err)
+    had_err = gt_rdb_accept(fi->db, fi->index_visitor, err);
+  gt_mutex_unlock(fi->dblock);
+  return had_err;
+}
+
 int gt_feature_index_gfflike_add_region_node(GtFeatureIndex *gfi,
                                              GtRegionNode *rn,
                                              GtError *err)
@@ -653,6 +851,13 @@ int gt_feature_index_gfflike_add_region_node(GtFeatureIndex *gfi,
   gt_assert(fi && rn);
   seqid = gt_str_get(gt_genome_node_get_seqid((GtGenomeNode*) rn));
   rng = gt_genome_node_get_range((GtGenomeNode*) rn);
+  if (fi->bulk_load) {
+    gt_mutex_lock(fi->dblock);
+    had_err = bulk_load_begin(fi, err);
+    gt_mutex_unlock(fi->dblock);
+    if (had_err)
+      return had_err;
+  }
   gt_rdb_stmt_reset(fi->stmts[GT_PSTMT_SEQUENCEREGION_INSERT], err);
   gt_rdb_stmt_bind_string(fi->stmts[GT_PSTMT_SEQUENCEREGION_INSERT],
                           0, seqid, err);
@@ -867,6 +1072,8 @@ static int insert_single_node(GtFeatureIndexGFFlike *fi,
      multiple parents */
   node_ul_gt_hashmap_add(fi->cache_node2id, fn, *id);
   ul_node_gt_hashmap_add(fi->cache_id2node, *id, fn);
+  if (fi->in_transaction)
+    fi->bulk_load_nodes++;
 
   /* insert attributes */
   attribs = gt_feature_node_get_attribute_list(fn);
@@ -1022,12 +1229,25 @@ int gt_feature_index_gfflike_add_feature_node(GtFeatureIndex *gfi,
   gt_assert(gfi && gf);
 
   fi = feature_index_gfflike_cast(gfi);
+  if (fi->bulk_load) {
+    gt_mutex_lock(fi->dblock);
+    had_err = bulk_load_begin(fi, err);
+    gt_mutex_unlock(fi->dblock);
+    if (had_err)
+      return had_err;
+  }
   had_err = insert_feature_node(fi,
                                 (GtFeatureNode*)
                                          gt_genome_node_ref((GtGenomeNode*) gf),
                                 err);
   if (!had_err)
     gt_hashmap_add(fi->ref_nodes, gf, (void*) 1);
+  if (!had_err && fi->bulk_load &&
+      fi->bulk_load_nodes >= GT_ANNO_DB_GFFLIKE_BULK_LOAD_BATCH_SIZE) {
+    gt_mutex_lock(fi->dblock);
+    had_err = bulk_load_commit(fi, err);
+    gt_mutex_unlock(fi->dblock);
+  }
   return had_err;
 }
 
@@ -1254,6 +1474,11 @@ static int gt_feature_index_gfflike_save(GtFeatureIndex *fi,
   oci = (ObserverCallbackInfo*) fig->obs->data;
 
   gt_mutex_lock(fig->dblock);
+  /* transactions cannot be nested */
+  if (bulk_load_commit(fig, err)) {
+    gt_mutex_unlock(fig->dblock);
+    return -1;
+  }
   stmt_b = gt_rdb_prepare(fig->db, "BEGIN TRANSACTION;", 0, err);
   stmt_e = gt_rdb_prepare(fig->db, "END TRANSACTION;", 0, err);
   gt_rdb_stmt_exec(stmt_b, err);
@@ -1650,6 +1875,13 @@ void gt_feature_index_gfflike_delete(GtFeatureIndex *gfi)
   GtUword i;
   if (!gfi) return;
   fi = feature_index_gfflike_cast(gfi);
+  if (fi->bulk_load) {
+    /* keep the features loaded so far, like in the default mode */
+    GtError *err = gt_error_new();
+    (void) gt_feature_index_gfflike_finish_bulk_load(gfi, err);
+    gt_error_delete(err);
+  }
+  gt_rdb_visitor_delete(fi->index_visitor);
   for (i=0;i<GT_PSTMT_NOF_STATEMENTS;i++) {
     gt_rdb_stmt_delete(fi->stmts[i]);
   }
@@ -1920,6 +2152,18 @@ static int prepstmt_init(GtFeatureIndexGFFlike *fis, GtError *err)
                          2,
                          err);
   if (!r) return -1;
+  if (fis->bulk_load_transactions) {
+    r = fis->stmts[GT_PSTMT_BEGIN_TRANSACTION] = gt_rdb_prepare(fis->db,
+                          "BEGIN TRANSACTION",
+                           0,
+                           err);
+    if (!r) return -1;
+    r = fis->stmts[GT_PSTMT_COMMIT_TRANSACTION] = gt_rdb_prepare(fis->db,
+                          "COMMIT TRANSACTION",
+                           0,
+                           err);
+    if (!r) return -1;
+  }
   return 0;
 }
 
@@ -1936,6 +2180,7 @@ GtFeatureIndex* anno_db_gfflike_build(GtAnnoDBSchema *schema, GtRDB *db,
   GtFeatureIndex *fi = NULL;
   GtFeatureIndexGFFlike *fis;
   GtAnnoDBGFFlike *adg;
+  GFFlikeIndexVisitor *iv;
   ObserverCallbackInfo *oci;
   gt_assert(schema && db);
   gt_error_check(err);
@@ -1978,6 +2223,13 @@ GtFeatureIndex* anno_db_gfflike_build(GtAnnoDBSchema *schema, GtRDB *db,
     fis->obs->attribute_deleted = node_attribute_delete_callback;
     fis->obs->child_added = node_child_add_callback;
     fis->db = gt_rdb_ref(db);
+    fis->index_visitor = gt_rdb_visitor_create(gfflike_index_visitor_class());
+    iv = gfflike_index_visitor_cast(fis->index_visitor);
+    iv->saved_pragmas = adg->saved_pragmas;
+    fis->bulk_load = adg->bulk_load;
+    fis->bulk_load_transactions = adg->bulk_load && adg->bulk_load_transactions;
+    fis->in_transaction = false;
+    fis->bulk_load_nodes = 0;
 
     if (prepstmt_init(fis, err)) {
       gt_feature_index_delete(fi);
@@ -2014,6 +2266,20 @@ static const GtRDBVisitorClass* gfflike_setup_visitor_class()
   return svc;
 }
 
+static const GtRDBVisitorClass* gfflike_index_visitor_class()
+{
+  static const GtRDBVisitorClass *ivc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!ivc) {
+    ivc = gt_rdb_visitor_class_new(sizeof (GFFlikeIndexVisitor),
+                                   NULL,
+                                   anno_db_gfflike_create_indexes_visit_sqlite,
+                                   anno_db_gfflike_create_indexes_visit_mysql);
+  }
+  gt_class_alloc_lock_leave();
+  return ivc;
+}
+
 static GtRDBVisitor* gfflike_setup_visitor_new(GtAnnoDBGFFlike *adb)
 {
   GtRDBVisitor *v = gt_rdb_visitor_create(gfflike_setup_visitor_class());
@@ -2031,6 +2297,43 @@ GtAnnoDBSchema* gt_anno_db_gfflike_new(void)
   return s;
 }
 
+GtAnnoDBSchema* gt_anno_db_gfflike_new_bulk_load(void)
+{
+  GtAnnoDBSchema *s = gt_anno_db_gfflike_new();
+  GtAnnoDBGFFlike *adg = anno_db_gfflike_cast(s);
+  adg->bulk_load = true;
+  return s;
+}
+
+#ifdef HAVE_SQLITE
+/* appends the synchronous mode and the journal mode of <rdb> to <result> */
+static int anno_db_gfflike_get_pragmas_sqlite(GtRDB *rdb, GtStr *result,
+                                              GtError *err)
+{
+  static const char *queries[] = { "PRAGMA synchronous",
+                                   "PRAGMA journal_mode" };
+  GtRDBStmt *stmt;
+  GtStr *value = gt_str_new();
+  GtUword i;
+  int had_err = 0;
+  for (i = 0; !had_err && i < sizeof (queries) / sizeof (queries[0]); i++) {
+    if (!(stmt = gt_rdb_prepare(rdb, queries[i], 0, err)) ||
+        gt_rdb_stmt_exec(stmt, err) != 0 ||
+        gt_rdb_stmt_get_string(stmt, 0, value, err)) {
+      had_err = -1;
+    }
+    else {
+      if (i > 0)
+        gt_str_append_char(result, ' ');
+      gt_str_append_str(result, value);
+    }
+    gt_rdb_stmt_delete(stmt);
+  }
+  gt_str_delete(value);
+  return had_err;
+}
+#endif
+
 int gt_anno_db_gfflike_unit_test(GtError *err)
 {
   int had_err = 0, status = 0;
@@ -2070,6 +2373,41 @@ int gt_anno_db_gfflike_unit_test(GtError *err)
     gt_ensure(status == 0);
   }
 
+#ifdef HAVE_SQLITE
+  if (!had_err) {
+    /* the connection settings are restored after a bulk load */
+    GtStr *before = gt_str_new(), *during = gt_str_new(),
+          *after = gt_str_new();
+    gt_feature_index_delete(fi);
+    gt_anno_db_schema_delete(adb);
+    fi = NULL;
+    adb = gt_anno_db_gfflike_new_bulk_load();
+    status = anno_db_gfflike_get_pragmas_sqlite(rdb, before, testerr);
+    gt_ensure(status == 0);
+    if (!had_err) {
+      fi = gt_anno_db_schema_get_feature_index(adb, rdb, testerr);
+      gt_ensure(fi != NULL);
+    }
+    if (!had_err) {
+      status = anno_db_gfflike_get_pragmas_sqlite(rdb, during, testerr);
+      gt_ensure(status == 0);
+      gt_ensure(strcmp(gt_str_get(during), "0 memory") == 0);
+    }
+    if (!had_err) {
+      status = gt_feature_index_gfflike_finish_bulk_load(fi, testerr);
+      gt_ensure(status == 0);
+    }
+    if (!had_err) {
+      status = anno_db_gfflike_get_pragmas_sqlite(rdb, after, testerr);
+      gt_ensure(status == 0);
+      gt_ensure(gt_str_cmp(before, after) == 0);
+    }
+    gt_str_delete(before);
+    gt_str_delete(during);
+    gt_str_delete(after);
+  }
+#endif
+
   gt_xremove(gt_str_get(tmpfilename));
   gt_str_delete(tmpfilename);
   gt_feature_index_delete(fi);
@@ -29,6 +29,21 @@ typedef struct GtAnnoDBGFFlike GtAnnoDBGFFlike;
 /* Creates a new <GtAnnoDBGFFlike> schema object. */
 GtAnnoDBSchema* gt_anno_db_gfflike_new(void);
 
+/* Creates a new <GtAnnoDBGFFlike> schema object for loading large amounts of
+   annotations. The feature indexes retrieved from it insert the features in
+   large transactions and create the secondary indexes of the database only in
+   <gt_feature_index_gfflike_finish_bulk_load()> (or when they are deleted). */
+GtAnnoDBSchema* gt_anno_db_gfflike_new_bulk_load(void);
+
+/* Commits the features added to <gfi> in bulk-load mode, restores the
+   connection settings changed for the load (e.g. the synchronous mode and
+   the journal of SQLite) and creates the secondary indexes of the database.
+   Afterwards, features are inserted one by one again. Does nothing if <gfi>
+   is not in bulk-load mode. Returns 0 on success, a negative value otherwise.
+   The message in <err> is set accordingly. */
+int             gt_feature_index_gfflike_finish_bulk_load(GtFeatureIndex *gfi,
+                                                          GtError *err);
+
 /* Retrieves all features contained in <gfi> into <results>. Returns 0 on
    success, a negative value otherwise. The message in <err> is set
    accordingly. */
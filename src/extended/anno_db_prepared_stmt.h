@@ -51,6 +51,8 @@ enum GtAnnoDBPreparedStmt {
   GT_PSTMT_NODE_DELETE_ATTRIB,
   GT_PSTMT_NODE_DELETE_ATTRIB_FOR_NODE,
   GT_PSTMT_NODE_ADD_CHILD,
+  GT_PSTMT_BEGIN_TRANSACTION,
+  GT_PSTMT_COMMIT_TRANSACTION,
   GT_PSTMT_NOF_STATEMENTS
 };
 
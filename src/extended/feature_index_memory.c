@@ -24,6 +24,7 @@
 #include "core/cstr_api.h"
 #include "core/ensure.h"
 #include "core/hashmap.h"
+#include "core/interval_index.h"
 #include "core/interval_tree.h"
 #include "core/ma.h"
 #include "core/minmax.h"
@@ -52,6 +53,7 @@ struct GtFeatureIndexMemory {
 
 typedef struct {
   GtIntervalTree *features;
+  GtIntervalIndex *compact_features; /* read-only copy of <features> */
   GtRegionNode *region;
   GtRange dyn_range;
 } RegionInfo;
@@ -59,6 +61,7 @@ typedef struct {
 static void region_info_delete(RegionInfo *info)
 {
   gt_interval_tree_delete(info->features);
+  gt_interval_index_delete(info->compact_features);
   if (info->region)
     gt_genome_node_delete((GtGenomeNode*)info->region);
   gt_free(info);
@@ -128,6 +131,8 @@ int gt_feature_index_memory_add_feature_node(GtFeatureIndex *gfi,
   /* add node to the appropriate array in the hashtable */
   new_node = gt_interval_tree_node_new(gn, node_range.start, node_range.end);
   gt_interval_tree_insert(info->features, new_node);
+  gt_interval_index_delete(info->compact_features);
+  info->compact_features = NULL;
   /* update dynamic range */
   info->dyn_range.start = MIN(info->dyn_range.start, node_range.start);
   info->dyn_range.end = MAX(info->dyn_range.end, node_range.end);
@@ -178,8 +183,11 @@ int gt_feature_index_memory_remove_node(GtFeatureIndex *gfi,
                                    node_range.end,
                                    &info);
 
-  if (info.node)
+  if (info.node) {
     gt_interval_tree_remove(rinfo->features, info.node);
+    gt_interval_index_delete(rinfo->compact_features);
+    rinfo->compact_features = NULL;
+  }
   return 0;
 }
 
@@ -228,6 +236,7 @@ int gt_feature_index_memory_get_features_for_range(GtFeatureIndex *gfi,
 {
   RegionInfo *ri;
   GtFeatureIndexMemory *fi;
+  bool sorted = false;
   gt_error_check(err);
   gt_assert(gfi && results);
 
@@ -237,12 +246,59 @@ int gt_feature_index_memory_get_features_for_range(GtFeatureIndex *gfi,
     gt_error_set(err, "feature index does not contain the given sequence id");
     return -1;
   }
-  gt_interval_tree_find_all_overlapping(ri->features, qry_range->start,
-                                        qry_range->end, results);
-  gt_array_sort(results, gt_genome_node_cmp_range_start);
+  if (ri->compact_features) {
+    /* the compact index reports the features sorted by range already */
+    sorted = !gt_array_size(results);
+    gt_interval_index_find_all_overlapping(ri->compact_features,
+                                           qry_range->start, qry_range->end,
+                                           results);
+  }
+  else {
+    gt_interval_tree_find_all_overlapping(ri->features, qry_range->start,
+                                          qry_range->end, results);
+  }
+  if (!sorted)
+    gt_array_sort(results, gt_genome_node_cmp_range_start);
+  return 0;
+}
+
+static int add_feature_to_interval_index(GtIntervalTreeNode *node,
+                                         void *data)
+{
+  GtIntervalIndex *interval_index = (GtIntervalIndex*) data;
+  GtGenomeNode *gn = (GtGenomeNode*) gt_interval_tree_node_get_data(node);
+  GtRange range = gt_genome_node_get_range(gn);
+  gt_interval_index_add(interval_index, gn, range.start, range.end);
+  return 0;
+}
+
+static int compact_region(GT_UNUSED void *key, void *value,
+                          GT_UNUSED void *data, GT_UNUSED GtError *err)
+{
+  RegionInfo *info = (RegionInfo*) value;
+  GT_UNUSED int had_err;
+  gt_assert(info);
+  if (!info->compact_features) {
+    info->compact_features = gt_interval_index_new();
+    had_err = gt_interval_tree_traverse(info->features,
+                                        add_feature_to_interval_index,
+                                        info->compact_features);
+    gt_assert(!had_err); /* add_feature_to_interval_index() is sane */
+    gt_interval_index_prepare(info->compact_features);
+  }
   return 0;
 }
 
+void gt_feature_index_memory_compact(GtFeatureIndex *gfi)
+{
+  GtFeatureIndexMemory *fi;
+  GT_UNUSED int had_err;
+  gt_assert(gfi);
+  fi = gt_feature_index_memory_cast(gfi);
+  had_err = gt_hashmap_foreach(fi->regions, compact_region, NULL, NULL);
+  gt_assert(!had_err); /* compact_region() is sane */
+}
+
 GtFeatureNode*  gt_feature_index_memory_get_node_by_ptr(GtFeatureIndexMemory
                                                                           *fim,
                                                         GtFeatureNode *ptr,
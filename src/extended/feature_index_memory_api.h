@@ -35,4 +35,11 @@ GtFeatureNode*  gt_feature_index_memory_get_node_by_ptr(GtFeatureIndexMemory*,
                                                         GtFeatureNode *ptr,
                                                         GtError *err);
 
+/* Builds a read-optimized copy of the interval trees of <feature_index>, a
+   <GtFeatureIndexMemory>, in which the features of each region node are
+   stored in a single array sorted by position. Subsequent range queries use
+   it instead of the interval trees. Call it once after all features have been
+   added, adding or removing features discards the compact index again. */
+void            gt_feature_index_memory_compact(GtFeatureIndex *feature_index);
+
 #endif
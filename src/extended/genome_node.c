@@ -17,6 +17,7 @@
 
 #include <stdarg.h>
 #include "core/assert_api.h"
+#include "core/atomic.h"
 #include "core/class_alloc.h"
 #include "core/cstr_api.h"
 #include "core/ensure.h"
@@ -40,9 +41,7 @@ typedef struct {
 GtGenomeNode* gt_genome_node_ref(GtGenomeNode *gn)
 {
   gt_assert(gn);
-  gt_rwlock_wrlock(gn->lock);
-  gn->reference_count++;
-  gt_rwlock_unlock(gn->lock);
+  gt_atomic_uint_inc(&gn->reference_count);
   return gn;
 }
 
@@ -189,9 +188,6 @@ GtGenomeNode* gt_genome_node_create(const GtGenomeNodeClass *gnc)
   gn->reference_count    = 0;
   gn->userdata           = NULL;
   gn->userdata_nof_items = 0;
-#ifdef GT_THREADS_ENABLED
-  gn-> lock              = gt_rwlock_new();
-#endif
   return gn;
 }
 
@@ -469,21 +465,15 @@ int gt_genome_node_unit_test(GtError *err)
 void gt_genome_node_delete(GtGenomeNode *gn)
 {
   if (!gn) return;
-  gt_rwlock_wrlock(gn->lock);
-  if (gn->reference_count) {
-    gn->reference_count--;
-    gt_rwlock_unlock(gn->lock);
+  /* the reference count is decremented atomically, only the thread which
+     releases the last reference sees the previous value 0 and frees <gn> */
+  if (gt_atomic_uint_fetch_dec(&gn->reference_count))
     return;
-  }
   gt_assert(gn->c_class);
   if (gn->c_class->free)
     gn->c_class->free(gn);
   gt_str_delete(gn->filename);
   if (gn->userdata)
     gt_hashmap_delete(gn->userdata);
-  gt_rwlock_unlock(gn->lock);
-#ifdef GT_THREADS_ENABLED
-  gt_rwlock_delete(gn->lock);
-#endif
   gt_free(gn);
 }
@@ -21,7 +21,6 @@
 #include <stdio.h>
 #include "core/dlist.h"
 #include "core/hashmap.h"
-#include "core/thread_api.h"
 #include "extended/genome_node.h"
 
 typedef void    (*GtGenomeNodeFreeFunc)(GtGenomeNode*);
@@ -52,11 +51,9 @@ struct GtGenomeNode
   const GtGenomeNodeClass *c_class;
   GtStr *filename;
   GtHashmap *userdata; /* created on demand */
-  /* GtGenomeNodes are very space critical, therefore we can justify a bit
-     ifdef-hell here... */
-#ifdef GT_THREADS_ENABLED
-  GtRWLock *lock;
-#endif
+  /* GtGenomeNodes are very space critical, therefore the reference count is
+     modified with the atomic operations from core/atomic.h instead of being
+     protected by a lock per node */
   unsigned int line_number,
                reference_count,
                userdata_nof_items;
@@ -16,18 +16,102 @@
 */
 
 #include <string.h>
+#include "core/array_api.h"
 #include "core/assert_api.h"
 #include "core/class_alloc_lock.h"
+#include "core/cstr_api.h"
 #include "core/cstr_table.h"
+#include "core/dynalloc.h"
+#include "core/file.h"
 #include "core/fileutils_api.h"
+#include "core/ma.h"
 #include "core/queue.h"
 #include "core/progressbar.h"
 #include "core/str_array.h"
+#include "core/thread_api.h"
+#include "extended/eof_node_api.h"
 #include "extended/genome_node.h"
+#include "extended/gff3_defines.h"
 #include "extended/gff3_in_stream_plain.h"
 #include "extended/gff3_parser.h"
 #include "extended/node_stream_api.h"
 
+/* If more than one job is available, a file is parsed by a pipeline: A reader
+   thread splits the file into blocks which end with a terminator line
+   ("###") and have a length of at least <GT_GFF3_PIPELINE_BLOCKSIZE>
+   characters. <gt_jobs> worker threads parse the blocks with their own
+   parsers. This works because a terminator completes all features parsed
+   before it. The only state which is passed from one block to the next are
+   the sequence regions (the lines defining them are collected by the reader
+   and registered with the parsers of the workers) and the GVF mode.
+   The workers record how many nodes each call of their parser created, and
+   the stream replays these calls in the order of the blocks into its node
+   buffer. Thus, the stream delivers the same nodes as in sequential parsing,
+   also if the file is not sorted or contains an error.
+   At the beginning of FASTA sequences or if no terminator has been found within
+   <GT_GFF3_PIPELINE_MAXBLOCKSIZE> characters, the remainder of the file is
+   parsed sequentially. */
+#define GT_GFF3_PIPELINE_BLOCKSIZE    ((size_t) 1 << 18)
+#define GT_GFF3_PIPELINE_MAXBLOCKSIZE ((size_t) 1 << 26)
+#define GT_GFF3_PIPELINE_BLOCKSPERJOB 4
+
+typedef enum {
+  GT_GFF3_BLOCK_FREE,
+  GT_GFF3_BLOCK_READ,
+  GT_GFF3_BLOCK_PARSED
+} GtGFF3BlockState;
+
+typedef struct {
+  GtGFF3BlockState state;
+  char *text;
+  size_t length,
+         allocated;
+  GtUint64 line_number; /* number of lines before the block */
+  GtUword num_of_regions, /* number of sequence regions before the block */
+          next_node,
+          next_call;
+  bool gvf_mode, /* a GVF version pragma occurred before the block */
+       last, /* the block ends the file */
+       tail; /* the rest of the file is parsed sequentially */
+  GtArray *nodes,
+          *calls; /* number of nodes created by each call of the parser */
+  GtError *err;
+  int had_err;
+} GtGFF3Block;
+
+typedef struct {
+  char *line;
+  unsigned int line_number;
+} GtGFF3RegionLine;
+
+typedef struct {
+  GtGFF3Parser *parser;
+  GtCstrTable *used_types;
+  GtUword num_of_regions; /* number of sequence regions known to <parser> */
+} GtGFF3Worker;
+
+typedef struct {
+  GtFile *fpin; /* read by the reader thread */
+  GtStr *filenamestr;
+  GtGFF3Block *blocks;
+  GtUword num_of_blocks, /* the blocks are used as a ring buffer */
+          next_read, /* the following numbers count all blocks of the file */
+          next_parse,
+          next_deliver,
+          next_worker;
+  GtArray *region_lines;
+  GtGFF3Worker *workers;
+  GtThread *reader,
+           **threads;
+  GtMutex *mutex;
+  GtCond *block_free,
+         *block_read,
+         *block_parsed;
+  bool gvf_mode,
+       reader_done,
+       abort;
+} GtGFF3Pipeline;
+
 struct GtGFF3InStreamPlain {
   const GtNodeStream parent_instance;
   GtUword next_file;
@@ -37,12 +121,16 @@ struct GtGFF3InStreamPlain {
        stdin_argument,
        stdin_processed,
        file_is_open,
-       progress_bar;
+       progress_bar,
+       gvf_mode, /* a GVF version pragma has been read by a pipeline */
+       sequential; /* the remaining files are parsed sequentially */
   GtFile *fpin;
   GtUint64 line_number;
   GtQueue *genome_node_buffer;
   GtGFF3Parser *gff3_parser;
   GtCstrTable *used_types;
+  GtGFF3Worker *workers;
+  GtGFF3Pipeline *pipeline;
 };
 
 #define gff3_in_stream_plain_cast(NS)\
@@ -71,6 +159,460 @@ static int buffer_is_sorted(void **elem, void *info, GtError *err)
   return 0;
 }
 
+static void gff3_block_parse(GtGFF3Block *block, GtGFF3Worker *worker,
+                             GtStr *filenamestr)
+{
+  GtQueue *genome_nodes;
+  GtGenomeNode *sentinel = NULL;
+  GtFile *fpin;
+  GtUint64 line_number = block->line_number;
+  GtUword num_of_nodes;
+  bool eof = false;
+  int status_code;
+
+  if (block->gvf_mode)
+    gt_gff3_parser_enable_gvf_mode(worker->parser);
+  gt_gff3_parser_rearm_eof_node(worker->parser);
+  genome_nodes = gt_queue_new();
+  /* after the first call, the node buffer of the stream is never empty when
+     the parser is called, which determines where the parser returns. A
+     sentinel node makes the calls of the worker end at the same lines. */
+  if (block->line_number) {
+    sentinel = gt_eof_node_new();
+    gt_queue_add(genome_nodes, sentinel);
+  }
+  fpin = gt_file_new_from_buffer(block->text, block->length, NULL);
+  block->text = NULL;
+  block->allocated = 0;
+  do {
+    block->had_err = gt_gff3_parser_parse_genome_nodes(worker->parser,
+                                                       &status_code,
+                                                       genome_nodes,
+                                                       worker->used_types,
+                                                       filenamestr,
+                                                       &line_number, fpin,
+                                                       block->err);
+    if (block->had_err) {
+      /* the parser has deleted all nodes, including the sentinel */
+      break;
+    }
+    num_of_nodes = 0;
+    while (gt_queue_size(genome_nodes)) {
+      GtGenomeNode *gn = gt_queue_get(genome_nodes);
+      if (gn == sentinel)
+        continue;
+      if (gt_eof_node_try_cast(gn)) {
+        eof = true;
+        /* the parser sees the end of each block, but only the end of the last
+           one is the end of the file */
+        if (!block->last) {
+          gt_genome_node_delete(gn);
+          continue;
+        }
+      }
+      gt_array_add(block->nodes, gn);
+      num_of_nodes++;
+    }
+    if (eof && !block->last && gt_array_size(block->calls)) {
+      /* the final call of an inner block only sees the end of the block,
+         in sequential parsing it does not exist */
+      *(GtUword*) gt_array_get_last(block->calls) += num_of_nodes;
+    }
+    else
+      gt_array_add(block->calls, num_of_nodes);
+    if (!sentinel)
+      sentinel = gt_eof_node_new();
+    gt_queue_add(genome_nodes, sentinel);
+  } while (!eof);
+  if (!block->had_err)
+    gt_genome_node_delete(gt_queue_get(genome_nodes));
+  gt_assert(!gt_queue_size(genome_nodes));
+  gt_file_delete(fpin);
+  gt_queue_delete(genome_nodes);
+}
+
+static void* gff3_pipeline_worker(void *data)
+{
+  GtGFF3Pipeline *pipeline = data;
+  GtGFF3Worker *worker;
+  GtGFF3Block *block;
+
+  gt_mutex_lock(pipeline->mutex);
+  worker = pipeline->workers + pipeline->next_worker++;
+  for (;;) {
+    GtUword i;
+    while (!pipeline->abort && pipeline->next_parse == pipeline->next_read &&
+           !pipeline->reader_done) {
+      gt_cond_wait(pipeline->block_read, pipeline->mutex);
+    }
+    if (pipeline->abort || pipeline->next_parse == pipeline->next_read)
+      break;
+    block = pipeline->blocks + pipeline->next_parse++ %
+                                                      pipeline->num_of_blocks;
+    gt_assert(block->state == GT_GFF3_BLOCK_READ);
+    /* the blocks are taken in increasing order, so the sequence regions
+       defined before the current block can be registered incrementally */
+    for (i = worker->num_of_regions; i < block->num_of_regions; i++) {
+      GtGFF3RegionLine region = *(GtGFF3RegionLine*)
+                                 gt_array_get(pipeline->region_lines, i);
+      gt_mutex_unlock(pipeline->mutex);
+      gt_gff3_parser_register_sequence_region(worker->parser, region.line,
+                                              region.line_number,
+                                              pipeline->filenamestr);
+      gt_mutex_lock(pipeline->mutex);
+    }
+    worker->num_of_regions = block->num_of_regions;
+    gt_mutex_unlock(pipeline->mutex);
+    if (!block->tail) {
+      gff3_block_parse(block, worker, pipeline->filenamestr);
+    }
+    if (block->had_err) {
+      /* the parser may be left with incomplete features, start over with
+         the next block */
+      gt_gff3_parser_reset(worker->parser);
+      worker->num_of_regions = 0;
+    }
+    gt_mutex_lock(pipeline->mutex);
+    block->state = GT_GFF3_BLOCK_PARSED;
+    gt_cond_broadcast(pipeline->block_parsed);
+  }
+  gt_mutex_unlock(pipeline->mutex);
+  return NULL;
+}
+
+static GtGFF3Block* gff3_pipeline_next_free_block(GtGFF3Pipeline *pipeline,
+                                                  GtUint64 line_number,
+                                                  GtUword num_of_regions,
+                                                  bool gvf_mode)
+{
+  GtGFF3Block *block;
+  bool abort;
+  gt_mutex_lock(pipeline->mutex);
+  block = pipeline->blocks + pipeline->next_read % pipeline->num_of_blocks;
+  while (!pipeline->abort && block->state != GT_GFF3_BLOCK_FREE)
+    gt_cond_wait(pipeline->block_free, pipeline->mutex);
+  abort = pipeline->abort;
+  gt_mutex_unlock(pipeline->mutex);
+  if (abort)
+    return NULL;
+  block->length = 0;
+  block->line_number = line_number;
+  block->num_of_regions = num_of_regions;
+  block->gvf_mode = gvf_mode;
+  block->last = block->tail = false;
+  block->next_node = block->next_call = 0;
+  block->had_err = 0;
+  gt_error_unset(block->err);
+  return block;
+}
+
+static void gff3_pipeline_publish_block(GtGFF3Pipeline *pipeline,
+                                        GtGFF3Block *block)
+{
+  gt_mutex_lock(pipeline->mutex);
+  block->state = GT_GFF3_BLOCK_READ;
+  pipeline->next_read++;
+  if (block->last || block->tail)
+    pipeline->reader_done = true;
+  gt_cond_broadcast(pipeline->block_read);
+  gt_mutex_unlock(pipeline->mutex);
+}
+
+static void gff3_block_append_line(GtGFF3Block *block, const char *line,
+                                   GtUword line_length)
+{
+  if (block->length + line_length + 1 > block->allocated) {
+    block->text = gt_dynalloc(block->text, &block->allocated,
+                              block->length + line_length + 1);
+  }
+  memcpy(block->text + block->length, line, line_length);
+  block->length += line_length;
+  block->text[block->length++] = '\n';
+}
+
+static void* gff3_pipeline_reader(void *data)
+{
+  GtGFF3Pipeline *pipeline = data;
+  GtGFF3Block *block;
+  GtUint64 line_number = 0;
+  GtUword line_length, num_of_regions = 0;
+  char *line;
+  bool gvf_mode = pipeline->gvf_mode;
+
+  block = gff3_pipeline_next_free_block(pipeline, line_number, num_of_regions,
+                                        gvf_mode);
+  while (block && gt_file_xread_line(pipeline->fpin, &line, &line_length)
+                  != EOF) {
+    line_number++;
+    gff3_block_append_line(block, line, line_length);
+    if (line[0] == '>' || strcmp(line, GT_GFF_FASTA_DIRECTIVE) == 0 ||
+        block->length >= GT_GFF3_PIPELINE_MAXBLOCKSIZE) {
+      /* the consumer continues with the remaining file */
+      block->tail = true;
+      break;
+    }
+    if (line[0] != '#' || line_length < 2 || line[1] != '#')
+      continue;
+    if (strncmp(line, GT_GFF_SEQUENCE_REGION,
+                strlen(GT_GFF_SEQUENCE_REGION)) == 0) {
+      GtGFF3RegionLine region;
+      region.line = gt_cstr_dup(line);
+      region.line_number = (unsigned int) line_number;
+      gt_mutex_lock(pipeline->mutex);
+      gt_array_add(pipeline->region_lines, region);
+      gt_mutex_unlock(pipeline->mutex);
+      num_of_regions++;
+    }
+    else if (strncmp(line, GT_GVF_VERSION_PREFIX,
+                     strlen(GT_GVF_VERSION_PREFIX)) == 0) {
+      gvf_mode = true;
+    }
+    else if (strncmp(line, GT_GFF_TERMINATOR,
+                     strlen(GT_GFF_TERMINATOR)) == 0 &&
+             block->length >= GT_GFF3_PIPELINE_BLOCKSIZE) {
+      gff3_pipeline_publish_block(pipeline, block);
+      block = gff3_pipeline_next_free_block(pipeline, line_number,
+                                            num_of_regions, gvf_mode);
+    }
+  }
+  if (block) {
+    if (!block->tail)
+      block->last = true;
+    gff3_pipeline_publish_block(pipeline, block);
+  }
+  pipeline->gvf_mode = gvf_mode;
+  return NULL;
+}
+
+static void gff3_pipeline_delete(GtGFF3Pipeline *pipeline)
+{
+  GtUword i, j;
+  if (!pipeline) return;
+  gt_mutex_lock(pipeline->mutex);
+  pipeline->abort = true;
+  gt_cond_broadcast(pipeline->block_free);
+  gt_cond_broadcast(pipeline->block_read);
+  gt_mutex_unlock(pipeline->mutex);
+  if (pipeline->reader) {
+    gt_thread_join(pipeline->reader);
+    gt_thread_delete(pipeline->reader);
+  }
+  for (i = 0; i < gt_jobs && pipeline->threads[i]; i++) {
+    gt_thread_join(pipeline->threads[i]);
+    gt_thread_delete(pipeline->threads[i]);
+  }
+  gt_free(pipeline->threads);
+  for (i = 0; i < pipeline->num_of_blocks; i++) {
+    GtGFF3Block *block = pipeline->blocks + i;
+    for (j = block->next_node; j < gt_array_size(block->nodes); j++)
+      gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(block->nodes, j));
+    gt_array_delete(block->nodes);
+    gt_array_delete(block->calls);
+    gt_error_delete(block->err);
+    gt_free(block->text);
+  }
+  gt_free(pipeline->blocks);
+  for (i = 0; i < gt_array_size(pipeline->region_lines); i++)
+    gt_free(((GtGFF3RegionLine*) gt_array_get(pipeline->region_lines, i))
+            ->line);
+  gt_array_delete(pipeline->region_lines);
+  gt_cond_delete(pipeline->block_free);
+  gt_cond_delete(pipeline->block_read);
+  gt_cond_delete(pipeline->block_parsed);
+  gt_mutex_delete(pipeline->mutex);
+  gt_file_delete(pipeline->fpin);
+  gt_free(pipeline);
+}
+
+/* Start a pipeline which parses <fpin> (taking ownership). */
+static GtGFF3Pipeline* gff3_pipeline_new(GtGFF3InStreamPlain *is, GtFile *fpin,
+                                         GtStr *filenamestr, GtError *err)
+{
+  GtGFF3Pipeline *pipeline;
+  GtUword i;
+  int had_err = 0;
+
+  gt_error_check(err);
+  if (!is->workers) {
+    /* the settings of the stream are complete when the first file is
+       parsed */
+    is->workers = gt_malloc(sizeof (GtGFF3Worker) * gt_jobs);
+    for (i = 0; i < gt_jobs; i++) {
+      is->workers[i].parser = gt_gff3_parser_new_like(is->gff3_parser);
+      is->workers[i].used_types = gt_cstr_table_new();
+    }
+  }
+  for (i = 0; i < gt_jobs; i++) {
+    gt_gff3_parser_reset(is->workers[i].parser);
+    is->workers[i].num_of_regions = 0;
+  }
+  pipeline = gt_calloc(1, sizeof *pipeline);
+  pipeline->fpin = fpin;
+  pipeline->filenamestr = filenamestr;
+  pipeline->gvf_mode = is->gvf_mode;
+  pipeline->workers = is->workers;
+  pipeline->num_of_blocks = GT_GFF3_PIPELINE_BLOCKSPERJOB * gt_jobs;
+  pipeline->blocks = gt_calloc(pipeline->num_of_blocks,
+                               sizeof *pipeline->blocks);
+  for (i = 0; i < pipeline->num_of_blocks; i++) {
+    pipeline->blocks[i].nodes = gt_array_new(sizeof (GtGenomeNode*));
+    pipeline->blocks[i].calls = gt_array_new(sizeof (GtUword));
+    pipeline->blocks[i].err = gt_error_new();
+  }
+  pipeline->region_lines = gt_array_new(sizeof (GtGFF3RegionLine));
+  pipeline->mutex = gt_mutex_new();
+  pipeline->block_free = gt_cond_new();
+  pipeline->block_read = gt_cond_new();
+  pipeline->block_parsed = gt_cond_new();
+  pipeline->threads = gt_calloc(gt_jobs, sizeof (GtThread*));
+  for (i = 0; !had_err && i < gt_jobs; i++) {
+    if (!(pipeline->threads[i] = gt_thread_new(gff3_pipeline_worker, pipeline,
+                                               err))) {
+      had_err = -1;
+    }
+  }
+  if (!had_err && !(pipeline->reader = gt_thread_new(gff3_pipeline_reader,
+                                                     pipeline, err))) {
+    had_err = -1;
+  }
+  if (had_err) {
+    gff3_pipeline_delete(pipeline);
+    return NULL;
+  }
+  return pipeline;
+}
+
+static bool gff3_in_stream_plain_use_pipeline(GtGFF3InStreamPlain *is)
+{
+#ifdef GT_THREADS_ENABLED
+  return gt_jobs > 1 && !is->sequential && !is->progress_bar &&
+         gt_gff3_parser_terminators_separate_state(is->gff3_parser);
+#else
+  return false;
+#endif
+}
+
+static void gff3_in_stream_plain_end_pipeline(GtGFF3InStreamPlain *is)
+{
+  GtGFF3Pipeline *pipeline = is->pipeline;
+  gt_assert(pipeline && pipeline->reader_done);
+  gt_thread_join(pipeline->reader);
+  gt_thread_delete(pipeline->reader);
+  pipeline->reader = NULL;
+  is->gvf_mode = pipeline->gvf_mode;
+  gff3_pipeline_delete(pipeline);
+  is->pipeline = NULL;
+}
+
+/* Switch to sequential parsing for the remainder of the current file, which
+   starts with the <tail> block. */
+static void gff3_in_stream_plain_parse_tail(GtGFF3InStreamPlain *is,
+                                            GtGFF3Block *tail)
+{
+  GtGFF3Pipeline *pipeline = is->pipeline;
+  GtUword i;
+  gt_assert(tail->tail);
+  gt_thread_join(pipeline->reader);
+  gt_thread_delete(pipeline->reader);
+  pipeline->reader = NULL;
+  for (i = 0; i < tail->num_of_regions; i++) {
+    GtGFF3RegionLine *region = gt_array_get(pipeline->region_lines, i);
+    gt_gff3_parser_register_sequence_region(is->gff3_parser, region->line,
+                                            region->line_number,
+                                            pipeline->filenamestr);
+  }
+  if (tail->gvf_mode)
+    gt_gff3_parser_enable_gvf_mode(is->gff3_parser);
+  is->fpin = gt_file_new_from_buffer(tail->text, tail->length, pipeline->fpin);
+  is->line_number = tail->line_number;
+  tail->text = NULL;
+  pipeline->fpin = NULL;
+  /* the parser of the stream carries the state of the sequentially parsed
+     part, the following files are parsed sequentially, too */
+  is->sequential = true;
+  gff3_pipeline_delete(pipeline);
+  is->pipeline = NULL;
+}
+
+/* Replay the next call of a worker parser: The nodes it created are added to
+   the node buffer of <is>, and <*status_code> is set as by
+   gt_gff3_parser_parse_genome_nodes(). Returns 1 if the rest of the file has
+   to be parsed sequentially. */
+static int gff3_in_stream_plain_parse_from_pipeline(GtGFF3InStreamPlain *is,
+                                                    int *status_code,
+                                                    GtError *err)
+{
+  GtGFF3Pipeline *pipeline = is->pipeline;
+  GtGFF3Block *block;
+  GtUword i, num_of_nodes;
+
+  gt_error_check(err);
+  for (;;) {
+    block = pipeline->blocks + pipeline->next_deliver %
+                                                      pipeline->num_of_blocks;
+    gt_mutex_lock(pipeline->mutex);
+    while (block->state != GT_GFF3_BLOCK_PARSED)
+      gt_cond_wait(pipeline->block_parsed, pipeline->mutex);
+    gt_mutex_unlock(pipeline->mutex);
+    if (block->tail) {
+      gff3_in_stream_plain_parse_tail(is, block);
+      return 1;
+    }
+    if (block->next_call < gt_array_size(block->calls)) {
+      num_of_nodes = *(GtUword*) gt_array_get(block->calls, block->next_call++);
+      for (i = 0; i < num_of_nodes; i++) {
+        gt_queue_add(is->genome_node_buffer,
+                     *(GtGenomeNode**) gt_array_get(block->nodes,
+                                                    block->next_node++));
+      }
+      *status_code = gt_queue_size(is->genome_node_buffer) ? 0 : EOF;
+      return 0;
+    }
+    if (block->had_err) {
+      /* the parser discards the buffered nodes in case of an error */
+      while (gt_queue_size(is->genome_node_buffer))
+        gt_genome_node_delete(gt_queue_get(is->genome_node_buffer));
+      gt_error_set(err, "%s", gt_error_get(block->err));
+      return -1;
+    }
+    if (block->last) {
+      /* further calls after the end of the file */
+      if (gt_queue_size(is->genome_node_buffer))
+        *status_code = 0;
+      else {
+        gff3_in_stream_plain_end_pipeline(is);
+        *status_code = EOF;
+      }
+      return 0;
+    }
+    /* all calls of the block have been replayed */
+    gt_array_reset(block->nodes);
+    gt_array_reset(block->calls);
+    block->next_node = block->next_call = 0;
+    gt_mutex_lock(pipeline->mutex);
+    block->state = GT_GFF3_BLOCK_FREE;
+    pipeline->next_deliver++;
+    gt_cond_signal(pipeline->block_free);
+    gt_mutex_unlock(pipeline->mutex);
+  }
+}
+
+static int gff3_in_stream_plain_parse(GtGFF3InStreamPlain *is,
+                                      int *status_code, GtStr *filenamestr,
+                                      GtError *err)
+{
+  gt_error_check(err);
+  if (is->pipeline) {
+    int rval = gff3_in_stream_plain_parse_from_pipeline(is, status_code, err);
+    if (rval != 1)
+      return rval;
+  }
+  return gt_gff3_parser_parse_genome_nodes(is->gff3_parser, status_code,
+                                           is->genome_node_buffer,
+                                           is->used_types, filenamestr,
+                                           &is->line_number, is->fpin, err);
+}
+
 static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
                                      GtError *err)
 {
@@ -131,6 +673,21 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
                             gt_file_number_of_lines(gt_str_array_get(is->files,
                                                              is->next_file-1)));
       }
+      if (gff3_in_stream_plain_use_pipeline(is)) {
+        filenamestr = gt_str_array_size(is->files)
+                      ? gt_str_array_get_str(is->files, is->next_file-1)
+                      : is->stdinstr;
+        is->pipeline = gff3_pipeline_new(is, is->fpin
+                                             ? is->fpin
+                                             : gt_file_xopen(NULL, "r"),
+                                         filenamestr, err);
+        is->fpin = NULL;
+        if (!is->pipeline) {
+          had_err = -1;
+          break;
+        }
+        continue;
+      }
     }
 
     gt_assert(is->file_is_open);
@@ -139,19 +696,11 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
                   ? gt_str_array_get_str(is->files, is->next_file-1)
                   : is->stdinstr;
     /* read two nodes */
-    had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser, &status_code,
-                                                is->genome_node_buffer,
-                                                is->used_types, filenamestr,
-                                                &is->line_number, is->fpin,
-                                                err);
+    had_err = gff3_in_stream_plain_parse(is, &status_code, filenamestr, err);
     if (had_err)
       break;
     if (status_code != EOF) {
-      had_err = gt_gff3_parser_parse_genome_nodes(is->gff3_parser, &status_code,
-                                                  is->genome_node_buffer,
-                                                  is->used_types, filenamestr,
-                                                  &is->line_number, is->fpin,
-                                                  err);
+      had_err = gff3_in_stream_plain_parse(is, &status_code, filenamestr, err);
       if (had_err)
         break;
     }
@@ -194,6 +743,15 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
 static void gff3_in_stream_plain_free(GtNodeStream *ns)
 {
   GtGFF3InStreamPlain *gff3_in_stream_plain = gff3_in_stream_plain_cast(ns);
+  GtUword i;
+  gff3_pipeline_delete(gff3_in_stream_plain->pipeline);
+  if (gff3_in_stream_plain->workers) {
+    for (i = 0; i < gt_jobs; i++) {
+      gt_gff3_parser_delete(gff3_in_stream_plain->workers[i].parser);
+      gt_cstr_table_delete(gff3_in_stream_plain->workers[i].used_types);
+    }
+    gt_free(gff3_in_stream_plain->workers);
+  }
   gt_str_array_delete(gff3_in_stream_plain->files);
   gt_str_delete(gff3_in_stream_plain->stdinstr);
   while (gt_queue_size(gff3_in_stream_plain->genome_node_buffer)) {
@@ -271,7 +829,20 @@ void gt_gff3_in_stream_plain_set_type_checker(GtNodeStream *ns,
 GtStrArray* gt_gff3_in_stream_plain_get_used_types(GtNodeStream *ns)
 {
   GtGFF3InStreamPlain *is = gff3_in_stream_plain_cast(ns);
+  GtUword i, j;
   gt_assert(is);
+  if (is->workers) {
+    /* collect the types used in the blocks parsed by the workers */
+    for (i = 0; i < gt_jobs; i++) {
+      GtStrArray *types = gt_cstr_table_get_all(is->workers[i].used_types);
+      for (j = 0; j < gt_str_array_size(types); j++) {
+        const char *type = gt_str_array_get(types, j);
+        if (!gt_cstr_table_get(is->used_types, type))
+          gt_cstr_table_add(is->used_types, type);
+      }
+      gt_str_array_delete(types);
+    }
+  }
   return gt_cstr_table_get_all(is->used_types);
 }
 
@@ -23,6 +23,7 @@
 #include "core/assert_api.h"
 #include "core/compat.h"
 #include "core/cstr_api.h"
+#include "core/file.h"
 #include "core/hashmap.h"
 #include "core/ma.h"
 #include "core/md5_seqid.h"
@@ -61,6 +62,7 @@ struct GtGFF3Parser {
   GtMapping *offset_mapping;
   GtOrphanage *orphanage;
   GtTypeChecker *type_checker;
+  GtFile *stdin_file; /* used if no input file is given */
   unsigned int last_terminator; /* line number of the last terminator */
 };
 
@@ -1641,7 +1643,9 @@ static int gff3_parser_parse_fasta_entry(GtQueue *genome_nodes,
   }
   if (!had_err) {
     GtGenomeNode *sequence_node;
-    GtStr *sequence = gt_str_new();
+    GtStr *sequence = gt_str_new(),
+          *description = gt_str_new_cstr(line+1); /* <line> points into the
+                                                     read buffer of <fpin> */
     int cc;
     while ((cc = gt_file_xfgetc(fpin)) != EOF) {
       if (cc == '>') {
@@ -1651,9 +1655,10 @@ static int gff3_parser_parse_fasta_entry(GtQueue *genome_nodes,
       if (cc != '\n' && cc != '\r' && cc != ' ')
         gt_str_append_char(sequence, cc);
     }
-    sequence_node = gt_sequence_node_new(line+1, sequence);
+    sequence_node = gt_sequence_node_new(gt_str_get(description), sequence);
     gt_genome_node_set_origin(sequence_node, filename, line_number);
     gt_queue_add(genome_nodes, sequence_node);
+    gt_str_delete(description);
     gt_str_delete(sequence);
   }
   return had_err;
@@ -2008,8 +2013,7 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
                                       GtUint64 *line_number,
                                       GtFile *fpin, GtError *err)
 {
-  size_t line_length;
-  GtStr *line_buffer;
+  GtUword line_length;
   char *line;
   const char *filename;
   int rval, had_err = 0;
@@ -2019,12 +2023,14 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
 
   filename = gt_str_get(filenamestr);
 
-  /* init */
-  line_buffer = gt_str_new();
+  /* a <NULL> file denotes stdin, which has to be buffered across calls */
+  if (!fpin) {
+    if (!parser->stdin_file)
+      parser->stdin_file = gt_file_xopen(NULL, "r");
+    fpin = parser->stdin_file;
+  }
 
-  while ((rval = gt_str_read_next_line_generic(line_buffer, fpin)) != EOF) {
-    line = gt_str_get(line_buffer);
-    line_length = gt_str_length(line_buffer);
+  while ((rval = gt_file_xread_line(fpin, &line, &line_length)) != EOF) {
     (*line_number)++;
 
     if (*line_number == 1) {
@@ -2034,7 +2040,6 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
       if (had_err == -1) /* error */
         break;
       if (had_err == 1) { /* line processed */
-        gt_str_reset(line_buffer);
         had_err = 0;
         continue;
       }
@@ -2065,7 +2070,6 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
       if (had_err || (!parser->incomplete_node && gt_queue_size(genome_nodes)))
         break;
     }
-    gt_str_reset(line_buffer);
   }
 
   if (!had_err && rval == EOF && *line_number == 0) {
@@ -2090,7 +2094,6 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
     parser->eof_emitted = true;
   }
 
-  gt_str_delete(line_buffer);
   if (gt_queue_size(genome_nodes))
     *status_code = 0; /* at least one node was created */
   else
@@ -2098,6 +2101,64 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
   return had_err;
 }
 
+GtGFF3Parser* gt_gff3_parser_new_like(const GtGFF3Parser *parser)
+{
+  GtGFF3Parser *new_parser;
+  gt_assert(parser && !parser->offset_mapping);
+  new_parser = gt_gff3_parser_new(parser->type_checker);
+  new_parser->checkids = parser->checkids;
+  new_parser->checkregions = parser->checkregions;
+  new_parser->strict = parser->strict;
+  new_parser->tidy = parser->tidy;
+  new_parser->offset = parser->offset;
+  return new_parser;
+}
+
+bool gt_gff3_parser_terminators_separate_state(const GtGFF3Parser *parser)
+{
+  gt_assert(parser);
+  /* with <checkids> the feature info is kept across terminators, and the
+     mapping of an offset file cannot be shared between threads */
+  return !parser->checkids && !parser->offset_mapping;
+}
+
+void gt_gff3_parser_register_sequence_region(GtGFF3Parser *parser,
+                                             const char *line,
+                                             unsigned int line_number,
+                                             GtStr *filenamestr)
+{
+  GtQueue *genome_nodes;
+  GtError *err;
+  char *linecopy;
+  gt_assert(parser && line && filenamestr);
+  gt_assert(strncmp(line, GT_GFF_SEQUENCE_REGION,
+                    strlen(GT_GFF_SEQUENCE_REGION)) == 0);
+  linecopy = gt_cstr_dup(line);
+  genome_nodes = gt_queue_new();
+  err = gt_error_new();
+  /* errors (e.g., a region which is known already) have been reported by the
+     parser which parsed the line in the first place */
+  (void) parse_meta_gff3_line(parser, genome_nodes, linecopy, strlen(linecopy),
+                              filenamestr, line_number, err);
+  while (gt_queue_size(genome_nodes))
+    gt_genome_node_delete(gt_queue_get(genome_nodes));
+  gt_error_delete(err);
+  gt_queue_delete(genome_nodes);
+  gt_free(linecopy);
+}
+
+void gt_gff3_parser_enable_gvf_mode(GtGFF3Parser *parser)
+{
+  gt_assert(parser);
+  parser->gvf_mode = true;
+}
+
+void gt_gff3_parser_rearm_eof_node(GtGFF3Parser *parser)
+{
+  gt_assert(parser);
+  parser->eof_emitted = false;
+}
+
 void gt_gff3_parser_reset(GtGFF3Parser *parser)
 {
   gt_assert(parser);
@@ -2119,5 +2180,6 @@ void gt_gff3_parser_delete(GtGFF3Parser *parser)
   gt_mapping_delete(parser->offset_mapping);
   gt_orphanage_delete(parser->orphanage);
   gt_type_checker_delete(parser->type_checker);
+  gt_file_delete(parser->stdin_file);
   gt_free(parser);
 }
@@ -22,6 +22,29 @@
 
 void gt_gff3_parser_enable_strict_mode(GtGFF3Parser*);
 int  gt_gff3_parser_set_offsetfile(GtGFF3Parser*, GtStr*, GtError*);
+/* Return a new parser with the same settings as <parser> (modes, checks,
+   offset, and type checker) but without any parsing state.
+   <parser> must not use an offset file. */
+GtGFF3Parser* gt_gff3_parser_new_like(const GtGFF3Parser *parser);
+/* Returns <true> if <parser> keeps no state across terminator lines ("###")
+   besides the sequence regions and the GVF mode. Then the parts of a file
+   which end with terminators can be parsed by different parsers, see
+   gt_gff3_parser_register_sequence_region() and
+   gt_gff3_parser_enable_gvf_mode(). */
+bool gt_gff3_parser_terminators_separate_state(const GtGFF3Parser *parser);
+/* Make the sequence region defined by the "##sequence-region" <line>, which
+   was parsed by another parser on line <line_number> of the file denoted by
+   <filenamestr>, known to <parser> without creating a region node.
+   Regions already known to <parser> are not changed. */
+void gt_gff3_parser_register_sequence_region(GtGFF3Parser *parser,
+                                             const char *line,
+                                             unsigned int line_number,
+                                             GtStr *filenamestr);
+/* Let <parser> behave as if it had seen a GVF version pragma before. */
+void gt_gff3_parser_enable_gvf_mode(GtGFF3Parser *parser);
+/* Let <parser> create an end-of-file node at the next end of a file, even if
+   it has created one already since it was reset. */
+void gt_gff3_parser_rearm_eof_node(GtGFF3Parser *parser);
 int  gt_gff3_parser_parse_target_attributes(const char *values,
                                             GtUword *num_of_targets,
                                             GtStr *first_target_id,
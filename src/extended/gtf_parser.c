@@ -18,6 +18,7 @@
 #include <string.h>
 #include "core/assert_api.h"
 #include "core/cstr_api.h"
+#include "core/file.h"
 #include "core/hashmap.h"
 #include "core/ma.h"
 #include "core/parseutils.h"
@@ -241,9 +242,9 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
                         GtStr *filenamestr, GtFile *fpin, bool be_tolerant,
                         GtError *err)
 {
-  GtStr *seqid_str, *source_str, *line_buffer;
+  GtStr *seqid_str, *source_str;
   char *line;
-  size_t line_length;
+  GtUword line_length;
   GtUword i, line_number = 0;
   GtGenomeNode *gn;
   GtRange range;
@@ -274,6 +275,7 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
   GT_UNUSED bool gff_type_is_valid = false;
   const char *type = NULL;
   const char *filename;
+  GtFile *stdin_file = NULL;
   bool score_is_defined;
   int had_err = 0;
 
@@ -283,7 +285,8 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
   filename = gt_str_get(filenamestr);
 
   /* alloc */
-  line_buffer = gt_str_new();
+  if (!fpin)
+    fpin = stdin_file = gt_file_xopen(NULL, "r");
   splitter = gt_splitter_new(),
   attribute_splitter = gt_splitter_new();
 
@@ -292,7 +295,6 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
           if (be_tolerant) {                                        \
             fprintf(stderr, "skipping line: %s\n", gt_error_get(err)); \
             gt_error_unset(err);                                       \
-            gt_str_reset(line_buffer);                                 \
             had_err = 0;                                            \
             continue;                                               \
           }                                                         \
@@ -302,9 +304,7 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
           }                                                         \
         }
 
-  while (gt_str_read_next_line_generic(line_buffer, fpin) != EOF) {
-    line = gt_str_get(line_buffer);
-    line_length = gt_str_length(line_buffer);
+  while (gt_file_xread_line(fpin, &line, &line_length) != EOF) {
     line_number++;
     had_err = 0;
 
@@ -349,7 +349,6 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
         /* we skip unknown features */
         fprintf(stderr, "skipping line " GT_WU " in file \"%s\": unknown "
                 "feature: \"%s\"\n", line_number, filename, feature);
-        gt_str_reset(line_buffer);
         continue;
       }
 
@@ -393,7 +392,9 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
       /* parse the attributes */
       gt_splitter_reset(attribute_splitter);
       gene_id = NULL;
+      gene_name = NULL;
       transcript_id = NULL;
+      transcript_name = NULL;
       gt_splitter_split(attribute_splitter, attributes, strlen(attributes),
                         ';');
       for (i = 0; i < gt_splitter_size(attribute_splitter); i++) {
@@ -536,8 +537,6 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
         gt_feature_node_set_phase((GtFeatureNode*) gn, phase_value);
       gt_array_add(gt_genome_node_array, gn);
     }
-
-    gt_str_reset(line_buffer);
   }
 
   /* process all region nodes */
@@ -556,7 +555,7 @@ int gt_gtf_parser_parse(GtGTFParser *parser, GtQueue *genome_nodes,
   /* free */
   gt_splitter_delete(splitter);
   gt_splitter_delete(attribute_splitter);
-  gt_str_delete(line_buffer);
+  gt_file_delete(stdin_file);
 
   return had_err;
 }
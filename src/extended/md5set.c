@@ -20,9 +20,11 @@
 #include <ctype.h>
 #endif
 #include "md5.h"
+#include "core/atomic.h"
 #include "core/compat.h"
 #include "core/log.h"
 #include "core/ma.h"
+#include "core/multithread_api.h"
 #include "core/safearith.h"
 #include "core/types_api.h"
 #include "extended/md5set.h"
@@ -285,3 +287,197 @@ GtMD5SetStatus gt_md5set_add_sequence(GtMD5Set *set, const char* seq,
 
   return GT_MD5SET_NOT_FOUND;
 }
+
+/* number of sequences a thread hashes at a time */
+#define GT_MD5SET_CHUNK_SIZE 64
+
+typedef struct {
+  const char **seqs;
+  const GtUword *seqlens,
+                *indexes; /* sequences to hash, all if NULL */
+  GtUword numofindexes,
+          next_chunk;
+  bool reverse_complement;
+  gt_md5_t *md5sums;
+  bool *failed;
+} GtMD5SetThreadInfo;
+
+/* hashes the sequences <info->indexes> (or their reverse complements) */
+static void* gt_md5set_hash_thread(void *data)
+{
+  GtMD5SetThreadInfo *info = data;
+  GtUword k, start, end, bufsize = 0;
+  char *buffer = NULL;
+  GtError *err;
+
+  gt_assert(info != NULL);
+  err = gt_error_new();
+  for (;;)
+  {
+    start = gt_atomic_uword_add_fetch(&info->next_chunk, GT_MD5SET_CHUNK_SIZE)
+            - GT_MD5SET_CHUNK_SIZE;
+    if (start >= info->numofindexes)
+      break;
+    end = start + GT_MD5SET_CHUNK_SIZE;
+    if (end > info->numofindexes)
+      end = info->numofindexes;
+    for (k = start; k < end; k++)
+    {
+      GtUword j, i = info->indexes != NULL ? info->indexes[k] : k,
+              seqlen = info->seqlens[i];
+      if (bufsize < seqlen)
+      {
+        buffer = gt_realloc(buffer, sizeof (char) * seqlen);
+        bufsize = seqlen;
+      }
+      for (j = 0; j < seqlen; j++)
+        buffer[j] = toupper(info->seqs[i][j]);
+      if (info->reverse_complement &&
+          gt_reverse_complement(buffer, seqlen, err) != 0)
+      {
+        /* the error is reported by the calling thread */
+        info->failed[i] = true;
+        gt_error_unset(err);
+        continue;
+      }
+      GT_MD5SET_HASH_STRING(buffer, seqlen, info->md5sums[i]);
+    }
+  }
+  gt_error_delete(err);
+  gt_free(buffer);
+  return NULL;
+}
+
+static int gt_md5set_hash_sequences(GtMD5SetThreadInfo *info,
+                                    const GtUword *indexes,
+                                    GtUword numofindexes,
+                                    bool reverse_complement, GtError *err)
+{
+  info->indexes = indexes;
+  info->numofindexes = numofindexes;
+  info->next_chunk = 0;
+  info->reverse_complement = reverse_complement;
+  if (numofindexes == 0)
+    return 0;
+  return gt_multithread(gt_md5set_hash_thread, info, err);
+}
+
+/* a hash inserted by a call of <gt_md5set_add_sequences()>, with the index of
+   the sequence which inserted it */
+typedef struct {
+  gt_md5_t md5sum;
+  GtUword seqnum;
+} GtMD5SetInsertion;
+
+static int gt_md5set_insertion_cmp(const void *a, const void *b)
+{
+  const GtMD5SetInsertion *x = a, *y = b;
+  if (x->md5sum.h != y->md5sum.h)
+    return x->md5sum.h < y->md5sum.h ? -1 : 1;
+  if (x->md5sum.l != y->md5sum.l)
+    return x->md5sum.l < y->md5sum.l ? -1 : 1;
+  return 0;
+}
+
+int gt_md5set_add_sequences(GtMD5Set *set, const char **seqs,
+                            const GtUword *seqlens, GtUword numofseqs,
+                            bool both_strands, GtMD5SetStatus *status,
+                            GtError *err)
+{
+  GtMD5SetThreadInfo info;
+  GtMD5SetInsertion *insertions = NULL;
+  GtUword i, k, numofinsertions = 0;
+  gt_md5_t *md5sums, *md5sums_rc = NULL;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(set != NULL && set->table != NULL);
+  gt_assert(numofseqs == 0 || (seqs != NULL && seqlens != NULL &&
+                               status != NULL));
+
+  /* The hashes are computed in parallel, while the lookups are done in order
+     of the sequences. As in gt_md5set_add_sequence(), the reverse complement
+     is only hashed for the sequences whose forward hash was not found. */
+  info.seqs = seqs;
+  info.seqlens = seqlens;
+  info.md5sums = md5sums = gt_malloc(sizeof (gt_md5_t) * numofseqs);
+  info.failed = NULL;
+  if (gt_md5set_hash_sequences(&info, NULL, numofseqs, false, err) != 0)
+  {
+    status[0] = GT_MD5SET_ERROR;
+    had_err = -1;
+  }
+  if (!had_err && both_strands)
+    insertions = gt_malloc(sizeof (GtMD5SetInsertion) * numofseqs);
+  for (i = 0; !had_err && i < numofseqs; i++)
+  {
+    if (gt_md5set_search(set, md5sums[i], true))
+      status[i] = GT_MD5SET_FOUND;
+    else
+    {
+      status[i] = GT_MD5SET_NOT_FOUND;
+      if (both_strands)
+      {
+        insertions[numofinsertions].md5sum = md5sums[i];
+        insertions[numofinsertions].seqnum = i;
+        numofinsertions++;
+      }
+    }
+  }
+
+  if (!had_err && numofinsertions > 0)
+  {
+    GtUword *indexes = gt_malloc(sizeof (GtUword) * numofinsertions);
+    for (k = 0; k < numofinsertions; k++)
+      indexes[k] = insertions[k].seqnum;
+    md5sums_rc = gt_malloc(sizeof (gt_md5_t) * numofseqs);
+    info.md5sums = md5sums_rc;
+    info.failed = gt_calloc((size_t) numofseqs, sizeof (bool));
+    if (gt_md5set_hash_sequences(&info, indexes, numofinsertions, true,
+                                 err) != 0)
+    {
+      status[0] = GT_MD5SET_ERROR;
+      had_err = -1;
+    }
+    qsort(insertions, (size_t) numofinsertions, sizeof (GtMD5SetInsertion),
+          gt_md5set_insertion_cmp);
+    /* When sequence i was added sequentially, <set> contained the hashes
+       present before this call and the forward hashes of the sequences up to
+       i. The set now contains the forward hashes of all sequences, so a
+       reverse complement hash which has been inserted by this call only
+       counts if it was inserted by a sequence not after i. */
+    for (k = 0; !had_err && k < numofinsertions; k++)
+    {
+      i = indexes[k];
+      if (info.failed[i])
+      {
+        /* repeat the computation to report the error */
+        char *buffer = gt_malloc(sizeof (char) * seqlens[i]);
+        GtUword j;
+        for (j = 0; j < seqlens[i]; j++)
+          buffer[j] = toupper(seqs[i][j]);
+        had_err = gt_reverse_complement(buffer, seqlens[i], err);
+        gt_assert(had_err);
+        gt_free(buffer);
+        status[i] = GT_MD5SET_ERROR;
+      }
+      else if (gt_md5set_search(set, md5sums_rc[i], false))
+      {
+        GtMD5SetInsertion key, *insertion;
+        key.md5sum = md5sums_rc[i];
+        insertion = bsearch(&key, insertions, (size_t) numofinsertions,
+                            sizeof (GtMD5SetInsertion),
+                            gt_md5set_insertion_cmp);
+        if (insertion == NULL || insertion->seqnum <= i)
+          status[i] = GT_MD5SET_RC_FOUND;
+      }
+    }
+    gt_free(info.failed);
+    gt_free(indexes);
+  }
+
+  gt_free(insertions);
+  gt_free(md5sums_rc);
+  gt_free(md5sums);
+  return had_err;
+}
@@ -18,6 +18,10 @@
 #ifndef MD5SET_H
 #define MD5SET_H
 
+#include <stdbool.h>
+#include "core/error_api.h"
+#include "core/types_api.h"
+
 /* A set which represents a (possibly large) set of sequences, allowing to
    check whether a sequence or its reverse complement belongs to the set;
    only 128-bit MD5 hashes are stored, not the sequences themselves
@@ -52,4 +56,17 @@ GtMD5SetStatus gt_md5set_add_sequence(GtMD5Set *set, const char* seq,
                                  GtUword seqlen, bool both_strands,
                                  GtError *err);
 
+/* Adds the <numofseqs> sequences <seqs> (of lengths <seqlens>) to <set> as if
+   <gt_md5set_add_sequence()> was called for each of them in order and stores
+   the results in <status>. The MD5 hashes are calculated in <gt_jobs> many
+   threads, only the lookups in <set> are done sequentially.
+   Returns 0 on success. On error, -1 is returned and <err> is set
+   accordingly; in this case <status> is only valid for the sequences before
+   the erroneous one (whose <status> is <GT_MD5SET_ERROR>) and <set> may
+   contain hashes of later sequences. */
+int            gt_md5set_add_sequences(GtMD5Set *set, const char **seqs,
+                                       const GtUword *seqlens,
+                                       GtUword numofseqs, bool both_strands,
+                                       GtMD5SetStatus *status, GtError *err);
+
 #endif
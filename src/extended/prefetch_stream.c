@@ -0,0 +1,215 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/atomic.h"
+#include "core/class_alloc_lock.h"
+#include "core/ma.h"
+#include "core/thread_api.h"
+#include "extended/node_stream_api.h"
+#include "extended/prefetch_stream.h"
+
+/* The buffered nodes are kept in a ring buffer with a single producer (the
+   prefetching thread) and a single consumer (the caller of
+   <gt_node_stream_next()>). <head> is only advanced by the consumer and <tail>
+   only by the producer, so nodes are handed over without locking. The mutex
+   and the condition variables are only used to put a thread to sleep if the
+   buffer is empty or full. To avoid a context switch per node, a sleeping
+   thread is only woken up again once the buffer is at least half full (or half
+   empty, respectively). */
+struct GtPrefetchStream {
+  const GtNodeStream parent_instance;
+  GtNodeStream *in_stream;
+  GtGenomeNode **buffer;
+  GtUword buffer_size,
+          head,             /* number of nodes taken from the buffer */
+          tail,             /* number of nodes put into the buffer */
+          consumer_waiting,
+          producer_waiting,
+          finished,
+          stop;
+  GtMutex *mutex;
+  GtCond *not_empty,
+         *not_full;
+  GtThread *thread;
+  GtError *in_err;
+  int in_had_err;
+};
+
+#define prefetch_stream_cast(NS)\
+        gt_node_stream_cast(gt_prefetch_stream_class(), NS)
+
+#ifdef GT_THREADS_ENABLED
+
+/* Waits until the buffer has space for another node. Returns true if the
+   prefetching has been stopped in the meantime. */
+static bool prefetch_stream_wait_for_space(GtPrefetchStream *ps)
+{
+  if (ps->tail - gt_atomic_uword_load_ordered(&ps->head) < ps->buffer_size)
+    return false;
+  gt_mutex_lock(ps->mutex);
+  gt_atomic_uword_store(&ps->producer_waiting, 1);
+  while (ps->tail - gt_atomic_uword_load_ordered(&ps->head) == ps->buffer_size
+         && !gt_atomic_uword_load_ordered(&ps->stop)) {
+    gt_cond_wait(ps->not_full, ps->mutex);
+  }
+  gt_atomic_uword_store(&ps->producer_waiting, 0);
+  gt_mutex_unlock(ps->mutex);
+  return gt_atomic_uword_load_ordered(&ps->stop) ? true : false;
+}
+
+static void* prefetch_stream_thread(void *data)
+{
+  GtPrefetchStream *ps = data;
+  GtGenomeNode *gn;
+  int had_err = 0;
+  gt_assert(ps);
+  while (!gt_atomic_uword_load_ordered(&ps->stop)) {
+    had_err = gt_node_stream_next(ps->in_stream, &gn, ps->in_err);
+    if (had_err || !gn)
+      break;
+    if (prefetch_stream_wait_for_space(ps)) {
+      gt_genome_node_delete(gn);
+      break;
+    }
+    ps->buffer[ps->tail % ps->buffer_size] = gn;
+    gt_atomic_uword_store(&ps->tail, ps->tail + 1);
+    if (gt_atomic_uword_load_ordered(&ps->consumer_waiting) &&
+        ps->tail - gt_atomic_uword_load_ordered(&ps->head)
+        >= ps->buffer_size / 2) {
+      gt_mutex_lock(ps->mutex);
+      gt_cond_signal(ps->not_empty);
+      gt_mutex_unlock(ps->mutex);
+    }
+  }
+  ps->in_had_err = had_err;
+  gt_atomic_uword_store(&ps->finished, 1);
+  gt_mutex_lock(ps->mutex);
+  gt_cond_signal(ps->not_empty);
+  gt_mutex_unlock(ps->mutex);
+  return NULL;
+}
+
+static int prefetch_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                GtError *err)
+{
+  GtPrefetchStream *ps;
+  gt_error_check(err);
+  ps = prefetch_stream_cast(ns);
+  if (!ps->thread &&
+      !(ps->thread = gt_thread_new(prefetch_stream_thread, ps, err))) {
+    return -1;
+  }
+  if (gt_atomic_uword_load_ordered(&ps->tail) == ps->head) {
+    gt_mutex_lock(ps->mutex);
+    gt_atomic_uword_store(&ps->consumer_waiting, 1);
+    while (gt_atomic_uword_load_ordered(&ps->tail) == ps->head &&
+           !gt_atomic_uword_load_ordered(&ps->finished)) {
+      gt_cond_wait(ps->not_empty, ps->mutex);
+    }
+    gt_atomic_uword_store(&ps->consumer_waiting, 0);
+    gt_mutex_unlock(ps->mutex);
+  }
+  if (gt_atomic_uword_load_ordered(&ps->tail) == ps->head) {
+    /* the prefetching thread has finished and all nodes have been taken */
+    *gn = NULL;
+    if (ps->in_had_err) {
+      gt_error_set_nonvariadic(err, gt_error_get(ps->in_err));
+      return -1;
+    }
+    return 0;
+  }
+  *gn = ps->buffer[ps->head % ps->buffer_size];
+  gt_atomic_uword_store(&ps->head, ps->head + 1);
+  if (gt_atomic_uword_load_ordered(&ps->producer_waiting) &&
+      gt_atomic_uword_load_ordered(&ps->tail) - ps->head
+      <= ps->buffer_size / 2) {
+    gt_mutex_lock(ps->mutex);
+    gt_cond_signal(ps->not_full);
+    gt_mutex_unlock(ps->mutex);
+  }
+  return 0;
+}
+
+#else
+
+static int prefetch_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                GtError *err)
+{
+  GtPrefetchStream *ps;
+  gt_error_check(err);
+  ps = prefetch_stream_cast(ns);
+  return gt_node_stream_next(ps->in_stream, gn, err);
+}
+
+#endif
+
+static void prefetch_stream_free(GtNodeStream *ns)
+{
+  GtPrefetchStream *ps = prefetch_stream_cast(ns);
+  if (ps->thread) {
+    gt_atomic_uword_store(&ps->stop, 1);
+    gt_mutex_lock(ps->mutex);
+    gt_cond_signal(ps->not_full);
+    gt_mutex_unlock(ps->mutex);
+    gt_thread_join(ps->thread);
+    gt_thread_delete(ps->thread);
+    for (; ps->head < ps->tail; ps->head++)
+      gt_genome_node_delete(ps->buffer[ps->head % ps->buffer_size]);
+  }
+  gt_cond_delete(ps->not_full);
+  gt_cond_delete(ps->not_empty);
+  gt_mutex_delete(ps->mutex);
+  gt_error_delete(ps->in_err);
+  gt_free(ps->buffer);
+  gt_node_stream_delete(ps->in_stream);
+}
+
+const GtNodeStreamClass* gt_prefetch_stream_class(void)
+{
+  static const GtNodeStreamClass *nsc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!nsc) {
+    nsc = gt_node_stream_class_new(sizeof (GtPrefetchStream),
+                                   prefetch_stream_free,
+                                   prefetch_stream_next);
+  }
+  gt_class_alloc_lock_leave();
+  return nsc;
+}
+
+GtNodeStream* gt_prefetch_stream_new(GtNodeStream *in_stream,
+                                     GtUword buffer_size)
+{
+  GtPrefetchStream *ps;
+  GtNodeStream *ns;
+  gt_assert(in_stream && buffer_size >= 2);
+  ns = gt_node_stream_create(gt_prefetch_stream_class(),
+                             gt_node_stream_is_sorted(in_stream));
+  ps = prefetch_stream_cast(ns);
+  ps->in_stream = gt_node_stream_ref(in_stream);
+  ps->buffer = gt_malloc(sizeof *ps->buffer * buffer_size);
+  ps->buffer_size = buffer_size;
+  ps->head = ps->tail = 0;
+  ps->consumer_waiting = ps->producer_waiting = 0;
+  ps->finished = ps->stop = 0;
+  ps->mutex = gt_mutex_new();
+  ps->not_empty = gt_cond_new();
+  ps->not_full = gt_cond_new();
+  ps->thread = NULL;
+  ps->in_err = gt_error_new();
+  ps->in_had_err = 0;
+  return ns;
+}
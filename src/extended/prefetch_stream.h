@@ -0,0 +1,41 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef PREFETCH_STREAM_H
+#define PREFETCH_STREAM_H
+
+#include "extended/node_stream_api.h"
+
+/* The default number of nodes a <GtPrefetchStream> buffers. */
+#define GT_PREFETCH_STREAM_DEFAULT_SIZE 1024
+
+/* Implements the <GtNodeStream> interface. A <GtPrefetchStream> pulls the
+   nodes from its <in_stream> in a separate thread and buffers up to
+   <buffer_size> of them, so that the streams before and after it run
+   concurrently. The nodes are returned in the order of <in_stream>, errors
+   are reported after all nodes before them have been returned.
+   All streams before the <GtPrefetchStream> are only used by the prefetching
+   thread until the <GtPrefetchStream> has been deleted. Without thread support
+   the nodes are passed through unbuffered. */
+typedef struct GtPrefetchStream GtPrefetchStream;
+
+const GtNodeStreamClass* gt_prefetch_stream_class(void);
+/* Returns a new <GtPrefetchStream> for <in_stream>, <buffer_size> must be at
+   least 2. */
+GtNodeStream*            gt_prefetch_stream_new(GtNodeStream *in_stream,
+                                                GtUword buffer_size);
+
+#endif
@@ -18,22 +18,331 @@
 #include "core/array.h"
 #include "core/assert_api.h"
 #include "core/class_alloc_lock.h"
+#include "core/fa.h"
+#include "core/ma.h"
+#include "core/minmax.h"
+#include "core/str_array.h"
+#include "core/xansi_api.h"
 #include "extended/eof_node_api.h"
+#include "extended/feature_node_iterator_api.h"
 #include "extended/genome_node.h"
+#include "extended/gff3_in_stream_plain.h"
+#include "extended/gff3_visitor_api.h"
+#include "extended/meta_node_api.h"
 #include "extended/node_stream_api.h"
+#include "extended/priority_queue.h"
+#include "extended/sequence_node_api.h"
 #include "extended/sort_stream.h"
 
+/* estimated memory consumption of a feature node, including its attributes
+   and the list of its children */
+#define GT_SORT_STREAM_FEATURE_NODE_SIZE  320UL
+#define GT_SORT_STREAM_OTHER_NODE_SIZE    128UL
+/* maximal number of runs which are merged at once */
+#define GT_SORT_STREAM_MAXFANIN           16UL
+
+typedef struct {
+  GtNodeStream *in_stream;
+  GtGenomeNode *node; /* the next node of the run, NULL at its end */
+  GtUword idx; /* position of the run, decides between equal nodes */
+} GtSortStreamRun;
+
+/* merges up to <GT_SORT_STREAM_MAXFANIN> runs, the runs with a next node are
+   kept in a heap */
+typedef struct {
+  GtSortStreamRun *runs;
+  GtUword num_of_runs;
+  GtPriorityQueue *heap;
+} GtSortStreamMerger;
+
+typedef struct {
+  FILE *fp;
+  GtFile *outfile;
+  GtNodeVisitor *gff3_visitor;
+} GtSortStreamRunWriter;
+
 struct GtSortStream {
   const GtNodeStream parent_instance;
   GtNodeStream *in_stream;
-  GtUword idx;
-  GtArray *nodes;
+  GtSortStreamMerger *merger; /* merges the runs, if any have been written */
+  GtUword idx,
+          memlimit,
+          runsize;
+  GtArray *nodes,
+          *run; /* nodes which are written to a run if <memlimit> is hit */
+  GtStrArray *runfiles;
   bool sorted;
 };
 
 #define gt_sort_stream_cast(GS)\
         gt_node_stream_cast(gt_sort_stream_class(), GS);
 
+/* meta and region nodes are kept in memory, as the runs are parsed without
+   them. Sequence nodes are kept as well, because the sorted GFF3 input stream
+   cannot read back a ##FASTA section holding more than one sequence */
+static bool gt_sort_stream_node_is_resident(GtGenomeNode *gn)
+{
+  return gt_meta_node_try_cast(gn) || gt_region_node_try_cast(gn) ||
+         gt_sequence_node_try_cast(gn);
+}
+
+static GtUword gt_sort_stream_estimate_size(GtGenomeNode *gn)
+{
+  GtFeatureNode *fn;
+  GtFeatureNodeIterator *fni;
+  GtUword size = GT_SORT_STREAM_OTHER_NODE_SIZE;
+
+  if ((fn = gt_feature_node_try_cast(gn))) {
+    fni = gt_feature_node_iterator_new(fn);
+    while (gt_feature_node_iterator_next(fni))
+      size += GT_SORT_STREAM_FEATURE_NODE_SIZE;
+    gt_feature_node_iterator_delete(fni);
+  }
+  return size;
+}
+
+/* creates a new temporary GFF3 file, whose name is added to <runfiles> */
+static void gt_sort_stream_run_writer_init(GtSortStreamRunWriter *writer,
+                                           GtStrArray *runfiles)
+{
+  GtStr *runfile = gt_str_new();
+  writer->fp = gt_xtmpfp(runfile);
+  writer->outfile = gt_file_new_from_fileptr(writer->fp);
+  writer->gff3_visitor = gt_gff3_visitor_new(writer->outfile);
+  /* the IDs are retained, otherwise they would be lost for output with
+     retained IDs */
+  gt_gff3_visitor_retain_id_attributes((GtGFF3Visitor*)
+                                       writer->gff3_visitor);
+  gt_str_array_add(runfiles, runfile);
+  gt_str_delete(runfile);
+}
+
+/* writes <node> to the run and deletes it */
+static int gt_sort_stream_run_writer_write(GtSortStreamRunWriter *writer,
+                                           GtGenomeNode *node, GtError *err)
+{
+  int had_err;
+  gt_error_check(err);
+  had_err = gt_genome_node_accept(node, writer->gff3_visitor, err);
+  gt_genome_node_delete(node);
+  return had_err;
+}
+
+static void gt_sort_stream_run_writer_finish(GtSortStreamRunWriter *writer)
+{
+  gt_node_visitor_delete(writer->gff3_visitor);
+  gt_file_delete_without_handle(writer->outfile);
+  gt_fa_xfclose(writer->fp);
+}
+
+/* sorts the nodes of the current run and writes them to a temporary GFF3
+   file, which is parsed again in the merge phase */
+static int gt_sort_stream_write_run(GtSortStream *sort_stream, GtError *err)
+{
+  GtSortStreamRunWriter writer;
+  GtGenomeNode *node;
+  GtUword i;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_genome_nodes_sort_stable(sort_stream->run);
+  gt_sort_stream_run_writer_init(&writer, sort_stream->runfiles);
+  for (i = 0; i < gt_array_size(sort_stream->run); i++) {
+    node = *(GtGenomeNode**) gt_array_get(sort_stream->run, i);
+    if (!had_err)
+      had_err = gt_sort_stream_run_writer_write(&writer, node, err);
+    else
+      gt_genome_node_delete(node);
+  }
+  gt_sort_stream_run_writer_finish(&writer);
+  gt_array_reset(sort_stream->run);
+  sort_stream->runsize = 0;
+  return had_err;
+}
+
+static int gt_sort_stream_run_compare(const void *a, const void *b)
+{
+  GtSortStreamRun *run_a = (GtSortStreamRun*) a,
+                  *run_b = (GtSortStreamRun*) b;
+  int rval = gt_genome_node_compare(&run_a->node, &run_b->node);
+  if (rval)
+    return rval;
+  /* keep the sort stable */
+  if (run_a->idx < run_b->idx)
+    return -1;
+  return run_a->idx > run_b->idx ? 1 : 0;
+}
+
+/* reads the next node of <run>, the EOF nodes and the resident nodes (which
+   have been kept in memory) are skipped */
+static int gt_sort_stream_run_advance(GtSortStreamRun *run, GtError *err)
+{
+  int had_err;
+  gt_error_check(err);
+  while (!(had_err = gt_node_stream_next(run->in_stream, &run->node, err)) &&
+         run->node) {
+    if (gt_eof_node_try_cast(run->node) ||
+        gt_sort_stream_node_is_resident(run->node)) {
+      gt_genome_node_delete(run->node);
+    }
+    else
+      break;
+  }
+  if (had_err)
+    run->node = NULL;
+  return had_err;
+}
+
+static void gt_sort_stream_merger_delete(GtSortStreamMerger *merger)
+{
+  GtUword i;
+  if (!merger) return;
+  for (i = 0; i < merger->num_of_runs; i++) {
+    gt_genome_node_delete(merger->runs[i].node);
+    gt_node_stream_delete(merger->runs[i].in_stream);
+  }
+  gt_free(merger->runs);
+  gt_priority_queue_delete(merger->heap);
+  gt_free(merger);
+}
+
+/* returns a merger for the <num_of_runs> runs starting with the one at index
+   <first> of <runfiles>, or NULL on error */
+static GtSortStreamMerger* gt_sort_stream_merger_new(GtStrArray *runfiles,
+                                                     GtUword first,
+                                                     GtUword num_of_runs,
+                                                     GtError *err)
+{
+  GtSortStreamMerger *merger;
+  GtSortStreamRun *run;
+  GtUword i;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(num_of_runs && num_of_runs <= GT_SORT_STREAM_MAXFANIN);
+  merger = gt_malloc(sizeof *merger);
+  merger->runs = gt_calloc(num_of_runs, sizeof *merger->runs);
+  merger->num_of_runs = num_of_runs;
+  merger->heap = gt_priority_queue_new(gt_sort_stream_run_compare,
+                                       num_of_runs);
+  for (i = 0; !had_err && i < num_of_runs; i++) {
+    run = merger->runs + i;
+    run->in_stream = gt_gff3_in_stream_plain_new_sorted(
+                                    gt_str_array_get(runfiles, first + i));
+    run->idx = i;
+    had_err = gt_sort_stream_run_advance(run, err);
+    if (!had_err && run->node)
+      gt_priority_queue_add(merger->heap, run);
+  }
+  if (had_err) {
+    gt_sort_stream_merger_delete(merger);
+    return NULL;
+  }
+  return merger;
+}
+
+/* returns the next node of the merged runs in <*gn>, or NULL if the runs are
+   exhausted */
+static int gt_sort_stream_merger_next(GtSortStreamMerger *merger,
+                                      GtGenomeNode **gn, GtError *err)
+{
+  GtSortStreamRun *run;
+  GtGenomeNode *node;
+  int had_err;
+  gt_error_check(err);
+  if (gt_priority_queue_is_empty(merger->heap)) {
+    *gn = NULL;
+    return 0;
+  }
+  run = gt_priority_queue_extract_min(merger->heap);
+  node = run->node;
+  had_err = gt_sort_stream_run_advance(run, err);
+  if (had_err) {
+    gt_genome_node_delete(node);
+    return had_err;
+  }
+  if (run->node)
+    gt_priority_queue_add(merger->heap, run);
+  *gn = node;
+  return 0;
+}
+
+/* merges the <num_of_runs> runs starting at index <first> into a new run,
+   which is added to <merged_runfiles> */
+static int gt_sort_stream_merge_into_run(GtStrArray *runfiles, GtUword first,
+                                         GtUword num_of_runs,
+                                         GtStrArray *merged_runfiles,
+                                         GtError *err)
+{
+  GtSortStreamMerger *merger;
+  GtSortStreamRunWriter writer;
+  GtGenomeNode *node;
+  int had_err = 0;
+
+  gt_error_check(err);
+  if (!(merger = gt_sort_stream_merger_new(runfiles, first, num_of_runs, err)))
+    return -1;
+  gt_sort_stream_run_writer_init(&writer, merged_runfiles);
+  while (!had_err &&
+         !(had_err = gt_sort_stream_merger_next(merger, &node, err)) && node) {
+    had_err = gt_sort_stream_run_writer_write(&writer, node, err);
+  }
+  gt_sort_stream_run_writer_finish(&writer);
+  gt_sort_stream_merger_delete(merger);
+  return had_err;
+}
+
+/* merges consecutive runs in passes until at most <GT_SORT_STREAM_MAXFANIN>
+   runs are left, which are merged while the nodes are delivered. This bounds
+   the number of open files and the cost of finding the minimal node. */
+static int gt_sort_stream_merge_runs(GtSortStream *sort_stream, GtError *err)
+{
+  GtStrArray *merged_runfiles;
+  GtUword i, j, num_of_runs;
+  int had_err = 0;
+
+  gt_error_check(err);
+  while (gt_str_array_size(sort_stream->runfiles) > GT_SORT_STREAM_MAXFANIN) {
+    merged_runfiles = gt_str_array_new();
+    for (i = 0; i < gt_str_array_size(sort_stream->runfiles);
+         i += num_of_runs) {
+      num_of_runs = MIN(GT_SORT_STREAM_MAXFANIN,
+                        gt_str_array_size(sort_stream->runfiles) - i);
+      if (!had_err) {
+        had_err = gt_sort_stream_merge_into_run(sort_stream->runfiles, i,
+                                                num_of_runs, merged_runfiles,
+                                                err);
+      }
+      for (j = i; j < i + num_of_runs; j++)
+        gt_xremove(gt_str_array_get(sort_stream->runfiles, j));
+    }
+    gt_str_array_delete(sort_stream->runfiles);
+    sort_stream->runfiles = merged_runfiles;
+    if (had_err)
+      return had_err;
+  }
+  sort_stream->merger =
+    gt_sort_stream_merger_new(sort_stream->runfiles, 0,
+                              gt_str_array_size(sort_stream->runfiles), err);
+  return sort_stream->merger ? 0 : -1;
+}
+
+/* returns the next node of the merged runs in <*gn>, or NULL if the runs are
+   exhausted (in which case the merger is deleted) */
+static int gt_sort_stream_next_merged(GtSortStream *sort_stream,
+                                      GtGenomeNode **gn, GtError *err)
+{
+  int had_err;
+  gt_error_check(err);
+  gt_assert(sort_stream->merger);
+  had_err = gt_sort_stream_merger_next(sort_stream->merger, gn, err);
+  if (!had_err && !*gn) {
+    gt_sort_stream_merger_delete(sort_stream->merger);
+    sort_stream->merger = NULL;
+  }
+  return had_err;
+}
+
 static int gt_sort_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
                                GtError *err)
 {
@@ -49,17 +358,47 @@ static int gt_sort_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
                                            err)) && node) {
       if ((eofn = gt_eof_node_try_cast(node)))
         gt_genome_node_delete(node); /* get rid of EOF nodes */
+      else if (sort_stream->memlimit &&
+               !gt_sort_stream_node_is_resident(node)) {
+        gt_array_add(sort_stream->run, node);
+        sort_stream->runsize += gt_sort_stream_estimate_size(node);
+        if (sort_stream->runsize > sort_stream->memlimit &&
+            (had_err = gt_sort_stream_write_run(sort_stream, err)))
+          break;
+      }
       else
         gt_array_add(sort_stream->nodes, node);
     }
+    if (!had_err && gt_array_size(sort_stream->run)) {
+      if (gt_str_array_size(sort_stream->runfiles))
+        had_err = gt_sort_stream_write_run(sort_stream, err);
+      else {
+        /* the memory limit has not been hit, sort in memory */
+        gt_array_add_array(sort_stream->nodes, sort_stream->run);
+        gt_array_reset(sort_stream->run);
+      }
+    }
     if (!had_err) {
       gt_genome_nodes_sort_stable(sort_stream->nodes);
+      if (gt_str_array_size(sort_stream->runfiles))
+        had_err = gt_sort_stream_merge_runs(sort_stream, err);
       sort_stream->sorted = true;
     }
   }
 
   if (!had_err) {
     gt_assert(sort_stream->sorted);
+    /* the merged runs go between the resident meta and region nodes and the
+       resident sequence nodes, which come last in sorted order */
+    if (sort_stream->merger &&
+        (sort_stream->idx == gt_array_size(sort_stream->nodes) ||
+         gt_sequence_node_try_cast(*(GtGenomeNode**)
+                                   gt_array_get(sort_stream->nodes,
+                                                sort_stream->idx)))) {
+      had_err = gt_sort_stream_next_merged(sort_stream, gn, err);
+      if (had_err || *gn)
+        return had_err;
+    }
     if (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
       *gn = *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
                                            sort_stream->idx);
@@ -105,6 +444,15 @@ static void gt_sort_stream_free(GtNodeStream *ns)
                           gt_array_get(sort_stream->nodes, i));
   }
   gt_array_delete(sort_stream->nodes);
+  for (i = 0; i < gt_array_size(sort_stream->run); i++) {
+    gt_genome_node_delete(*(GtGenomeNode**)
+                          gt_array_get(sort_stream->run, i));
+  }
+  gt_array_delete(sort_stream->run);
+  gt_sort_stream_merger_delete(sort_stream->merger);
+  for (i = 0; i < gt_str_array_size(sort_stream->runfiles); i++)
+    gt_xremove(gt_str_array_get(sort_stream->runfiles, i));
+  gt_str_array_delete(sort_stream->runfiles);
   gt_node_stream_delete(sort_stream->in_stream);
 }
 
@@ -130,5 +478,17 @@ GtNodeStream* gt_sort_stream_new(GtNodeStream *in_stream)
   sort_stream->sorted = false;
   sort_stream->idx = 0;
   sort_stream->nodes = gt_array_new(sizeof (GtGenomeNode*));
+  sort_stream->merger = NULL;
+  sort_stream->memlimit = 0;
+  sort_stream->runsize = 0;
+  sort_stream->run = gt_array_new(sizeof (GtGenomeNode*));
+  sort_stream->runfiles = gt_str_array_new();
   return ns;
 }
+
+void gt_sort_stream_set_memory_limit(GtNodeStream *ns, GtUword memlimit)
+{
+  GtSortStream *sort_stream = gt_sort_stream_cast(ns);
+  gt_assert(!sort_stream->sorted);
+  sort_stream->memlimit = memlimit;
+}
@@ -22,4 +22,13 @@
 
 const GtNodeStreamClass* gt_sort_stream_class(void);
 
+/* Limit the memory which <sort_stream> uses for the nodes it sorts to about
+   <memlimit> bytes (0 means no limit). If the limit is hit, the nodes
+   retrieved so far (except for meta and region nodes) are sorted and written
+   to a temporary GFF3 file. These runs are merged after all nodes have been
+   retrieved, in several passes if there are many of them. */
+void                     gt_sort_stream_set_memory_limit(GtNodeStream
+                                                         *sort_stream,
+                                                         GtUword memlimit);
+
 #endif
@@ -19,6 +19,7 @@
 #include "core/cstr_api.h"
 #include "core/cstr_table.h"
 #include "core/ma.h"
+#include "core/thread_api.h"
 #include "extended/obo_parse_tree.h"
 #include "extended/type_checker_obo.h"
 #include "extended/type_checker_rep.h"
@@ -29,6 +30,7 @@ struct GtTypeCheckerOBO {
   GtStr *description;
   GtCstrTable *feature_node_types;
   GtTypeGraph *type_graph;
+  GtMutex *type_graph_mutex; /* the type graph caches part-of results */
 };
 
 #define gt_type_checker_obo_cast(FTF)\
@@ -38,6 +40,7 @@ static void gt_type_checker_obo_free(GtTypeChecker *tc)
 {
   GtTypeCheckerOBO *tco = gt_type_checker_obo_cast(tc);
   gt_type_graph_delete(tco->type_graph);
+  gt_mutex_delete(tco->type_graph_mutex);
   gt_cstr_table_delete(tco->feature_node_types);
   gt_str_delete(tco->description);
 }
@@ -63,9 +66,14 @@ static bool gt_type_checker_obo_is_partof(GtTypeChecker *tc,
                                           const char *child_type)
 {
   GtTypeCheckerOBO *tco;
+  bool is_partof;
   gt_assert(tc && parent_type && child_type);
   tco = gt_type_checker_obo_cast(tc);
-  return gt_type_graph_is_partof(tco->type_graph, parent_type, child_type);
+  gt_mutex_lock(tco->type_graph_mutex);
+  is_partof = gt_type_graph_is_partof(tco->type_graph, parent_type,
+                                      child_type);
+  gt_mutex_unlock(tco->type_graph_mutex);
+  return is_partof;
 }
 
 const GtTypeCheckerClass* gt_type_checker_obo_class(void)
@@ -136,6 +144,7 @@ GtTypeChecker* gt_type_checker_obo_new(const char *obo_file_path, GtError *err)
   gt_str_append_cstr(tco->description, obo_file_path);
   tco->feature_node_types = gt_cstr_table_new();
   tco->type_graph = gt_type_graph_new();
+  tco->type_graph_mutex = gt_mutex_new();
   if (create_feature_nodes(tco, obo_file_path, err)) {
     gt_type_checker_delete(tc);
     return NULL;
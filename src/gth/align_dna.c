@@ -16,12 +16,21 @@
 */
 
 #include <math.h>
+#include <string.h>
+/* the SSE4.2 kernel of dna_intron_states_row() is compiled for every x86-64
+   build with a compiler which supports the target attribute and selected at
+   runtime if the CPU supports SSE4.2 */
+#if defined (__x86_64__) && \
+    (defined (__clang__) || __GNUC__ > 4 || \
+     (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define DNA_INTRON_STATES_SSE
+#include <nmmintrin.h>
+#endif
 #include "core/divmodmul.h"
 #include "core/safearith.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "gth/align_dna_imp.h"
-#include "gth/array2dim_plain.h"
 #include "gth/compute_scores.h"
 #include "gth/gthenum.h"
 #include "gth/gtherror.h"
@@ -46,16 +55,69 @@ static const char* dna_showretracenames(DnaRetrace retrace)
   return dna_retracenames[retrace];
 }
 
-/* the following function allocates space for the DP tables for cDNAs/ESTs */
+/* the following function initializes the DP tables for cDNAs/ESTs for the
+   first genomic position */
+static void dp_matrix_init_first_row(GthDPMatrix *dpm)
+{
+  GtUword n, m;
+
+  dpm->path[0][0]  = DNA_E_NM;
+  dpm->path[0][0] |= I_STATE_E_N;
+  for (m = 1; m <= dpm->ref_dp_length; m++) {
+    dpm->path[0][m]  = DNA_E_M;
+    dpm->path[0][m] |= I_STATE_I_N;
+  }
+
+  for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
+    dpm->score[DNA_E_STATE][n][0] = 0.0;
+    dpm->score[DNA_I_STATE][n][0] = 0.0;
+
+    for (m = 1; m <= dpm->ref_dp_length; m++) {
+      dpm->score[DNA_E_STATE][n][m] = (GthFlt) 0.0;
+      /* disallow intron status for 5' non-matching cDNA letters: */
+      dpm->score[DNA_I_STATE][n][m] = (GthFlt) GTH_MINUSINFINITY;
+    }
+
+    memset(dpm->intronstart[n], 0,
+           sizeof *dpm->intronstart[n] * (dpm->ref_dp_length + 1));
+    memset(dpm->exonstart[n], 0,
+           sizeof *dpm->exonstart[n] * (dpm->ref_dp_length + 1));
+  }
+}
+
+/* the following function frees the score, intronstart, and exonstart tables
+   for cDNAs/ESTs */
+static void dp_matrix_free_tables(GthDPMatrix *dpm)
+{
+  GtUword t, n;
+
+  /* freeing space for dpm->intronstart and dpm->exonstart */
+  for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
+    gt_free(dpm->intronstart[n]);
+    gt_free(dpm->exonstart[n]);
+  }
+
+  /* freeing space for dpm->score */
+  for (t = DNA_E_STATE; t < DNA_NUMOFSTATES; t++) {
+    for (n = 0; n < DNA_NUMOFSCORETABLES; n++)
+      gt_free(dpm->score[t][n]);
+  }
+}
+
+/* the following function allocates space for the DP tables for cDNAs/ESTs.
+   If <checkpointing> is true, only the backtrace matrix rows of one block and
+   the checkpoints are stored (see gth/dp_checkpoints.h). */
 static int dp_matrix_init(GthDPMatrix *dpm,
                           GtUword gen_dp_length,
                           GtUword ref_dp_length,
                           GtUword autoicmaxmatrixsize,
                           bool introncutout,
+                          bool checkpointing,
                           GthJumpTable *jump_table,
+                          GthDPWorkspace *dp_workspace,
                           GthStat *stat)
 {
-  GtUword t, n, m, matrixsize, sizeofpathtype =  sizeof (GthPath);
+  GtUword t, n, matrixsize, matrixspace, sizeofpathtype =  sizeof (GthPath);
 
   /* XXX: adjust this check for QUARTER_MATRIX case */
   if (DNA_NUMOFSTATES * sizeofpathtype * (gen_dp_length + 1) >=
@@ -68,71 +130,83 @@ static int dp_matrix_init(GthDPMatrix *dpm,
   matrixsize = gt_safe_mult_ulong((GT_DIV2(gen_dp_length + 1) +
                                    GT_MOD2(gen_dp_length + 1)),
                                    ref_dp_length + 1);
+  matrixspace = sizeofpathtype * matrixsize;
+
+  /* allocate space for dpm->score */
+  for (t = DNA_E_STATE; t < DNA_NUMOFSTATES; t++) {
+    for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
+      dpm->score[t][n] = gt_malloc(sizeof (GthFlt) * (ref_dp_length + 1));
+    }
+  }
+
+  /* allocating space for intronstart and exonstart */
+  for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
+    dpm->intronstart[n] = gt_malloc(sizeof *dpm->intronstart[n] *
+                                    (ref_dp_length + 1));
+    dpm->exonstart[n] = gt_malloc(sizeof *dpm->exonstart[n] *
+                                  (ref_dp_length + 1));
+  }
+
+  dpm->checkpoints = NULL;
+  if (checkpointing) {
+    /* two genomic positions share a row of the quarter matrix */
+    gt_assert(!jump_table);
+    dpm->checkpoints = gth_dp_checkpoints_new(gen_dp_length + 1, 2, 2,
+                                              ref_dp_length + 1);
+    for (t = DNA_E_STATE; t < DNA_NUMOFSTATES; t++) {
+      for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
+        gth_dp_checkpoints_add_table(dpm->checkpoints, dpm->score[t][n],
+                                     sizeof (GthFlt) * (ref_dp_length + 1));
+      }
+    }
+    for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
+      gth_dp_checkpoints_add_table(dpm->checkpoints, dpm->intronstart[n],
+                                   sizeof *dpm->intronstart[n] *
+                                   (ref_dp_length + 1));
+      gth_dp_checkpoints_add_table(dpm->checkpoints, dpm->exonstart[n],
+                                   sizeof *dpm->exonstart[n] *
+                                   (ref_dp_length + 1));
+    }
+    matrixspace = gth_dp_checkpoints_space(dpm->checkpoints);
+  }
 
   if (!introncutout && autoicmaxmatrixsize > 0) {
     /* in this case the automatic intron cutout technique is enabled
        check if allocated matrix would be larger as specified maximal
        matrix size. If so, return matrix allocation error */
-    if (sizeofpathtype * matrixsize * DNA_NUMOFSTATES >
+    if ((dpm->checkpoints ? matrixspace : matrixspace * DNA_NUMOFSTATES) >
         autoicmaxmatrixsize << 20) {
+      gth_dp_checkpoints_delete(dpm->checkpoints);
+      dp_matrix_free_tables(dpm);
       return GTH_ERROR_MATRIX_ALLOCATION_FAILED;
     }
   }
 
   /* allocate space for dpm->path */
-  if (jump_table) {
-    gth_array2dim_plain_calloc(dpm->path,
-                               GT_DIV2(gen_dp_length + 1) +
-                               GT_MOD2(gen_dp_length + 1), ref_dp_length + 1);
-  }
+  dpm->dp_workspace = dp_workspace;
+  if (dpm->checkpoints)
+    dpm->path = gth_dp_checkpoints_path(dpm->checkpoints);
   else {
-    gth_array2dim_plain_malloc(dpm->path,
-                               GT_DIV2(gen_dp_length + 1) +
-                               GT_MOD2(gen_dp_length + 1), ref_dp_length + 1);
+    dpm->path = gth_dp_workspace_get_path(dp_workspace,
+                                          GT_DIV2(gen_dp_length + 1) +
+                                          GT_MOD2(gen_dp_length + 1),
+                                          ref_dp_length + 1,
+                                          jump_table ? true : false);
   }
   dpm->path_jt = NULL;
-  if (!dpm->path)
+  if (!dpm->path) {
+    dp_matrix_free_tables(dpm);
     return GTH_ERROR_MATRIX_ALLOCATION_FAILED;
-
-  /* allocate space for dpm->score */
-  for (t = DNA_E_STATE; t < DNA_NUMOFSTATES; t++) {
-    for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
-      dpm->score[t][n] = gt_malloc(sizeof (GthFlt) * (ref_dp_length + 1));
-    }
-  }
-
-  /* allocating space for intronstart and exonstart */
-  for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
-    dpm->intronstart[n] = gt_calloc(ref_dp_length + 1,
-                                    sizeof *dpm->intronstart);
-    dpm->exonstart[n] = gt_calloc(ref_dp_length + 1, sizeof *dpm->exonstart);
   }
 
   /* initialize the DP matrices */
-  dpm->path[0][0]  = DNA_E_NM;
-  dpm->path[0][0] |= I_STATE_E_N;
-  for (m = 1; m <= ref_dp_length; m++) {
-    dpm->path[0][m]  = DNA_E_M;
-    dpm->path[0][m] |= I_STATE_I_N;
-  }
-
-  for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
-    dpm->score[DNA_E_STATE][n][0] = 0.0;
-    dpm->score[DNA_I_STATE][n][0] = 0.0;
-
-    for (m = 1; m <= ref_dp_length; m++) {
-      dpm->score[DNA_E_STATE][n][m] = (GthFlt) 0.0;
-      /* disallow intron status for 5' non-matching cDNA letters: */
-      dpm->score[DNA_I_STATE][n][m] = (GthFlt) GTH_MINUSINFINITY;
-    }
-  }
   dpm->gen_dp_length = gen_dp_length;
   dpm->ref_dp_length = ref_dp_length;
+  dp_matrix_init_first_row(dpm);
 
   /* statistics */
   gth_stat_increment_numofbacktracematrixallocations(stat);
-  gth_stat_increase_totalsizeofbacktracematricesinMB(stat,
-                                           (sizeofpathtype * matrixsize) >> 20);
+  gth_stat_increase_totalsizeofbacktracematricesinMB(stat, matrixspace >> 20);
 
   return 0;
 }
@@ -275,44 +349,224 @@ static void I_1m(GthDPMatrix *dpm, GtUword m, GthDbl log_1minusprobies)
   }
 }
 
-/* the following function evaluate the dynamic programming tables */
-static void dna_complete_path_matrix(GthDPMatrix *dpm,
-                                     const unsigned char *gen_seq_tran,
-                                     const unsigned char *ref_seq_tran,
-                                     GtUword genomic_offset,
-                                     GtAlphabet *gen_alphabet,
-                                     GthDPParam *dp_param,
-                                     GthDPOptionsEST *dp_options_est,
-                                     GthDPOptionsCore *dp_options_core)
+/* the following function precomputes the output weights */
+static GthDbl** dna_outputweights_new(GtAlphabet *gen_alphabet,
+                                      GthDPOptionsEST *dp_options_est)
+{
+  GthDbl **outputweights;
+  unsigned int gen_alphabet_mapsize = gt_alphabet_size(gen_alphabet);
+  GtUword n, m;
+
+  /* XXX: maybe make this smaller */
+  gt_array2dim_calloc(outputweights, UCHAR_MAX+1, UCHAR_MAX+1);
+  for (n = 0; n <= UCHAR_MAX; n++) {
+    for (m = 0; m <= UCHAR_MAX; m++) {
+      ADDOUTPUTWEIGHT(outputweights[n][m], n, m);
+    }
+  }
+  return outputweights;
+}
+
+#ifdef DNA_INTRON_STATES_SSE
+/* evaluates the intron states of row <n> like <dna_intron_states_row()>, four
+   cells at once, and returns the first cell which has not been evaluated.
+   Both compute the same values, the short exon penalty is subtracted in double
+   precision as well. */
+__attribute__ ((target ("sse4.2")))
+static GtUword dna_intron_states_row_sse(GthDPMatrix *dpm, GtUword n,
+                                         GthFlt log_donor,
+                                         GthFlt log_1minusacceptor,
+                                         GthDPOptionsCore *dp_options_core)
+{
+  const GthFlt *prev_e_score = dpm->score[DNA_E_STATE][GT_MOD2(n-1)],
+               *prev_i_score = dpm->score[DNA_I_STATE][GT_MOD2(n-1)];
+  const GtUword *prev_exonstart = dpm->exonstart[GT_MOD2(n-1)],
+                *prev_intronstart = dpm->intronstart[GT_MOD2(n-1)];
+  GthFlt *i_score = dpm->score[DNA_I_STATE][GT_MOD2(n)];
+  GtUword *intronstart = dpm->intronstart[GT_MOD2(n)], m,
+          ref_dp_length = dpm->ref_dp_length;
+  GthPath *path = dpm->path[GT_DIV2(n)];
+  bool acceptortrans = !dp_options_core->freeintrontrans;
+  const __m128i signbit = _mm_set1_epi64x((GtInt64)
+                                                  ((GtUint64) 1 << 63)),
+                minexonlength
+                  = _mm_xor_si128(_mm_set1_epi64x((GtInt64)
+                                                  dp_options_core->
+                                                  dpminexonlength),
+                                  signbit),
+                row = _mm_set1_epi64x((GtInt64) n),
+                retrace_e_n = _mm_set1_epi32(GT_MOD2(n) ? I_STATE_E_N << 4
+                                                        : I_STATE_E_N),
+                retrace_i_n = _mm_set1_epi32(GT_MOD2(n) ? I_STATE_I_N << 4
+                                                        : I_STATE_I_N);
+  const __m128 donor = _mm_set1_ps(log_donor),
+               acceptor = _mm_set1_ps(log_1minusacceptor);
+  const __m128d penalty = _mm_set1_pd(dp_options_core->shortexonpenalty);
+
+  m = 1;
+  /* the acceptor transition is left out for the last cell, which is done by
+     the scalar loop */
+  for (; m + 3 < ref_dp_length; m += 4) {
+    __m128 maxvec, valuevec, shortexon, better;
+    __m128i lo, hi, retracevec;
+    uint32_t pathbytes;
+
+    /* 0. */
+    maxvec = _mm_add_ps(_mm_loadu_ps(prev_e_score + m), donor);
+    lo = _mm_sub_epi64(row, _mm_loadu_si128((const __m128i *)
+                                            (prev_exonstart + m)));
+    hi = _mm_sub_epi64(row, _mm_loadu_si128((const __m128i *)
+                                            (prev_exonstart + m + 2)));
+    /* unsigned comparison of n - exonstart < dpminexonlength */
+    lo = _mm_cmpgt_epi64(minexonlength, _mm_xor_si128(lo, signbit));
+    hi = _mm_cmpgt_epi64(minexonlength, _mm_xor_si128(hi, signbit));
+    shortexon = _mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi),
+                               _MM_SHUFFLE(2, 0, 2, 0));
+    maxvec = _mm_blendv_ps(maxvec,
+                           _mm_movelh_ps(
+                             _mm_cvtpd_ps(_mm_sub_pd(_mm_cvtps_pd(maxvec),
+                                                     penalty)),
+                             _mm_cvtpd_ps(_mm_sub_pd(
+                               _mm_cvtps_pd(_mm_movehl_ps(maxvec, maxvec)),
+                               penalty))),
+                           shortexon);
+
+    /* 1. */
+    valuevec = _mm_loadu_ps(prev_i_score + m);
+    if (acceptortrans)
+      valuevec = _mm_add_ps(valuevec, acceptor);
+    better = _mm_cmplt_ps(maxvec, valuevec);
+
+    /* save maximum values */
+    _mm_storeu_ps(i_score + m, _mm_blendv_ps(maxvec, valuevec, better));
+    retracevec = _mm_blendv_epi8(retrace_e_n, retrace_i_n,
+                                 _mm_castps_si128(better));
+    retracevec = _mm_packus_epi16(_mm_packs_epi32(retracevec, retracevec),
+                                  retracevec);
+    pathbytes = (uint32_t) _mm_cvtsi128_si32(retracevec);
+    if (GT_MOD2(n)) {
+      uint32_t oldbytes;
+      memcpy(&oldbytes, path + m, sizeof oldbytes);
+      pathbytes |= oldbytes;
+    }
+    memcpy(path + m, &pathbytes, sizeof pathbytes);
+
+    /* begin of a new intron or continue existing intron */
+    lo = _mm_cvtepi32_epi64(_mm_castps_si128(better));
+    hi = _mm_cvtepi32_epi64(_mm_srli_si128(_mm_castps_si128(better), 8));
+    _mm_storeu_si128((__m128i *) (intronstart + m),
+                     _mm_blendv_epi8(row,
+                                     _mm_loadu_si128((const __m128i *)
+                                                     (prev_intronstart + m)),
+                                     lo));
+    _mm_storeu_si128((__m128i *) (intronstart + m + 2),
+                     _mm_blendv_epi8(row,
+                                     _mm_loadu_si128((const __m128i *)
+                                                     (prev_intronstart + m +
+                                                      2)),
+                                     hi));
+  }
+  return m;
+}
+#endif
+
+/* the following function evaluates the intron states I_nm of row <n> for all
+   <m> and stores their backtrace references. They only depend on the previous
+   row, therefore they are evaluated for the whole row before the exon states,
+   in a loop without dependencies between the cells.
+   <log_donor> is the (row invariant) transition weight from an exon state
+   and <log_1minusacceptor> the one from an intron state.
+   If the CPU supports SSE4.2, most cells are evaluated by
+   <dna_intron_states_row_sse()> and the remaining ones by the scalar loop. */
+static void dna_intron_states_row(GthDPMatrix *dpm, GtUword n,
+                                  GthFlt log_donor,
+                                  GthFlt log_1minusacceptor,
+                                  GthDPOptionsCore *dp_options_core)
+{
+  const GthFlt *prev_e_score = dpm->score[DNA_E_STATE][GT_MOD2(n-1)],
+               *prev_i_score = dpm->score[DNA_I_STATE][GT_MOD2(n-1)];
+  const GtUword *prev_exonstart = dpm->exonstart[GT_MOD2(n-1)],
+                *prev_intronstart = dpm->intronstart[GT_MOD2(n-1)];
+  GthFlt *i_score = dpm->score[DNA_I_STATE][GT_MOD2(n)], value, maxvalue;
+  GtUword *intronstart = dpm->intronstart[GT_MOD2(n)], m,
+          ref_dp_length = dpm->ref_dp_length;
+  GthPath *path = dpm->path[GT_DIV2(n)], retrace;
+  bool acceptortrans = !dp_options_core->freeintrontrans;
+
+  m = 1;
+#ifdef DNA_INTRON_STATES_SSE
+  if (__builtin_cpu_supports("sse4.2")) {
+    m = dna_intron_states_row_sse(dpm, n, log_donor, log_1minusacceptor,
+                                  dp_options_core);
+  }
+#endif
+  for (; m <= ref_dp_length; m++) {
+    /* 0. */
+    maxvalue = prev_e_score[m] + log_donor;
+    if (n - prev_exonstart[m] < dp_options_core->dpminexonlength)
+       maxvalue -= dp_options_core->shortexonpenalty;
+    retrace  = I_STATE_E_N;
+
+    /* 1. */
+    value = prev_i_score[m];
+    if (acceptortrans && m < ref_dp_length)
+      value += log_1minusacceptor;
+    UPDATEMAX(I_STATE_I_N);
+
+    /* save maximum values */
+    i_score[m] = maxvalue;
+    if (GT_MOD2(n))
+      path[m] |= (retrace << 4);
+    else
+      path[m]  = retrace;
+
+    /* begin of a new intron or continue existing intron */
+    intronstart[m] = retrace == I_STATE_E_N ? n : prev_intronstart[m];
+  }
+}
+
+/* the following function evaluates the dynamic programming tables for the
+   genomic positions <first_row> to <last_row> */
+static void dna_complete_path_matrix_rows(GthDPMatrix *dpm,
+                                          const unsigned char *gen_seq_tran,
+                                          const unsigned char *ref_seq_tran,
+                                          GtUword first_row,
+                                          GtUword last_row,
+                                          GtAlphabet *gen_alphabet,
+                                          GthDPParam *dp_param,
+                                          GthDPOptionsEST *dp_options_est,
+                                          GthDPOptionsCore *dp_options_core,
+                                          GthDbl **outputweights)
 {
   GthFlt value, maxvalue;
   GthPath retrace;
-  GtUword n, m, modn, modnminus1;
-  GthDbl rval, outputweight, **outputweights,
+  GtUword n, m, modn, modnminus1, ref_dp_length = dpm->ref_dp_length;
+  GthDbl rval, outputweight,
          log_probies,          /* initial exon state probability */
-         log_1minusprobies;    /* initial intron state probability */
+         log_1minusprobies,    /* initial intron state probability */
+         donor_rval,           /* row invariant transition weights */
+         acceptor_rval,
+         deletion_acceptor_rval = 0.0;
   GthFlt log_probdelgen,       /* deletion in genomic sequence */
          log_1minusprobdelgen;
+  const GthDbl *gen_outputweights;
+  const GthFlt *prev_e_score, *prev_i_score;
+  const GtUword *prev_exonstart, *prev_intronstart, *intronstart;
+  GthFlt *e_score, *i_score;
+  GtUword *exonstart;
+  GthPath *path;
+  bool lastrow;
   unsigned char genomicchar, referencechar;
-  unsigned int gen_alphabet_mapsize = gt_alphabet_size(gen_alphabet);
 
   gt_assert(dpm->gen_dp_length > 1);
+  gt_assert(first_row > 0 && last_row <= dpm->gen_dp_length);
 
   log_probies = (GthDbl) log((double) dp_options_est->probies);
   log_1minusprobies = (GthDbl) log(1.0 - dp_options_est->probies);
   log_probdelgen = (GthFlt) log((double) dp_options_est->probdelgen);
   log_1minusprobdelgen = (GthFlt) log(1.0 - dp_options_est->probdelgen);
 
-  /* precompute outputweights
-     XXX: move this to somewhere else, maybe make it smaller */
-  gt_array2dim_calloc(outputweights, UCHAR_MAX+1, UCHAR_MAX+1);
-  for (n = 0; n <= UCHAR_MAX; n++) {
-    for (m = 0; m <= UCHAR_MAX; m++) {
-      ADDOUTPUTWEIGHT(outputweights[n][m], n, m);
-    }
-  }
-
-  if (!genomic_offset) {
+  if (first_row == 1) {
     /* handle case for n equals 1 */
     dpm->path[0][0] |= UPPER_E_N;
     dpm->path[0][0] |= UPPER_I_STATE_I_N;
@@ -323,16 +577,12 @@ static void dna_complete_path_matrix(GthDPMatrix *dpm,
            dp_options_est, dp_options_core);
       I_1m(dpm, m, log_1minusprobies);
     }
+    first_row = 2;
   }
 
   /* handle all other n's
      stepping along the genomic sequence */
-  if (genomic_offset)
-    n = genomic_offset + 1;
-  else
-    n = 2;
-
-  for (; n <= dpm->gen_dp_length; n++) {
+  for (n = first_row; n <= last_row; n++) {
     modn = GT_MOD2(n);
     modnminus1 = GT_MOD2(n-1);
     genomicchar = gen_seq_tran[n-1];
@@ -346,154 +596,182 @@ static void dna_complete_path_matrix(GthDPMatrix *dpm,
       dpm->path[GT_DIV2(n)][0] |= I_STATE_I_N;
     }
 
+    /* evaluate I_nm for the whole row */
+    dna_intron_states_row(dpm, n,
+                          log_1minusprobdelgen + dp_param->log_Pdonor[n-1],
+                          dp_param->log_1minusPacceptor[n-2],
+                          dp_options_core);
+
+    /* the weights which do not depend on the position in the cDNA/EST */
+    gen_outputweights = outputweights[genomicchar];
+    donor_rval = (GthDbl) (log_1minusprobdelgen +
+                           dp_param->log_1minusPdonor[n-1]);
+    acceptor_rval = (GthDbl) (dp_param->log_Pacceptor[n-2] +
+                              log_1minusprobdelgen);
+    lastrow = n == dpm->gen_dp_length;
+    if (!lastrow) {
+      deletion_acceptor_rval = (GthDbl) (dp_param->log_Pacceptor[n-1] +
+                                         log_probdelgen);
+    }
+    prev_e_score = dpm->score[DNA_E_STATE][modnminus1];
+    prev_i_score = dpm->score[DNA_I_STATE][modnminus1];
+    prev_exonstart = dpm->exonstart[modnminus1];
+    prev_intronstart = dpm->intronstart[modnminus1];
+    e_score = dpm->score[DNA_E_STATE][modn];
+    i_score = dpm->score[DNA_I_STATE][modn];
+    exonstart = dpm->exonstart[modn];
+    intronstart = dpm->intronstart[modn];
+    path = dpm->path[GT_DIV2(n)];
+
     /* stepping along the cDNA/EST sequence */
-    for (m = 1; m <= dpm->ref_dp_length; m++) {
+    for (m = 1; m <= ref_dp_length; m++) {
       referencechar = ref_seq_tran[m-1];
 
       /* evaluate E_nm */
 
       /* 0. */
       outputweight = 0.0;
-      rval = (GthDbl) (log_1minusprobdelgen + dp_param->log_1minusPdonor[n-1]);
-      rval += outputweights[genomicchar][referencechar];
+      rval = donor_rval;
+      rval += gen_outputweights[referencechar];
       if ((m < dp_options_est->wdecreasedoutput ||
-           m > dpm->ref_dp_length - dp_options_est->wdecreasedoutput) &&
+           m > ref_dp_length - dp_options_est->wdecreasedoutput) &&
            genomicchar == referencechar) {
-        outputweight += outputweights[genomicchar][referencechar];
+        outputweight += gen_outputweights[referencechar];
         rval -= (outputweight / 2.0);
       }
-      maxvalue = (GthFlt) (dpm->score[DNA_E_STATE][modnminus1][m-1] + rval);
+      maxvalue = (GthFlt) (prev_e_score[m-1] + rval);
       retrace  = DNA_E_NM;
 
       /* 1. */
       outputweight = 0.0;
-      rval = (GthDbl) (dp_param->log_Pacceptor[n-2] + log_1minusprobdelgen);
-      rval += outputweights[genomicchar][referencechar];
+      rval = acceptor_rval;
+      rval += gen_outputweights[referencechar];
       if ((m < dp_options_est->wdecreasedoutput ||
-           m > dpm->ref_dp_length - dp_options_est->wdecreasedoutput) &&
+           m > ref_dp_length - dp_options_est->wdecreasedoutput) &&
            genomicchar == referencechar) {
-        outputweight += outputweights[genomicchar][referencechar];
+        outputweight += gen_outputweights[referencechar];
         rval -= (outputweight / 2.0);
       }
-      value = (GthFlt) (dpm->score[DNA_I_STATE][modnminus1][m-1] + rval);
+      value = (GthFlt) (prev_i_score[m-1] + rval);
       /* intron from intronstart to n-1 => n-1 - intronstart + 1 */
-      if (n - dpm->intronstart[modnminus1][m - 1] <
-          dp_options_core->dpminintronlength) {
+      if (n - prev_intronstart[m - 1] < dp_options_core->dpminintronlength)
         value -= dp_options_core->shortintronpenalty;
-      }
       UPDATEMAX(DNA_I_NM);
 
       /* 2. */
       rval = 0.0;
-      if (m < dpm->ref_dp_length || n < dp_options_est->wzerotransition)
-        rval += (log_1minusprobdelgen + dp_param->log_1minusPdonor[n-1]);
-      if (m < dpm->ref_dp_length)
-        rval += outputweights[genomicchar][DASH];
-      value = (GthFlt) (dpm->score[DNA_E_STATE][modnminus1][m] + rval);
+      if (m < ref_dp_length || n < dp_options_est->wzerotransition)
+        rval += donor_rval;
+      if (m < ref_dp_length)
+        rval += gen_outputweights[DASH];
+      value = (GthFlt) (prev_e_score[m] + rval);
       UPDATEMAX(DNA_E_N);
 
       /* 3. */
-      rval = (GthDbl) (dp_param->log_Pacceptor[n-2] + log_1minusprobdelgen);
-      if (m < dpm->ref_dp_length)
-        rval += outputweights[genomicchar][DASH];
-      value = (GthFlt) (dpm->score[DNA_I_STATE][modnminus1][m] + rval);
+      rval = acceptor_rval;
+      if (m < ref_dp_length)
+        rval += gen_outputweights[DASH];
+      value = (GthFlt) (prev_i_score[m] + rval);
       /* intron from intronstart to n-1 => n-1 - intronstart + 1 */
-      if (n - dpm->intronstart[modnminus1][m] <
-          dp_options_core->dpminintronlength) {
+      if (n - prev_intronstart[m] < dp_options_core->dpminintronlength)
         value -= dp_options_core->shortintronpenalty;
-      }
       UPDATEMAX(DNA_I_N);
 
       /* 4. */
       rval = 0.0;
-      if (n < dpm->gen_dp_length || m < dp_options_est->wzerotransition)
+      if (!lastrow || m < dp_options_est->wzerotransition)
         rval = (GthDbl) log_probdelgen;
-      if (n < dpm->gen_dp_length)
+      if (!lastrow)
         rval += outputweights[DASH][referencechar];
-      value = (GthFlt) (dpm->score[DNA_E_STATE][modn][m-1] + rval);
+      value = (GthFlt) (e_score[m-1] + rval);
       UPDATEMAX(DNA_E_M);
 
       /* 5. */
       rval = 0.0;
-      if (n < dpm->gen_dp_length)
-       rval += (dp_param->log_Pacceptor[n-1] + log_probdelgen);
-      if (n < dpm->gen_dp_length)
+      if (!lastrow) {
+        rval += deletion_acceptor_rval;
         rval += outputweights[DASH][referencechar];
-      value = (GthFlt) (dpm->score[DNA_I_STATE][modn][m-1] + rval);
+      }
+      value = (GthFlt) (i_score[m-1] + rval);
       /* intron from intronstart to n => n - intronstart + 1 */
-      if (n - dpm->intronstart[modn][m - 1] + 1 <
-          dp_options_core->dpminintronlength) {
+      if (n - intronstart[m - 1] + 1 < dp_options_core->dpminintronlength)
         value -= dp_options_core->shortintronpenalty;
-      }
       UPDATEMAX(DNA_I_M);
 
-      /* save maximum values */
-      dpm->score[DNA_E_STATE][modn][m] = maxvalue;
+      /* save maximum values, the backtrace reference of I_nm is already
+         stored */
+      e_score[m] = maxvalue;
       if (modn)
-        dpm->path[GT_DIV2(n)][m] |= (retrace << 4);
+        path[m] |= (retrace << 4);
       else
-        dpm->path[GT_DIV2(n)][m]  = retrace;
+        path[m] |= retrace;
 
       switch (retrace) {
         case DNA_I_NM:
         case DNA_I_N:
         case DNA_I_M:
-          dpm->exonstart[modn][m] = n;
+          exonstart[m] = n;
           break;
         case DNA_E_NM:
-          dpm->exonstart[modn][m] = dpm->exonstart[modnminus1][m - 1];
+          exonstart[m] = prev_exonstart[m - 1];
           break;
         case DNA_E_N:
-          dpm->exonstart[modn][m] = dpm->exonstart[modnminus1][m];
+          exonstart[m] = prev_exonstart[m];
           break;
         case DNA_E_M:
-          dpm->exonstart[modn][m] = dpm->exonstart[modn][m - 1];
-          break;
-        default: gt_assert(0);
-      }
-
-      /* evaluate I_nm */
-
-      /* 0. */
-      maxvalue = dpm->score[DNA_E_STATE][modnminus1][m] +
-                 (log_1minusprobdelgen + dp_param->log_Pdonor[n-1]);
-      if (n - dpm->exonstart[modnminus1][m]
-          < dp_options_core->dpminexonlength) {
-         maxvalue -= dp_options_core->shortexonpenalty;
-      }
-      retrace  = I_STATE_E_N;
-
-      /* 1. */
-      value = dpm->score[DNA_I_STATE][modnminus1][m];
-      if (!dp_options_core->freeintrontrans && m < dpm->ref_dp_length)
-        value += dp_param->log_1minusPacceptor[n-2];
-      UPDATEMAX(I_STATE_I_N);
-
-      /* save maximum values */
-      dpm->score[DNA_I_STATE][modn][m] = maxvalue;
-      if (modn)
-        dpm->path[GT_DIV2(n)][m] |= (retrace << 4);
-      else
-        dpm->path[GT_DIV2(n)][m] |= retrace;
-
-      switch (retrace) {
-       case I_STATE_E_N:
-          /* begin of a new intron */
-          dpm->intronstart[modn][m] = n;
-          break;
-        case I_STATE_I_N:
-          /* continue existing intron */
-          dpm->intronstart[modn][m] = dpm->intronstart[modnminus1][m];
+          exonstart[m] = exonstart[m - 1];
           break;
         default: gt_assert(0);
       }
     }
   }
+}
 
-  /* free space  */
+/* the following function evaluate the dynamic programming tables */
+static void dna_complete_path_matrix(GthDPMatrix *dpm,
+                                     const unsigned char *gen_seq_tran,
+                                     const unsigned char *ref_seq_tran,
+                                     GtUword genomic_offset,
+                                     GtAlphabet *gen_alphabet,
+                                     GthDPParam *dp_param,
+                                     GthDPOptionsEST *dp_options_est,
+                                     GthDPOptionsCore *dp_options_core)
+{
+  GthDbl **outputweights = dna_outputweights_new(gen_alphabet, dp_options_est);
+  dna_complete_path_matrix_rows(dpm, gen_seq_tran, ref_seq_tran,
+                                genomic_offset + 1, dpm->gen_dp_length,
+                                gen_alphabet, dp_param, dp_options_est,
+                                dp_options_core, outputweights);
   gt_array2dim_delete(outputweights);
 }
 
+/* the information needed to recompute a block of rows from its checkpoint */
+typedef struct {
+  GthDPMatrix *dpm;
+  const unsigned char *gen_seq_tran,
+                      *ref_seq_tran;
+  GtAlphabet *gen_alphabet;
+  GthDPParam *dp_param;
+  GthDPOptionsEST *dp_options_est;
+  GthDPOptionsCore *dp_options_core;
+  GthDbl **outputweights;
+} DnaCheckpointsInfo;
+
+static void dna_checkpoints_compute_rows(GtUword first_row, GtUword last_row,
+                                         void *data)
+{
+  DnaCheckpointsInfo *info = data;
+  if (!first_row) {
+    dp_matrix_init_first_row(info->dpm);
+    first_row = 1;
+  }
+  dna_complete_path_matrix_rows(info->dpm, info->gen_seq_tran,
+                                info->ref_seq_tran, first_row, last_row,
+                                info->gen_alphabet, info->dp_param,
+                                info->dp_options_est, info->dp_options_core,
+                                info->outputweights);
+}
+
 static void dna_include_exon(GthBacktracePath *backtrace_path,
                              GtUword exonlength)
 {
@@ -542,6 +820,8 @@ static int dna_evaltracepath(GthBacktracePath *backtrace_path, GthDPMatrix *dpm,
     /* here we map the quarter matrix bitvector stuff back on the simple Retrace
        types.  Thereby, no further changes on the backtracing procedure are
        necessary. */
+    if (dpm->checkpoints)
+      gth_dp_checkpoints_provide_row(dpm->checkpoints, genptr);
     pathtype = dpm->path[GT_DIV2(genptr)][refptr];
     if (dpm->path_jt)
       pathtype_jt = dpm->path_jt[GT_DIV2(genptr)][refptr];
@@ -746,22 +1026,13 @@ static int dna_find_optimal_path(GthBacktracePath *backtrace_path,
 /* the following function frees the DP tables for cDNAs/ESTs */
 static void dp_matrix_free(GthDPMatrix *dpm)
 {
-  GtUword t, n;
-
-  /* freeing space for dpm->intronstart and dpm->exonstart */
-  for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
-    gt_free(dpm->intronstart[n]);
-    gt_free(dpm->exonstart[n]);
-  }
-
-  /* freeing space for dpm->score */
-  for (t = DNA_E_STATE; t < DNA_NUMOFSTATES; t++) {
-    for (n = 0; n < DNA_NUMOFSCORETABLES; n++)
-      gt_free(dpm->score[t][n]);
-  }
+  dp_matrix_free_tables(dpm);
 
   /* freeing space for dpm->path */
-  gth_array2dim_plain_delete(dpm->path);
+  if (dpm->checkpoints)
+    gth_dp_checkpoints_delete(dpm->checkpoints);
+  else
+    gth_dp_workspace_release_path(dpm->dp_workspace, dpm->path);
   if (dpm->path_jt)
     gt_array2dim_delete(dpm->path_jt);
 }
@@ -997,7 +1268,8 @@ static void detect_small_terminal_exons(GthSA *sa,
   }
 
   if (dp_matrix_init(&dpm_terminal, gen_dp_length_terminal,
-                     ref_dp_length_terminal, 0, false, NULL, stat)) {
+                     ref_dp_length_terminal, 0, false, false, NULL, NULL,
+                     stat)) {
     /* out of memory */
     return;
   }
@@ -1135,7 +1407,8 @@ static void detect_small_initial_exons(GthSA *sa,
             gen_seq_bounds->end);
 
   if (dp_matrix_init(&dpm_initial, gen_dp_length_initial,
-                     ref_dp_length_initial, 0, false, NULL, stat)) {
+                     ref_dp_length_initial, 0, false, false, NULL, NULL,
+                     stat)) {
     /* out of memory */
     return;
   }
@@ -1244,6 +1517,7 @@ int gth_align_dna(GthSA *sa,
                   GthDNACompletePathMatrixJT dna_complete_path_matrix_jt,
                   GthJumpTable *jump_table,
                   GtUword ref_offset,
+                  GthDPWorkspace *dp_workspace,
                   GthStat *stat,
                   GtFile *outfp)
 {
@@ -1252,6 +1526,7 @@ int gth_align_dna(GthSA *sa,
   GthPathMatrix *pm = NULL;
   GthDPParam *dp_param;
   GthDPMatrix dpm;
+  DnaCheckpointsInfo checkpoints_info;
   int rval;
 
   gt_assert(gen_ranges);
@@ -1273,7 +1548,8 @@ int gth_align_dna(GthSA *sa,
                              introncutout ? spliced_seq->splicedseqlen
                                           : gen_dp_length,
                              ref_dp_length, autoicmaxmatrixsize, introncutout,
-                             jump_table, stat))) {
+                             dp_options_core->checkpointdp && !jump_table,
+                             jump_table, dp_workspace, stat))) {
     gth_dp_param_delete(dp_param);
     gth_spliced_seq_delete(spliced_seq);
     return rval;
@@ -1290,6 +1566,21 @@ int gth_align_dna(GthSA *sa,
                                 dp_options_est, dp_options_core, jump_table,
                                 gen_ranges, ref_dp_length, ref_offset, &pm);
   }
+  else if (dpm.checkpoints) {
+    /* the rows are recomputed blockwise during the backtracing */
+    checkpoints_info.dpm = &dpm;
+    checkpoints_info.gen_seq_tran = introncutout ? spliced_seq->splicedseq
+                                                 : gen_seq_tran + gen_dp_start;
+    checkpoints_info.ref_seq_tran = ref_seq_tran;
+    checkpoints_info.gen_alphabet = gen_alphabet;
+    checkpoints_info.dp_param = dp_param;
+    checkpoints_info.dp_options_est = dp_options_est;
+    checkpoints_info.dp_options_core = dp_options_core;
+    checkpoints_info.outputweights = dna_outputweights_new(gen_alphabet,
+                                                           dp_options_est);
+    gth_dp_checkpoints_fill(dpm.checkpoints, dna_checkpoints_compute_rows,
+                            &checkpoints_info);
+  }
   else {
     dna_complete_path_matrix(&dpm,
                              introncutout ? spliced_seq->splicedseq
@@ -1299,7 +1590,7 @@ int gth_align_dna(GthSA *sa,
   }
 
   /* debugging */
-  if (!dpm.path_jt &&
+  if (!dpm.path_jt && !dpm.checkpoints &&
       dp_options_core->btmatrixgenrange.start != GT_UNDEF_UWORD) {
     pm = gth_path_matrix_new(dpm.path, dpm.gen_dp_length, dpm.ref_dp_length,
                              &dp_options_core->btmatrixgenrange,
@@ -1307,13 +1598,16 @@ int gth_align_dna(GthSA *sa,
   }
 
   /* backtracing */
-  if ((rval = dna_find_optimal_path(gth_sa_backtrace_path(sa), &dpm,
-                                    ref_seq_tran,
-                                    introncutout ? spliced_seq->splicedseq
-                                                 : gen_seq_tran + gen_dp_start,
-                                    introncutout, spliced_seq, comments,
-                                    dp_options_core->noicinintroncheck, false,
-                                    pm, outfp))) {
+  rval = dna_find_optimal_path(gth_sa_backtrace_path(sa), &dpm, ref_seq_tran,
+                               introncutout ? spliced_seq->splicedseq
+                                            : gen_seq_tran + gen_dp_start,
+                               introncutout, spliced_seq, comments,
+                               dp_options_core->noicinintroncheck, false, pm,
+                               outfp);
+  if (dpm.checkpoints) {
+    gt_array2dim_delete(checkpoints_info.outputweights);
+  }
+  if (rval) {
     if (rval == GTH_ERROR_CUTOUT_NOT_IN_INTRON) {
       dp_matrix_free(&dpm);
       gth_dp_param_delete(dp_param);
@@ -1441,6 +1735,7 @@ GthSA* gth_align_dna_simple(GthInput *input,
                        NULL,
                        NULL,
                        0,
+                       NULL,
                        stat,
                        NULL);
   if (rval) {
@@ -22,6 +22,7 @@
 #include "gth/dp_options_core.h"
 #include "gth/dp_options_est.h"
 #include "gth/dp_options_postpro.h"
+#include "gth/dp_workspace.h"
 #include "gth/path_matrix.h"
 #include "gth/sa.h"
 
@@ -128,6 +129,7 @@ int gth_align_dna(GthSA*,
                   GthDNACompletePathMatrixJT complete_path_matrix_jt,
                   GthJumpTable *jump_table,
                   GtUword ref_offset,
+                  GthDPWorkspace*,
                   GthStat*,
                   GtFile*);
 
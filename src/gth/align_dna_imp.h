@@ -19,6 +19,8 @@
 #define ALIGN_DNA_IMP_H
 
 #include "gth/align_dna.h"
+#include "gth/dp_checkpoints.h"
+#include "gth/dp_workspace.h"
 
 #define DNA_NUMOFSCORETABLES  2
 
@@ -82,6 +84,9 @@ struct GthDPMatrix {
                 *exonstart[DNA_NUMOFSCORETABLES],
                 gen_dp_length,
                 ref_dp_length;
+  GthDPCheckpoints *checkpoints;    /* if set, <path> only contains the rows of
+                                       the current block */
+  GthDPWorkspace *dp_workspace;     /* <path> is taken from here, if set */
 };
 
 #endif
@@ -20,7 +20,6 @@
 #include "core/safearith.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
-#include "gth/array2dim_plain.h"
 #include "gth/gthenum.h"
 #include "gth/gtherror.h"
 #include "gth/align_protein_imp.h"
@@ -57,7 +56,7 @@ static void dp_table_core_free(DPtablecore *core)
     for (n = 0; n < PROTEIN_NUMOFSCORETABLES; n++)
       gt_free(core->score[t][n]);
   }
-  gth_array2dim_plain_delete(core->path);
+  gth_dp_workspace_release_path(core->dp_workspace, core->path);
 }
 
 static GthPath path_e_state_read(GthDPtables *dpm, unsigned int n,
@@ -121,7 +120,7 @@ static int dp_table_core_init(DPtablecore *core, GtUword gen_dp_length,
                               GtUword ref_dp_length,
                               GtUword autoicmaxmatrixsize,
                               bool introncutout, GthJumpTable *jump_table,
-                              GthStat *stat)
+                              GthDPWorkspace *dp_workspace, GthStat *stat)
 {
   GtUword matrixsize, t, n,
                 sizeofpathtype = sizeof (GthPath);
@@ -152,6 +151,7 @@ static int dp_table_core_init(DPtablecore *core, GtUword gen_dp_length,
       core->score[t][n] = NULL;
   }
   core->path = NULL;
+  core->dp_workspace = dp_workspace;
 
   /* allocating space for core->score and core->path */
   for (t = E_STATE; t < PROTEIN_NUMOFSTATES; t++) {
@@ -160,14 +160,9 @@ static int dp_table_core_init(DPtablecore *core, GtUword gen_dp_length,
     }
   }
 
-  if (jump_table) {
-    gth_array2dim_plain_calloc(core->path, gen_dp_length + 1,
-                               ref_dp_length + 1);
-  }
-  else {
-    gth_array2dim_plain_malloc(core->path, gen_dp_length + 1,
-                               ref_dp_length + 1);
-  }
+  core->path = gth_dp_workspace_get_path(dp_workspace, gen_dp_length + 1,
+                                         ref_dp_length + 1,
+                                         jump_table ? true : false);
   if (!core->path) {
     /* matrix allocation failed, return after free of allocated tables */
     dp_table_core_free(core);
@@ -198,19 +193,109 @@ static void initinput(GthAlignInputProtein *input,
   input->score_matrix_alpha = gth_input_score_matrix_alpha(gth_input);
 }
 
-/* the following function allocates space for the DP tables for proteins */
+/* the following function frees the DP tables for proteins */
+static void dp_tables_free(GthDPtables *dpm)
+{
+  GtUword n;
+
+  /* free core */
+  if (dpm->checkpoints) {
+    gth_dp_checkpoints_delete(dpm->checkpoints);
+    dpm->core.path = NULL;
+  }
+  dp_table_core_free(&dpm->core);
+
+  /* freespace for intronstart and splitcodon arrays */
+  for (n = 0; n < PROTEIN_NUMOFSCORETABLES; n++) {
+    gt_free(dpm->intronstart_A[n]);
+    gt_free(dpm->intronstart_B[n]);
+    gt_free(dpm->intronstart_C[n]);
+    gt_free(dpm->exonstart[n]);
+    gt_free(dpm->splitcodon_B[n]);
+    gt_free(dpm->splitcodon_C1[n]);
+    gt_free(dpm->splitcodon_C2[n]);
+  }
+}
+
+/* the following function allocates the backtrace matrix rows of one block and
+   registers all ring buffer tables of the DP for the checkpoints */
+static int dp_tables_checkpoints_init(GthDPtables *dpm, GtUword ref_dp_length,
+                                      GtUword autoicmaxmatrixsize,
+                                      bool introncutout, GthStat *stat)
+{
+  GtUword t, n, space;
+
+  for (t = E_STATE; t < PROTEIN_NUMOFSTATES; t++) {
+    for (n = 0; n < PROTEIN_NUMOFSCORETABLES; n++) {
+      gth_dp_checkpoints_add_table(dpm->checkpoints, dpm->core.score[t][n],
+                                   sizeof (GthFlt) * (ref_dp_length + 1));
+    }
+  }
+  for (n = 0; n < PROTEIN_NUMOFSCORETABLES; n++) {
+    gth_dp_checkpoints_add_table(dpm->checkpoints, dpm->intronstart_A[n],
+                                 sizeof (GtUword) * (ref_dp_length + 1));
+    gth_dp_checkpoints_add_table(dpm->checkpoints, dpm->intronstart_B[n],
+                                 sizeof (GtUword) * (ref_dp_length + 1));
+    gth_dp_checkpoints_add_table(dpm->checkpoints, dpm->intronstart_C[n],
+                                 sizeof (GtUword) * (ref_dp_length + 1));
+    if (dpm->exonstart[n]) {
+      gth_dp_checkpoints_add_table(dpm->checkpoints, dpm->exonstart[n],
+                                   sizeof (GtUword) * (ref_dp_length + 1));
+    }
+    gth_dp_checkpoints_add_table(dpm->checkpoints, dpm->splitcodon_B[n],
+                                 sizeof (unsigned char) * (ref_dp_length + 1));
+    gth_dp_checkpoints_add_table(dpm->checkpoints, dpm->splitcodon_C1[n],
+                                 sizeof (unsigned char) * (ref_dp_length + 1));
+    gth_dp_checkpoints_add_table(dpm->checkpoints, dpm->splitcodon_C2[n],
+                                 sizeof (unsigned char) * (ref_dp_length + 1));
+  }
+
+  space = gth_dp_checkpoints_space(dpm->checkpoints);
+  if (!introncutout && autoicmaxmatrixsize > 0 &&
+      space > autoicmaxmatrixsize << 20) {
+    return GTH_ERROR_MATRIX_ALLOCATION_FAILED;
+  }
+  dpm->core.path = gth_dp_checkpoints_path(dpm->checkpoints);
+
+  /* statistics */
+  gth_stat_increment_numofbacktracematrixallocations(stat);
+  gth_stat_increase_totalsizeofbacktracematricesinMB(stat, space >> 20);
+
+  return 0;
+}
+
+/* the following function allocates space for the DP tables for proteins.
+   If <checkpointing> is true, only the backtrace matrix rows of one block and
+   the checkpoints are stored (see gth/dp_checkpoints.h). */
 static int dp_tables_alloc(GthDPtables *dpm, GtUword gen_dp_length,
                            bool proteinexonpenal, GtUword ref_dp_length,
                            GtUword autoicmaxmatrixsize, bool introncutout,
-                           GthJumpTable *jump_table, GthStat *stat)
+                           bool checkpointing, GthJumpTable *jump_table,
+                           GthDPWorkspace *dp_workspace, GthStat *stat)
 {
-  GtUword n;
+  GtUword t, n;
   int rval;
 
   /* allocate core */
-  if ((rval = dp_table_core_init(&dpm->core, gen_dp_length, ref_dp_length,
-                                 autoicmaxmatrixsize, introncutout, jump_table,
-                                 stat))) {
+  dpm->checkpoints = NULL;
+  if (checkpointing) {
+    /* the first block has to contain the rows set by dp_tables_init() */
+    gt_assert(!jump_table);
+    for (t = E_STATE; t < PROTEIN_NUMOFSTATES; t++) {
+      for (n = 0; n < PROTEIN_NUMOFSCORETABLES; n++) {
+        dpm->core.score[t][n] = gt_malloc(sizeof (GthFlt) *
+                                          (ref_dp_length + 1));
+      }
+    }
+    dpm->core.path = NULL;
+    dpm->core.dp_workspace = NULL;
+    dpm->checkpoints = gth_dp_checkpoints_new(gen_dp_length + 1, 1,
+                                              PROTEIN_NUMOFSCORETABLES,
+                                              ref_dp_length + 1);
+  }
+  else if ((rval = dp_table_core_init(&dpm->core, gen_dp_length, ref_dp_length,
+                                      autoicmaxmatrixsize, introncutout,
+                                      jump_table, dp_workspace, stat))) {
     return rval;
   }
 
@@ -236,6 +321,14 @@ static int dp_tables_alloc(GthDPtables *dpm, GtUword gen_dp_length,
                                       (ref_dp_length + 1));
   }
 
+  if (dpm->checkpoints &&
+      (rval = dp_tables_checkpoints_init(dpm, ref_dp_length,
+                                         autoicmaxmatrixsize, introncutout,
+                                         stat))) {
+    dp_tables_free(dpm);
+    return rval;
+  }
+
   return 0;
 }
 
@@ -318,23 +411,29 @@ unsigned char gthgetcodon(unsigned char genomicchar1,
   return codon;
 }
 
-/* the following function evaluate the dynamic programming tables */
-static void complete_path_matrix(GthDPtables *dpm, GthAlignInputProtein *input,
-                                 bool proteinexonpenal,
-                                 const unsigned char *gen_seq_tran,
-                                 GtUword gen_dp_length,
-                                 GtUword ref_dp_length,
-                                 GthDPParam *dp_param,
-                                 GthDPOptionsCore *dp_options_core,
-                                 GthDPScoresProtein *dp_scores_protein)
+/* the following function evaluates the dynamic programming tables for the
+   genomic positions <first_row> to <last_row> */
+static void complete_path_matrix_rows(GthDPtables *dpm,
+                                      GthAlignInputProtein *input,
+                                      bool proteinexonpenal,
+                                      const unsigned char *gen_seq_tran,
+                                      GtUword gen_dp_length,
+                                      GtUword ref_dp_length,
+                                      GtUword first_row,
+                                      GtUword last_row,
+                                      GthDPParam *dp_param,
+                                      GthDPOptionsCore *dp_options_core,
+                                      GthDPScoresProtein *dp_scores_protein)
 {
   GtUword n, m, modn, modnminus1, modnminus2, modnminus3;
   unsigned char origreferencechar;
   GthFlt value, maxvalue;
   GthPath retrace;
 
+  gt_assert(first_row >= GENOMICDPSTART && last_row <= gen_dp_length);
+
   /* stepping along the genomic sequence */
-  for (n = GENOMICDPSTART; n <= gen_dp_length; n++) {
+  for (n = first_row; n <= last_row; n++) {
     modn       = GT_MOD4(n),
     modnminus1 = GT_MOD4(n-1),
     modnminus2 = GT_MOD4(n-2),
@@ -606,6 +705,50 @@ static void complete_path_matrix(GthDPtables *dpm, GthAlignInputProtein *input,
   }
 }
 
+/* the following function evaluate the dynamic programming tables */
+static void complete_path_matrix(GthDPtables *dpm, GthAlignInputProtein *input,
+                                 bool proteinexonpenal,
+                                 const unsigned char *gen_seq_tran,
+                                 GtUword gen_dp_length,
+                                 GtUword ref_dp_length,
+                                 GthDPParam *dp_param,
+                                 GthDPOptionsCore *dp_options_core,
+                                 GthDPScoresProtein *dp_scores_protein)
+{
+  complete_path_matrix_rows(dpm, input, proteinexonpenal, gen_seq_tran,
+                            gen_dp_length, ref_dp_length, GENOMICDPSTART,
+                            gen_dp_length, dp_param, dp_options_core,
+                            dp_scores_protein);
+}
+
+/* the information needed to recompute a block of rows from its checkpoint */
+typedef struct {
+  GthDPtables *dpm;
+  GthAlignInputProtein *input;
+  bool proteinexonpenal;
+  const unsigned char *gen_seq_tran;
+  GtUword gen_dp_length,
+          ref_dp_length;
+  GthDPParam *dp_param;
+  GthDPOptionsCore *dp_options_core;
+  GthDPScoresProtein *dp_scores_protein;
+} CheckpointsInfo;
+
+static void checkpoints_compute_rows(GtUword first_row, GtUword last_row,
+                                     void *data)
+{
+  CheckpointsInfo *info = data;
+  if (!first_row) {
+    dp_tables_init(info->dpm, info->proteinexonpenal, info->ref_dp_length);
+    first_row = GENOMICDPSTART;
+  }
+  complete_path_matrix_rows(info->dpm, info->input, info->proteinexonpenal,
+                            info->gen_seq_tran, info->gen_dp_length,
+                            info->ref_dp_length, first_row, last_row,
+                            info->dp_param, info->dp_options_core,
+                            info->dp_scores_protein);
+}
+
 static void include_exon(GthBacktracePath *backtrace_path,
                          GtUword exonlength)
 {
@@ -704,6 +847,8 @@ static int evaltracepath(GthBacktracePath *backtrace_path, GthDPtables *dpm,
     skipdummyprocessing = true;
 
   while ((genptr > 0) || (refptr > 0)) {
+    if (dpm->checkpoints)
+      gth_dp_checkpoints_provide_row(dpm->checkpoints, genptr);
     switch (actualstate) {
       case E_STATE:
         pathtype = path_e_state_read(dpm, genptr, refptr);
@@ -1025,26 +1170,6 @@ static int find_optimal_path(GthBacktracePath *backtrace_path, GthDPtables *dpm,
   return 0;
 }
 
-/* the following function frees the DP tables for proteins */
-static void dp_tables_free(GthDPtables *dpm)
-{
-  GtUword n;
-
-  /* free core */
-  dp_table_core_free(&dpm->core);
-
-  /* freespace for intronstart and splitcodon arrays */
-  for (n = 0; n < PROTEIN_NUMOFSCORETABLES; n++) {
-    gt_free(dpm->intronstart_A[n]);
-    gt_free(dpm->intronstart_B[n]);
-    gt_free(dpm->intronstart_C[n]);
-    gt_free(dpm->exonstart[n]);
-    gt_free(dpm->splitcodon_B[n]);
-    gt_free(dpm->splitcodon_C1[n]);
-    gt_free(dpm->splitcodon_C2[n]);
-  }
-}
-
 int gth_align_protein(GthSA *sa,
                       GtArray *gen_ranges,
                       const unsigned char *gen_seq_tran,
@@ -1069,6 +1194,7 @@ int gth_align_protein(GthSA *sa,
                       complete_path_matrix_jt,
                       GthJumpTable *jump_table,
                       GT_UNUSED GtUword ref_offset,
+                      GthDPWorkspace *dp_workspace,
                       GthStat *stat,
                       GtFile *outfp)
 {
@@ -1079,6 +1205,7 @@ int gth_align_protein(GthSA *sa,
   GthAlignInputProtein input;
   GtTransTable *transtable;
   GthDPtables dpm;
+  CheckpointsInfo checkpoints_info;
   int rval;
 
   gt_assert(gen_ranges);
@@ -1105,8 +1232,9 @@ int gth_align_protein(GthSA *sa,
   if ((rval = dp_tables_alloc(&dpm, introncutout ? spliced_seq->splicedseqlen
                                                  : gen_dp_length,
                               proteinexonpenal, ref_dp_length,
-                              autoicmaxmatrixsize, introncutout, jump_table,
-                              stat))) {
+                              autoicmaxmatrixsize, introncutout,
+                              dp_options_core->checkpointdp && !jump_table,
+                              jump_table, dp_workspace, stat))) {
     gth_dp_param_delete(dp_param);
     gth_spliced_seq_delete(spliced_seq);
     gth_dp_scores_protein_delete(dp_scores_protein);
@@ -1135,6 +1263,23 @@ int gth_align_protein(GthSA *sa,
   }
   else {
 #endif
+  if (dpm.checkpoints) {
+    /* the rows are recomputed blockwise during the backtracing */
+    checkpoints_info.dpm = &dpm;
+    checkpoints_info.input = &input;
+    checkpoints_info.proteinexonpenal = proteinexonpenal;
+    checkpoints_info.gen_seq_tran = introncutout ? spliced_seq->splicedseq
+                                                 : gen_seq_tran + gen_dp_start;
+    checkpoints_info.gen_dp_length = introncutout ? spliced_seq->splicedseqlen
+                                                  : gen_dp_length;
+    checkpoints_info.ref_dp_length = ref_dp_length;
+    checkpoints_info.dp_param = dp_param;
+    checkpoints_info.dp_options_core = dp_options_core;
+    checkpoints_info.dp_scores_protein = dp_scores_protein;
+    gth_dp_checkpoints_fill(dpm.checkpoints, checkpoints_compute_rows,
+                            &checkpoints_info);
+  }
+  else {
     complete_path_matrix(&dpm, &input, proteinexonpenal,
                          introncutout ? spliced_seq->splicedseq
                                       : gen_seq_tran + gen_dp_start,
@@ -1142,6 +1287,7 @@ int gth_align_protein(GthSA *sa,
                                       : gen_dp_length,
                          ref_dp_length, dp_param, dp_options_core,
                          dp_scores_protein);
+  }
 
   /* backtracing */
   if ((rval = find_optimal_path(gth_sa_backtrace_path(sa), &dpm, ref_dp_length,
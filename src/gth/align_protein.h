@@ -21,6 +21,7 @@
 #include "core/trans_table_api.h"
 #include "gth/dp_options_core.h"
 #include "gth/dp_options_postpro.h"
+#include "gth/dp_workspace.h"
 #include "gth/spliced_seq.h"
 #include "gth/align_common.h"
 #include "gth/dp_scores_protein.h"
@@ -84,6 +85,7 @@ int gth_align_protein(GthSA*,
                       GthProteinCompletePathMatrixJT complete_path_matrix_jt,
                       GthJumpTable *jump_table,
                       GtUword ref_offset,
+                      GthDPWorkspace*,
                       GthStat*,
                       GtFile*);
 
@@ -19,6 +19,8 @@
 #define ALIGN_PROTEIN_IMP_H
 
 #include "gth/align_protein.h"
+#include "gth/dp_checkpoints.h"
+#include "gth/dp_workspace.h"
 
 #define WSIZE_PROTEIN   20
 #define WSIZE_DNA       60 /* (3 * WSIZE_PROTEIN) */
@@ -78,6 +80,7 @@ typedef struct {
   /* table to store the score of a path */
   GthFlt *score[PROTEIN_NUMOFSTATES][PROTEIN_NUMOFSCORETABLES];
   GthPath **path; /* backtrace table of size gen_dp_length * ref_dp_length */
+  GthDPWorkspace *dp_workspace; /* <path> is taken from here, if set */
 } DPtablecore;
 
 /* structure of a path matrix byte:
@@ -110,6 +113,8 @@ struct GthDPtables {
   unsigned char *splitcodon_B[PROTEIN_NUMOFSCORETABLES],
                 *splitcodon_C1[PROTEIN_NUMOFSCORETABLES],
                 *splitcodon_C2[PROTEIN_NUMOFSCORETABLES];
+  GthDPCheckpoints *checkpoints; /* if set, <core.path> only contains the rows
+                                    of the current block */
 };
 
 #endif
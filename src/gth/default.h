@@ -106,6 +106,8 @@
 #define GTH_DEFAULT_JTOVERLAP            5
 #define GTH_DEFAULT_JTDEBUG              false
 
+#define GTH_DEFAULT_CHECKPOINTDP         false
+
 #define GTH_DEFAULT_PROBIES              0.5
 #define GTH_DEFAULT_PROBDELGEN           0.03
 #define GTH_DEFAULT_IDENTITYWEIGHT       2.0
@@ -0,0 +1,218 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <math.h>
+#include <string.h>
+#include "core/array_api.h"
+#include "core/ma_api.h"
+#include "core/undef_api.h"
+#include "gth/dp_checkpoints.h"
+
+typedef struct {
+  void *table;
+  size_t size;
+} DPCheckpointsTable;
+
+struct GthDPCheckpoints {
+  GtUword num_of_rows,
+          num_of_path_rows,
+          path_row_length,
+          rows_per_block,
+          num_of_blocks,
+          current_block;
+  unsigned int rows_per_path_row,
+               min_rows_per_block;
+  GtArray *tables;
+  size_t state_size;
+  GthPath **path,
+          *block;
+  unsigned char *states; /* the saved states of all blocks except the first */
+  GthDPCheckpointsComputeRows compute_rows;
+  void *data;
+};
+
+GthDPCheckpoints* gth_dp_checkpoints_new(GtUword num_of_rows,
+                                         unsigned int rows_per_path_row,
+                                         unsigned int min_rows_per_block,
+                                         GtUword path_row_length)
+{
+  GthDPCheckpoints *cp;
+  gt_assert(num_of_rows && rows_per_path_row && path_row_length);
+  cp = gt_calloc(1, sizeof *cp);
+  cp->num_of_rows = num_of_rows;
+  cp->num_of_path_rows = (num_of_rows + rows_per_path_row - 1)
+                         / rows_per_path_row;
+  cp->path_row_length = path_row_length;
+  cp->rows_per_path_row = rows_per_path_row;
+  cp->min_rows_per_block = min_rows_per_block;
+  cp->tables = gt_array_new(sizeof (DPCheckpointsTable));
+  cp->current_block = GT_UNDEF_UWORD;
+  return cp;
+}
+
+void gth_dp_checkpoints_add_table(GthDPCheckpoints *cp, void *table,
+                                  size_t size)
+{
+  DPCheckpointsTable t;
+  gt_assert(cp && table && !cp->path);
+  t.table = table;
+  t.size = size;
+  gt_array_add(cp->tables, t);
+  cp->state_size += size;
+}
+
+/* Chooses the number of rows per block which minimizes the space for the saved
+   states (num_of_rows / rows_per_block many) plus the backtrace matrix rows of
+   one block. */
+static GtUword dp_checkpoints_rows_per_block(const GthDPCheckpoints *cp)
+{
+  GtUword rows_per_block, r = cp->rows_per_path_row;
+  rows_per_block = (GtUword) sqrt((double) cp->num_of_rows * cp->state_size
+                                  * r / cp->path_row_length);
+  if (rows_per_block < cp->min_rows_per_block)
+    rows_per_block = cp->min_rows_per_block;
+  if (rows_per_block > cp->num_of_rows)
+    rows_per_block = cp->num_of_rows;
+  /* a block must not split a backtrace matrix row */
+  return (rows_per_block + r - 1) / r * r;
+}
+
+GtUword gth_dp_checkpoints_space(const GthDPCheckpoints *cp)
+{
+  GtUword rows_per_block, num_of_blocks;
+  gt_assert(cp);
+  rows_per_block = dp_checkpoints_rows_per_block(cp);
+  num_of_blocks = (cp->num_of_rows + rows_per_block - 1) / rows_per_block;
+  return cp->num_of_path_rows * sizeof (GthPath*) +
+         rows_per_block / cp->rows_per_path_row * cp->path_row_length
+         * sizeof (GthPath) + (num_of_blocks - 1) * cp->state_size;
+}
+
+static void dp_checkpoints_map_block(GthDPCheckpoints *cp, GtUword block)
+{
+  GtUword i, first, last;
+  gt_assert(block < cp->num_of_blocks);
+  if (cp->current_block != GT_UNDEF_UWORD) {
+    first = cp->current_block * cp->rows_per_block / cp->rows_per_path_row;
+    last = first + cp->rows_per_block / cp->rows_per_path_row;
+    if (last > cp->num_of_path_rows)
+      last = cp->num_of_path_rows;
+    for (i = first; i < last; i++)
+      cp->path[i] = NULL;
+  }
+  first = block * cp->rows_per_block / cp->rows_per_path_row;
+  last = first + cp->rows_per_block / cp->rows_per_path_row;
+  if (last > cp->num_of_path_rows)
+    last = cp->num_of_path_rows;
+  for (i = first; i < last; i++)
+    cp->path[i] = cp->block + (i - first) * cp->path_row_length;
+  cp->current_block = block;
+}
+
+GthPath** gth_dp_checkpoints_path(GthDPCheckpoints *cp)
+{
+  gt_assert(cp);
+  if (!cp->path) {
+    cp->rows_per_block = dp_checkpoints_rows_per_block(cp);
+    cp->num_of_blocks = (cp->num_of_rows + cp->rows_per_block - 1)
+                        / cp->rows_per_block;
+    cp->path = gt_calloc(cp->num_of_path_rows, sizeof *cp->path);
+    cp->block = gt_malloc(sizeof *cp->block * cp->path_row_length *
+                          (cp->rows_per_block / cp->rows_per_path_row));
+    if (cp->num_of_blocks > 1) {
+      cp->states = gt_malloc(cp->state_size * (cp->num_of_blocks - 1));
+    }
+    dp_checkpoints_map_block(cp, 0);
+  }
+  return cp->path;
+}
+
+static void dp_checkpoints_save(GthDPCheckpoints *cp, GtUword block)
+{
+  DPCheckpointsTable *t;
+  unsigned char *state;
+  GtUword i;
+  gt_assert(block > 0);
+  state = cp->states + (block - 1) * cp->state_size;
+  for (i = 0; i < gt_array_size(cp->tables); i++) {
+    t = gt_array_get(cp->tables, i);
+    memcpy(state, t->table, t->size);
+    state += t->size;
+  }
+}
+
+static void dp_checkpoints_restore(GthDPCheckpoints *cp, GtUword block)
+{
+  DPCheckpointsTable *t;
+  unsigned char *state;
+  GtUword i;
+  gt_assert(block > 0);
+  state = cp->states + (block - 1) * cp->state_size;
+  for (i = 0; i < gt_array_size(cp->tables); i++) {
+    t = gt_array_get(cp->tables, i);
+    memcpy(t->table, state, t->size);
+    state += t->size;
+  }
+}
+
+static void dp_checkpoints_compute_block(GthDPCheckpoints *cp, GtUword block)
+{
+  GtUword first, last;
+  first = block * cp->rows_per_block;
+  last = first + cp->rows_per_block - 1;
+  if (last >= cp->num_of_rows)
+    last = cp->num_of_rows - 1;
+  dp_checkpoints_map_block(cp, block);
+  cp->compute_rows(first, last, cp->data);
+}
+
+void gth_dp_checkpoints_fill(GthDPCheckpoints *cp,
+                             GthDPCheckpointsComputeRows compute_rows,
+                             void *data)
+{
+  GtUword block;
+  gt_assert(cp && compute_rows);
+  (void) gth_dp_checkpoints_path(cp);
+  cp->compute_rows = compute_rows;
+  cp->data = data;
+  for (block = 0; block < cp->num_of_blocks; block++) {
+    if (block > 0)
+      dp_checkpoints_save(cp, block);
+    dp_checkpoints_compute_block(cp, block);
+  }
+}
+
+void gth_dp_checkpoints_provide_row(GthDPCheckpoints *cp, GtUword row)
+{
+  GtUword block;
+  gt_assert(cp && cp->compute_rows && row < cp->num_of_rows);
+  block = row / cp->rows_per_block;
+  if (block != cp->current_block) {
+    if (block > 0)
+      dp_checkpoints_restore(cp, block);
+    dp_checkpoints_compute_block(cp, block);
+  }
+}
+
+void gth_dp_checkpoints_delete(GthDPCheckpoints *cp)
+{
+  if (!cp) return;
+  gt_free(cp->states);
+  gt_free(cp->block);
+  gt_free(cp->path);
+  gt_array_delete(cp->tables);
+  gt_free(cp);
+}
@@ -0,0 +1,70 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef DP_CHECKPOINTS_H
+#define DP_CHECKPOINTS_H
+
+#include <stddef.h>
+#include "gth/align_common.h"
+
+/* A <GthDPCheckpoints> object allows to compute a DP whose rows only depend on
+   a fixed number of previous rows (kept in ring buffer tables) without storing
+   the complete backtrace matrix. The rows of the DP are grouped into blocks of
+   about sqrt(n) rows. During the forward pass the ring buffer tables are saved
+   at the start of every block and only the backtrace matrix rows of the current
+   block are kept. During the backtracing the block containing a requested row
+   is recomputed from its checkpoint. Since the recomputation starts from the
+   very same state, the backtrace matrix rows are identical to the ones of a
+   complete computation. The space requirement drops from O(n*m) to
+   O(sqrt(n)*m) at the price of computing the DP twice. */
+typedef struct GthDPCheckpoints GthDPCheckpoints;
+
+/* Computes the DP rows <first_row> to <last_row>. For <first_row> == 0 the
+   ring buffer tables and the first backtrace matrix rows have to be
+   initialized. */
+typedef void (*GthDPCheckpointsComputeRows)(GtUword first_row,
+                                            GtUword last_row, void *data);
+
+/* Returns a new <GthDPCheckpoints> object for a DP with <num_of_rows> rows
+   (including row 0). <rows_per_path_row> DP rows share one backtrace matrix row
+   of length <path_row_length>. Every block contains at least
+   <min_rows_per_block> rows. */
+GthDPCheckpoints* gth_dp_checkpoints_new(GtUword num_of_rows,
+                                         unsigned int rows_per_path_row,
+                                         unsigned int min_rows_per_block,
+                                         GtUword path_row_length);
+/* Adds the ring buffer <table> of <size> bytes to the saved state. All tables
+   have to be added before <gth_dp_checkpoints_path()> is called. */
+void              gth_dp_checkpoints_add_table(GthDPCheckpoints*, void *table,
+                                               size_t size);
+/* Returns the space in bytes required for the backtrace matrix rows and the
+   checkpoints. */
+GtUword           gth_dp_checkpoints_space(const GthDPCheckpoints*);
+/* Returns the row pointers of the backtrace matrix. Only the rows of the
+   current block (the first one before <gth_dp_checkpoints_fill()>) point to
+   valid memory. */
+GthPath**         gth_dp_checkpoints_path(GthDPCheckpoints*);
+/* Computes all DP rows blockwise with <compute_rows> and saves the
+   checkpoints. Afterwards the last block is the current one. */
+void              gth_dp_checkpoints_fill(GthDPCheckpoints*,
+                                          GthDPCheckpointsComputeRows
+                                          compute_rows, void *data);
+/* Makes sure that the backtrace matrix row of DP row <row> is available. */
+void              gth_dp_checkpoints_provide_row(GthDPCheckpoints*,
+                                                 GtUword row);
+void              gth_dp_checkpoints_delete(GthDPCheckpoints*);
+
+#endif
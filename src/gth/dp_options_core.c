@@ -35,6 +35,7 @@ GthDPOptionsCore* gth_dp_options_core_new(void)
   dp_options_core->btmatrixrefrange.end = GT_UNDEF_UWORD;
   dp_options_core->jtoverlap = GTH_DEFAULT_JTOVERLAP;
   dp_options_core->jtdebug = GTH_DEFAULT_JTDEBUG;
+  dp_options_core->checkpointdp = GTH_DEFAULT_CHECKPOINTDP;
   return dp_options_core;
 }
 
@@ -33,7 +33,10 @@ typedef struct {
   GtRange btmatrixgenrange,
           btmatrixrefrange;
   GtUword jtoverlap;
-  bool jtdebug;
+  bool jtdebug,
+       checkpointdp;              /* store only checkpoints of the DP tables
+                                     and recompute the backtrace matrix
+                                     blockwise */
 } GthDPOptionsCore;
 
 GthDPOptionsCore* gth_dp_options_core_new(void);
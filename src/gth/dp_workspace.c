@@ -0,0 +1,158 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/assert_api.h"
+#include "core/divmodmul.h"
+#include "core/ma_api.h"
+#include "core/minmax.h"
+#include "core/unused_api.h"
+#include "gth/array2dim_plain.h"
+#include "gth/dp_workspace.h"
+
+#define DP_WORKSPACE_STATS_BUF_SIZE 160
+
+struct GthDPWorkspace {
+  GthPath **rows,
+          *entries;
+  GtUword num_of_rows,    /* allocated row pointers */
+          num_of_entries, /* allocated matrix entries */
+          num_of_requests,
+          num_of_reuses,
+          num_of_allocations,
+          num_of_separate_allocations;
+  size_t peak_size;
+  bool in_use;
+};
+
+GthDPWorkspace* gth_dp_workspace_new(void)
+{
+  return gt_calloc(1, sizeof (GthDPWorkspace));
+}
+
+/* returns the new size of a table with <allocated> elements which has to hold
+   at least <needed> elements */
+static GtUword dp_workspace_grow(GtUword allocated, GtUword needed)
+{
+  return MAX(allocated + GT_DIV2(allocated), needed);
+}
+
+/* makes sure that <dpw> has space for <rows> row pointers and <entries>
+   entries. Returns false if the memory could not be allocated. */
+static bool dp_workspace_reserve(GthDPWorkspace *dpw, GtUword rows,
+                                 GtUword entries)
+{
+  GtUword size;
+  size_t space;
+  if (rows > dpw->num_of_rows) {
+    size = dp_workspace_grow(dpw->num_of_rows, rows);
+    free(dpw->rows);
+    if (!(dpw->rows = malloc(sizeof *dpw->rows * size)) &&
+        !(dpw->rows = malloc(sizeof *dpw->rows * (size = rows)))) {
+      dpw->num_of_rows = 0;
+      return false;
+    }
+    dpw->num_of_rows = size;
+  }
+  if (entries > dpw->num_of_entries) {
+    /* the content does not have to be kept, therefore no realloc(3) */
+    size = dp_workspace_grow(dpw->num_of_entries, entries);
+    free(dpw->entries);
+    if (!(dpw->entries = malloc(sizeof *dpw->entries * size)) &&
+        !(dpw->entries = malloc(sizeof *dpw->entries * (size = entries)))) {
+      dpw->num_of_entries = 0;
+      return false;
+    }
+    dpw->num_of_entries = size;
+    dpw->num_of_allocations++;
+  }
+  space = sizeof *dpw->rows * dpw->num_of_rows +
+          sizeof *dpw->entries * dpw->num_of_entries;
+  dpw->peak_size = MAX(dpw->peak_size, space);
+  return true;
+}
+
+GthPath** gth_dp_workspace_get_path(GthDPWorkspace *dpw, GtUword rows,
+                                    GtUword columns, bool clear)
+{
+  GthPath **path;
+  GtUword i, entries = rows * columns,
+          num_of_allocations;
+
+  if (!dpw || dpw->in_use) {
+    if (dpw)
+      dpw->num_of_separate_allocations++;
+    if (clear) {
+      gth_array2dim_plain_calloc(path, rows, columns);
+    }
+    else {
+      gth_array2dim_plain_malloc(path, rows, columns);
+    }
+    return path;
+  }
+
+  dpw->num_of_requests++;
+  num_of_allocations = dpw->num_of_allocations;
+  if (!dp_workspace_reserve(dpw, rows, entries))
+    return NULL;
+  if (dpw->num_of_allocations == num_of_allocations)
+    dpw->num_of_reuses++;
+  for (i = 0; i < rows; i++)
+    dpw->rows[i] = dpw->entries + i * columns;
+  if (clear)
+    memset(dpw->entries, 0, sizeof *dpw->entries * entries);
+  dpw->in_use = true;
+  return dpw->rows;
+}
+
+void gth_dp_workspace_release_path(GthDPWorkspace *dpw, GthPath **path)
+{
+  if (!path)
+    return;
+  if (dpw && dpw->in_use && path == dpw->rows)
+    dpw->in_use = false;
+  else {
+    gth_array2dim_plain_delete(path);
+  }
+}
+
+void gth_dp_workspace_show_stats(const GthDPWorkspace *dpw,
+                                 GthShowVerbose showverbose)
+{
+  char buf[DP_WORKSPACE_STATS_BUF_SIZE];
+  GT_UNUSED int rval;
+  gt_assert(dpw && showverbose);
+  rval = snprintf(buf, DP_WORKSPACE_STATS_BUF_SIZE,
+                  "DP workspace: " GT_WU " backtrace matrices, " GT_WU
+                  " reused, " GT_WU " allocations, " GT_WU
+                  " separate allocations, peak size " GT_WU " MB",
+                  dpw->num_of_requests, dpw->num_of_reuses,
+                  dpw->num_of_allocations, dpw->num_of_separate_allocations,
+                  (GtUword) (dpw->peak_size >> 20));
+  gt_assert(rval < DP_WORKSPACE_STATS_BUF_SIZE);
+  showverbose(buf);
+}
+
+void gth_dp_workspace_delete(GthDPWorkspace *dpw)
+{
+  if (!dpw) return;
+  gt_assert(!dpw->in_use);
+  free(dpw->entries);
+  free(dpw->rows);
+  gt_free(dpw);
+}
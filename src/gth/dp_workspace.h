@@ -0,0 +1,49 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef DP_WORKSPACE_H
+#define DP_WORKSPACE_H
+
+#include <stdbool.h>
+#include "gth/align_common.h"
+#include "gth/gthoutput.h"
+
+/* A <GthDPWorkspace> keeps the backtrace matrix of the DP between the
+   alignments of a run, so that it does not have to be allocated and freed for
+   every single alignment. The memory grows geometrically and is only freed
+   when the workspace is deleted. Only one backtrace matrix can be taken from
+   a workspace at a time; a workspace must not be shared between threads. */
+typedef struct GthDPWorkspace GthDPWorkspace;
+
+GthDPWorkspace* gth_dp_workspace_new(void);
+/* Returns a backtrace matrix with <rows> rows of length <columns>, all entries
+   are zero if <clear> is true. If <dp_workspace> is NULL or its matrix is
+   already in use, the matrix is allocated separately. Returns NULL if the
+   memory could not be allocated. */
+GthPath**       gth_dp_workspace_get_path(GthDPWorkspace *dp_workspace,
+                                          GtUword rows, GtUword columns,
+                                          bool clear);
+/* Gives the backtrace matrix <path> obtained from
+   <gth_dp_workspace_get_path()> back to <dp_workspace>. */
+void            gth_dp_workspace_release_path(GthDPWorkspace *dp_workspace,
+                                              GthPath **path);
+/* Shows the reuse statistics and the peak size of <dp_workspace> with
+   <showverbose>. */
+void            gth_dp_workspace_show_stats(const GthDPWorkspace*,
+                                            GthShowVerbose showverbose);
+void            gth_dp_workspace_delete(GthDPWorkspace*);
+
+#endif
@@ -0,0 +1,672 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include "core/alphabet_api.h"
+#include "core/array_api.h"
+#include "core/chardef.h"
+#include "core/dynalloc.h"
+#include "core/fileutils_api.h"
+#include "core/ma.h"
+#include "core/seq_iterator_sequence_buffer_api.h"
+#include "core/str_array_api.h"
+#include "core/timer_api.h"
+#include "core/undef_api.h"
+#include "core/unused_api.h"
+#include "core/xposix.h"
+#include "gth/align_dna.h"
+#include "gth/align_protein.h"
+#include "gth/call_info.h"
+#include "gth/default.h"
+#include "gth/gt_gthdpbench.h"
+#include "gth/gthdef.h"
+#include "gth/sa_collection.h"
+#include "gth/seq_con_rep.h"
+#include "gth/similarity_filter.h"
+
+typedef struct {
+  bool checkpoint,
+       protein,
+       workspace,
+       chains,
+       verbose;
+  GtRange range;
+  GtUword refs;
+  unsigned int first;
+  GtStr *scorematrix;
+} GtGthdpbenchArguments;
+
+/* a sequence container holding the encoded DNA sequences of a file, the
+   original and the transformed sequences are the same */
+typedef struct {
+  GthSeqCon parent_instance;
+  GtAlphabet *alphabet;
+  GtUchar *seq,
+          *seq_rc; /* every sequence is reverse complemented in place */
+  GtArray *ranges;
+  GtStrArray *descs;
+  GtUword total_length;
+} GtGthdpbenchSeqCon;
+
+static void* gt_gthdpbench_arguments_new(void)
+{
+  GtGthdpbenchArguments *arguments = gt_calloc((size_t) 1, sizeof *arguments);
+  arguments->scorematrix = gt_str_new();
+  return arguments;
+}
+
+static void gt_gthdpbench_arguments_delete(void *tool_arguments)
+{
+  GtGthdpbenchArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_str_delete(arguments->scorematrix);
+  gt_free(arguments);
+}
+
+static GtOptionParser* gt_gthdpbench_option_parser_new(void *tool_arguments)
+{
+  GtGthdpbenchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option, *protein_option, *chains_option, *first_option;
+
+  gt_assert(arguments);
+
+  /* init */
+  op = gt_option_parser_new("[option ...] genomic_file reference_file",
+                            "Align each cDNA/EST (or protein) sequence of "
+                            "reference_file to the first sequence of "
+                            "genomic_file with the spliced alignment DP of "
+                            "GenomeThreader and show the exons.");
+
+  /* -range */
+  option = gt_option_new_range("range", "genomic range the reference "
+                               "sequences are aligned to (1-based, default: "
+                               "complete sequence)", &arguments->range, NULL);
+  gt_option_parser_add_option(op, option);
+
+  /* -refs */
+  option = gt_option_new_uword("refs", "maximal number of reference "
+                               "sequences to align (0 aligns all)",
+                               &arguments->refs, 0);
+  gt_option_parser_add_option(op, option);
+
+  /* -protein */
+  protein_option = gt_option_new_bool("protein", "reference_file contains "
+                                      "protein sequences, use the protein DP",
+                                      &arguments->protein, false);
+  gt_option_parser_add_option(op, protein_option);
+
+  /* -scorematrix */
+  option = gt_option_new_string("scorematrix", "amino acid substitution matrix "
+                                "used for -protein", arguments->scorematrix,
+                                "BLOSUM62");
+  gt_option_parser_add_option(op, option);
+
+  /* -checkpoint */
+  option = gt_option_new_bool("checkpoint", "use the checkpointing DP which "
+                              "only stores a part of the backtrace matrix",
+                              &arguments->checkpoint, false);
+  gt_option_parser_add_option(op, option);
+
+  /* -workspace */
+  option = gt_option_new_bool("workspace", "reuse the memory of the backtrace "
+                              "matrix for all reference sequences",
+                              &arguments->workspace, false);
+  gt_option_parser_add_option(op, option);
+
+  /* -chains */
+  chains_option = gt_option_new_bool("chains", "align the reference sequences "
+                                     "like gth does after the chaining "
+                                     "phase: one chain per sequence covering "
+                                     "the genomic range, aligned by the "
+                                     "similarity filter in -j DP workers, "
+                                     "and show the saved alignments",
+                                     &arguments->chains, false);
+  gt_option_parser_add_option(op, chains_option);
+  gt_option_exclude(chains_option, protein_option);
+  gt_option_exclude(chains_option, option);
+
+  /* -first */
+  first_option = gt_option_new_uint("first", "show only the first n "
+                                    "alignments (0 shows all), requires "
+                                    "-chains", &arguments->first, 0);
+  gt_option_parser_add_option(op, first_option);
+  gt_option_imply(first_option, chains_option);
+
+  option = gt_option_new_verbose(&arguments->verbose);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_min_max_args(op, 2U, 2U);
+  return op;
+}
+
+/* reads the first sequence of <filename> encoded with <alphabet> */
+static GtUchar* gt_gthdpbench_read_seq(const char *filename,
+                                       GtAlphabet *alphabet, GtUword *len,
+                                       GtError *err)
+{
+  GtSeqIterator *seqit;
+  GtStrArray *files;
+  const GtUchar *seq;
+  GtUchar *gen_seq = NULL;
+  char *desc;
+  int rval;
+
+  gt_error_check(err);
+  files = gt_str_array_new();
+  gt_str_array_add_cstr(files, filename);
+  seqit = gt_seq_iterator_sequence_buffer_new(files, err);
+  if (seqit) {
+    gt_seq_iterator_set_symbolmap(seqit, gt_alphabet_symbolmap(alphabet));
+    rval = gt_seq_iterator_next(seqit, &seq, len, &desc, err);
+    if (!rval)
+      gt_error_set(err, "file \"%s\" contains no sequence", filename);
+    else if (rval == 1) {
+      gen_seq = gt_malloc(sizeof *gen_seq * *len);
+      memcpy(gen_seq, seq, sizeof *gen_seq * *len);
+    }
+    gt_seq_iterator_delete(seqit);
+  }
+  gt_str_array_delete(files);
+  return gen_seq;
+}
+
+static const GthSeqConClass* gt_gthdpbench_seq_con_class(void);
+
+#define gt_gthdpbench_seq_con_cast(SC)\
+        gth_seq_con_cast(gt_gthdpbench_seq_con_class(), SC)
+
+static void gt_gthdpbench_seq_con_demand_orig_seq(GT_UNUSED GthSeqCon *sc)
+{
+  /* the original sequence is always present */
+}
+
+static GtUchar* gt_gthdpbench_seq_con_get_seq(GthSeqCon *sc,
+                                              GT_UNUSED GtUword seq_num)
+{
+  GtGthdpbenchSeqCon *bsc = gt_gthdpbench_seq_con_cast(sc);
+  return bsc->seq;
+}
+
+static GtUchar* gt_gthdpbench_seq_con_get_seq_rc(GthSeqCon *sc,
+                                                 GT_UNUSED GtUword seq_num)
+{
+  GtGthdpbenchSeqCon *bsc = gt_gthdpbench_seq_con_cast(sc);
+  return bsc->seq_rc;
+}
+
+static void gt_gthdpbench_seq_con_get_description(GthSeqCon *sc,
+                                                  GtUword seq_num,
+                                                  GtStr *desc)
+{
+  GtGthdpbenchSeqCon *bsc = gt_gthdpbench_seq_con_cast(sc);
+  gt_str_append_cstr(desc, gt_str_array_get(bsc->descs, seq_num));
+}
+
+static void gt_gthdpbench_seq_con_echo_description(GthSeqCon *sc,
+                                                   GtUword seq_num,
+                                                   GtFile *outfp)
+{
+  GtGthdpbenchSeqCon *bsc = gt_gthdpbench_seq_con_cast(sc);
+  gt_file_xfputs(gt_str_array_get(bsc->descs, seq_num), outfp);
+}
+
+static GtUword gt_gthdpbench_seq_con_num_of_seqs(GthSeqCon *sc)
+{
+  GtGthdpbenchSeqCon *bsc = gt_gthdpbench_seq_con_cast(sc);
+  return gt_array_size(bsc->ranges);
+}
+
+static GtUword gt_gthdpbench_seq_con_total_length(GthSeqCon *sc)
+{
+  GtGthdpbenchSeqCon *bsc = gt_gthdpbench_seq_con_cast(sc);
+  return bsc->total_length;
+}
+
+static GtRange gt_gthdpbench_seq_con_get_range(GthSeqCon *sc,
+                                               GtUword seq_num)
+{
+  GtGthdpbenchSeqCon *bsc = gt_gthdpbench_seq_con_cast(sc);
+  return *(GtRange*) gt_array_get(bsc->ranges, seq_num);
+}
+
+static GtAlphabet* gt_gthdpbench_seq_con_get_alphabet(GthSeqCon *sc)
+{
+  GtGthdpbenchSeqCon *bsc = gt_gthdpbench_seq_con_cast(sc);
+  return bsc->alphabet;
+}
+
+static void gt_gthdpbench_seq_con_free(GthSeqCon *sc)
+{
+  GtGthdpbenchSeqCon *bsc = gt_gthdpbench_seq_con_cast(sc);
+  gt_free(bsc->seq);
+  gt_free(bsc->seq_rc);
+  gt_array_delete(bsc->ranges);
+  gt_str_array_delete(bsc->descs);
+  gt_alphabet_delete(bsc->alphabet);
+}
+
+static const GthSeqConClass* gt_gthdpbench_seq_con_class(void)
+{
+  static const GthSeqConClass *scc = NULL;
+  if (!scc) {
+    scc = gth_seq_con_class_new(sizeof (GtGthdpbenchSeqCon),
+                                gt_gthdpbench_seq_con_demand_orig_seq,
+                                gt_gthdpbench_seq_con_get_seq,
+                                gt_gthdpbench_seq_con_get_seq,
+                                gt_gthdpbench_seq_con_get_seq_rc,
+                                gt_gthdpbench_seq_con_get_seq_rc,
+                                gt_gthdpbench_seq_con_get_description,
+                                gt_gthdpbench_seq_con_echo_description,
+                                gt_gthdpbench_seq_con_num_of_seqs,
+                                gt_gthdpbench_seq_con_total_length,
+                                gt_gthdpbench_seq_con_get_range,
+                                gt_gthdpbench_seq_con_get_alphabet,
+                                gt_gthdpbench_seq_con_free);
+  }
+  return scc;
+}
+
+/* reads the DNA sequences of the file <indexname> without the suffix added by
+   the input, separated by a SEPARATOR. The constructor cannot report errors,
+   the runner checks that the files exist. */
+static GthSeqCon* gt_gthdpbench_seq_con_new(const char *indexname,
+                                            GT_UNUSED bool assign_rc,
+                                            GT_UNUSED bool orig_seq,
+                                            GT_UNUSED bool tran_seq)
+{
+  GthSeqCon *sc;
+  GtGthdpbenchSeqCon *bsc;
+  GtSeqIterator *seqit;
+  GtStrArray *files;
+  GtStr *filename;
+  GtError *err;
+  GtRange range;
+  const GtUchar *seq;
+  GtUword len, i;
+  size_t allocated = 0;
+  char *desc;
+  int rval;
+
+  sc = gth_seq_con_create(gt_gthdpbench_seq_con_class());
+  bsc = gt_gthdpbench_seq_con_cast(sc);
+  bsc->alphabet = gt_alphabet_new_dna();
+  bsc->ranges = gt_array_new(sizeof (GtRange));
+  bsc->descs = gt_str_array_new();
+  err = gt_error_new();
+  filename = gt_str_new_cstr(indexname);
+  gt_assert(gt_str_length(filename) > strlen(DNASUFFIX) + 1);
+  gt_str_set_length(filename,
+                    gt_str_length(filename) - strlen(DNASUFFIX) - 1);
+  files = gt_str_array_new();
+  gt_str_array_add(files, filename);
+  if (!(seqit = gt_seq_iterator_sequence_buffer_new(files, err))) {
+    fprintf(stderr, "%s\n", gt_error_get(err));
+    exit(EXIT_FAILURE);
+  }
+  gt_seq_iterator_set_symbolmap(seqit, gt_alphabet_symbolmap(bsc->alphabet));
+  while ((rval = gt_seq_iterator_next(seqit, &seq, &len, &desc, err)) == 1) {
+    if (gt_array_size(bsc->ranges) > 0)
+      bsc->total_length++; /* separator */
+    bsc->seq = gt_dynalloc(bsc->seq, &allocated,
+                           sizeof *bsc->seq * (bsc->total_length + len + 1));
+    if (gt_array_size(bsc->ranges) > 0)
+      bsc->seq[bsc->total_length - 1] = (GtUchar) SEPARATOR;
+    memcpy(bsc->seq + bsc->total_length, seq, sizeof *seq * len);
+    range.start = bsc->total_length;
+    range.end = bsc->total_length + len - 1;
+    gt_array_add(bsc->ranges, range);
+    gt_str_array_add_cstr(bsc->descs, desc);
+    bsc->total_length += len;
+  }
+  if (rval < 0 || !gt_array_size(bsc->ranges)) {
+    fprintf(stderr, "%s\n", rval < 0 ? gt_error_get(err)
+                                      : "file contains no sequence");
+    exit(EXIT_FAILURE);
+  }
+  gt_seq_iterator_delete(seqit);
+  gt_str_array_delete(files);
+  gt_str_delete(filename);
+  gt_error_delete(err);
+
+  /* reverse complement every sequence in place */
+  bsc->seq_rc = gt_malloc(sizeof *bsc->seq_rc * bsc->total_length);
+  for (i = 0; i < gt_array_size(bsc->ranges); i++) {
+    GtUword pos;
+    range = *(GtRange*) gt_array_get(bsc->ranges, i);
+    for (pos = range.start; pos <= range.end; pos++) {
+      GtUchar cc = bsc->seq[range.end - (pos - range.start)];
+      bsc->seq_rc[pos] = ISSPECIAL(cc) ? cc : (GtUchar) 3 - cc;
+    }
+    if (range.end + 1 < bsc->total_length)
+      bsc->seq_rc[range.end + 1] = (GtUchar) SEPARATOR;
+  }
+  return sc;
+}
+
+static void gt_gthdpbench_show_verbose(const char *msg)
+{
+  printf("# %s\n", msg);
+}
+
+static void gt_gthdpbench_show_time(GtTimer *timer)
+{
+  struct rusage ru;
+  gt_xgetrusage(RUSAGE_SELF, &ru);
+  printf("# SPACE maximal resident set size: "GT_WD" kilobytes\n",
+         (GtWord) ru.ru_maxrss);
+  printf("# TIME DP: ");
+  gt_timer_show_formatted(timer, GT_WD".%06ld seconds real, "
+                          GT_WD"s user, "GT_WD"s system\n", stdout);
+}
+
+/* aligns the reference sequences with the DP workers of the similarity filter,
+   one chain per reference sequence covering the genomic range */
+static int gt_gthdpbench_align_chains(GtGthdpbenchArguments *arguments,
+                                      const char *genomic_file,
+                                      const char *reference_file,
+                                      GtError *err)
+{
+  GthCallInfo *call_info;
+  GthInput *input;
+  GthChainCollection *chain_collection = NULL;
+  GthSACollection *sa_collection = NULL;
+  GthSACollectionIterator *iterator;
+  GthStat *stat = NULL;
+  GtTimer *timer = NULL;
+  GthSA *sa;
+  GtRange gen_seq_bounds, gen_range;
+  GtUword gen_total_length, numofrefs, numofsas = 0, i;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  if (!gt_file_exists(genomic_file)) {
+    gt_error_set(err, "file \"%s\" does not exist", genomic_file);
+    return -1;
+  }
+  if (!gt_file_exists(reference_file)) {
+    gt_error_set(err, "file \"%s\" does not exist", reference_file);
+    return -1;
+  }
+
+  call_info = gth_call_info_new("gthdpbench");
+  call_info->firstalshown = arguments->first;
+  call_info->minaveragessp = GTH_DEFAULT_MINAVERAGESSP;
+  call_info->duplicate_check = GTH_DC_ID;
+  call_info->dp_options_core->checkpointdp = arguments->checkpoint;
+  input = gth_input_new(NULL, gt_gthdpbench_seq_con_new);
+  gth_input_add_genomic_file(input, genomic_file);
+  gth_input_add_cdna_file(input, reference_file);
+  gth_input_load_genomic_file(input, 0, false);
+  gth_input_load_reference_file(input, 0, false);
+
+  /* the chains lie on the first genomic sequence */
+  gen_seq_bounds = gth_input_get_genomic_range(input, 0, 0);
+  gen_total_length = gt_range_length(&gen_seq_bounds);
+  if (arguments->range.start == GT_UNDEF_UWORD)
+    gen_range = gen_seq_bounds;
+  else if (!arguments->range.start ||
+           arguments->range.end > gen_total_length) {
+    gt_error_set(err, "genomic range "GT_WU"-"GT_WU" lies outside of the "
+                 "genomic sequence of length "GT_WU, arguments->range.start,
+                 arguments->range.end, gen_total_length);
+    had_err = -1;
+  }
+  else {
+    gen_range.start = gen_seq_bounds.start + arguments->range.start - 1;
+    gen_range.end = gen_seq_bounds.start + arguments->range.end - 1;
+  }
+
+  if (!had_err) {
+    chain_collection = gth_chain_collection_new();
+    numofrefs = gth_input_num_of_ref_seqs(input, 0);
+    if (arguments->refs && arguments->refs < numofrefs)
+      numofrefs = arguments->refs;
+    for (i = 0; i < numofrefs; i++) {
+      GthChain *chain = gth_chain_new();
+      chain->gen_file_num = 0;
+      chain->gen_seq_num = 0;
+      chain->ref_file_num = 0;
+      chain->ref_seq_num = i;
+      gt_array_add(chain->forwardranges, gen_range);
+      gt_ranges_copy_to_opposite_strand(chain->reverseranges,
+                                        chain->forwardranges,
+                                        gen_total_length,
+                                        gen_seq_bounds.start);
+      gth_chain_collection_add(chain_collection, chain);
+    }
+    sa_collection = gth_sa_collection_new(call_info->duplicate_check);
+    stat = gth_stat_new();
+    gth_stat_enable_sa_stats(stat);
+    if (arguments->verbose) {
+      timer = gt_timer_new();
+      gt_timer_start(timer);
+    }
+    had_err = gth_similarity_filter_align_chains(sa_collection,
+                                                 chain_collection, call_info,
+                                                 input, stat, 0, 0, true, err);
+    if (timer)
+      gt_timer_stop(timer);
+  }
+
+  if (!had_err) {
+    iterator = gth_sa_collection_iterator_new(sa_collection);
+    while ((sa = gth_sa_collection_iterator_next(iterator))) {
+      numofsas++;
+      printf(">%s %c%c call "GT_WU" score %.3f\n", gth_sa_ref_id(sa),
+             gth_sa_gen_strand_char(sa), gth_sa_ref_strand_char(sa),
+             gth_sa_call_number(sa), gth_sa_score(sa));
+      gth_sa_show_exons(sa, NULL);
+    }
+    gth_sa_collection_iterator_delete(iterator);
+    printf("# number of cDNAs/ESTs: "GT_WU"\n", numofrefs);
+    printf("# number of spliced alignments: "GT_WU"\n", numofsas);
+    gth_stat_show(stat, true, false, NULL);
+    if (arguments->verbose)
+      gt_gthdpbench_show_time(timer);
+  }
+
+  gt_timer_delete(timer);
+  gth_stat_delete(stat);
+  gth_sa_collection_delete(sa_collection);
+  gth_chain_collection_delete(chain_collection);
+  gth_input_delete_complete(input);
+  gth_call_info_delete(call_info);
+  return had_err;
+}
+
+static int gt_gthdpbench_runner(GT_UNUSED int argc, const char **argv,
+                                int parsed_args, void *tool_arguments,
+                                GtError *err)
+{
+  GtGthdpbenchArguments *arguments = tool_arguments;
+  GthSpliceSiteModel *splice_site_model = NULL;
+  GthDPWorkspace *dp_workspace = NULL;
+  GthDPOptionsCore *dp_options_core = NULL;
+  GthDPOptionsEST *dp_options_est = NULL;
+  GthDPOptionsPostpro *dp_options_postpro = NULL;
+  GtAlphabet *alphabet, *protein_alphabet = NULL;
+  GthInput *input = NULL;
+  GthOutput *out = NULL;
+  GtSeqIterator *seqit = NULL;
+  GtStrArray *files;
+  GtArray *gen_ranges;
+  GtRange gen_seq_bounds, gen_range;
+  GthStat *stat = NULL;
+  GtTimer *timer = NULL;
+  GthSA *sa;
+  const GtUchar *ref_seq;
+  GtUchar *gen_seq, *ref_seq_tran = NULL;
+  GtUword gen_len, ref_len, numofrefs = 0, numofsas = 0;
+  char *desc;
+  int rval, had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  if (arguments->chains) {
+    return gt_gthdpbench_align_chains(arguments, argv[parsed_args],
+                                      argv[parsed_args + 1], err);
+  }
+
+  alphabet = gt_alphabet_new_dna();
+  gen_ranges = gt_array_new(sizeof (GtRange));
+  files = gt_str_array_new();
+  gt_str_array_add_cstr(files, argv[parsed_args + 1]);
+
+  if (!(gen_seq = gt_gthdpbench_read_seq(argv[parsed_args], alphabet, &gen_len,
+                                         err))) {
+    had_err = -1;
+  }
+  if (!had_err) {
+    gen_seq_bounds.start = 0;
+    gen_seq_bounds.end = gen_len - 1;
+    if (arguments->range.start == GT_UNDEF_UWORD)
+      gen_range = gen_seq_bounds;
+    else if (!arguments->range.start || arguments->range.end > gen_len) {
+      gt_error_set(err, "genomic range "GT_WU"-"GT_WU" lies outside of the "
+                   "genomic sequence of length "GT_WU, arguments->range.start,
+                   arguments->range.end, gen_len);
+      had_err = -1;
+    }
+    else {
+      gen_range.start = arguments->range.start - 1;
+      gen_range.end = arguments->range.end - 1;
+    }
+  }
+  if (!had_err) {
+    gt_array_add(gen_ranges, gen_range);
+    if (!(seqit = gt_seq_iterator_sequence_buffer_new(files, err)))
+      had_err = -1;
+    else if (!arguments->protein)
+      gt_seq_iterator_set_symbolmap(seqit, gt_alphabet_symbolmap(alphabet));
+  }
+  if (!had_err && arguments->protein) {
+    /* the input only provides the amino acid substitution matrix, the protein
+       DP uses the original characters and the encoded sequence */
+    input = gth_input_new(NULL, gt_gthdpbench_seq_con_new);
+    gth_input_add_protein_file(input, argv[parsed_args + 1]);
+    out = gthoutput_new();
+    had_err = gth_input_load_scorematrix(input,
+                                         gt_str_get(arguments->scorematrix),
+                                         out, err);
+    protein_alphabet = gt_alphabet_new_protein();
+  }
+
+  if (!had_err) {
+    splice_site_model = gth_splice_site_model_new();
+    dp_options_core = gth_dp_options_core_new();
+    dp_options_core->checkpointdp = arguments->checkpoint;
+    dp_options_est = gth_dp_options_est_new();
+    dp_options_postpro = gth_dp_options_postpro_new();
+    stat = gth_stat_new();
+    if (arguments->workspace)
+      dp_workspace = gth_dp_workspace_new();
+    if (arguments->verbose) {
+      timer = gt_timer_new();
+      gt_timer_start(timer);
+    }
+  }
+
+  while (!had_err && (!arguments->refs || numofrefs < arguments->refs)) {
+    rval = gt_seq_iterator_next(seqit, &ref_seq, &ref_len, &desc, err);
+    if (rval <= 0) {
+      if (rval < 0)
+        had_err = -1;
+      break;
+    }
+    if (arguments->protein) {
+      ref_seq_tran = gt_realloc(ref_seq_tran, sizeof *ref_seq_tran * ref_len);
+      gt_alphabet_encode_seq(protein_alphabet, ref_seq_tran,
+                             (const char*) ref_seq, ref_len);
+    }
+    numofrefs++;
+    sa = gth_sa_new();
+    gth_sa_set_gen_strand(sa, true);
+    gth_sa_set_ref_strand(sa, true);
+    gth_sa_set_gen_total_length(sa, gen_len);
+    gth_sa_set_gen_offset(sa, 0);
+    gth_sa_set_ref_total_length(sa, ref_len);
+    if (arguments->protein) {
+      rval = gth_align_protein(sa, gen_ranges, gen_seq, ref_seq_tran, ref_seq,
+                               ref_len,
+                               alphabet, protein_alphabet, input, false, 0,
+                               false, false, false, false, 1, &gen_seq_bounds,
+                               splice_site_model, dp_options_core,
+                               dp_options_postpro, NULL, NULL, 0,
+                               dp_workspace, stat, NULL);
+    }
+    else {
+      rval = gth_align_dna(sa, gen_ranges, gen_seq, gen_seq, ref_seq, ref_seq,
+                           ref_len, alphabet, alphabet, false, 0, false, false,
+                           false, &gen_seq_bounds, splice_site_model,
+                           dp_options_core, dp_options_est, dp_options_postpro,
+                           NULL, NULL, 0, dp_workspace, stat, NULL);
+    }
+    if (!rval) {
+      numofsas++;
+      printf(">%s\n", desc);
+      gth_sa_show_exons(sa, NULL);
+    }
+    gth_sa_delete(sa);
+  }
+
+  if (timer)
+    gt_timer_stop(timer);
+  if (!had_err) {
+    printf("# number of %s: "GT_WU"\n",
+           arguments->protein ? "proteins" : "cDNAs/ESTs", numofrefs);
+    printf("# number of spliced alignments: "GT_WU"\n", numofsas);
+    if (arguments->verbose) {
+      gt_gthdpbench_show_time(timer);
+      if (dp_workspace) {
+        gth_dp_workspace_show_stats(dp_workspace,
+                                    gt_gthdpbench_show_verbose);
+      }
+    }
+  }
+
+  gt_timer_delete(timer);
+  gth_dp_workspace_delete(dp_workspace);
+  gth_stat_delete(stat);
+  gth_dp_options_postpro_delete(dp_options_postpro);
+  gth_dp_options_est_delete(dp_options_est);
+  gth_dp_options_core_delete(dp_options_core);
+  gth_splice_site_model_delete(splice_site_model);
+  gt_free(ref_seq_tran);
+  gt_alphabet_delete(protein_alphabet);
+  gthoutput_delete(out);
+  gth_input_delete_complete(input);
+  gt_seq_iterator_delete(seqit);
+  gt_free(gen_seq);
+  gt_str_array_delete(files);
+  gt_array_delete(gen_ranges);
+  gt_alphabet_delete(alphabet);
+  return had_err;
+}
+
+GtTool* gt_gthdpbench(void)
+{
+  return gt_tool_new(gt_gthdpbench_arguments_new,
+                     gt_gthdpbench_arguments_delete,
+                     gt_gthdpbench_option_parser_new,
+                     NULL,
+                     gt_gthdpbench_runner);
+}
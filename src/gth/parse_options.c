@@ -166,6 +166,7 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
          *optstopafterchaining = NULL,    /* sim. filter, gl. chaining filter */
          *optintroncutout = NULL,         /* sim. filter, after gl. chaining */
          *optfastdp = NULL,               /* sim. filter, after gl. chaining */
+         *optcheckpointdp = NULL,         /* sim. filter, after gl. chaining */
          *optautointroncutout = NULL,     /* sim. filter, after gl. chaining */
          *opticinitialdelta = NULL,       /* sim. filter, after gl. chaining */
          *opticiterations = NULL,         /* sim. filter, after gl. chaining */
@@ -767,6 +768,21 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
     gt_option_parser_add_option(op, optfastdp);
   }
 
+  /* -checkpointdp */
+  if (!gthconsensus_parsing) {
+    optcheckpointdp = gt_option_new_bool("checkpointdp", "store only "
+                                         "checkpoints of the DP tables and "
+                                         "recompute the backtrace matrix "
+                                         "blockwise\nuses O(sqrt(n)*m) instead "
+                                         "of O(n*m) space for the DP at the "
+                                         "price of computing it twice",
+                                         &call_info->dp_options_core
+                                         ->checkpointdp,
+                                         GTH_DEFAULT_CHECKPOINTDP);
+    gt_option_is_extended_option(optcheckpointdp);
+    gt_option_parser_add_option(op, optcheckpointdp);
+  }
+
   /* -autointroncutout */
   if (!gthconsensus_parsing) {
     optautointroncutout = gt_option_new_uint("autointroncutout", "set the "
@@ -1307,6 +1323,8 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
     gt_option_exclude(optskipalignmentout, optintermediate);
   if (optxmlout && optgff3out)
     gt_option_exclude(optxmlout, optgff3out);
+  if (optfastdp && optcheckpointdp)
+    gt_option_exclude(optfastdp, optcheckpointdp);
 
   /* option implications (single) */
   if (opttopos && optfrompos)
@@ -15,6 +15,10 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include "core/atomic.h"
+#include "core/ma_api.h"
+#include "core/minmax.h"
+#include "core/multithread_api.h"
 #include "core/trans_table.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
@@ -33,6 +37,9 @@
 
 #define SHOW_COMPUTE_MATCHES_STATUS_BUF_SIZE    160
 
+/* the number of chains per DP worker which are aligned in one batch */
+#define DP_JOBS_PER_WORKER                      16
+
 typedef struct {
   GtUword call_number;
   bool significant_match_found,
@@ -40,6 +47,59 @@ typedef struct {
        stop_amino_acid_warning;
 } GthMatchInfo;
 
+/* the sequences of the current genomic and reference file */
+typedef struct {
+  const unsigned char *gen_seq_tran,
+                      *gen_seq_orig,
+                      *gen_seq_tran_rc,
+                      *gen_seq_orig_rc;
+  GtAlphabet *gen_alphabet,
+             *ref_alphabet;
+} GthCurrentSeqs;
+
+/* the DP of a single chain. The chain is prepared and the resulting <sa> is
+   saved by the calling thread in the order of the chain collection, only the
+   DP itself is done by the worker threads. */
+typedef struct {
+  GthChain *chain;
+  GtUword chainctr,
+          gen_total_length,
+          gen_offset,
+          ref_total_length,
+          ref_offset;
+  GtRange gen_seq_bounds,
+          gen_seq_bounds_rc;
+  const unsigned char *ref_seq_tran,
+                      *ref_seq_orig,
+                      *ref_seq_tran_rc,
+                      *ref_seq_orig_rc;
+  GthSA *saA,
+        *saB, /* only allocated if the second strand may have to be aligned */
+        *sa;  /* the alignment which has to be saved, NULL if there is none */
+  bool significant_match_found; /* set if <sa> is NULL for compatibility with
+                                   GS2 */
+  int rval;
+} GthDPJob;
+
+typedef struct {
+  GthDPJob *jobs;
+  GtUword num_of_jobs,
+          next_job,
+          next_slot,
+          gen_file_num,
+          ref_file_num,
+          num_of_chains;
+  GthStat **stats;
+  GthDPWorkspace **dp_workspaces;
+  bool directmatches,
+       refseqisdna;
+  GthCallInfo *call_info;
+  GthInput *input;
+  const GthCurrentSeqs *seqs;
+  GthDNACompletePathMatrixJT dna_complete_path_matrix_jt;
+  GthProteinCompletePathMatrixJT protein_complete_path_matrix_jt;
+} GthDPWorkerInfo;
+
 static void show_matrix_calculation_status(GthShowVerbose showverbose,
                                            bool gen_strand_forward,
                                            bool ref_strand_forward,
@@ -114,7 +174,9 @@ static int callsahmt(bool call_dna_dp,
                      GtUword ref_total_length,
                      GtUword ref_offset,
                      GthInput *input,
+                     const GthCurrentSeqs *seqs,
                      Introncutoutinfo *introncutoutinfo,
+                     GthDPWorkspace *dp_workspace,
                      GthStat *stat,
                      GtUword chainctr,
                      GtUword num_of_chains,
@@ -190,26 +252,23 @@ static int callsahmt(bool call_dna_dp,
     if (forward) {
       if (call_dna_dp) {
         rval = gth_align_dna(sa, used_chain->forwardranges,
-                             gth_input_current_gen_seq_tran(input),
-                             gth_input_current_gen_seq_orig(input),
+                             seqs->gen_seq_tran, seqs->gen_seq_orig,
                              ref_seq_tran, ref_seq_orig, ref_total_length,
-                             gth_input_current_gen_alphabet(input),
-                             gth_input_current_ref_alphabet(input),
+                             seqs->gen_alphabet, seqs->ref_alphabet,
                              useintroncutout,
                              introncutoutinfo->autoicmaxmatrixsize,
                              out->showeops, out->comments, out->gs2out,
                              gen_seq_bounds, splice_site_model, dp_options_core,
                              dp_options_est, dp_options_postpro,
                              dna_complete_path_matrix_jt,
-                             raw_chain->forward_jump_table, ref_offset, stat,
-                             out->outfp);
+                             raw_chain->forward_jump_table, ref_offset,
+                             dp_workspace, stat, out->outfp);
       }
       else { /* call_protein_dp */
         rval = gth_align_protein(sa, used_chain->forwardranges,
-                                 gth_input_current_gen_seq_tran(input),
+                                 seqs->gen_seq_tran,
                                  ref_seq_tran, ref_seq_orig, ref_total_length,
-                                 gth_input_current_gen_alphabet(input),
-                                 gth_input_current_ref_alphabet(input),
+                                 seqs->gen_alphabet, seqs->ref_alphabet,
                                  input, useintroncutout,
                                  introncutoutinfo->autoicmaxmatrixsize,
                                  proteinexonpenal, out->showeops, out->comments,
@@ -218,33 +277,30 @@ static int callsahmt(bool call_dna_dp,
                                  dp_options_postpro,
                                  protein_complete_path_matrix_jt,
                                  raw_chain->forward_jump_table, ref_offset,
-                                 stat, out->outfp);
+                                 dp_workspace, stat, out->outfp);
       }
     }
     else {
       /* the DP is called with the revers positions specifiers */
       if (call_dna_dp) {
         rval = gth_align_dna(sa, used_chain->reverseranges,
-                             gth_input_current_gen_seq_tran_rc(input),
-                             gth_input_current_gen_seq_orig_rc(input),
+                             seqs->gen_seq_tran_rc, seqs->gen_seq_orig_rc,
                              ref_seq_tran, ref_seq_orig, ref_total_length,
-                             gth_input_current_gen_alphabet(input),
-                             gth_input_current_ref_alphabet(input),
+                             seqs->gen_alphabet, seqs->ref_alphabet,
                              useintroncutout,
                              introncutoutinfo->autoicmaxmatrixsize,
                              out->showeops, out->comments, out->gs2out,
                              gen_seq_bounds_rc, splice_site_model,
                              dp_options_core, dp_options_est,
                              dp_options_postpro, dna_complete_path_matrix_jt,
-                             raw_chain->reverse_jump_table, ref_offset, stat,
-                             out->outfp);
+                             raw_chain->reverse_jump_table, ref_offset,
+                             dp_workspace, stat, out->outfp);
       }
       else { /* call_protein_dp */
         rval = gth_align_protein(sa, used_chain->reverseranges,
-                                 gth_input_current_gen_seq_tran_rc(input),
+                                 seqs->gen_seq_tran_rc,
                                  ref_seq_tran, ref_seq_orig, ref_total_length,
-                                 gth_input_current_gen_alphabet(input),
-                                 gth_input_current_ref_alphabet(input),
+                                 seqs->gen_alphabet, seqs->ref_alphabet,
                                  input, useintroncutout,
                                  introncutoutinfo->autoicmaxmatrixsize,
                                  proteinexonpenal, out->showeops, out->comments,
@@ -253,7 +309,7 @@ static int callsahmt(bool call_dna_dp,
                                  dp_options_postpro,
                                  protein_complete_path_matrix_jt,
                                  raw_chain->reverse_jump_table, ref_offset,
-                                 stat, out->outfp);
+                                 dp_workspace, stat, out->outfp);
       }
     }
 
@@ -355,23 +411,16 @@ static bool isunsuccessfulalignment(GthSA *sa,
   return false;
 }
 
+/* the following function computes the alignment of <job> and sets <job->sa>
+   to the alignment which has to be saved. The alignments of <job> which are
+   not saved are deleted by the caller. */
 static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
-                       GthInput *input, GthStat *stat,
-                       GthSACollection *sa_collection, GthSA *saA,
+                       GthInput *input, const GthCurrentSeqs *seqs,
+                       GthDPWorkspace *dp_workspace, GthStat *stat,
+                       GthDPJob *job,
                        GtUword gen_file_num,
                        GtUword ref_file_num,
-                       GtUword gen_total_length,
-                       GtUword gen_offset,
-                       const GtRange *gen_seq_bounds,
-                       const GtRange *gen_seq_bounds_rc,
-                       GtUword ref_total_length, GtUword ref_offset,
-                       GtUword chainctr,
-                       GtUword num_of_chains, GthMatchInfo *match_info,
-                       const unsigned char *ref_seq_tran,
-                       const unsigned char *ref_seq_orig,
-                       const unsigned char *ref_seq_tran_rc,
-                       const unsigned char *ref_seq_orig_rc,
-                       GthChain *chain,
+                       GtUword num_of_chains,
                        GthDNACompletePathMatrixJT dna_complete_path_matrix_jt,
                        GthProteinCompletePathMatrixJT
                        protein_complete_path_matrix_jt)
@@ -379,18 +428,20 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
   int rval;
   bool bothstrandsanalyzed, firstdp = true,
        GT_UNUSED gs2outdirectmatches = directmatches;
-  GthSA *saB = NULL;
+  GthSA *saA = job->saA, *saB = job->saB;
   GtFile *outfp = call_info->out->outfp;
 
   if (directmatches ? gth_input_forward(input)
                     : gth_input_reverse(input)) {
     /* calculate alignment */
     rval = callsahmt(true, saA, directmatches, gen_file_num, ref_file_num,
-                     chain, gen_total_length, gen_offset, gen_seq_bounds,
-                     gen_seq_bounds_rc,
-                     ref_seq_tran, ref_seq_orig, ref_total_length, ref_offset,
-                     input, &call_info->simfilterparam.introncutoutinfo, stat,
-                     chainctr, num_of_chains, call_info->translationtable,
+                     job->chain, job->gen_total_length, job->gen_offset,
+                     &job->gen_seq_bounds, &job->gen_seq_bounds_rc,
+                     job->ref_seq_tran, job->ref_seq_orig,
+                     job->ref_total_length, job->ref_offset, input, seqs,
+                     &call_info->simfilterparam.introncutoutinfo,
+                     dp_workspace, stat, job->chainctr, num_of_chains,
+                     call_info->translationtable,
                      directmatches, call_info->proteinexonpenal,
                      call_info->splice_site_model, call_info->dp_options_core,
                      call_info->dp_options_est, call_info->dp_options_postpro,
@@ -406,10 +457,8 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
 
     if (rval == GTH_ERROR_SA_COULD_NOT_BE_DETERMINED ||
         isunsuccessfulalignment(saA, call_info->out->comments, outfp)) {
-      match_info->call_number--;
       /* if the spliced alignment was unsuccessful, it is deleted and the
          next hit is considered. */
-      gth_sa_delete(saA);
       return 0; /* continue */
     }
 
@@ -417,7 +466,7 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
        Otherwise we have to calculate the alignment to the other strand
        first and then save the better one. */
     if (!bothstrandsanalyzed)
-      save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
+      job->sa = saA;
   }
 
   if (directmatches ? gth_input_reverse(input)
@@ -431,12 +480,8 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
         gth_sa_set_ref_strand(saA, false);
       }
       else {
-        /* allocating space for second alignment */
-        saB = gth_sa_new_and_set(!directmatches, false, input,
-                                 chain->gen_file_num, chain->gen_seq_num,
-                                 chain->ref_file_num, chain->ref_seq_num,
-                                 match_info->call_number, gen_total_length,
-                                 gen_offset, ref_total_length);
+        /* space for second alignment has been allocated by the caller */
+        gt_assert(saB);
       }
 
       /* setting gs2outdirectmatches (for compatibility) */
@@ -444,13 +489,15 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
 
       /* calculate alignment */
       rval = callsahmt(true, firstdp ? saA : saB, !directmatches,
-                       gen_file_num, ref_file_num, chain, gen_total_length,
-                       gen_offset, gen_seq_bounds, gen_seq_bounds_rc,
-                       ref_seq_tran_rc, ref_seq_orig_rc, ref_total_length,
-                       ref_offset, input,
-                       &call_info->simfilterparam.introncutoutinfo, stat,
-                       chainctr, num_of_chains, call_info->translationtable,
-                       directmatches, call_info->proteinexonpenal,
+                       gen_file_num, ref_file_num, job->chain,
+                       job->gen_total_length, job->gen_offset,
+                       &job->gen_seq_bounds, &job->gen_seq_bounds_rc,
+                       job->ref_seq_tran_rc, job->ref_seq_orig_rc,
+                       job->ref_total_length, job->ref_offset, input, seqs,
+                       &call_info->simfilterparam.introncutoutinfo,
+                       dp_workspace, stat, job->chainctr, num_of_chains,
+                       call_info->translationtable, directmatches,
+                       call_info->proteinexonpenal,
                        call_info->splice_site_model, call_info->dp_options_core,
                        call_info->dp_options_est, call_info->dp_options_postpro,
                        dna_complete_path_matrix_jt,
@@ -465,15 +512,14 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
             isunsuccessfulalignment(saA, call_info->out->comments, outfp)) {
           /* for compatibility with GS2 */
           /* XXX: makes no sense. Possibly only if -gs2out is used. */
-          match_info->significant_match_found= true;
+          job->significant_match_found = true;
 
           /* if the spliced alignment was unsuccessful, it is deleted and
              the next hit is considered. */
-          gth_sa_delete(saA);
           return 0; /* continue */
         }
 
-        save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
+        job->sa = saA;
       }
       else /* !firstdp */
       {
@@ -481,20 +527,16 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
             isunsuccessfulalignment(saB, call_info->out->comments, outfp) ||
             !gth_sa_B_is_better_than_A(saA, saB)) {
           /* insert first SA */
-          save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
-          /* discard second SA */
-          gth_sa_delete(saB);
+          job->sa = saA;
         }
         else {
           /* insert second SA */
-          save_sa(sa_collection, saB, call_info->sa_filter, match_info, stat);
-          /* free first SA */
-          gth_sa_delete(saA);
+          job->sa = saB;
         }
       }
     }
     else
-      save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
+      job->sa = saA;
   }
 
   return 0;
@@ -503,23 +545,13 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
 static int call_protein_DP(bool directmatches,
                            GthCallInfo *call_info,
                            GthInput *input,
+                           const GthCurrentSeqs *seqs,
+                           GthDPWorkspace *dp_workspace,
                            GthStat *stat,
-                           GthSACollection *sa_collection,
-                           GthSA *saA,
+                           GthDPJob *job,
                            GtUword gen_file_num,
                            GtUword ref_file_num,
-                           GtUword gen_total_length,
-                           GtUword gen_offset,
-                           const GtRange *gen_seq_bounds,
-                           const GtRange *gen_seq_bounds_rc,
-                           GtUword ref_total_length,
-                           GtUword ref_offset,
-                           GtUword chainctr,
                            GtUword num_of_chains,
-                           GthMatchInfo *match_info,
-                           const unsigned char *ref_seq_tran,
-                           const unsigned char *ref_seq_orig,
-                           GthChain *chain,
                            GthDNACompletePathMatrixJT
                            dna_complete_path_matrix_jt,
                            GthProteinCompletePathMatrixJT
@@ -537,37 +569,71 @@ static int call_protein_DP(bool directmatches,
 #endif
 
   /* calculate alignment */
-  rval = callsahmt(false, saA, directmatches, gen_file_num, ref_file_num,
-                   chain, gen_total_length, gen_offset, gen_seq_bounds,
-                   gen_seq_bounds_rc, ref_seq_tran, ref_seq_orig,
-                   ref_total_length, ref_offset, input,
-                   &call_info->simfilterparam.introncutoutinfo, stat, chainctr,
-                   num_of_chains, call_info->translationtable, directmatches,
-                   call_info->proteinexonpenal, call_info->splice_site_model,
-                   call_info->dp_options_core, call_info->dp_options_est,
-                   call_info->dp_options_postpro, dna_complete_path_matrix_jt,
+  rval = callsahmt(false, job->saA, directmatches, gen_file_num, ref_file_num,
+                   job->chain, job->gen_total_length, job->gen_offset,
+                   &job->gen_seq_bounds, &job->gen_seq_bounds_rc,
+                   job->ref_seq_tran, job->ref_seq_orig,
+                   job->ref_total_length, job->ref_offset, input, seqs,
+                   &call_info->simfilterparam.introncutoutinfo,
+                   dp_workspace, stat, job->chainctr, num_of_chains,
+                   call_info->translationtable,
+                   directmatches, call_info->proteinexonpenal,
+                   call_info->splice_site_model, call_info->dp_options_core,
+                   call_info->dp_options_est, call_info->dp_options_postpro,
+                   dna_complete_path_matrix_jt,
                    protein_complete_path_matrix_jt, call_info->out);
   if (rval && rval != GTH_ERROR_SA_COULD_NOT_BE_DETERMINED) {
                    /* ^ this error is treated below */
     return rval;
   }
 
-  if (rval == GTH_ERROR_SA_COULD_NOT_BE_DETERMINED ||
-      isunsuccessfulalignment(saA, call_info->out->comments, outfp)) {
-    match_info->call_number--;
-    /* if the spliced alignment was unsuccessful, it is deleted and the
-       next hit is considered. */
-    gth_sa_delete(saA);
-    /* continue */
-    return 0;
+  /* if the spliced alignment was unsuccessful, it is deleted and the next hit
+     is considered. Otherwise we can save the alignment now */
+  if (rval != GTH_ERROR_SA_COULD_NOT_BE_DETERMINED &&
+      !isunsuccessfulalignment(job->saA, call_info->out->comments, outfp)) {
+    job->sa = job->saA;
   }
 
-  /* we can save the alignment now */
-  save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
-
   return 0;
 }
 
+static void* dp_worker_thread(void *data)
+{
+  GthDPWorkerInfo *info = data;
+  GthDPWorkspace *dp_workspace;
+  GthStat *stat;
+  GthDPJob *job;
+  GtUword j, slot;
+
+  gt_assert(info);
+  slot = gt_atomic_uword_add_fetch(&info->next_slot, 1) - 1;
+  stat = info->stats[slot];
+  dp_workspace = info->dp_workspaces[slot];
+  while ((j = gt_atomic_uword_add_fetch(&info->next_job, 1) - 1)
+         < info->num_of_jobs) {
+    job = info->jobs + j;
+    if (info->refseqisdna) {
+      job->rval = call_dna_DP(info->directmatches, info->call_info,
+                              info->input, info->seqs, dp_workspace, stat,
+                              job,
+                              info->gen_file_num, info->ref_file_num,
+                              info->num_of_chains,
+                              info->dna_complete_path_matrix_jt,
+                              info->protein_complete_path_matrix_jt);
+    }
+    else {
+      job->rval = call_protein_DP(info->directmatches, info->call_info,
+                                  info->input, info->seqs, dp_workspace,
+                                  stat, job,
+                                  info->gen_file_num, info->ref_file_num,
+                                  info->num_of_chains,
+                                  info->dna_complete_path_matrix_jt,
+                                  info->protein_complete_path_matrix_jt);
+    }
+  }
+  return NULL;
+}
+
 static void show_no_match_line(GthAlphatype overallalphatype, GtFile *outfp)
 {
   gt_file_xprintf(outfp, "\nNo significant ");
@@ -626,10 +692,158 @@ static GthChainCollection* match_and_chain(GthCallInfo *call_info,
   return chain_collection;
 }
 
+static void prepare_dp_job(GthDPJob *job, GthChain *chain, GtUword chainctr,
+                           GthCallInfo *call_info, GthInput *input,
+                           bool directmatches, bool refseqisdna,
+                           GthMatchInfo *match_info)
+{
+  GtRange range;
+
+  job->chain = chain;
+  job->chainctr = chainctr;
+  job->saB = NULL;
+  job->sa = NULL;
+  job->significant_match_found = false;
+  job->rval = 0;
+
+  /* compute considered genomic regions if not set by -frompos */
+  if (!gth_input_use_substring_spec(input)) {
+    job->gen_seq_bounds = gth_input_get_genomic_range(input,
+                                                      chain->gen_file_num,
+                                                      chain->gen_seq_num);
+    job->gen_total_length  = gt_range_length(&job->gen_seq_bounds);
+    job->gen_offset        = job->gen_seq_bounds.start;
+    job->gen_seq_bounds_rc = job->gen_seq_bounds;
+  }
+  else {
+    /* genomic multiseq contains exactly one sequence */
+    gt_assert(gth_input_num_of_gen_seqs(input, chain->gen_file_num) == 1);
+    job->gen_total_length = gth_input_genomic_file_total_length(input,
+                                                                chain
+                                                                ->gen_file_num);
+    job->gen_seq_bounds.start    = gth_input_genomic_substring_from(input);
+    job->gen_seq_bounds.end      = gth_input_genomic_substring_to(input);
+    job->gen_offset              = 0;
+    job->gen_seq_bounds_rc.start = job->gen_total_length - 1
+                                   - job->gen_seq_bounds.end;
+    job->gen_seq_bounds_rc.end   = job->gen_total_length - 1
+                                   - job->gen_seq_bounds.start;
+  }
+
+  /* "retrieving" the reference sequence */
+  range = gth_input_get_reference_range(input, chain->ref_file_num,
+                                        chain->ref_seq_num);
+  job->ref_seq_tran = gth_input_current_ref_seq_tran(input) + range.start;
+  job->ref_seq_orig = gth_input_current_ref_seq_orig(input) + range.start;
+  if (refseqisdna) {
+    job->ref_seq_tran_rc = gth_input_current_ref_seq_tran_rc(input)
+                           + range.start;
+    job->ref_seq_orig_rc = gth_input_current_ref_seq_orig_rc(input)
+                           + range.start;
+  }
+  else {
+    job->ref_seq_tran_rc = NULL;
+    job->ref_seq_orig_rc = NULL;
+  }
+  job->ref_total_length = range.end - range.start + 1;
+  job->ref_offset = range.start;
+
+  /* check if protein sequences have a stop amino acid */
+  if (!refseqisdna && !match_info->stop_amino_acid_warning &&
+     job->ref_seq_orig[job->ref_total_length - 1] != GT_STOP_AMINO) {
+    GtStr *ref_id = gt_str_new();
+    gth_input_save_ref_id(input, ref_id, chain->ref_file_num,
+                          chain->ref_seq_num);
+    gt_warning("protein sequence '%s' (#" GT_WU " in file %s) does not end "
+               "with a stop amino acid ('%c'). If it is not a protein "
+               "fragment you should add a stop amino acid to improve the "
+               "prediction. For example with `gt seqtransform "
+               "-addstopaminos` (see http://genometools.org for details).",
+               gt_str_get(ref_id), chain->ref_seq_num,
+               gth_input_get_reference_filename(input, chain->ref_file_num),
+               GT_STOP_AMINO);
+    match_info->stop_amino_acid_warning = true;
+    gt_str_delete(ref_id);
+  }
+
+  /* allocating space for alignment, the consecutive call number is set when
+     the alignment is saved */
+  job->saA = gth_sa_new_and_set(directmatches, true, input, chain->gen_file_num,
+                                chain->gen_seq_num, chain->ref_file_num,
+                                chain->ref_seq_num, GT_UNDEF_UWORD,
+                                job->gen_total_length, job->gen_offset,
+                                job->ref_total_length);
+
+  /* allocating space for the alignment to the second strand, because the
+     input must not be accessed by the DP workers */
+  if (refseqisdna && gth_input_both(input) && !call_info->cdnaforwardonly) {
+    job->saB = gth_sa_new_and_set(!directmatches, false, input,
+                                  chain->gen_file_num, chain->gen_seq_num,
+                                  chain->ref_file_num, chain->ref_seq_num,
+                                  GT_UNDEF_UWORD, job->gen_total_length,
+                                  job->gen_offset, job->ref_total_length);
+  }
+
+  /* extend the DP borders to the left and to the right */
+  gth_chain_extend_borders(chain, &job->gen_seq_bounds,
+                           &job->gen_seq_bounds_rc, job->gen_total_length,
+                           job->gen_offset);
+
+  /* From here on the dp positions always refer to the forward strand of the
+     genomic DNA. */
+}
+
+static void delete_dp_job_sas(GthDPJob *job)
+{
+  if (job->saA != job->sa)
+    gth_sa_delete(job->saA);
+  if (job->saB != job->sa)
+    gth_sa_delete(job->saB);
+}
+
+/* the following function saves the alignment of <job> which has been computed
+   by a DP worker */
+static int save_dp_job(GthDPJob *job, GthSACollection *sa_collection,
+                       GthCallInfo *call_info, GthStat *stat,
+                       GthMatchInfo *match_info)
+{
+  match_info->call_number++;
+
+  /* check return value */
+  if (job->rval == GTH_ERROR_DP_PARAMETER_ALLOCATION_FAILED) {
+    /* statistics bookkeeping */
+    gth_stat_increment_numoffailedDPparameterallocations(stat);
+    gth_stat_increment_numofundeterminedSAs(stat);
+    /* free space */
+    job->sa = NULL;
+    delete_dp_job_sas(job);
+    match_info->call_number--;
+    return 0; /* continue with the next DP range */
+  }
+  else if (job->rval) {
+    job->sa = NULL;
+    delete_dp_job_sas(job);
+    return -1;
+  }
+
+  delete_dp_job_sas(job);
+  if (job->sa) {
+    gth_sa_set_call_number(job->sa, match_info->call_number);
+    save_sa(sa_collection, job->sa, call_info->sa_filter, match_info, stat);
+  }
+  else if (job->significant_match_found)
+    match_info->significant_match_found = true;
+  else
+    match_info->call_number--;
+
+  return 0;
+}
+
 static int calc_spliced_alignments(GthSACollection *sa_collection,
                                    GthChainCollection *chain_collection,
                                    GthCallInfo *call_info,
                                    GthInput *input,
+                                   GthDPWorkspace **dp_workspaces,
                                    GthStat *stat,
                                    GtUword gen_file_num,
                                    GtUword ref_file_num,
@@ -638,30 +852,67 @@ static int calc_spliced_alignments(GthSACollection *sa_collection,
                                    GthDNACompletePathMatrixJT
                                    dna_complete_path_matrix_jt,
                                    GthProteinCompletePathMatrixJT
-                                   protein_complete_path_matrix_jt)
+                                   protein_complete_path_matrix_jt,
+                                   GtError *err)
 {
-  const unsigned char *ref_seq_tran, *ref_seq_orig, *ref_seq_tran_rc = NULL,
-                      *ref_seq_orig_rc = NULL;
-  GtUword chainctr, gen_offset = GT_UNDEF_UWORD, gen_total_length,
-                ref_total_length;
+  GtUword chainctr = 0, num_of_chains, batch_size, num_of_stats, j;
   GtFile *outfp = call_info->out->outfp;
-  GtRange gen_seq_bounds, gen_seq_bounds_rc;
-  bool refseqisdna;
-  GthChain *chain;
-  GtRange range;
-  GthSA *saA;
-  int rval;
+  GthDPWorkerInfo info;
+  GthCurrentSeqs seqs;
+  bool refseqisdna, parallel;
+  int had_err = 0;
 
+  gt_error_check(err);
   gt_assert(sa_collection && chain_collection);
 
   refseqisdna = gth_input_ref_file_is_dna(input, ref_file_num);
+  num_of_chains = gth_chain_collection_size(chain_collection);
 
-  for (chainctr = 0;
-       chainctr < gth_chain_collection_size(chain_collection);
-       chainctr++) {
-       chain = gth_chain_collection_get(chain_collection, chainctr);
-    if (++match_info->call_number > call_info->firstalshown &&
-        call_info->firstalshown > 0) {
+  seqs.gen_seq_tran = gth_input_current_gen_seq_tran(input);
+  seqs.gen_seq_orig = gth_input_current_gen_seq_orig(input);
+  if (!directmatches || gth_input_reverse(input)) {
+    seqs.gen_seq_tran_rc = gth_input_current_gen_seq_tran_rc(input);
+    seqs.gen_seq_orig_rc = gth_input_current_gen_seq_orig_rc(input);
+  }
+  else {
+    seqs.gen_seq_tran_rc = NULL;
+    seqs.gen_seq_orig_rc = NULL;
+  }
+  seqs.gen_alphabet = gth_input_current_gen_alphabet(input);
+  seqs.ref_alphabet = gth_input_current_ref_alphabet(input);
+
+  /* the chains are aligned in batches by <gt_jobs> DP workers, each with its
+     own statistics and DP workspace. The DPs are only done one after another
+     if they produce output, which has to appear in the order of the chains. */
+  parallel = gt_jobs > 1 && !call_info->out->comments &&
+             !call_info->out->showverbose && !call_info->out->showeops;
+  batch_size = parallel ? gt_jobs * DP_JOBS_PER_WORKER : 1;
+  num_of_stats = parallel ? gt_jobs : 1;
+
+  info.jobs = gt_malloc(sizeof *info.jobs * batch_size);
+  info.stats = gt_malloc(sizeof *info.stats * num_of_stats);
+  info.dp_workspaces = dp_workspaces;
+  if (parallel) {
+    for (j = 0; j < num_of_stats; j++)
+      info.stats[j] = gth_stat_new();
+  }
+  else
+    info.stats[0] = stat;
+  info.gen_file_num = gen_file_num;
+  info.ref_file_num = ref_file_num;
+  info.num_of_chains = num_of_chains;
+  info.directmatches = directmatches;
+  info.refseqisdna = refseqisdna;
+  info.call_info = call_info;
+  info.input = input;
+  info.seqs = &seqs;
+  info.dna_complete_path_matrix_jt = dna_complete_path_matrix_jt;
+  info.protein_complete_path_matrix_jt = protein_complete_path_matrix_jt;
+
+  while (!had_err && chainctr < num_of_chains) {
+    if (call_info->firstalshown > 0 &&
+        match_info->call_number >= call_info->firstalshown) {
+      match_info->call_number++;
       if (!(call_info->out->xmlout || call_info->out->gff3out))
         gt_file_xfputc('\n', outfp);
       else if (call_info->out->xmlout)
@@ -684,113 +935,59 @@ static int calc_spliced_alignments(GthSACollection *sa_collection,
       break; /* break out of loop */
     }
 
-    /* compute considered genomic regions if not set by -frompos */
-    if (!gth_input_use_substring_spec(input)) {
-      gen_seq_bounds = gth_input_get_genomic_range(input, chain->gen_file_num,
-                                                   chain->gen_seq_num);
-      gen_total_length      = gt_range_length(&gen_seq_bounds);
-      gen_offset            = gen_seq_bounds.start;
-      gen_seq_bounds_rc     = gen_seq_bounds;
-    }
-    else {
-      /* genomic multiseq contains exactly one sequence */
-      gt_assert(gth_input_num_of_gen_seqs(input, chain->gen_file_num) == 1);
-      gen_total_length = gth_input_genomic_file_total_length(input,
-                                                             chain
-                                                             ->gen_file_num);
-      gen_seq_bounds.start    = gth_input_genomic_substring_from(input);
-      gen_seq_bounds.end      = gth_input_genomic_substring_to(input);
-      gen_offset              = 0;
-      gen_seq_bounds_rc.start = gen_total_length - 1 - gen_seq_bounds.end;
-      gen_seq_bounds_rc.end   = gen_total_length - 1 - gen_seq_bounds.start;
-    }
-
-    /* "retrieving" the reference sequence */
-    range = gth_input_get_reference_range(input, chain->ref_file_num,
-                                          chain->ref_seq_num);
-    ref_seq_tran = gth_input_current_ref_seq_tran(input) + range.start;
-    ref_seq_orig = gth_input_current_ref_seq_orig(input) + range.start;
-    if (refseqisdna) {
-      ref_seq_tran_rc = gth_input_current_ref_seq_tran_rc(input) + range.start;
-      ref_seq_orig_rc = gth_input_current_ref_seq_orig_rc(input) + range.start;
+    /* every chain increases the call number by at most one, the batch must
+       not contain chains after the maximal number of matches */
+    info.num_of_jobs = MIN(batch_size, num_of_chains - chainctr);
+    if (call_info->firstalshown > 0) {
+      info.num_of_jobs = MIN(info.num_of_jobs, call_info->firstalshown
+                                               - match_info->call_number);
     }
-    ref_total_length = range.end - range.start + 1;
-
-    /* check if protein sequences have a stop amino acid */
-    if (!refseqisdna && !match_info->stop_amino_acid_warning &&
-       ref_seq_orig[ref_total_length - 1] != GT_STOP_AMINO) {
-      GtStr *ref_id = gt_str_new();
-      gth_input_save_ref_id(input, ref_id, chain->ref_file_num,
-                            chain->ref_seq_num);
-      gt_warning("protein sequence '%s' (#" GT_WU " in file %s) does not end "
-                 "with a stop amino acid ('%c'). If it is not a protein "
-                 "fragment you should add a stop amino acid to improve the "
-                 "prediction. For example with `gt seqtransform "
-                 "-addstopaminos` (see http://genometools.org for details).",
-                 gt_str_get(ref_id), chain->ref_seq_num,
-                 gth_input_get_reference_filename(input, chain->ref_file_num),
-                 GT_STOP_AMINO);
-      match_info->stop_amino_acid_warning = true;
-      gt_str_delete(ref_id);
+    for (j = 0; j < info.num_of_jobs; j++) {
+      prepare_dp_job(info.jobs + j,
+                     gth_chain_collection_get(chain_collection, chainctr + j),
+                     chainctr + j, call_info, input, directmatches,
+                     refseqisdna, match_info);
     }
 
-    /* allocating space for alignment */
-    saA = gth_sa_new_and_set(directmatches, true, input, chain->gen_file_num,
-                             chain->gen_seq_num, chain->ref_file_num,
-                             chain->ref_seq_num, match_info->call_number,
-                             gen_total_length, gen_offset, ref_total_length);
-
-    /* extend the DP borders to the left and to the right */
-    gth_chain_extend_borders(chain, &gen_seq_bounds, &gen_seq_bounds_rc,
-                             gen_total_length, gen_offset);
-
-    /* From here on the dp positions always refer to the forward strand of the
-       genomic DNA. */
-
     /* call the Dynamic Programming */
-    if (refseqisdna) {
-      rval = call_dna_DP(directmatches, call_info, input, stat,
-                         sa_collection, saA, gen_file_num, ref_file_num,
-                         gen_total_length, gen_offset, &gen_seq_bounds,
-                         &gen_seq_bounds_rc, ref_total_length, range.start,
-                         chainctr, gth_chain_collection_size(chain_collection),
-                         match_info, ref_seq_tran, ref_seq_orig,
-                         ref_seq_tran_rc, ref_seq_orig_rc, chain,
-                         dna_complete_path_matrix_jt,
-                         protein_complete_path_matrix_jt);
-    }
-    else {
-      rval = call_protein_DP(directmatches, call_info, input,
-                             stat, sa_collection, saA, gen_file_num,
-                             ref_file_num, gen_total_length, gen_offset,
-                             &gen_seq_bounds, &gen_seq_bounds_rc,
-                             ref_total_length, range.start, chainctr,
-                             gth_chain_collection_size(chain_collection),
-                             match_info, ref_seq_tran, ref_seq_orig, chain,
-                             dna_complete_path_matrix_jt,
-                             protein_complete_path_matrix_jt);
+    info.next_job = 0;
+    info.next_slot = 0;
+    if (parallel)
+      had_err = gt_multithread(dp_worker_thread, &info, err);
+    else
+      dp_worker_thread(&info);
+
+    /* save the alignments in the order of the chains */
+    for (j = 0; j < info.num_of_jobs; j++) {
+      if (!had_err) {
+        had_err = save_dp_job(info.jobs + j, sa_collection, call_info, stat,
+                              match_info);
+      }
+      else {
+        /* the alignment of the job is not saved, free it as well */
+        info.jobs[j].sa = NULL;
+        delete_dp_job_sas(info.jobs + j);
+      }
     }
-    /* check return value */
-    if (rval == GTH_ERROR_DP_PARAMETER_ALLOCATION_FAILED) {
-      /* statistics bookkeeping */
-      gth_stat_increment_numoffailedDPparameterallocations(stat);
-      gth_stat_increment_numofundeterminedSAs(stat);
-      /* free space */
-      gth_sa_delete(saA);
-      match_info->call_number--;
-      continue; /* continue with the next DP range */
+    chainctr += info.num_of_jobs;
+  }
+
+  if (parallel) {
+    for (j = 0; j < num_of_stats; j++) {
+      gth_stat_add(stat, info.stats[j]);
+      gth_stat_delete(info.stats[j]);
     }
-    else if (rval)
-      return -1;
   }
+  gt_free(info.stats);
+  gt_free(info.jobs);
 
-  if (!call_info->out->xmlout && !call_info->out->gff3out && !directmatches &&
-      !match_info->significant_match_found &&
+  if (!had_err && !call_info->out->xmlout && !call_info->out->gff3out &&
+      !directmatches && !match_info->significant_match_found &&
       match_info->call_number <= call_info->firstalshown) {
     show_no_match_line(gth_input_get_alphatype(input, ref_file_num), outfp);
   }
 
-  return 0;
+  return had_err;
 }
 
 static void show_compute_matches_status(bool direct, GthShowVerbose showverbose,
@@ -832,8 +1029,10 @@ static void show_compute_matches_status(bool direct, GthShowVerbose showverbose,
 static int compute_sa_collection(GthSACollection *sa_collection,
                                  GthCallInfo *call_info,
                                  GthInput *input,
+                                 GthDPWorkspace **dp_workspaces,
                                  GthStat *stat,
-                                 const GthPlugins *plugins)
+                                 const GthPlugins *plugins,
+                                 GtError *err)
 {
   GthChainCollection *chain_collection;
   GthMatchInfo match_info;
@@ -859,11 +1058,13 @@ static int compute_sa_collection(GthSACollection *sa_collection,
                                            &match_info, plugins);
         if (chain_collection) {
           rval = calc_spliced_alignments(sa_collection, chain_collection,
-                                         call_info, input, stat, g, r, true,
+                                         call_info, input, dp_workspaces,
+                                         stat, g, r, true,
                                          &match_info,
                                          plugins->dna_complete_path_matrix_jt,
                                          plugins
-                                         ->protein_complete_path_matrix_jt);
+                                         ->protein_complete_path_matrix_jt,
+                                         err);
           gth_chain_collection_delete(chain_collection);
           if (rval)
             break;
@@ -884,11 +1085,13 @@ static int compute_sa_collection(GthSACollection *sa_collection,
                                            &match_info, plugins);
         if (chain_collection) {
           rval = calc_spliced_alignments(sa_collection, chain_collection,
-                                         call_info, input, stat, g, r, false,
+                                         call_info, input, dp_workspaces,
+                                         stat, g, r, false,
                                          &match_info,
                                          plugins->dna_complete_path_matrix_jt,
                                          plugins
-                                         ->protein_complete_path_matrix_jt);
+                                         ->protein_complete_path_matrix_jt,
+                                         err);
           gth_chain_collection_delete(chain_collection);
           if (rval)
             break;
@@ -902,19 +1105,81 @@ static int compute_sa_collection(GthSACollection *sa_collection,
   return rval;
 }
 
+/* the DP memory of each DP worker, reused for all alignments */
+static GthDPWorkspace** dp_workspaces_new(void)
+{
+  GthDPWorkspace **dp_workspaces;
+  GtUword j;
+  dp_workspaces = gt_malloc(sizeof *dp_workspaces * gt_jobs);
+  for (j = 0; j < gt_jobs; j++)
+    dp_workspaces[j] = gth_dp_workspace_new();
+  return dp_workspaces;
+}
+
+static void dp_workspaces_delete(GthDPWorkspace **dp_workspaces)
+{
+  GtUword j;
+  for (j = 0; j < gt_jobs; j++)
+    gth_dp_workspace_delete(dp_workspaces[j]);
+  gt_free(dp_workspaces);
+}
+
+int gth_similarity_filter_align_chains(GthSACollection *sa_collection,
+                                       GthChainCollection *chain_collection,
+                                       GthCallInfo *call_info,
+                                       GthInput *input, GthStat *stat,
+                                       GtUword gen_file_num,
+                                       GtUword ref_file_num,
+                                       bool directmatches, GtError *err)
+{
+  GthDPWorkspace **dp_workspaces;
+  GthMatchInfo match_info;
+  int had_err;
+
+  gt_error_check(err);
+  gt_assert(sa_collection && chain_collection && call_info && input && stat);
+
+  match_info.call_number = 0;
+  match_info.significant_match_found = false;
+  match_info.max_call_number_reached = false;
+  match_info.stop_amino_acid_warning = false;
+
+  dp_workspaces = dp_workspaces_new();
+  had_err = calc_spliced_alignments(sa_collection, chain_collection, call_info,
+                                    input, dp_workspaces, stat, gen_file_num,
+                                    ref_file_num, directmatches, &match_info,
+                                    NULL, NULL, err);
+  dp_workspaces_delete(dp_workspaces);
+
+  return had_err;
+}
+
 int gth_similarity_filter(GthCallInfo *call_info, GthInput *input,
                           GthStat *stat, unsigned int indentlevel,
-                          const GthPlugins *plugins, GT_UNUSED GtError *err)
+                          const GthPlugins *plugins, GtError *err)
 {
   GthSACollection *sa_collection; /* stores the calculated spliced alignments */
+  GthDPWorkspace **dp_workspaces;
+  int had_err;
 
   gt_error_check(err);
 
   /* initialization */
   sa_collection = gth_sa_collection_new(call_info->duplicate_check);
+  dp_workspaces = dp_workspaces_new();
 
   /* compute the spliced alignments */
-  if (compute_sa_collection(sa_collection, call_info, input, stat, plugins)) {
+  had_err = compute_sa_collection(sa_collection, call_info, input,
+                                  dp_workspaces, stat, plugins, err);
+
+  /* with verbose output all DPs are done by the first worker */
+  if (call_info->out->showverbose) {
+    gth_dp_workspace_show_stats(dp_workspaces[0],
+                                call_info->out->showverbose);
+  }
+  dp_workspaces_delete(dp_workspaces);
+
+  if (had_err) {
     gth_sa_collection_delete(sa_collection);
     return -1;
   }
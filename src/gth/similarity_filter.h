@@ -18,11 +18,26 @@
 #ifndef SIMILARITY_FILTER_H
 #define SIMILARITY_FILTER_H
 
+#include "gth/chain_collection.h"
 #include "gth/plugins.h"
+#include "gth/sa_collection.h"
 #include "gth/stat.h"
 
 int gth_similarity_filter(GthCallInfo*, GthInput*, GthStat*,
                           unsigned int indentlevel, const GthPlugins *plugins,
                           GtError*);
 
+/* Computes the spliced alignments of the chains in <chain_collection> in
+   <gt_jobs> DP workers, exactly as <gth_similarity_filter()> does after the
+   chaining phase, and inserts them into <sa_collection>. The genomic file
+   <gen_file_num> and the reference file <ref_file_num> of the chains have to
+   be loaded in <input>. No jump tables are used. */
+int gth_similarity_filter_align_chains(GthSACollection *sa_collection,
+                                       GthChainCollection *chain_collection,
+                                       GthCallInfo *call_info,
+                                       GthInput *input, GthStat *stat,
+                                       GtUword gen_file_num,
+                                       GtUword ref_file_num,
+                                       bool directmatches, GtError *err);
+
 #endif
@@ -214,6 +214,47 @@ void gth_stat_increase_numofPGLs_stored(GthStat *stat, GtUword addend)
   stat->numofPGLs_stored += addend;
 }
 
+static void add_to_distri(GtUword key, GtUint64 value, void *data)
+{
+  gt_disc_distri_add_multi(data, key, value);
+}
+
+void gth_stat_add(GthStat *stat, const GthStat *addend)
+{
+  gt_assert(stat && addend);
+  stat->numofchains                       += addend->numofchains;
+  stat->numofremovedzerobaseexons         += addend->numofremovedzerobaseexons;
+  stat->numofautointroncutoutcalls        +=
+    addend->numofautointroncutoutcalls;
+  stat->numofunsuccessfulintroncutoutDPs  +=
+    addend->numofunsuccessfulintroncutoutDPs;
+  stat->numoffailedDPparameterallocations +=
+    addend->numoffailedDPparameterallocations;
+  stat->numoffailedmatrixallocations      +=
+    addend->numoffailedmatrixallocations;
+  stat->numofundeterminedSAs              += addend->numofundeterminedSAs;
+  stat->numoffilteredpolyAtailmatches     +=
+    addend->numoffilteredpolyAtailmatches;
+  stat->numofSAs                          += addend->numofSAs;
+  stat->numofPGLs_stored                  += addend->numofPGLs_stored;
+  gth_stat_increase_totalsizeofbacktracematricesinMB(stat,
+                                    addend->totalsizeofbacktracematricesinMB);
+  stat->numofbacktracematrixallocations   +=
+    addend->numofbacktracematrixallocations;
+  gt_disc_distri_foreach(addend->exondistribution, add_to_distri,
+                         stat->exondistribution);
+  gt_disc_distri_foreach(addend->introndistribution, add_to_distri,
+                         stat->introndistribution);
+  gt_disc_distri_foreach(addend->matchnumdistribution, add_to_distri,
+                         stat->matchnumdistribution);
+  gt_disc_distri_foreach(addend->refseqcoveragedistribution, add_to_distri,
+                         stat->refseqcoveragedistribution);
+  gt_disc_distri_foreach(addend->sa_alignment_score_distribution,
+                         add_to_distri, stat->sa_alignment_score_distribution);
+  gt_disc_distri_foreach(addend->sa_coverage_distribution, add_to_distri,
+                         stat->sa_coverage_distribution);
+}
+
 GtUword gth_stat_get_numofSAs(GthStat *stat)
 {
   gt_assert(stat);
@@ -44,6 +44,7 @@ void          gth_stat_increase_numofchains(GthStat*, GtUword);
 void          gth_stat_increase_totalsizeofbacktracematricesinMB(GthStat*,
                                                                  GtUword);
 void          gth_stat_increase_numofPGLs_stored(GthStat*, GtUword);
+void          gth_stat_add(GthStat *stat, const GthStat *addend);
 GtUword gth_stat_get_numofSAs(GthStat*);
 bool          gth_stat_get_exondistri(GthStat*);
 bool          gth_stat_get_introndistri(GthStat*);
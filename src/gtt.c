@@ -42,6 +42,7 @@
 #include "core/grep_api.h"
 #include "core/hashmap.h"
 #include "core/hashtable.h"
+#include "core/interval_index.h"
 #include "core/interval_tree.h"
 #include "core/mathsupport.h"
 #include "core/md5_seqid.h"
@@ -319,6 +320,8 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "hashtable class", gt_hashtable_unit_test);
   gt_hashmap_add(unit_tests, "hmm class", gt_hmm_unit_test);
   gt_hashmap_add(unit_tests, "huffman coding class", gt_huffman_unit_test);
+  gt_hashmap_add(unit_tests, "interval index class",
+                 gt_interval_index_unit_test);
   gt_hashmap_add(unit_tests, "interval tree class", gt_interval_tree_unit_test);
   gt_hashmap_add(unit_tests, "Lua serializer module",
                                                    gt_lua_serializer_unit_test);
@@ -32,6 +32,7 @@
 #include "core/multithread_api.h"
 #include "core/str_api.h"
 #include "core/thread_api.h"
+#include "core/timer_api.h"
 #include "core/types_api.h"
 #include "core/undef_api.h"
 #include "extended/feature_type.h"
@@ -106,6 +107,13 @@ typedef struct
 
 GT_DECLAREARRAYSTRUCT(LTRboundaries);
 
+/* The candidates found by one thread, in the order of their seeds. */
+typedef struct
+{
+  GtArrayLTRboundaries boundaries;
+  GtArrayGtUlong seednumbers; /* seed of each element of boundaries */
+} LTRcandidates;
+
 typedef enum {
   GT_LTRHARVEST_STREAM_STATE_START,
   GT_LTRHARVEST_STREAM_STATE_REGIONS,
@@ -901,9 +909,8 @@ static void adjustboundariesfromXdropextension(GtXdropbest xdropbest_left,
 /* The following function applies the filter algorithms one after another
    to all candidate pairs */
 static int gt_searchforLTRs(GtLTRharvestStream *lo,
-                            GtArrayLTRboundaries *arrayLTRboundaries,
+                            LTRcandidates *candidates,
                             GT_UNUSED GtMutex *rmutex,
-                            GT_UNUSED GtMutex *wmutex,
                             GtUword *cur_seed,
                             GtError *err)
 {
@@ -1108,10 +1115,10 @@ static int gt_searchforLTRs(GtLTRharvestStream *lo,
     if (!gt_double_smaller_double(boundaries.similarity,
                                   lo->similaritythreshold))
     {
-      gt_mutex_lock(wmutex);
-      GT_GETNEXTFREEINARRAY(boundaries_ptr,arrayLTRboundaries,LTRboundaries,5);
+      GT_GETNEXTFREEINARRAY(boundaries_ptr,&candidates->boundaries,
+                            LTRboundaries,5);
       *boundaries_ptr = boundaries;
-      gt_mutex_unlock(wmutex);
+      GT_STOREINARRAY(&candidates->seednumbers,GtUlong,5,my_seed);
     }
   }
 #ifdef GT_GREEDY_BUFFER
@@ -1127,23 +1134,74 @@ static int gt_searchforLTRs(GtLTRharvestStream *lo,
 
 typedef struct {
   GtLTRharvestStream *lo;
-  GtArrayLTRboundaries *arrayLTRboundaries;
+  LTRcandidates *candidates; /* one for each thread */
   const GtEncseq *encseq;
   GtError *err;
-  GtMutex *rmutex, *wmutex;
-  GtUword cur_seed;
+  GtMutex *rmutex;
+  GtUword cur_seed,
+          cur_candidates;
 } GtLTRharvestThreadInfo;
 
 static void* gt_searchforLTRs_threadfunc(void *data) {
   GtLTRharvestThreadInfo *info = (GtLTRharvestThreadInfo*) data;
+  LTRcandidates *candidates;
   GT_UNUSED int rval;
   gt_assert(info);
-  rval = gt_searchforLTRs(info->lo, info->arrayLTRboundaries, info->rmutex,
-                          info->wmutex, &info->cur_seed, info->err);
+  gt_mutex_lock(info->rmutex);
+  gt_assert(info->cur_candidates < (GtUword) gt_jobs);
+  candidates = info->candidates + info->cur_candidates++;
+  gt_mutex_unlock(info->rmutex);
+  rval = gt_searchforLTRs(info->lo, candidates, info->rmutex,
+                          &info->cur_seed, info->err);
   gt_assert(rval == 0);
   return NULL;
 }
 
+/* The following function merges the candidates of all threads into
+   <arrayLTRboundaries> in the order of their seeds. As every thread
+   processes its seeds in increasing order, this is the order in which a
+   single thread would have stored them, so that the subsequent sorting
+   and filtering steps deliver the same result for any number of threads. */
+static void gt_mergecandidates(GtArrayLTRboundaries *arrayLTRboundaries,
+                               const LTRcandidates *candidates,
+                               GtUword numofcandidates)
+{
+  GtUword idx, total = 0, *nextcandidate;
+
+  nextcandidate = gt_calloc((size_t) numofcandidates, sizeof (*nextcandidate));
+  for (idx = 0; idx < numofcandidates; idx++)
+  {
+    total += candidates[idx].boundaries.nextfreeLTRboundaries;
+  }
+  if (total > 0)
+  {
+    GT_CHECKARRAYSPACEMULTI(arrayLTRboundaries,LTRboundaries,total);
+  }
+  while (total-- > 0)
+  {
+    GtUword minidx = numofcandidates, minseed = 0;
+
+    for (idx = 0; idx < numofcandidates; idx++)
+    {
+      const LTRcandidates *current = candidates + idx;
+
+      if (nextcandidate[idx] < current->boundaries.nextfreeLTRboundaries &&
+          (minidx == numofcandidates ||
+           current->seednumbers.spaceGtUlong[nextcandidate[idx]] < minseed))
+      {
+        minidx = idx;
+        minseed = current->seednumbers.spaceGtUlong[nextcandidate[idx]];
+      }
+    }
+    gt_assert(minidx < numofcandidates);
+    arrayLTRboundaries->spaceLTRboundaries
+      [arrayLTRboundaries->nextfreeLTRboundaries++]
+      = candidates[minidx].boundaries.spaceLTRboundaries
+                                     [nextcandidate[minidx]++];
+  }
+  gt_free(nextcandidate);
+}
+
 /* The following function removes exact duplicates from the (sorted!)
    array of predicted LTR elements. Exact duplicates occur when different seeds
    are extended to same boundary coordinates. */
@@ -1234,6 +1292,13 @@ static int gt_ltrharvest_stream_next(GtNodeStream *ns,
 
   ltrh_stream = gt_ltrharvest_stream_cast(ns);
   if (ltrh_stream->state == GT_LTRHARVEST_STREAM_STATE_START) {
+    GtTimer *timer = NULL;
+    GtUword idx;
+
+    if (ltrh_stream->verbosemode) {
+      timer = gt_timer_new_with_progress_description("enumerating seeds");
+      gt_timer_start(timer);
+    }
     GT_INITARRAY(&ltrh_stream->repeatinfo.repeats, Repeat);
     ltrh_stream->prevseqnum = GT_UNDEF_UWORD;
     if (!had_err && gt_enumeratemaxpairs(ltrh_stream->ssar,
@@ -1246,14 +1311,25 @@ static int gt_ltrharvest_stream_next(GtNodeStream *ns,
     {
       had_err = -1;
     }
+    if (timer != NULL) {
+      gt_timer_show_progress_formatted(timer, stderr,
+                                       "extending "GT_WU" seeds",
+                                       ltrh_stream->repeatinfo.repeats.
+                                         nextfreeRepeat);
+    }
 
     threadinfo.lo = ltrh_stream;
     threadinfo.encseq = ltrh_stream->encseq;
-    threadinfo.arrayLTRboundaries = &ltrh_stream->arrayLTRboundaries;
+    threadinfo.candidates = gt_malloc(sizeof (*threadinfo.candidates) *
+                                      gt_jobs);
+    for (idx = 0; idx < (GtUword) gt_jobs; idx++) {
+      GT_INITARRAY(&threadinfo.candidates[idx].boundaries, LTRboundaries);
+      GT_INITARRAY(&threadinfo.candidates[idx].seednumbers, GtUlong);
+    }
     threadinfo.err = err;
     threadinfo.cur_seed = 0;
+    threadinfo.cur_candidates = 0;
     threadinfo.rmutex = gt_mutex_new();
-    threadinfo.wmutex = gt_mutex_new();
     /* apply the seed extension and filter algorithms */
     if (!had_err && gt_multithread(gt_searchforLTRs_threadfunc,
                                    &threadinfo, err) != 0)
@@ -1261,15 +1337,32 @@ static int gt_ltrharvest_stream_next(GtNodeStream *ns,
       had_err = -1;
     }
     gt_mutex_delete(threadinfo.rmutex);
-    gt_mutex_delete(threadinfo.wmutex);
 
     /* not needed any longer */
     GT_FREEARRAY(&ltrh_stream->repeatinfo.repeats, Repeat);
 
+    /* collect the candidates of all threads */
+    if (!had_err) {
+      gt_mergecandidates(&ltrh_stream->arrayLTRboundaries,
+                         threadinfo.candidates, (GtUword) gt_jobs);
+    }
+    for (idx = 0; idx < (GtUword) gt_jobs; idx++) {
+      GT_FREEARRAY(&threadinfo.candidates[idx].boundaries, LTRboundaries);
+      GT_FREEARRAY(&threadinfo.candidates[idx].seednumbers, GtUlong);
+    }
+    gt_free(threadinfo.candidates);
+    if (timer != NULL) {
+      gt_timer_show_progress_formatted(timer, stderr,
+                                       "sorting and filtering "GT_WU
+                                       " candidates",
+                                       ltrh_stream->arrayLTRboundaries.
+                                         nextfreeLTRboundaries);
+    }
+
     /* sort results after seed extension */
-    if (!had_err && threadinfo.arrayLTRboundaries->spaceLTRboundaries) {
-      qsort(threadinfo.arrayLTRboundaries->spaceLTRboundaries,
-            (size_t) threadinfo.arrayLTRboundaries->nextfreeLTRboundaries,
+    if (!had_err && ltrh_stream->arrayLTRboundaries.spaceLTRboundaries) {
+      qsort(ltrh_stream->arrayLTRboundaries.spaceLTRboundaries,
+            (size_t) ltrh_stream->arrayLTRboundaries.nextfreeLTRboundaries,
              sizeof (LTRboundaries),  bdcompare);
     }
 
@@ -1283,6 +1376,10 @@ static int gt_ltrharvest_stream_next(GtNodeStream *ns,
       gt_removeoverlapswithlowersimilarity(&ltrh_stream->arrayLTRboundaries,
                                             ltrh_stream->nooverlaps);
     }
+    if (timer != NULL) {
+      gt_timer_show_progress_final(timer, stderr);
+      gt_timer_delete(timer);
+    }
 
     /* build array of non-skipped elements */
     if (!had_err) {
@@ -2703,6 +2703,12 @@ printBucket(const struct blockCompositionSeq *seqIdx, GtUword bucketNum,
   return outCount;
 }
 
+bool
+gt_EISUsesMMap(const EISeq *seq)
+{
+  return seqIdxUsesMMap(constEncIdxSeq2blockCompositionSeq(seq));
+}
+
 unsigned
 gt_blockEncIdxSeqSegmentLen(const struct blockEncParams *params)
 {
@@ -152,6 +152,16 @@ typedef union EISHint *EISHint;
 void
 gt_deleteEncIdxSeq(EISeq *seq);
 
+/**
+ * \brief Query whether the index data of a sequence object is memory
+ * mapped. Otherwise the blocks are read from a file pointer shared by
+ * all hints, which must not be used concurrently.
+ * @param seq reference of object to query
+ * @return true if the index data is memory mapped
+ */
+bool
+gt_EISUsesMMap(const EISeq *seq);
+
 /**
  * \brief Retrieve alphabet transformation from sequence object
  * @param seq reference of object to query for alphabet
@@ -413,6 +413,30 @@ void gt_deletevoidBWTSeq(FMindex *fmindex)
   gt_deleteBWTSeq(bwtseq);
 }
 
+FMindex *gt_sharedcopyvoidBWTSeq(const FMindex *packedindex)
+{
+  BWTSeq *bwtseq;
+
+  /* the superblocks of an index which is not mapped are read with the file
+     pointer of the index */
+  if (!gt_EISUsesMMap(((const BWTSeq *) packedindex)->seqIdx))
+  {
+    return NULL;
+  }
+  bwtseq = gt_malloc(sizeof *bwtseq);
+  *bwtseq = *(const BWTSeq *) packedindex;
+  bwtseq->hint = newEISHint(bwtseq->seqIdx);
+  return (FMindex *) bwtseq;
+}
+
+void gt_deletesharedcopyvoidBWTSeq(FMindex *packedindex)
+{
+  BWTSeq *bwtseq = (BWTSeq *) packedindex;
+
+  deleteEISHint(bwtseq->seqIdx, bwtseq->hint);
+  gt_free(bwtseq);
+}
+
 GtUword gt_voidpackedindexuniqueforward(const void *fmindex,
                                               GT_UNUSED GtUword offset,
                                               GT_UNUSED GtUword left,
@@ -83,6 +83,15 @@ FMindex *gt_loadvoidBWTSeqForSA(const char *indexname,
 
 void gt_deletevoidBWTSeq(FMindex *packedindex);
 
+/* Returns a copy of <packedindex> which shares the loaded index with it, but
+   has its own rank cache, so that both can be queried concurrently. The copy
+   has to be deleted with gt_deletesharedcopyvoidBWTSeq() before
+   <packedindex> is deleted. Returns NULL if the index could not be memory
+   mapped, because then all queries read from the same file pointer. */
+FMindex *gt_sharedcopyvoidBWTSeq(const FMindex *packedindex);
+
+void gt_deletesharedcopyvoidBWTSeq(FMindex *packedindex);
+
 /* the parameter is const void *, as this is required by the other
    indexed based methods */
 
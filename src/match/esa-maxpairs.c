@@ -16,9 +16,13 @@
 */
 
 #include "core/arraydef.h"
+#include "core/minmax.h"
+#include "core/multithread_api.h"
+#include "core/thread_api.h"
 #include "core/unused_api.h"
 #include "esa-seqread.h"
 #include "esa-maxpairs.h"
+#include "lcpoverflow.h"
 
 #define ISLEFTDIVERSE   (GtUchar) (state->alphabetsize)
 #define INITIALCHAR     (GtUchar) (state->alphabetsize+1)
@@ -348,18 +352,16 @@ static int processbranchingedge_maxpairs(bool firstsucc,
 
 #include "esa-bottomup-maxpairs.inc"
 
-int gt_enumeratemaxpairs(Sequentialsuffixarrayreader *ssar,
-                         const GtEncseq *encseq,
-                         GtReadmode readmode,
-                         unsigned int searchlength,
-                         Processmaxpairs processmaxpairs,
-                         void *processmaxpairsinfo,
-                         GtError *err)
+static GtBUstate_maxpairs *gt_BUstate_maxpairs_new(const GtEncseq *encseq,
+                                                   GtReadmode readmode,
+                                                   unsigned int searchlength,
+                                                   Processmaxpairs
+                                                     processmaxpairs,
+                                                   void *processmaxpairsinfo)
 {
   unsigned int base;
   GtArrayGtUlong *ptr;
   GtBUstate_maxpairs *state;
-  bool haserr = false;
 
   state = gt_malloc(sizeof (*state));
   state->alphabetsize = gt_alphabet_num_of_chars(gt_encseq_alphabet(encseq));
@@ -377,10 +379,14 @@ int gt_enumeratemaxpairs(Sequentialsuffixarrayreader *ssar,
     ptr = &state->poslist[base];
     GT_INITARRAY(ptr,GtUlong);
   }
-  if (gt_esa_bottomup_maxpairs(ssar, state, err) != 0)
-  {
-    haserr = true;
-  }
+  return state;
+}
+
+static void gt_BUstate_maxpairs_delete(GtBUstate_maxpairs *state)
+{
+  unsigned int base;
+  GtArrayGtUlong *ptr;
+
   GT_FREEARRAY(&state->uniquechar,GtUlong);
   for (base = 0; base < state->alphabetsize; base++)
   {
@@ -389,5 +395,251 @@ int gt_enumeratemaxpairs(Sequentialsuffixarrayreader *ssar,
   }
   gt_free(state->poslist);
   gt_free(state);
+}
+
+/* number of parts of the suffix array processed in one round per job */
+#define GT_MAXPAIRS_PARTSPERJOB 4UL
+
+/* maximal number of suffixes in a part, which limits the number of maximal
+   pairs buffered in one round */
+#define GT_MAXPAIRS_MAXPARTWIDTH (1UL << 20)
+
+typedef struct
+{
+  GtUword len, pos1, pos2;
+} GtMaxpair;
+
+GT_DECLAREARRAYSTRUCT(GtMaxpair);
+
+typedef struct
+{
+  GtUword firstsuffix, width;
+  GtArrayGtMaxpair maxpairs;
+} GtMaxpairsPart;
+
+typedef struct
+{
+  const Sequentialsuffixarrayreader *ssar;
+  const GtEncseq *encseq;
+  GtReadmode readmode;
+  unsigned int searchlength;
+  GtMaxpairsPart *parts;
+  GtUword numofparts,
+          nextpart;
+  bool haserr;
+  GtMutex *mutex;
+} GtMaxpairsThreadinfo;
+
+static int gt_maxpairs_storepair(void *info,
+                                 GT_UNUSED const GtEncseq *encseq,
+                                 GtUword len,
+                                 GtUword pos1,
+                                 GtUword pos2,
+                                 GT_UNUSED GtError *err)
+{
+  GtArrayGtMaxpair *maxpairs = (GtArrayGtMaxpair *) info;
+  GtMaxpair *maxpair;
+
+  GT_GETNEXTFREEINARRAY(maxpair,maxpairs,GtMaxpair,maxpairs->
+                                                   allocatedGtMaxpair/2 + 32);
+  maxpair->len = len;
+  maxpair->pos1 = pos1;
+  maxpair->pos2 = pos2;
+  return 0;
+}
+
+/* each thread repeatedly takes the next part of the current round and
+   collects its maximal pairs */
+static void *gt_enumeratemaxpairs_thread(void *data)
+{
+  GtMaxpairsThreadinfo *threadinfo = (GtMaxpairsThreadinfo *) data;
+  GtBUstate_maxpairs *state;
+  GtError *err = gt_error_new();
+
+  state = gt_BUstate_maxpairs_new(threadinfo->encseq,
+                                  threadinfo->readmode,
+                                  threadinfo->searchlength,
+                                  gt_maxpairs_storepair,
+                                  NULL);
+  while (true)
+  {
+    GtMaxpairsPart *part;
+    Sequentialsuffixarrayreader *rangessar;
+    int retval;
+
+    gt_mutex_lock(threadinfo->mutex);
+    if (threadinfo->haserr || threadinfo->nextpart == threadinfo->numofparts)
+    {
+      gt_mutex_unlock(threadinfo->mutex);
+      break;
+    }
+    part = threadinfo->parts + threadinfo->nextpart++;
+    gt_mutex_unlock(threadinfo->mutex);
+    rangessar = gt_newSequentialsuffixarrayreaderrange(threadinfo->ssar,
+                                                       part->firstsuffix,
+                                                       part->width);
+    state->processmaxpairsinfo = &part->maxpairs;
+    state->initialized = false;
+    retval = gt_esa_bottomup_maxpairs(rangessar, state, err);
+    gt_freeSequentialsuffixarrayreader(&rangessar);
+    if (retval != 0)
+    {
+      gt_mutex_lock(threadinfo->mutex);
+      threadinfo->haserr = true;
+      gt_mutex_unlock(threadinfo->mutex);
+      break;
+    }
+  }
+  gt_BUstate_maxpairs_delete(state);
+  gt_error_delete(err);
+  return NULL;
+}
+
+/* Returns the end of the part of the suffix array beginning with
+   suffix <firstsuffix>. The part contains at least <minwidth> suffixes and
+   ends before the next suffix whose lcp value with its predecessor is
+   smaller than <searchlength>. Such a suffix begins a new subtree of lcp
+   intervals of depth at least <searchlength>, so that no maximal pair of
+   length <searchlength> or more spans the parts. */
+static GtUword gt_maxpairs_partend(const Suffixarray *suffixarray,
+                                   GtUword nonspecials,
+                                   unsigned int searchlength,
+                                   GtUword firstsuffix,
+                                   GtUword minwidth)
+{
+  GtUword idx;
+
+  for (idx = firstsuffix + MAX(minwidth,1UL); idx < nonspecials; idx++)
+  {
+    const GtUchar smalllcpvalue = suffixarray->lcptab[idx];
+
+    if (smalllcpvalue < (GtUchar) LCPOVERFLOW &&
+        (unsigned int) smalllcpvalue < searchlength)
+    {
+      return idx;
+    }
+  }
+  return nonspecials;
+}
+
+/* The suffix array is split into parts of independent lcp intervals,
+   which are processed in rounds of <GT_MAXPAIRS_PARTSPERJOB> * <gt_jobs>
+   parts. In each round the parts are traversed concurrently and their
+   maximal pairs are stored. Then the maximal pairs are passed to
+   <processmaxpairs> in the order of the parts, which is the same order as
+   in a single traversal of the whole suffix array. */
+static int gt_enumeratemaxpairs_threaded(Sequentialsuffixarrayreader *ssar,
+                                         const GtEncseq *encseq,
+                                         GtReadmode readmode,
+                                         unsigned int searchlength,
+                                         Processmaxpairs processmaxpairs,
+                                         void *processmaxpairsinfo,
+                                         GtError *err)
+{
+  GtMaxpairsThreadinfo threadinfo;
+  const Suffixarray *suffixarray = gt_suffixarraySequentialsuffixarrayreader(
+                                                                      ssar);
+  const GtUword nonspecials = gt_Sequentialsuffixarrayreader_nonspecials(ssar),
+                maxnumofparts = GT_MAXPAIRS_PARTSPERJOB * gt_jobs;
+  GtUword partidx, pairidx, nextsuffix = 0, minwidth;
+  bool haserr = false;
+
+  threadinfo.ssar = ssar;
+  threadinfo.encseq = encseq;
+  threadinfo.readmode = readmode;
+  threadinfo.searchlength = searchlength;
+  threadinfo.parts = gt_malloc(sizeof (*threadinfo.parts) * maxnumofparts);
+  for (partidx = 0; partidx < maxnumofparts; partidx++)
+  {
+    GT_INITARRAY(&threadinfo.parts[partidx].maxpairs,GtMaxpair);
+  }
+  threadinfo.mutex = gt_mutex_new();
+  minwidth = MIN(nonspecials/maxnumofparts,GT_MAXPAIRS_MAXPARTWIDTH);
+  while (!haserr && nextsuffix < nonspecials)
+  {
+    for (threadinfo.numofparts = 0;
+         threadinfo.numofparts < maxnumofparts && nextsuffix < nonspecials;
+         threadinfo.numofparts++)
+    {
+      GtMaxpairsPart *part = threadinfo.parts + threadinfo.numofparts;
+      GtUword partend = gt_maxpairs_partend(suffixarray,nonspecials,
+                                            searchlength,nextsuffix,minwidth);
+
+      part->firstsuffix = nextsuffix;
+      part->width = partend - nextsuffix;
+      part->maxpairs.nextfreeGtMaxpair = 0;
+      nextsuffix = partend;
+    }
+    threadinfo.nextpart = 0;
+    threadinfo.haserr = false;
+    if (gt_multithread(gt_enumeratemaxpairs_thread, &threadinfo, err) != 0)
+    {
+      haserr = true;
+      break;
+    }
+    if (threadinfo.haserr)
+    {
+      gt_error_set(err,"enumeration of maximal pairs failed");
+      haserr = true;
+      break;
+    }
+    for (partidx = 0; !haserr && partidx < threadinfo.numofparts; partidx++)
+    {
+      const GtArrayGtMaxpair *maxpairs = &threadinfo.parts[partidx].maxpairs;
+
+      for (pairidx = 0; pairidx < maxpairs->nextfreeGtMaxpair; pairidx++)
+      {
+        const GtMaxpair *maxpair = maxpairs->spaceGtMaxpair + pairidx;
+
+        if (processmaxpairs(processmaxpairsinfo,encseq,maxpair->len,
+                            maxpair->pos1,maxpair->pos2,err) != 0)
+        {
+          haserr = true;
+          break;
+        }
+      }
+    }
+  }
+  for (partidx = 0; partidx < maxnumofparts; partidx++)
+  {
+    GT_FREEARRAY(&threadinfo.parts[partidx].maxpairs,GtMaxpair);
+  }
+  gt_free(threadinfo.parts);
+  gt_mutex_delete(threadinfo.mutex);
+  return haserr ? -1 : 0;
+}
+
+int gt_enumeratemaxpairs(Sequentialsuffixarrayreader *ssar,
+                         const GtEncseq *encseq,
+                         GtReadmode readmode,
+                         unsigned int searchlength,
+                         Processmaxpairs processmaxpairs,
+                         void *processmaxpairsinfo,
+                         GtError *err)
+{
+  GtBUstate_maxpairs *state;
+  bool haserr = false;
+
+  if (gt_jobs > 1U &&
+      gt_accesstypeSequentialsuffixarrayreader(ssar) == SEQ_mappedboth)
+  {
+    return gt_enumeratemaxpairs_threaded(ssar,
+                                         encseq,
+                                         readmode,
+                                         searchlength,
+                                         processmaxpairs,
+                                         processmaxpairsinfo,
+                                         err);
+  }
+  state = gt_BUstate_maxpairs_new(encseq,
+                                  readmode,
+                                  searchlength,
+                                  processmaxpairs,
+                                  processmaxpairsinfo);
+  if (gt_esa_bottomup_maxpairs(ssar, state, err) != 0)
+  {
+    haserr = true;
+  }
+  gt_BUstate_maxpairs_delete(state);
   return haserr ? -1 : 0;
 }
@@ -51,6 +51,7 @@ Sequentialsuffixarrayreader *gt_newSequentialsuffixarrayreaderfromfile(
   ssar->nextlcptabindex = 1UL;
   ssar->largelcpindex = 0;
   ssar->seqactype = seqactype;
+  ssar->sharedsuffixarray = false;
   ssar->suftab = NULL;
   gt_assert(ssar->suffixarray != NULL);
   ssar->encseq = ssar->suffixarray->encseq;
@@ -74,6 +75,7 @@ Sequentialsuffixarrayreader *gt_newSequentialsuffixarrayreaderfromRAM(
   ssar->nextlcptabindex = 1UL; /* not required here */
   ssar->largelcpindex = 0; /* not required here */
   ssar->seqactype = SEQ_suftabfrommemory;
+  ssar->sharedsuffixarray = false;
   ssar->readmode = readmode;
   ssar->encseq = encseq;
   ssar->numberofsuffixes = gt_encseq_total_length(encseq) + 1;
@@ -100,8 +102,52 @@ void gt_updateSequentialsuffixarrayreaderfromRAM(
   }
 }
 
+Sequentialsuffixarrayreader *gt_newSequentialsuffixarrayreaderrange(
+                                  const Sequentialsuffixarrayreader *ssar,
+                                  GtUword firstsuffix,
+                                  GtUword width)
+{
+  Sequentialsuffixarrayreader *rangessar;
+  const Suffixarray *suffixarray = ssar->suffixarray;
+  GtUword left, right;
+
+  gt_assert(ssar->seqactype == SEQ_mappedboth &&
+            firstsuffix + width <= ssar->nonspecials);
+  rangessar = gt_malloc(sizeof *rangessar);
+  *rangessar = *ssar;
+  rangessar->sharedsuffixarray = true;
+  rangessar->nextsuftabindex = firstsuffix;
+  rangessar->nextlcptabindex = firstsuffix + 1;
+  rangessar->nonspecials = width;
+  /* binary search for the first large lcp value at or after the first
+     lcp value delivered */
+  left = 0;
+  right = suffixarray->numoflargelcpvalues.defined
+            ? suffixarray->numoflargelcpvalues.valueunsignedlong
+            : 0;
+  while (left < right)
+  {
+    GtUword mid = left + GT_DIV2(right - left);
+
+    if (suffixarray->llvtab[mid].position < firstsuffix + 1)
+    {
+      left = mid + 1;
+    } else
+    {
+      right = mid;
+    }
+  }
+  rangessar->largelcpindex = left;
+  return rangessar;
+}
+
 void gt_freeSequentialsuffixarrayreader(Sequentialsuffixarrayreader **ssar)
 {
+  if ((*ssar)->sharedsuffixarray)
+  {
+    gt_free(*ssar);
+    return;
+  }
   if ((*ssar)->suffixarray != NULL)
   {
     gt_freesuffixarray((*ssar)->suffixarray);
@@ -239,6 +285,12 @@ const ESASuffixptr *gt_suftabSequentialsuffixarrayreader(
   return ssar->suftab;
 }
 
+Sequentialaccesstype gt_accesstypeSequentialsuffixarrayreader(
+                          const Sequentialsuffixarrayreader *ssar)
+{
+  return ssar->seqactype;
+}
+
 const Suffixarray *gt_suffixarraySequentialsuffixarrayreader(
               const Sequentialsuffixarrayreader *ssar)
 {
@@ -42,6 +42,7 @@ struct Sequentialsuffixarrayreader
          nextlcptabindex, /* for SEQ_mappedboth */
          largelcpindex;   /* SEQ_mappedboth */
   Sequentialaccesstype seqactype;
+  bool sharedsuffixarray; /* suffixarray belongs to another reader */
   Lcpvalueiterator *lvi;
   const ESASuffixptr *suftab;
   const GtEncseq *encseq;
@@ -281,6 +282,19 @@ Sequentialsuffixarrayreader *gt_newSequentialsuffixarrayreaderfromfile(
 
 void gt_freeSequentialsuffixarrayreader(Sequentialsuffixarrayreader **ssar);
 
+/* Returns a reader delivering the <width> suffixes of the mapped suffix array
+   of <ssar> beginning with suffix number <firstsuffix> and the lcp values
+   following them. The suffix array is shared with <ssar>, which therefore
+   has to be freed after the returned reader. The readers can be used
+   concurrently. */
+Sequentialsuffixarrayreader *gt_newSequentialsuffixarrayreaderrange(
+                                  const Sequentialsuffixarrayreader *ssar,
+                                  GtUword firstsuffix,
+                                  GtUword width);
+
+Sequentialaccesstype gt_accesstypeSequentialsuffixarrayreader(
+                          const Sequentialsuffixarrayreader *ssar);
+
 const GtEncseq *gt_encseqSequentialsuffixarrayreader(
                           const Sequentialsuffixarrayreader *ssar);
 
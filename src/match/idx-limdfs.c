@@ -40,7 +40,8 @@ struct Genericindex
   Suffixarray *suffixarray;
   GtUword totallength;
   FMindex *packedindex;
-  bool withesa;
+  bool withesa,
+       sharedcopy; /* tables belong to another Genericindex */
   const Mbtab **mbtab;      /* only relevant for packedindex */
   unsigned int maxdepth;    /* maximaldepth of boundaries */
 };
@@ -51,6 +52,15 @@ void genericindex_delete(Genericindex *genericindex)
   {
     return;
   }
+  if (genericindex->sharedcopy)
+  {
+    if (genericindex->packedindex != NULL)
+    {
+      gt_deletesharedcopyvoidBWTSeq(genericindex->packedindex);
+    }
+    gt_free(genericindex);
+    return;
+  }
   gt_freesuffixarray(genericindex->suffixarray);
   gt_free(genericindex->suffixarray);
   if (genericindex->packedindex != NULL)
@@ -104,6 +114,7 @@ Genericindex *genericindex_new(const char *indexname,
     demand |= SARR_SSPTAB;
   }
   genericindex->withesa = withesa;
+  genericindex->sharedcopy = false;
   genericindex->suffixarray = gt_malloc(sizeof (*genericindex->suffixarray));
   if (gt_mapsuffixarray(genericindex->suffixarray,
                         demand,
@@ -166,6 +177,29 @@ Genericindex *genericindex_new(const char *indexname,
   return genericindex;
 }
 
+Genericindex *genericindex_new_sharedcopy(const Genericindex *genericindex)
+{
+  Genericindex *sharedcopy;
+
+  gt_assert(genericindex != NULL);
+  sharedcopy = gt_malloc(sizeof (*sharedcopy));
+  *sharedcopy = *genericindex;
+  sharedcopy->sharedcopy = true;
+  /* the suffix array tables are only read, but the packed index caches the
+     blocks of its last rank queries */
+  if (genericindex->packedindex != NULL)
+  {
+    sharedcopy->packedindex
+      = gt_sharedcopyvoidBWTSeq(genericindex->packedindex);
+    if (sharedcopy->packedindex == NULL)
+    {
+      gt_free(sharedcopy);
+      return NULL;
+    }
+  }
+  return sharedcopy;
+}
+
 typedef struct
 {
   GtUword offset,
@@ -47,6 +47,13 @@ Genericindex *genericindex_new(const char *indexname,
                                GtLogger *logger,
                                GtError *err);
 
+/* Returns a copy of <genericindex> sharing all mapped tables with it, which
+   can be searched concurrently to <genericindex> and its other copies. The
+   copy has to be deleted before <genericindex>. Returns NULL if
+   <genericindex> cannot be searched concurrently, as its packed index is not
+   memory mapped. */
+Genericindex *genericindex_new_sharedcopy(const Genericindex *genericindex);
+
 typedef struct Limdfsresources Limdfsresources;
 
 Limdfsresources *gt_newLimdfsresources(const Genericindex *genericindex,
@@ -149,6 +149,16 @@ GtRadixsortstringinfo *gt_radixsort_str_new(const GtTwobitencoding
   return rsi;
 }
 
+size_t gt_radixsort_str_size(GtUword maxwidth)
+{
+  return sizeof (GtRadixsortstringinfo) +
+         sizeof (GtUword) * GT_RADIXSORT_STR_NOFBUCKETS +
+         (sizeof (GtUword) + sizeof (gt_radixsort_str_bucketnum_t)) *
+         (size_t) (maxwidth/2) +
+         sizeof (uint8_t) * GT_POW2(GT_MULT2(GT_RADIXSORT_STR_KMERSIZE)) +
+         sizeof (GtRadixsortStrBucketInfo) * 1024;
+}
+
 void gt_radixsort_str_delete(GtRadixsortstringinfo *rsi)
 {
   if (rsi != NULL)
@@ -45,6 +45,10 @@ GtRadixsortstringinfo *gt_radixsort_str_new(const GtTwobitencoding
 
 void gt_radixsort_str_delete(GtRadixsortstringinfo *rsi);
 
+/* returns the number of bytes allocated by gt_radixsort_str_new() for the
+   given <maxwidth> */
+size_t gt_radixsort_str_size(GtUword maxwidth);
+
 void gt_radixsort_str_eqlen(GtRadixsortstringinfo *rsi,
                             GtUword *suffixes,
                             GtLcpvalues *lcpvalues,
@@ -25,6 +25,8 @@
 #include "core/unused_api.h"
 #include "core/types_api.h"
 #include "core/encseq.h"
+#include "core/ma_api.h"
+#include "core/thread_api.h"
 #include "bcktab.h"
 #include "kmer2string.h"
 #include "sfx-radixsort.h"
@@ -1497,6 +1499,24 @@ size_t gt_size_of_sort_workspace (const Sfxstrategy *sfxstrategy)
   return sumsize;
 }
 
+size_t gt_sortallbuckets_thread_workspace(const GtEncseq *encseq,
+                                          GtReadmode readmode,
+                                          GtUword maxbucketsize,
+                                          const Sfxstrategy *sfxstrategy)
+{
+  /* the table of the short read sort grows up to the size of the other
+     workspace, see gt_shortreadsort_maxwidth() */
+  size_t sumsize = GT_MULT2(gt_size_of_sort_workspace(sfxstrategy));
+
+  if (sfxstrategy->withradixsort &&
+      gt_encseq_accesstype_get(encseq) == GT_ACCESS_TYPE_EQUALLENGTH &&
+      readmode == GT_READMODE_FORWARD)
+  {
+    sumsize += gt_radixsort_str_size(maxbucketsize);
+  }
+  return sumsize;
+}
+
 static void bentsedgresources_delete(GtBentsedgresources *bsr, GtLogger *logger)
 {
   gt_free(bsr->countingsortinfo);
@@ -1520,47 +1540,22 @@ static void bentsedgresources_delete(GtBentsedgresources *bsr, GtLogger *logger)
   gt_free(bsr);
 }
 
-/*
-  The following function is called in sfx-suffixer.c and sorts all buckets by
-  different suffix comparison methods without the help of other sorting
-  information. GtSuffixsortspace contains the sortspace which is accessed
-  by some negative offset.
-*/
-
-void gt_sortallbuckets(GtSuffixsortspace *suffixsortspace,
-                       GtUword numberofsuffixes,
-                       GtBucketspec2 *bucketspec2,
-                       const GtEncseq *encseq,
-                       GtReadmode readmode,
-                       GtCodetype mincode,
-                       GtCodetype maxcode,
-                       const GtBcktab *bcktab,
-                       unsigned int numofchars,
-                       unsigned int prefixlength,
-                       GtOutlcpinfo *outlcpinfo,
-                       unsigned int sortmaxdepth,
-                       const Sfxstrategy *sfxstrategy,
-                       GtProcessunsortedsuffixrange processunsortedsuffixrange,
-                       void *processunsortedsuffixrangeinfo,
-                       GtUint64 *bucketiterstep,
-                       GtLogger *logger)
+static void gt_sortbucketrange(GtBentsedgresources *bsr,
+                               GtUword numberofsuffixes,
+                               const GtBucketspec2 *bucketspec2,
+                               GtCodetype fromcode,
+                               GtCodetype tocode,
+                               GtCodetype maxcode,
+                               const GtBcktab *bcktab,
+                               unsigned int numofchars,
+                               GtOutlcpinfo *outlcpinfo,
+                               GtUint64 *bucketiterstep)
 {
   GtCodetype code;
-  unsigned int rightchar = (unsigned int) (mincode % numofchars);
+  unsigned int rightchar = (unsigned int) (fromcode % numofchars);
   GtBucketspecification bucketspec;
-  GtBentsedgresources *bsr = bentsedgresources_new(suffixsortspace,
-                                                   encseq,
-                                                   readmode,
-                                                   prefixlength,
-                                                   bcktab,
-                                                   sortmaxdepth,
-                                                   sfxstrategy,
-                                                   outlcpinfo != NULL ? true
-                                                                      : false);
-  gt_bentsedgresources_addlcpinfo(bsr,outlcpinfo,bcktab);
-  bsr->processunsortedsuffixrangeinfo = processunsortedsuffixrangeinfo;
-  bsr->processunsortedsuffixrange = processunsortedsuffixrange;
-  for (code = mincode; code <= maxcode; code++)
+
+  for (code = fromcode; code <= tocode; code++)
   {
     if (bucketspec2 != NULL)
     {
@@ -1586,23 +1581,257 @@ void gt_sortallbuckets(GtSuffixsortspace *suffixsortspace,
       {
         gt_suffixsortspace_bucketleftidx_set(bsr->sssp,bucketspec.left);
         gt_sort_bentleysedgewick(bsr,bucketspec.nonspecialsinbucket,
-                                 (GtUword) prefixlength);
+                                 (GtUword) bsr->prefixlength);
         gt_suffixsortspace_bucketleftidx_set(bsr->sssp,0);
       }
       gt_Outlcpinfo_nonspecialsbucket(outlcpinfo,
-                                      prefixlength,
+                                      bsr->prefixlength,
                                       bsr->sssp,
                                       bsr->tableoflcpvalues,
                                       &bucketspec,
                                       code);
     }
     gt_Outlcpinfo_postbucket(outlcpinfo,
-                             prefixlength,
+                             bsr->prefixlength,
                              bsr->sssp,
                              bcktab,
                              &bucketspec,
                              code);
   }
+}
+
+#ifdef GT_THREADS_ENABLED
+
+/* Number of chunks of codes each thread fetches on average. Smaller chunks
+   balance the load better if the bucket sizes are skewed, which is typical
+   for repetitive genomes. */
+#define GT_BENTSEDG_CHUNKSPERTHREAD 64
+
+typedef struct
+{
+  GtUword numberofsuffixes;
+  const GtBucketspec2 *bucketspec2;
+  const GtBcktab *bcktab;
+  GtCodetype nextcode,
+             maxcode,
+             chunksize;
+  unsigned int numofchars;
+  GtMutex *mutex;
+} GtBentsedgSharedinfo;
+
+typedef struct
+{
+  GtBentsedgresources *bsr;
+  GtBentsedgSharedinfo *shared;
+  GtUint64 bucketiterstep;
+  GtThread *thread;
+} GtBentsedgThreadinfo;
+
+static void *gt_sortallbuckets_thread(void *data)
+{
+  GtBentsedgThreadinfo *threadinfo = (GtBentsedgThreadinfo *) data;
+  GtBentsedgSharedinfo *shared = threadinfo->shared;
+
+  while (true)
+  {
+    GtCodetype fromcode, tocode;
+
+    gt_mutex_lock(shared->mutex);
+    if (shared->nextcode > shared->maxcode)
+    {
+      gt_mutex_unlock(shared->mutex);
+      break;
+    }
+    fromcode = shared->nextcode;
+    if (shared->maxcode - fromcode >= shared->chunksize)
+    {
+      tocode = fromcode + shared->chunksize - 1;
+    } else
+    {
+      tocode = shared->maxcode;
+    }
+    shared->nextcode = tocode + 1;
+    gt_mutex_unlock(shared->mutex);
+    gt_sortbucketrange(threadinfo->bsr,
+                       shared->numberofsuffixes,
+                       shared->bucketspec2,
+                       fromcode,
+                       tocode,
+                       shared->maxcode,
+                       shared->bcktab,
+                       shared->numofchars,
+                       NULL,
+                       &threadinfo->bucketiterstep);
+  }
+  return NULL;
+}
+
+/* Sorts the buckets with codes in the range <mincode>..<maxcode> by
+   <threads> threads. Each thread owns its own resources (encseq readers,
+   stack, sorting workspace and a view on the shared <suffixsortspace>) and
+   repeatedly fetches a chunk of consecutive codes. As the buckets are
+   disjoint, the result does not depend on the assignment of buckets to
+   threads. */
+static void gt_sortallbuckets_threaded(GtSuffixsortspace *suffixsortspace,
+                                       GtUword numberofsuffixes,
+                                       const GtBucketspec2 *bucketspec2,
+                                       const GtEncseq *encseq,
+                                       GtReadmode readmode,
+                                       GtCodetype mincode,
+                                       GtCodetype maxcode,
+                                       const GtBcktab *bcktab,
+                                       unsigned int numofchars,
+                                       unsigned int prefixlength,
+                                       const Sfxstrategy *sfxstrategy,
+                                       GtUint64 *bucketiterstep,
+                                       unsigned int threads,
+                                       GtLogger *logger)
+{
+  unsigned int t;
+  GtBentsedgSharedinfo shared;
+  GtBentsedgThreadinfo *threadinfo;
+  GtError *err = gt_error_new();
+
+  gt_assert(threads >= 2U);
+  shared.numberofsuffixes = numberofsuffixes;
+  shared.bucketspec2 = bucketspec2;
+  shared.bcktab = bcktab;
+  shared.nextcode = mincode;
+  shared.maxcode = maxcode;
+  shared.chunksize = (maxcode - mincode + 1) /
+                     (GtCodetype) (threads * GT_BENTSEDG_CHUNKSPERTHREAD);
+  if (shared.chunksize == 0)
+  {
+    shared.chunksize = 1;
+  }
+  shared.numofchars = numofchars;
+  shared.mutex = gt_mutex_new();
+  gt_logger_log(logger,"sort buckets "GT_WU".."GT_WU" with %u threads in "
+                       "chunks of "GT_WU" codes",(GtUword) mincode,
+                       (GtUword) maxcode,threads,(GtUword) shared.chunksize);
+  threadinfo = gt_malloc(sizeof (*threadinfo) * threads);
+  for (t = 0; t < threads; t++)
+  {
+    threadinfo[t].bsr
+      = bentsedgresources_new(gt_suffixsortspace_view_new(suffixsortspace),
+                              encseq,
+                              readmode,
+                              prefixlength,
+                              bcktab,
+                              0,
+                              sfxstrategy,
+                              false);
+    threadinfo[t].shared = &shared;
+    threadinfo[t].bucketiterstep = 0;
+    threadinfo[t].thread = NULL;
+  }
+  /* start all other threads; if a thread cannot be started, the remaining
+     threads (at least the main thread) process its share of the buckets */
+  for (t = 1U; t < threads; t++)
+  {
+    threadinfo[t].thread = gt_thread_new(gt_sortallbuckets_thread,
+                                         threadinfo + t,err);
+    if (threadinfo[t].thread == NULL)
+    {
+      gt_logger_log(logger,"%s",gt_error_get(err));
+      gt_error_unset(err);
+      break;
+    }
+  }
+  (void) gt_sortallbuckets_thread(threadinfo);
+  for (t = 0; t < threads; t++)
+  {
+    GtSuffixsortspace *view = threadinfo[t].bsr->sssp;
+
+    if (threadinfo[t].thread != NULL)
+    {
+      gt_thread_join(threadinfo[t].thread);
+      gt_thread_delete(threadinfo[t].thread);
+    }
+    *bucketiterstep += threadinfo[t].bucketiterstep;
+    bentsedgresources_delete(threadinfo[t].bsr, logger);
+    gt_suffixsortspace_view_merge(suffixsortspace,view);
+    gt_suffixsortspace_delete(view,false);
+  }
+  gt_assert(shared.nextcode > maxcode);
+  gt_free(threadinfo);
+  gt_mutex_delete(shared.mutex);
+  gt_error_delete(err);
+}
+#endif
+
+/*
+  The following function is called in sfx-suffixer.c and sorts all buckets by
+  different suffix comparison methods without the help of other sorting
+  information. GtSuffixsortspace contains the sortspace which is accessed
+  by some negative offset. If more than one thread is requested and neither
+  lcp values nor a difference cover are involved, the buckets are sorted by
+  <numofthreads> threads.
+*/
+
+void gt_sortallbuckets(GtSuffixsortspace *suffixsortspace,
+                       GtUword numberofsuffixes,
+                       GtBucketspec2 *bucketspec2,
+                       const GtEncseq *encseq,
+                       GtReadmode readmode,
+                       GtCodetype mincode,
+                       GtCodetype maxcode,
+                       const GtBcktab *bcktab,
+                       unsigned int numofchars,
+                       unsigned int prefixlength,
+                       GtOutlcpinfo *outlcpinfo,
+                       unsigned int sortmaxdepth,
+                       const Sfxstrategy *sfxstrategy,
+                       GtProcessunsortedsuffixrange processunsortedsuffixrange,
+                       void *processunsortedsuffixrangeinfo,
+                       GtUint64 *bucketiterstep,
+                       GT_UNUSED unsigned int numofthreads,
+                       GtLogger *logger)
+{
+  GtBentsedgresources *bsr;
+
+#ifdef GT_THREADS_ENABLED
+  if (numofthreads > 1U && outlcpinfo == NULL && sortmaxdepth == 0 &&
+      processunsortedsuffixrange == NULL && mincode < maxcode)
+  {
+    gt_sortallbuckets_threaded(suffixsortspace,
+                               numberofsuffixes,
+                               bucketspec2,
+                               encseq,
+                               readmode,
+                               mincode,
+                               maxcode,
+                               bcktab,
+                               numofchars,
+                               prefixlength,
+                               sfxstrategy,
+                               bucketiterstep,
+                               numofthreads,
+                               logger);
+    return;
+  }
+#endif
+  bsr = bentsedgresources_new(suffixsortspace,
+                              encseq,
+                              readmode,
+                              prefixlength,
+                              bcktab,
+                              sortmaxdepth,
+                              sfxstrategy,
+                              outlcpinfo != NULL ? true : false);
+  gt_bentsedgresources_addlcpinfo(bsr,outlcpinfo,bcktab);
+  bsr->processunsortedsuffixrangeinfo = processunsortedsuffixrangeinfo;
+  bsr->processunsortedsuffixrange = processunsortedsuffixrange;
+  gt_sortbucketrange(bsr,
+                     numberofsuffixes,
+                     bucketspec2,
+                     mincode,
+                     maxcode,
+                     maxcode,
+                     bcktab,
+                     numofchars,
+                     outlcpinfo,
+                     bucketiterstep);
   bentsedgresources_delete(bsr, logger);
 }
 
@@ -52,8 +52,17 @@ void gt_sortallbuckets(GtSuffixsortspace *suffixsortspace,
                        GtProcessunsortedsuffixrange processunsortedsuffixrange,
                        void *processunsortedsuffixrangeinfo,
                        GtUint64 *bucketiterstep,
+                       unsigned int numofthreads,
                        GtLogger *logger);
 
+/* Returns the number of bytes of the sorting workspace each thread of
+   gt_sortallbuckets() allocates for buckets of at most <maxbucketsize>
+   suffixes. */
+size_t gt_sortallbuckets_thread_workspace(const GtEncseq *encseq,
+                                          GtReadmode readmode,
+                                          GtUword maxbucketsize,
+                                          const Sfxstrategy *sfxstrategy);
+
 void gt_sortallsuffixesfromstart(GtSuffixsortspace *suffixsortspace,
                                  GtUword numberofsuffixes,
                                  const GtEncseq *encseq,
@@ -1808,6 +1808,7 @@ static void dc_differencecover_sortsample(GtDifferencecover *dcov,
                         dc_addunsortedrange,
                         (void *) dcov,
                         &bucketiterstep,
+                        1U,
                         dcov->logger);
     }
     if (withcheck && dcov->effectivesamplesize > 0)
@@ -20,6 +20,7 @@
 #include "core/unused_api.h"
 #include "core/timer_api.h"
 #include "core/mathsupport.h"
+#include "core/thread_api.h"
 #include "sfx-linlcp.h"
 #include "sfx-sain.h"
 
@@ -431,10 +432,772 @@ static void gt_sain_induceStypes2fromspecialranges(
 
 #include "match/sfx-sain.inc"
 
+#ifdef GT_THREADS_ENABLED
+
+/*
+  The following functions implement a parallel variant of the induction
+  passes and of the classification of the Sstar suffixes. In an induction
+  pass most of the time is spent in random accesses to the sequence
+  delivering the character preceding the suffix at the current position of
+  the suffix array and the character left of it. The suffix array is
+  therefore scanned in blocks. While the main thread processes a block
+  sequentially as in the single threaded induction passes, <gt_jobs>-1
+  worker threads determine these characters for all entries of the next
+  block. An entry which was modified since its characters were determined
+  (because it was induced while the block was prefetched or processed) is
+  detected by comparing its value with the value seen by the prefetching
+  thread, and its characters are looked up again. Hence the result is
+  identical to the sequential passes. Only the character lookups run in
+  parallel, the scan itself, i.e., the induction of the suffixes into their
+  buckets, remains sequential, as each step depends on the entries written
+  by the steps before. The worker threads are started once per pass and
+  wait for the next block between the blocks.
+*/
+
+#define GT_SAIN_PREFETCHWIDTH      (1UL << 16)
+#define GT_SAIN_MINTHREADEDLENGTH  GT_MULT2(GT_SAIN_PREFETCHWIDTH)
+
+typedef struct
+{
+  GtWord value;
+  GtUword cc;
+  int cmp;
+} GtSainPrefetch;
+
+static bool gt_sain_usethreads(GtUword len)
+{
+  return gt_jobs > 1U && len >= GT_SAIN_MINTHREADEDLENGTH ? true : false;
+}
+
+/* A fixed set of worker threads which repeatedly run a function on one job
+   each. The worker with index <i> processes the job at
+   <jobs>+<i>*<jobsize>. */
+typedef struct GtSainWorkers GtSainWorkers;
+
+typedef struct
+{
+  GtSainWorkers *workers;
+  unsigned int idx;
+} GtSainWorkerinfo;
+
+struct GtSainWorkers
+{
+  GtMutex *mutex;
+  GtCond *startcond, *donecond;
+  GtThread **threads;
+  GtSainWorkerinfo *workerinfo;
+  unsigned int numofworkers, running;
+  GtUword round;
+  bool quit;
+  GtThreadFunc func;
+  void *jobs;
+  size_t jobsize;
+};
+
+static void *gt_sain_worker_thread(void *data)
+{
+  GtSainWorkerinfo *workerinfo = (GtSainWorkerinfo *) data;
+  GtSainWorkers *workers = workerinfo->workers;
+  GtUword round = 0;
+
+  while (true)
+  {
+    GtThreadFunc func;
+    void *job;
+
+    gt_mutex_lock(workers->mutex);
+    while (!workers->quit && workers->round == round)
+    {
+      gt_cond_wait(workers->startcond,workers->mutex);
+    }
+    if (workers->quit)
+    {
+      gt_mutex_unlock(workers->mutex);
+      break;
+    }
+    round = workers->round;
+    func = workers->func;
+    job = (char *) workers->jobs + workerinfo->idx * workers->jobsize;
+    gt_mutex_unlock(workers->mutex);
+    (void) func(job);
+    gt_mutex_lock(workers->mutex);
+    if (--workers->running == 0)
+    {
+      gt_cond_signal(workers->donecond);
+    }
+    gt_mutex_unlock(workers->mutex);
+  }
+  return NULL;
+}
+
+/* Start up to <numofworkers> threads. If a thread cannot be started, the
+   workers consist of the threads started before. */
+static GtSainWorkers *gt_sain_workers_new(unsigned int numofworkers)
+{
+  unsigned int t;
+  GtSainWorkers *workers = gt_malloc(sizeof (*workers));
+
+  workers->mutex = gt_mutex_new();
+  workers->startcond = gt_cond_new();
+  workers->donecond = gt_cond_new();
+  workers->threads = gt_malloc(sizeof (*workers->threads) * numofworkers);
+  workers->workerinfo = gt_malloc(sizeof (*workers->workerinfo) *
+                                  numofworkers);
+  workers->running = 0;
+  workers->round = 0;
+  workers->quit = false;
+  workers->func = NULL;
+  workers->jobs = NULL;
+  workers->jobsize = 0;
+  for (t = 0; t < numofworkers; t++)
+  {
+    workers->workerinfo[t].workers = workers;
+    workers->workerinfo[t].idx = t;
+    workers->threads[t] = gt_thread_new(gt_sain_worker_thread,
+                                        workers->workerinfo + t,NULL);
+    if (workers->threads[t] == NULL)
+    {
+      break;
+    }
+  }
+  workers->numofworkers = t;
+  return workers;
+}
+
+/* Let all workers run <func> on their job without waiting for them. */
+static void gt_sain_workers_start(GtSainWorkers *workers,
+                                  GtThreadFunc func,
+                                  void *jobs,
+                                  size_t jobsize)
+{
+  gt_mutex_lock(workers->mutex);
+  gt_assert(workers->running == 0);
+  workers->func = func;
+  workers->jobs = jobs;
+  workers->jobsize = jobsize;
+  workers->running = workers->numofworkers;
+  workers->round++;
+  gt_cond_broadcast(workers->startcond);
+  gt_mutex_unlock(workers->mutex);
+}
+
+/* Wait until all workers have finished their jobs. */
+static void gt_sain_workers_wait(GtSainWorkers *workers)
+{
+  gt_mutex_lock(workers->mutex);
+  while (workers->running > 0)
+  {
+    gt_cond_wait(workers->donecond,workers->mutex);
+  }
+  gt_mutex_unlock(workers->mutex);
+}
+
+static void gt_sain_workers_delete(GtSainWorkers *workers)
+{
+  unsigned int t;
+
+  if (workers == NULL)
+  {
+    return;
+  }
+  gt_sain_workers_wait(workers);
+  gt_mutex_lock(workers->mutex);
+  workers->quit = true;
+  gt_cond_broadcast(workers->startcond);
+  gt_mutex_unlock(workers->mutex);
+  for (t = 0; t < workers->numofworkers; t++)
+  {
+    gt_thread_join(workers->threads[t]);
+    gt_thread_delete(workers->threads[t]);
+  }
+  gt_cond_delete(workers->startcond);
+  gt_cond_delete(workers->donecond);
+  gt_mutex_delete(workers->mutex);
+  gt_free(workers->threads);
+  gt_free(workers->workerinfo);
+  gt_free(workers);
+}
+
+typedef struct
+{
+  const GtSainseq *sainseq;
+  const GtWord *suftab;
+  GtSainPrefetch *prefetch;
+  GtUword start, end;
+  bool decrement;
+} GtSainPrefetchthreadinfo;
+
+/* <prefetch> holds the characters of the block processed by the main thread,
+   <nextprefetch> those of the block <nextstart>..<nextend>-1 determined by
+   the workers, if <pending> is set. */
+typedef struct
+{
+  GtUword blockwidth, nextstart, nextend;
+  GtSainPrefetch *space, *prefetch, *nextprefetch;
+  GtSainPrefetchthreadinfo *threadinfo;
+  GtSainWorkers *workers;
+  bool pending;
+} GtSainPrefetcher;
+
+static GtSainPrefetcher *gt_sain_prefetcher_new(const GtSainseq *sainseq,
+                                                const GtWord *suftab,
+                                                bool decrement)
+{
+  unsigned int t, parts;
+  GtSainPrefetcher *prefetcher = gt_malloc(sizeof (*prefetcher));
+
+  prefetcher->workers = gt_sain_workers_new(gt_jobs - 1);
+  parts = MAX(prefetcher->workers->numofworkers,1U);
+  prefetcher->blockwidth = GT_SAIN_PREFETCHWIDTH * parts;
+  prefetcher->space = gt_malloc(sizeof (*prefetcher->space) *
+                                GT_MULT2(prefetcher->blockwidth));
+  prefetcher->prefetch = prefetcher->space;
+  prefetcher->nextprefetch = prefetcher->prefetch + prefetcher->blockwidth;
+  prefetcher->threadinfo = gt_malloc(sizeof (*prefetcher->threadinfo) *
+                                     parts);
+  for (t = 0; t < parts; t++)
+  {
+    prefetcher->threadinfo[t].sainseq = sainseq;
+    prefetcher->threadinfo[t].suftab = suftab;
+    prefetcher->threadinfo[t].decrement = decrement;
+  }
+  prefetcher->nextstart = prefetcher->nextend = 0;
+  prefetcher->pending = false;
+  return prefetcher;
+}
+
+static void gt_sain_prefetcher_delete(GtSainPrefetcher *prefetcher)
+{
+  if (prefetcher != NULL)
+  {
+    gt_sain_workers_delete(prefetcher->workers);
+    gt_free(prefetcher->space);
+    gt_free(prefetcher->threadinfo);
+    gt_free(prefetcher);
+  }
+}
+
+/* Determine the character at the position encoded by <value> and compare it
+   to the character left of it. In the first induction passes a value
+   exceeding the total length carries a round mark, in the second passes the
+   position is one less than the value. */
+static void gt_sain_prefetch_entry(const GtSainseq *sainseq,
+                                   GtSainPrefetch *pf,
+                                   GtWord value,
+                                   bool decrement)
+{
+  pf->value = value;
+  if (value > 0)
+  {
+    GtUword position = (GtUword) value;
+
+    if (decrement)
+    {
+      position--;
+    } else
+    {
+      if (position >= sainseq->totallength)
+      {
+        position -= sainseq->totallength;
+      }
+    }
+    pf->cc = gt_sainseq_getchar(sainseq,position);
+    if (position > 0 && pf->cc < sainseq->numofchars)
+    {
+      GtUword leftcontextcc = gt_sainseq_getchar(sainseq,position-1);
+
+      pf->cmp = leftcontextcc < pf->cc ? -1 : (leftcontextcc > pf->cc ? 1 : 0);
+    } else
+    {
+      pf->cmp = 0;
+    }
+  }
+}
+
+static void *gt_sain_prefetch_thread(void *data)
+{
+  GtSainPrefetchthreadinfo *threadinfo = (GtSainPrefetchthreadinfo *) data;
+  GtUword idx;
+
+  for (idx = threadinfo->start; idx < threadinfo->end; idx++)
+  {
+    gt_sain_prefetch_entry(threadinfo->sainseq,
+                           threadinfo->prefetch + idx - threadinfo->start,
+                           threadinfo->suftab[idx],
+                           threadinfo->decrement);
+  }
+  return NULL;
+}
+
+/* Let the workers prefetch the characters for the entries of the suffix
+   array in the range <start>..<end>-1 into <nextprefetch>. Without workers,
+   the main thread does this immediately. */
+static void gt_sain_prefetcher_start(GtSainPrefetcher *prefetcher,
+                                     GtUword start,
+                                     GtUword end)
+{
+  unsigned int t, parts = MAX(prefetcher->workers->numofworkers,1U);
+  GtUword partstart = start,
+          partwidth = (end - start) / parts;
+
+  gt_assert(!prefetcher->pending && end - start <= prefetcher->blockwidth);
+  for (t = 0; t < parts; t++)
+  {
+    GtSainPrefetchthreadinfo *threadinfo = prefetcher->threadinfo + t;
+
+    threadinfo->start = partstart;
+    threadinfo->end = t < parts - 1 ? partstart + partwidth : end;
+    threadinfo->prefetch = prefetcher->nextprefetch + (partstart - start);
+    partstart = threadinfo->end;
+  }
+  prefetcher->nextstart = start;
+  prefetcher->nextend = end;
+  prefetcher->pending = true;
+  if (prefetcher->workers->numofworkers > 0)
+  {
+    gt_sain_workers_start(prefetcher->workers,gt_sain_prefetch_thread,
+                          prefetcher->threadinfo,
+                          sizeof (*prefetcher->threadinfo));
+  } else
+  {
+    (void) gt_sain_prefetch_thread(prefetcher->threadinfo);
+  }
+}
+
+/* Make the characters for the block <blockstart>..<blockend>-1 available in
+   <prefetch> and start prefetching the block <nextstart>..<nextend>-1, which
+   is processed next (if it is not empty). */
+static void gt_sain_prefetcher_next(GtSainPrefetcher *prefetcher,
+                                    GtUword blockstart,
+                                    GtUword blockend,
+                                    GtUword nextstart,
+                                    GtUword nextend)
+{
+  GtSainPrefetch *tmp;
+
+  if (!prefetcher->pending)
+  {
+    gt_sain_prefetcher_start(prefetcher,blockstart,blockend);
+  }
+  gt_assert(prefetcher->nextstart == blockstart &&
+            prefetcher->nextend == blockend);
+  gt_sain_workers_wait(prefetcher->workers);
+  prefetcher->pending = false;
+  tmp = prefetcher->prefetch;
+  prefetcher->prefetch = prefetcher->nextprefetch;
+  prefetcher->nextprefetch = tmp;
+  if (nextstart < nextend)
+  {
+    gt_sain_prefetcher_start(prefetcher,nextstart,nextend);
+  }
+}
+
+/* Deliver the character and the comparison result for the entry at index
+   <IDX> of the suffix array which has the value <VALUE>. */
+#define GT_SAIN_PREFETCHED(IDX,VALUE,DECREMENT)\
+        pf = prefetcher->prefetch + ((IDX) - blockstart);\
+        if (pf->value != (VALUE))\
+        {\
+          pf = &localpf;\
+          gt_sain_prefetch_entry(sainseq,pf,VALUE,DECREMENT);\
+        }
+
+static void gt_sain_threaded_fast_induceLtypesuffixes1(GtSainseq *sainseq,
+                                                       GtWord *suftab,
+                                                       GtUword
+                                                         nonspecialentries)
+{
+  GtUword lastupdatecc = 0, *fillptr = sainseq->bucketfillptr,
+          blockstart, idx;
+  GtWord *bucketptr = NULL;
+  GtSainPrefetch *pf, localpf;
+  GtSainPrefetcher *prefetcher = gt_sain_prefetcher_new(sainseq,suftab,false);
+
+  gt_assert(sainseq->roundtable != NULL);
+  sainseq->currentround = 0;
+  for (blockstart = 0; blockstart < nonspecialentries;
+       blockstart += prefetcher->blockwidth)
+  {
+    const GtUword blockend = MIN(blockstart + prefetcher->blockwidth,
+                                 nonspecialentries);
+
+    gt_sain_prefetcher_next(prefetcher,blockstart,blockend,blockend,
+                            MIN(blockend + prefetcher->blockwidth,
+                                nonspecialentries));
+    for (idx = blockstart; idx < blockend; idx++)
+    {
+      GtWord *suftabptr = suftab + idx, position;
+
+      if ((position = *suftabptr) > 0)
+      {
+        GT_SAIN_PREFETCHED(idx,position,false);
+        if (position >= (GtWord) sainseq->totallength)
+        {
+          sainseq->currentround++;
+          position -= (GtWord) sainseq->totallength;
+        }
+        if (pf->cc < sainseq->numofchars)
+        {
+          if (position > 0)
+          {
+            GtUword t;
+
+            position--;
+            t = (pf->cc << 1) | (pf->cmp < 0 ? 1UL : 0);
+            gt_assert(pf->cc > 0 &&
+                      sainseq->roundtable[t] <= sainseq->currentround);
+            if (sainseq->roundtable[t] < sainseq->currentround)
+            {
+              position += (GtWord) sainseq->totallength;
+              sainseq->roundtable[t] = sainseq->currentround;
+            }
+            GT_SAINUPDATEBUCKETPTR(pf->cc);
+            gt_assert(suftabptr < bucketptr);
+            *bucketptr++ = (t & 1UL) ? ~position : position;
+            *suftabptr = 0;
+          }
+        } else
+        {
+          *suftabptr = 0;
+        }
+      } else
+      {
+        if (position < 0)
+        {
+          *suftabptr = ~position;
+        }
+      }
+    }
+  }
+  gt_sain_prefetcher_delete(prefetcher);
+}
+
+static void gt_sain_threaded_fast_induceStypesuffixes1(GtSainseq *sainseq,
+                                                       GtWord *suftab,
+                                                       GtUword
+                                                         nonspecialentries)
+{
+  GtUword lastupdatecc = 0, *fillptr = sainseq->bucketfillptr,
+          blockstart, blockend, idx;
+  GtWord *bucketptr = NULL;
+  GtSainPrefetch *pf, localpf;
+  GtSainPrefetcher *prefetcher;
+
+  gt_assert(sainseq->roundtable != NULL);
+  gt_sain_special_singleSinduction1(sainseq,
+                                    suftab,
+                                    (GtWord) (sainseq->totallength-1));
+  if (sainseq->seqtype == GT_SAIN_ENCSEQ)
+  {
+    gt_sain_induceStypes1fromspecialranges(sainseq,
+                                           sainseq->seq.encseq,
+                                           suftab);
+  }
+  prefetcher = gt_sain_prefetcher_new(sainseq,suftab,false);
+  for (blockend = nonspecialentries; blockend > 0; blockend = blockstart)
+  {
+    blockstart = blockend > prefetcher->blockwidth
+                   ? blockend - prefetcher->blockwidth : 0;
+    gt_sain_prefetcher_next(prefetcher,blockstart,blockend,
+                            blockstart > prefetcher->blockwidth
+                              ? blockstart - prefetcher->blockwidth : 0,
+                            blockstart);
+    for (idx = blockend; idx > blockstart; idx--)
+    {
+      GtWord *suftabptr = suftab + idx - 1, position;
+
+      if ((position = *suftabptr) > 0)
+      {
+        GT_SAIN_PREFETCHED(idx - 1,position,false);
+        if (position >= (GtWord) sainseq->totallength)
+        {
+          sainseq->currentround++;
+          position -= (GtWord) sainseq->totallength;
+        }
+        if (position > 0 && pf->cc < sainseq->numofchars)
+        {
+          GtUword t;
+
+          position--;
+          t = (pf->cc << 1) | (pf->cmp > 0 ? 1UL : 0);
+          gt_assert(sainseq->roundtable[t] <= sainseq->currentround);
+          if (sainseq->roundtable[t] < sainseq->currentround)
+          {
+            position += sainseq->totallength;
+            sainseq->roundtable[t] = sainseq->currentround;
+          }
+          GT_SAINUPDATEBUCKETPTR(pf->cc);
+          gt_assert(bucketptr != NULL && bucketptr - 1 < suftabptr);
+          *(--bucketptr) = (t & 1UL) ? ~(position+1) : position;
+        }
+        *suftabptr = 0;
+      }
+    }
+  }
+  gt_sain_prefetcher_delete(prefetcher);
+}
+
+static void gt_sain_threaded_induceLtypesuffixes2(const GtSainseq *sainseq,
+                                                  GtWord *suftab,
+                                                  GtUword nonspecialentries)
+{
+  GtUword lastupdatecc = 0, *fillptr = sainseq->bucketfillptr,
+          blockstart, idx;
+  GtWord *bucketptr = NULL;
+  GtSainPrefetch *pf, localpf;
+  GtSainPrefetcher *prefetcher = gt_sain_prefetcher_new(sainseq,suftab,true);
+
+  for (blockstart = 0; blockstart < nonspecialentries;
+       blockstart += prefetcher->blockwidth)
+  {
+    const GtUword blockend = MIN(blockstart + prefetcher->blockwidth,
+                                 nonspecialentries);
+
+    gt_sain_prefetcher_next(prefetcher,blockstart,blockend,blockend,
+                            MIN(blockend + prefetcher->blockwidth,
+                                nonspecialentries));
+    for (idx = blockstart; idx < blockend; idx++)
+    {
+      GtWord *suftabptr = suftab + idx, position = *suftabptr;
+
+      *suftabptr = ~position;
+      if (position > 0)
+      {
+        GT_SAIN_PREFETCHED(idx,position,true);
+        position--;
+        if (pf->cc < sainseq->numofchars)
+        {
+          gt_assert(pf->cc > 0);
+          GT_SAINUPDATEBUCKETPTR(pf->cc);
+          gt_assert(bucketptr != NULL && suftabptr < bucketptr);
+          *bucketptr++ = (position > 0 && pf->cmp < 0) ? ~position : position;
+        }
+      }
+    }
+  }
+  gt_sain_prefetcher_delete(prefetcher);
+}
+
+static void gt_sain_threaded_induceStypesuffixes2(const GtSainseq *sainseq,
+                                                  GtWord *suftab,
+                                                  GtUword nonspecialentries)
+{
+  GtUword lastupdatecc = 0, *fillptr = sainseq->bucketfillptr,
+          blockstart, blockend, idx;
+  GtWord *bucketptr = NULL;
+  GtSainPrefetch *pf, localpf;
+  GtSainPrefetcher *prefetcher;
+
+  gt_sain_special_singleSinduction2(sainseq,
+                                    suftab,
+                                    (GtWord) sainseq->totallength,
+                                    nonspecialentries);
+  if (sainseq->seqtype == GT_SAIN_ENCSEQ)
+  {
+    gt_sain_induceStypes2fromspecialranges(sainseq,
+                                           sainseq->seq.encseq,
+                                           suftab,
+                                           nonspecialentries);
+  }
+  prefetcher = gt_sain_prefetcher_new(sainseq,suftab,true);
+  for (blockend = nonspecialentries; blockend > 0; blockend = blockstart)
+  {
+    blockstart = blockend > prefetcher->blockwidth
+                   ? blockend - prefetcher->blockwidth : 0;
+    gt_sain_prefetcher_next(prefetcher,blockstart,blockend,
+                            blockstart > prefetcher->blockwidth
+                              ? blockstart - prefetcher->blockwidth : 0,
+                            blockstart);
+    for (idx = blockend; idx > blockstart; idx--)
+    {
+      GtWord *suftabptr = suftab + idx - 1, position;
+
+      if ((position = *suftabptr) > 0)
+      {
+        GT_SAIN_PREFETCHED(idx - 1,position,true);
+        position--;
+        if (pf->cc < sainseq->numofchars)
+        {
+          GT_SAINUPDATEBUCKETPTR(pf->cc);
+          gt_assert(bucketptr != NULL && bucketptr - 1 < suftabptr);
+          *(--bucketptr) = (position == 0 || pf->cmp > 0) ? ~position
+                                                          : position;
+        }
+      } else
+      {
+        *suftabptr = ~position;
+      }
+    }
+  }
+  gt_sain_prefetcher_delete(prefetcher);
+}
+
+/* Determine whether the suffix starting at <position> is of S-type by
+   looking for the first character right of it which differs. */
+static bool gt_sain_isStype(const GtSainseq *sainseq,GtUword position)
+{
+  GtUword cc = gt_sainseq_getchar(sainseq,position), nextpos;
+
+  for (nextpos = position + 1; nextpos < sainseq->totallength; nextpos++)
+  {
+    GtUword nextcc = gt_sainseq_getchar(sainseq,nextpos);
+
+    if (nextcc != cc)
+    {
+      return cc < nextcc ? true : false;
+    }
+  }
+  return true;
+}
+
+typedef struct
+{
+  const GtSainseq *sainseq;
+  GtUword *suftab,
+          *fillptr, /* numofchars entries, only used for insertion */
+          *count, /* numofchars entries */
+          countSstartype,
+          start,
+          end;
+  bool insert;
+} GtSainSstarthreadinfo;
+
+/* Scan the positions from <end>-1 down to <start> as in
+   <gt_sain_*_insertSstarsuffixes>. In the first phase only the Sstar
+   suffixes are counted for each first character, in the second phase they
+   are inserted into the buckets. */
+static void *gt_sain_Sstar_thread(void *data)
+{
+  GtSainSstarthreadinfo *threadinfo = (GtSainSstarthreadinfo *) data;
+  const GtSainseq *sainseq = threadinfo->sainseq;
+  GtUword position, nextcc;
+  bool nextisStype;
+
+  if (threadinfo->end == sainseq->totallength)
+  {
+    nextcc = GT_UNIQUEINT(sainseq->totallength);
+    nextisStype = true;
+  } else
+  {
+    nextcc = gt_sainseq_getchar(sainseq,threadinfo->end);
+    nextisStype = gt_sain_isStype(sainseq,threadinfo->end);
+  }
+  for (position = threadinfo->end; position > threadinfo->start; /**/)
+  {
+    GtUword currentcc = gt_sainseq_getchar(sainseq,--position);
+    bool currentisStype = (currentcc < nextcc ||
+                           (currentcc == nextcc && nextisStype)) ? true : false;
+    if (!currentisStype && nextisStype)
+    {
+      gt_assert(nextcc < sainseq->numofchars);
+      if (threadinfo->insert)
+      {
+        threadinfo->suftab[--threadinfo->fillptr[nextcc]] = position;
+      } else
+      {
+        threadinfo->count[nextcc]++;
+        threadinfo->countSstartype++;
+      }
+    }
+    nextisStype = currentisStype;
+    nextcc = currentcc;
+  }
+  return NULL;
+}
+
+/* The main thread scans the first part, the workers scan the following
+   parts. If not all workers could be started, the main thread also scans the
+   remaining parts. */
+static void gt_sain_Sstar_run(GtSainSstarthreadinfo *threadinfo,
+                              unsigned int threads,
+                              GtSainWorkers *workers)
+{
+  unsigned int t;
+
+  gt_assert(workers->numofworkers < threads);
+  gt_sain_workers_start(workers,gt_sain_Sstar_thread,threadinfo + 1,
+                        sizeof (*threadinfo));
+  (void) gt_sain_Sstar_thread(threadinfo);
+  for (t = workers->numofworkers + 1; t < threads; t++)
+  {
+    (void) gt_sain_Sstar_thread(threadinfo + t);
+  }
+  gt_sain_workers_wait(workers);
+}
+
+/* The sequence is split into <gt_jobs> parts, each scanned by its own
+   thread. As the Sstar suffixes are inserted from right to left, the part
+   of each bucket filled by a thread is located left of the parts filled by
+   the threads responsible for the sequence parts right of it. Thus the
+   Sstar suffixes end up in the same order as in the sequential scan. */
+static GtUword gt_sain_threaded_insertSstarsuffixes(GtSainseq *sainseq,
+                                                    GtUword *suftab)
+{
+  const unsigned int threads = gt_jobs;
+  unsigned int t;
+  GtUword charidx, countSstartype = 0, *counttab,
+          partwidth = sainseq->totallength/threads;
+  GtSainSstarthreadinfo *threadinfo = gt_malloc(sizeof (*threadinfo) *
+                                                threads);
+  GtSainWorkers *workers = gt_sain_workers_new(threads - 1);
+
+  counttab = gt_calloc((size_t) GT_MULT2(threads * sainseq->numofchars),
+                       sizeof (*counttab));
+  for (t = 0; t < threads; t++)
+  {
+    threadinfo[t].sainseq = sainseq;
+    threadinfo[t].suftab = suftab;
+    threadinfo[t].count = counttab + t * sainseq->numofchars;
+    threadinfo[t].fillptr = counttab + (threads + t) * sainseq->numofchars;
+    threadinfo[t].countSstartype = 0;
+    threadinfo[t].start = t * partwidth;
+    threadinfo[t].end = t < threads - 1 ? (t + 1) * partwidth
+                                        : sainseq->totallength;
+    threadinfo[t].insert = false;
+  }
+  gt_sain_Sstar_run(threadinfo,threads,workers);
+  gt_sain_endbuckets(sainseq);
+  for (charidx = 0; charidx < sainseq->numofchars; charidx++)
+  {
+    GtUword fill = sainseq->bucketfillptr[charidx];
+
+    for (t = threads; t > 0; t--)
+    {
+      threadinfo[t-1].fillptr[charidx] = fill;
+      fill -= threadinfo[t-1].count[charidx];
+    }
+    if (sainseq->sstarfirstcharcount != NULL)
+    {
+      sainseq->sstarfirstcharcount[charidx]
+        += sainseq->bucketfillptr[charidx] - fill;
+    }
+    sainseq->bucketfillptr[charidx] = fill;
+  }
+  for (t = 0; t < threads; t++)
+  {
+    countSstartype += threadinfo[t].countSstartype;
+    threadinfo[t].insert = true;
+  }
+  gt_sain_Sstar_run(threadinfo,threads,workers);
+  gt_sain_workers_delete(workers);
+  gt_free(counttab);
+  gt_free(threadinfo);
+  gt_assert(GT_MULT2(countSstartype) <= sainseq->totallength);
+  return countSstartype;
+}
+#endif
+
 static GtUword gt_sain_insertSstarsuffixes(GtSainseq *sainseq,
                                                  GtUword *suftab,
                                                  GtLogger *logger)
 {
+#ifdef GT_THREADS_ENABLED
+  if (gt_sain_usethreads(sainseq->totallength) &&
+      sainseq->numofchars <= UCHAR_MAX+1)
+  {
+    return gt_sain_threaded_insertSstarsuffixes(sainseq,suftab);
+  }
+#endif
   switch (sainseq->seqtype)
   {
     case GT_SAIN_PLAINSEQ:
@@ -474,6 +1237,14 @@ static void gt_sain_induceLtypesuffixes1(GtSainseq *sainseq,
                                          GtWord *suftab,
                                          GtUword nonspecialentries)
 {
+#ifdef GT_THREADS_ENABLED
+  if (sainseq->roundtable != NULL && gt_sain_usethreads(nonspecialentries))
+  {
+    gt_sain_threaded_fast_induceLtypesuffixes1(sainseq,suftab,
+                                               nonspecialentries);
+    return;
+  }
+#endif
   switch (sainseq->seqtype)
   {
     case GT_SAIN_PLAINSEQ:
@@ -593,6 +1364,14 @@ static void gt_sain_induceStypesuffixes1(GtSainseq *sainseq,
                                          GtWord *suftab,
                                          GtUword nonspecialentries)
 {
+#ifdef GT_THREADS_ENABLED
+  if (sainseq->roundtable != NULL && gt_sain_usethreads(nonspecialentries))
+  {
+    gt_sain_threaded_fast_induceStypesuffixes1(sainseq,suftab,
+                                               nonspecialentries);
+    return;
+  }
+#endif
   switch (sainseq->seqtype)
   {
     case GT_SAIN_PLAINSEQ:
@@ -752,6 +1531,13 @@ static void gt_sain_induceLtypesuffixes2(const GtSainseq *sainseq,
                                          GtWord *suftab,
                                          GtUword nonspecialentries)
 {
+#ifdef GT_THREADS_ENABLED
+  if (gt_sain_usethreads(nonspecialentries))
+  {
+    gt_sain_threaded_induceLtypesuffixes2(sainseq,suftab,nonspecialentries);
+    return;
+  }
+#endif
   switch (sainseq->seqtype)
   {
     case GT_SAIN_PLAINSEQ:
@@ -830,6 +1616,13 @@ static void gt_sain_induceStypesuffixes2(const GtSainseq *sainseq,
                                          GtWord *suftab,
                                          GtUword nonspecialentries)
 {
+#ifdef GT_THREADS_ENABLED
+  if (gt_sain_usethreads(nonspecialentries))
+  {
+    gt_sain_threaded_induceStypesuffixes2(sainseq,suftab,nonspecialentries);
+    return;
+  }
+#endif
   switch (sainseq->seqtype)
   {
     case GT_SAIN_PLAINSEQ:
@@ -41,6 +41,7 @@
 #include "core/divmodmul.h"
 #include "core/format64.h"
 #include "core/fileutils.h"
+#include "core/thread_api.h"
 #include "intcode-def.h"
 #include "firstcodes-buf.h"
 #include "esa-fileend.h"
@@ -81,6 +82,7 @@ struct Sfxiterator
   GtBcktab *bcktab;
   GtLeftborder *leftborder; /* points to bcktab->leftborder */
   GtDifferencecover *dcov;
+  unsigned int sortthreads; /* number of threads sorting the buckets */
 
   /* changed in each part */
   GtSuffixsortspace *suffixsortspace;
@@ -1323,6 +1325,7 @@ Sfxiterator *gt_Sfxiterator_new_withadditionalvalues(
     sfi->spmopt_kmerscancodesuffixmask = 0;
     sfi->spmopt_additionalprefixchars = 3U;
     sfi->dcov = NULL;
+    sfi->sortthreads = gt_jobs;
     sfi->withprogressbar = withprogressbar;
     if (sfxstrategy != NULL)
     {
@@ -1674,6 +1677,43 @@ Sfxiterator *gt_Sfxiterator_new_withadditionalvalues(
                                            numofsuffixestosort,
                                            sfi->sfxstrategy.suftabuint,
                                            err);
+      /* the threads sorting the buckets (only used without lcp values and
+         difference cover, see gt_sortallbuckets()) each have their own
+         workspace. As for the sequential sort, the workspace of the first
+         thread is not included. More parts would slow down the sorting more
+         than additional threads speed it up, so only as many threads are
+         used as fit into the memory limit with the same number of parts. */
+      if (retval > 0 && sfi->sortthreads > 1U && sfi->outlcpinfo == NULL &&
+          sfi->dcov == NULL && sfi->sfxstrategy.userdefinedsortmaxdepth == 0)
+      {
+        size_t threadworkspace
+          = gt_sortallbuckets_thread_workspace(sfi->encseq,
+                                               sfi->readmode,
+                                               largestbucketsize,
+                                               &sfi->sfxstrategy);
+
+        while (sfi->sortthreads > 1U &&
+               gt_suftabparts_fit_memlimit(estimatedspace +
+                                           (sfi->sortthreads - 1) *
+                                           threadworkspace,
+                                           maximumspace,
+                                           sfi->bcktab,
+                                           NULL,
+                                           sfxmrlist,
+                                           sfi->totallength,
+                                           0,
+                                           specialcharacters,
+                                           numofsuffixestosort,
+                                           sfi->sfxstrategy.suftabuint,
+                                           err) != retval)
+        {
+          gt_error_unset(err);
+          sfi->sortthreads--;
+        }
+        gt_logger_log(logger, "sort buckets with %u threads using %.2f MB "
+                              "workspace each",sfi->sortthreads,
+                              GT_MEGABYTES(threadworkspace));
+      }
       if (retval < 0)
       {
         haserr = true;
@@ -1942,6 +1982,7 @@ static void gt_sfxiterator_preparethispart(Sfxiterator *sfi)
                       processunsortedsuffixrange,
                       (void *) sfi->dcov,
                       &sfi->bucketiterstep,
+                      sfi->sortthreads,
                       sfi->logger);
   }
   if (bucketspec2 != NULL)
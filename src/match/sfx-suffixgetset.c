@@ -34,7 +34,7 @@
 
 struct GtSuffixsortspace
 {
-  bool unmapsortspace, currentexport;
+  bool unmapsortspace, currentexport, isview;
   Definedunsignedlong longestidx;
   uint32_t *uinttab;
   size_t basesize;
@@ -132,6 +132,7 @@ GtSuffixsortspace *gt_suffixsortspace_new(GtUword numofentries,
   suffixsortspace->partoffset = 0;
   suffixsortspace->bucketleftidx = 0;
   suffixsortspace->unmapsortspace = false;
+  suffixsortspace->isview = false;
   return suffixsortspace;
 }
 
@@ -163,6 +164,7 @@ GtSuffixsortspace *gt_suffixsortspace_new_fromfile(int filedesc,
   suffixsortspace->partoffset = 0;
   suffixsortspace->bucketleftidx = 0;
   suffixsortspace->unmapsortspace = true;
+  suffixsortspace->isview = false;
   suffixsortspace->maxindex = numofentries - 1;
   suffixsortspace->maxvalue = maxvalue;
   suffixsortspace->longestidx.defined = false;
@@ -173,12 +175,45 @@ GtSuffixsortspace *gt_suffixsortspace_new_fromfile(int filedesc,
   return suffixsortspace;
 }
 
+/* A view shares the table of <sssp>, but has its own bucket offset,
+   export pointer and record of the position of the longest suffix. Hence
+   several threads can sort disjoint buckets of the same table, each
+   through its own view. */
+
+GtSuffixsortspace *gt_suffixsortspace_view_new(const GtSuffixsortspace *sssp)
+{
+  GtSuffixsortspace *view;
+
+  gt_assert(sssp != NULL && !sssp->currentexport);
+  view = gt_malloc(sizeof (*view));
+  *view = *sssp;
+  view->isview = true;
+  view->longestidx.defined = false;
+  view->longestidx.valueunsignedlong = 0;
+  return view;
+}
+
+void gt_suffixsortspace_view_merge(GtSuffixsortspace *sssp,
+                                   const GtSuffixsortspace *view)
+{
+  gt_assert(sssp != NULL && view != NULL && view->isview);
+  if (view->longestidx.defined)
+  {
+    sssp->longestidx = view->longestidx;
+  }
+}
+
 void gt_suffixsortspace_delete(GtSuffixsortspace *suffixsortspace,
                                GT_UNUSED bool checklongestdefined)
 {
   if (suffixsortspace != NULL)
   {
     gt_assert(!checklongestdefined || suffixsortspace->longestidx.defined);
+    if (suffixsortspace->isview)
+    {
+      gt_free(suffixsortspace);
+      return;
+    }
     if (suffixsortspace->unmapsortspace)
     {
       gt_fa_xmunmap(suffixsortspace->ulongtab);
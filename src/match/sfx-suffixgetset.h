@@ -67,6 +67,11 @@ GtSuffixsortspace *gt_suffixsortspace_new_fromfile(int filedesc,
 void gt_suffixsortspace_delete(GT_UNUSED GtSuffixsortspace *suffixsortspace,
                                GT_UNUSED bool checklongestdefined);
 
+GtSuffixsortspace *gt_suffixsortspace_view_new(const GtSuffixsortspace *sssp);
+
+void gt_suffixsortspace_view_merge(GtSuffixsortspace *sssp,
+                                   const GtSuffixsortspace *view);
+
 void gt_suffixsortspace_showrange(const GtSuffixsortspace *sssp,
                                   GtUword subbucketleft,
                                   GtUword width);
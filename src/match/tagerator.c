@@ -16,6 +16,8 @@
 */
 
 #include <limits.h>
+#include <stdio.h>
+#include <string.h>
 #include "core/alphabet.h"
 #include "core/arraydef.h"
 #include "core/error.h"
@@ -23,9 +25,13 @@
 #include "core/format64.h"
 #include "core/intbits.h"
 #include "core/ma_api.h"
+#include "core/minmax.h"
+#include "core/multithread_api.h"
 #include "core/seq_iterator_sequence_buffer_api.h"
 #include "core/str_array.h"
+#include "core/thread_api.h"
 #include "core/unused_api.h"
+#include "core/xansi_api.h"
 #include "apmeoveridx.h"
 #include "dist-short.h"
 #include "echoseq.h"
@@ -40,6 +46,12 @@
 
 #define MAXTAGSIZE GT_INTWORDSIZE
 
+/* number of tags read before they are searched in parallel */
+#define TGR_BATCHSIZE 8192UL
+
+/* number of tags a thread takes from the batch at once */
+#define TGR_CHUNKSIZE 32UL
+
 #define ISRCDIR(TWL)  (((TWL)->tagptr == (TWL)->transformedtag)\
                         ? false\
                         : true)
@@ -57,6 +69,7 @@ typedef struct
   GtUchar transformedtag[MAXTAGSIZE],
         rctransformedtag[MAXTAGSIZE];
   GtUword taglen;
+  GtStr *outbuf; /* output for the current tag */
 } TgrTagwithlength;
 
 typedef struct
@@ -70,32 +83,54 @@ typedef struct
   const GtEncseq *encseq;
 } TgrShowmatchinfo;
 
-#define ADDTABULATOR\
+#define ADDTABULATOR(OUTBUF)\
         if (firstitem)\
         {\
           firstitem = false;\
         } else\
         {\
-          (void) putchar('\t');\
+          gt_str_append_char(OUTBUF,'\t');\
         }
 
+static void tgr_appendsequence(GtStr *outbuf,
+                               const GtAlphabet *alpha,
+                               const GtUchar *seq,
+                               GtUword len)
+{
+  GtUword idx;
+  const GtUchar *characters;
+
+  if (alpha == NULL)
+  {
+    characters = (const GtUchar *) "acgt";
+  } else
+  {
+    characters = gt_alphabet_characters(alpha);
+  }
+  for (idx = 0; idx < len; idx++)
+  {
+    gt_str_append_char(outbuf,(char) characters[(int) seq[idx]]);
+  }
+}
+
 static void tgr_showmatch(void *processinfo,const GtIdxMatch *match)
 {
   TgrShowmatchinfo *showmatchinfo = (TgrShowmatchinfo *) processinfo;
+  GtStr *outbuf = showmatchinfo->twlptr->outbuf;
   bool firstitem = true;
 
   gt_assert(showmatchinfo->tageratoroptions != NULL);
   if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_DBLENGTH)
   {
-    printf(""GT_WU"",match->dblen);
+    gt_str_append_ulong(outbuf,match->dblen);
     firstitem = false;
   }
   if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_DBSTARTPOS)
   {
-    ADDTABULATOR;
+    ADDTABULATOR(outbuf);
     if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_DBABSPOS)
     {
-      printf(""GT_WU"",match->dbstartpos);
+      gt_str_append_ulong(outbuf,match->dbstartpos);
     } else
     {
       GtUword seqstartpos,
@@ -103,27 +138,29 @@ static void tgr_showmatch(void *processinfo,const GtIdxMatch *match)
                                                   match->dbstartpos);
       seqstartpos = gt_encseq_seqstartpos(showmatchinfo->encseq, seqnum);
       gt_assert(seqstartpos <= match->dbstartpos);
-      printf(""GT_WU"\t"GT_WU"",seqnum, match->dbstartpos - seqstartpos);
+      gt_str_append_ulong(outbuf,seqnum);
+      gt_str_append_char(outbuf,'\t');
+      gt_str_append_ulong(outbuf,match->dbstartpos - seqstartpos);
     }
   }
   if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_DBSEQUENCE)
   {
-    ADDTABULATOR;
+    ADDTABULATOR(outbuf);
     gt_assert(match->dbsubstring != NULL);
-    gt_alphabet_decode_seq_to_fp(showmatchinfo->alpha,
-                                 stdout,
-                                 match->dbsubstring,
-                                 (GtUword) match->dblen);
+    tgr_appendsequence(outbuf,
+                       showmatchinfo->alpha,
+                       match->dbsubstring,
+                       (GtUword) match->dblen);
   }
   if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_STRAND)
   {
-    ADDTABULATOR;
-    printf("%c",ISRCDIR(showmatchinfo->twlptr) ? '-' : '+');
+    ADDTABULATOR(outbuf);
+    gt_str_append_char(outbuf,ISRCDIR(showmatchinfo->twlptr) ? '-' : '+');
   }
   if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_EDIST)
   {
-    ADDTABULATOR;
-    printf(""GT_WU"",match->distance);
+    ADDTABULATOR(outbuf);
+    gt_str_append_ulong(outbuf,match->distance);
   }
   if (showmatchinfo->tageratoroptions->maxintervalwidth > 0)
   {
@@ -144,48 +181,49 @@ static void tgr_showmatch(void *processinfo,const GtIdxMatch *match)
         gt_assert(match->querylen >= suffixlength);
         if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_TAGSTARTPOS)
         {
-          ADDTABULATOR;
-          printf(""GT_WU"",match->querylen - suffixlength);
+          ADDTABULATOR(outbuf);
+          gt_str_append_ulong(outbuf,match->querylen - suffixlength);
         }
         if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_TAGLENGTH)
         {
-          ADDTABULATOR;
-          printf(""GT_WU"",suffixlength);
+          ADDTABULATOR(outbuf);
+          gt_str_append_ulong(outbuf,suffixlength);
         }
         if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_TAGSUFFIXSEQ)
         {
-          ADDTABULATOR;
-          gt_alphabet_decode_seq_to_fp(NULL,
-                                       stdout,showmatchinfo->tagptr +
-                                       (match->querylen - suffixlength),
-                                       suffixlength);
+          ADDTABULATOR(outbuf);
+          tgr_appendsequence(outbuf,
+                             NULL,
+                             showmatchinfo->tagptr +
+                             (match->querylen - suffixlength),
+                             suffixlength);
         }
       }
     } else
     {
       if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_TAGSTARTPOS)
       {
-        ADDTABULATOR;
-        printf("0");
+        ADDTABULATOR(outbuf);
+        gt_str_append_char(outbuf,'0');
       }
       if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_TAGLENGTH)
       {
-        ADDTABULATOR;
-        printf(""GT_WU"",match->querylen);
+        ADDTABULATOR(outbuf);
+        gt_str_append_ulong(outbuf,match->querylen);
       }
       if (showmatchinfo->tageratoroptions->outputmode & TAGOUT_TAGSUFFIXSEQ)
       {
-        ADDTABULATOR;
-        gt_alphabet_decode_seq_to_fp(NULL,
-                                     stdout,
-                                     showmatchinfo->tagptr,
-                                     match->querylen);
+        ADDTABULATOR(outbuf);
+        tgr_appendsequence(outbuf,
+                           NULL,
+                           showmatchinfo->tagptr,
+                           match->querylen);
       }
     }
   }
   if (!firstitem)
   {
-    printf("\n");
+    gt_str_append_char(outbuf,'\n');
   }
 }
 
@@ -273,7 +311,9 @@ static void showmstats(void *processinfo,
 {
   TgrTagwithlength *twl = (TgrTagwithlength *) patterninfo;
 
-  printf(""GT_WU" %c",mstatlength,ISRCDIR(twl) ? '-' : '+');
+  gt_str_append_ulong(twl->outbuf,mstatlength);
+  gt_str_append_char(twl->outbuf,' ');
+  gt_str_append_char(twl->outbuf,ISRCDIR(twl) ? '-' : '+');
   if (gt_intervalwidthleq((const Limdfsresources *) processinfo,leftbound,
                        rightbound))
   {
@@ -285,10 +325,11 @@ static void showmstats(void *processinfo,
                                   mstatlength);
     for (idx = 0; idx<mstatspos->nextfreeGtUlong; idx++)
     {
-      printf(" "GT_WU"",mstatspos->spaceGtUlong[idx]);
+      gt_str_append_char(twl->outbuf,' ');
+      gt_str_append_ulong(twl->outbuf,mstatspos->spaceGtUlong[idx]);
     }
   }
-  printf("\n");
+  gt_str_append_char(twl->outbuf,'\n');
 }
 
 static int cmpdescend(const void *a,const void *b)
@@ -536,11 +577,215 @@ static void searchoverstrands(const TageratorOptions *tageratoroptions,
   }
 }
 
+typedef struct
+{
+  TgrTagwithlength twl;
+  TgrShowmatchinfo showmatchinfo;
+  ArrayTgrSimplematch storeonline, storeoffline;
+  Genericindex *sharedcopy; /* NULL if the index itself is used */
+  Myersonlineresources *mor;
+  Limdfsresources *limdfsresources;
+} TgrWorker;
+
+typedef struct
+{
+  GtUchar transformedtag[MAXTAGSIZE];
+  GtUword taglen;
+  uint64_t tagnumber;
+  bool search; /* if false, only the header line of the tag is shown */
+  GtStr *outbuf;
+} TgrBatchtag;
+
+typedef struct
+{
+  const TageratorOptions *tageratoroptions;
+  const AbstractDfstransformer *dfst;
+  const GtAlphabet *alpha;
+  TgrWorker *workers;
+  TgrBatchtag *batch;
+  GtUword numofworkers,
+          nextworker,
+          numoftags,
+          nexttag;
+  GtMutex *mutex;
+} TgrThreadinfo;
+
+static void tgr_initworker(TgrWorker *worker,
+                           const TageratorOptions *tageratoroptions,
+                           const Genericindex *genericindex,
+                           const GtEncseq *encseq,
+                           const AbstractDfstransformer *dfst)
+{
+  ProcessIdxMatch processmatch;
+  void *processmatchinfoonline, *processmatchinfooffline;
+  const GtAlphabet *alpha = gt_encseq_alphabet(encseq);
+  unsigned int numofchars = gt_alphabet_num_of_chars(alpha);
+
+  GT_INITARRAY(&worker->storeonline,TgrSimplematch);
+  GT_INITARRAY(&worker->storeoffline,TgrSimplematch);
+  worker->storeonline.twlptr = worker->storeoffline.twlptr = &worker->twl;
+  if (tageratoroptions->docompare)
+  {
+    processmatch = tgr_storematch;
+    processmatchinfoonline = &worker->storeonline;
+    processmatchinfooffline = &worker->storeoffline;
+    worker->showmatchinfo.eqsvector = NULL;
+    worker->showmatchinfo.encseq = encseq;
+  } else
+  {
+    processmatch = tgr_showmatch;
+    worker->showmatchinfo.twlptr = &worker->twl;
+    worker->showmatchinfo.tageratoroptions = tageratoroptions;
+    worker->showmatchinfo.alphasize = numofchars;
+    worker->showmatchinfo.alpha = alpha;
+    worker->showmatchinfo.eqsvector
+      = gt_malloc(sizeof (*worker->showmatchinfo.eqsvector) *
+                  worker->showmatchinfo.alphasize);
+    worker->showmatchinfo.encseq = encseq;
+    processmatchinfooffline = &worker->showmatchinfo;
+    processmatchinfoonline = &worker->showmatchinfo;
+  }
+  worker->mor = NULL;
+  if (tageratoroptions->doonline || tageratoroptions->docompare)
+  {
+    worker->mor = gt_newMyersonlineresources(numofchars,
+                                             tageratoroptions->nowildcards,
+                                             encseq,
+                                             processmatch,
+                                             processmatchinfoonline);
+  }
+  worker->limdfsresources = NULL;
+  if (!tageratoroptions->doonline || tageratoroptions->docompare)
+  {
+    GtUword maxpathlength;
+
+    if (tageratoroptions->userdefinedmaxdistance >= 0)
+    {
+      maxpathlength = (GtUword) (1+ MAXTAGSIZE +
+                                       tageratoroptions->
+                                       userdefinedmaxdistance);
+    } else
+    {
+      maxpathlength = (GtUword) (1+MAXTAGSIZE);
+    }
+    worker->limdfsresources
+      = gt_newLimdfsresources(genericindex,
+                              tageratoroptions->nowildcards,
+                              tageratoroptions->maxintervalwidth,
+                              maxpathlength,
+                              false, /* keepexpandedonstack */
+                              processmatch,
+                              processmatchinfooffline,
+                              tageratoroptions->docompare
+                                ? checkmstats
+                                : showmstats,
+                              &worker->twl, /* refer to uninit structure */
+                              dfst);
+  }
+}
+
+static void tgr_freeworker(TgrWorker *worker,
+                           const AbstractDfstransformer *dfst)
+{
+  GT_FREEARRAY(&worker->storeonline,TgrSimplematch);
+  GT_FREEARRAY(&worker->storeoffline,TgrSimplematch);
+  gt_free(worker->showmatchinfo.eqsvector);
+  if (worker->limdfsresources != NULL)
+  {
+    gt_freeLimdfsresources(&worker->limdfsresources,dfst);
+  }
+  gt_freeMyersonlineresources(worker->mor);
+  genericindex_delete(worker->sharedcopy);
+}
+
+static void tgr_processtag(const TgrThreadinfo *threadinfo,
+                           TgrWorker *worker,
+                           const TgrBatchtag *batchtag)
+{
+  const TageratorOptions *tageratoroptions = threadinfo->tageratoroptions;
+  TgrTagwithlength *twl = &worker->twl;
+  bool firstitem = true;
+
+  memcpy(twl->transformedtag,batchtag->transformedtag,
+         sizeof (*twl->transformedtag) * batchtag->taglen);
+  twl->taglen = batchtag->taglen;
+  twl->outbuf = batchtag->outbuf;
+  gt_copy_reversecomplement(twl->rctransformedtag,twl->transformedtag,
+                         twl->taglen);
+  twl->tagptr = twl->transformedtag;
+  gt_str_append_char(twl->outbuf,'#');
+  if (tageratoroptions->outputmode & TAGOUT_TAGNUM)
+  {
+    char tagnumberbuf[32];
+
+    (void) snprintf(tagnumberbuf,sizeof tagnumberbuf,"\t" Formatuint64_t,
+                    PRINTuint64_tcast(batchtag->tagnumber));
+    gt_str_append_cstr(twl->outbuf,tagnumberbuf);
+    firstitem = false;
+  }
+  if (tageratoroptions->outputmode & TAGOUT_TAGLENGTH)
+  {
+    ADDTABULATOR(twl->outbuf);
+    gt_str_append_ulong(twl->outbuf,twl->taglen);
+  }
+  if (tageratoroptions->outputmode & TAGOUT_TAGSEQ)
+  {
+    ADDTABULATOR(twl->outbuf);
+    tgr_appendsequence(twl->outbuf,threadinfo->alpha,twl->transformedtag,
+                       twl->taglen);
+  }
+  gt_str_append_char(twl->outbuf,'\n');
+  if (!batchtag->search)
+  {
+    return;
+  }
+  worker->storeoffline.nextfreeTgrSimplematch = 0;
+  worker->storeonline.nextfreeTgrSimplematch = 0;
+  searchoverstrands(tageratoroptions,
+                    twl,
+                    threadinfo->dfst,
+                    worker->mor,
+                    worker->limdfsresources,
+                    &worker->showmatchinfo,
+                    &worker->storeonline,
+                    &worker->storeoffline);
+}
+
+/* each thread takes its own worker and then processes chunks of tags from
+   the current batch until the batch is exhausted */
+static void *tgr_processbatch(void *data)
+{
+  TgrThreadinfo *threadinfo = (TgrThreadinfo *) data;
+  TgrWorker *worker;
+  GtUword tagnum, firsttag, lasttag;
+
+  gt_mutex_lock(threadinfo->mutex);
+  gt_assert(threadinfo->nextworker < threadinfo->numofworkers);
+  worker = threadinfo->workers + threadinfo->nextworker++;
+  gt_mutex_unlock(threadinfo->mutex);
+  while (true)
+  {
+    gt_mutex_lock(threadinfo->mutex);
+    firsttag = threadinfo->nexttag;
+    lasttag = MIN(firsttag + TGR_CHUNKSIZE,threadinfo->numoftags);
+    threadinfo->nexttag = lasttag;
+    gt_mutex_unlock(threadinfo->mutex);
+    if (firsttag == lasttag)
+    {
+      break;
+    }
+    for (tagnum = firsttag; tagnum < lasttag; tagnum++)
+    {
+      tgr_processtag(threadinfo,worker,threadinfo->batch + tagnum);
+    }
+  }
+  return NULL;
+}
+
 int gt_runtagerator(const TageratorOptions *tageratoroptions,GtError *err)
 {
-  bool haserr = false, firstitem;
+  bool haserr = false;
   int retval;
-  Myersonlineresources *mor = NULL;
   Genericindex *genericindex = NULL;
   const GtEncseq *encseq = NULL;
   GtLogger *logger;
@@ -584,88 +829,58 @@ int gt_runtagerator(const TageratorOptions *tageratoroptions,GtError *err)
   }
   if (!haserr)
   {
-    TgrTagwithlength twl;
-    uint64_t tagnumber;
-    unsigned int numofchars;
-    const GtUchar *symbolmap, *currenttag;
+    GtUword taglen, numoftags, idx;
+    uint64_t tagnumber = 0;
+    const GtUchar *symbolmap, *currenttag = NULL;
     char *desc = NULL;
-    ProcessIdxMatch processmatch;
-    TgrShowmatchinfo showmatchinfo;
-    void *processmatchinfoonline, *processmatchinfooffline;
-    Limdfsresources *limdfsresources = NULL;
-    const GtAlphabet *alpha;
-    ArrayTgrSimplematch storeonline, storeoffline;
-    const AbstractDfstransformer *dfst;
+    bool endofinput = false, tagtooshort = false;
+    TgrThreadinfo threadinfo;
     GtSeqIterator *seqit = NULL;
+    GtError *tagerr;
 
+    threadinfo.tageratoroptions = tageratoroptions;
     if (tageratoroptions->userdefinedmaxdistance >= 0)
     {
-      dfst = gt_apme_AbstractDfstransformer();
+      threadinfo.dfst = gt_apme_AbstractDfstransformer();
     } else
     {
-      dfst = gt_pms_AbstractDfstransformer();
+      threadinfo.dfst = gt_pms_AbstractDfstransformer();
     }
-    GT_INITARRAY(&storeonline,TgrSimplematch);
-    GT_INITARRAY(&storeoffline,TgrSimplematch);
-    storeonline.twlptr = storeoffline.twlptr = &twl;
-    alpha = gt_encseq_alphabet(encseq);
-    symbolmap = gt_alphabet_symbolmap(alpha);
-    numofchars = gt_alphabet_num_of_chars(alpha);
-    if (tageratoroptions->docompare)
-    {
-      processmatch = tgr_storematch;
-      processmatchinfoonline = &storeonline;
-      processmatchinfooffline = &storeoffline;
-      showmatchinfo.eqsvector = NULL;
-      showmatchinfo.encseq = encseq;
-    } else
-    {
-      processmatch = tgr_showmatch;
-      showmatchinfo.twlptr = &twl;
-      showmatchinfo.tageratoroptions = tageratoroptions;
-      showmatchinfo.alphasize = (unsigned int) numofchars;
-      showmatchinfo.alpha = alpha;
-      showmatchinfo.eqsvector = gt_malloc(sizeof (*showmatchinfo.eqsvector) *
-                                          showmatchinfo.alphasize);
-      showmatchinfo.encseq = encseq;
-      processmatchinfooffline = &showmatchinfo;
-      processmatchinfoonline = &showmatchinfo;
-    }
-    if (tageratoroptions->doonline || tageratoroptions->docompare)
-    {
-      gt_assert(encseq != NULL);
-      mor = gt_newMyersonlineresources(numofchars,
-                                    tageratoroptions->nowildcards,
-                                    encseq,
-                                    processmatch,
-                                    processmatchinfoonline);
-    }
-    if (!tageratoroptions->doonline || tageratoroptions->docompare)
-    {
-      GtUword maxpathlength;
+    threadinfo.alpha = gt_encseq_alphabet(encseq);
+    symbolmap = gt_alphabet_symbolmap(threadinfo.alpha);
+    /* the index is mapped once and shared by all workers, each worker has
+       its own search resources */
+    threadinfo.numofworkers = (GtUword) gt_jobs;
+    threadinfo.workers = gt_calloc((size_t) threadinfo.numofworkers,
+                                   sizeof (*threadinfo.workers));
+    for (idx = 0; idx < threadinfo.numofworkers; idx++)
+    {
+      TgrWorker *worker = threadinfo.workers + idx;
 
-      if (tageratoroptions->userdefinedmaxdistance >= 0)
+      if (idx > 0 && genericindex != NULL)
       {
-        maxpathlength = (GtUword) (1+ MAXTAGSIZE +
-                                         tageratoroptions->
-                                         userdefinedmaxdistance);
-      } else
-      {
-        maxpathlength = (GtUword) (1+MAXTAGSIZE);
+        worker->sharedcopy = genericindex_new_sharedcopy(genericindex);
+        if (worker->sharedcopy == NULL)
+        {
+          /* the index cannot be searched concurrently, use a single
+             worker */
+          gt_logger_log(logger,"index is not memory mapped, search the tags "
+                                "in a single thread");
+          threadinfo.numofworkers = idx;
+          break;
+        }
       }
-      limdfsresources = gt_newLimdfsresources(genericindex,
-                                           tageratoroptions->nowildcards,
-                                           tageratoroptions->maxintervalwidth,
-                                           maxpathlength,
-                                           false, /* keepexpandedonstack */
-                                           processmatch,
-                                           processmatchinfooffline,
-                                           tageratoroptions->docompare
-                                             ? checkmstats
-                                             : showmstats,
-                                           &twl, /* refer to uninit structure */
-                                           dfst);
+      tgr_initworker(worker,tageratoroptions,
+                     worker->sharedcopy != NULL ? worker->sharedcopy
+                                                : genericindex,
+                     encseq,threadinfo.dfst);
+    }
+    threadinfo.batch = gt_malloc(sizeof (*threadinfo.batch) * TGR_BATCHSIZE);
+    for (idx = 0; idx < TGR_BATCHSIZE; idx++)
+    {
+      threadinfo.batch[idx].outbuf = gt_str_new();
     }
+    threadinfo.mutex = gt_mutex_new();
     printf("# for each match show: ");
     gt_getsetargmodekeywords(tageratoroptions->modedesc,
                              tageratoroptions->numberofmodedescentries,
@@ -676,90 +891,106 @@ int gt_runtagerator(const TageratorOptions *tageratoroptions,GtError *err)
     {
       haserr = true;
     }
-    if (!haserr)
+    /* errors in the tags are only reported after the tags before them have
+       been processed */
+    tagerr = gt_error_new();
+    while (!haserr && !endofinput)
     {
-      for (tagnumber = 0; !haserr; tagnumber++)
+      for (numoftags = 0; numoftags < TGR_BATCHSIZE; numoftags++)
       {
-        retval = gt_seq_iterator_next(seqit, &currenttag, &twl.taglen, &desc,
-                                     err);
+        TgrBatchtag *batchtag = threadinfo.batch + numoftags;
+
+        retval = gt_seq_iterator_next(seqit, &currenttag, &taglen, &desc,
+                                      tagerr);
         if (retval != 1)
         {
+          endofinput = true;
           break;
         }
-        if (dotransformtag(twl.transformedtag,
+        if (dotransformtag(batchtag->transformedtag,
                            symbolmap,
                            currenttag,
-                           twl.taglen,
+                           taglen,
                            tagnumber,
                            tageratoroptions->replacewildcard,
-                           err) != 0)
+                           tagerr) != 0)
         {
-          haserr = true;
-          gt_free(desc);
+          endofinput = true;
           break;
         }
-        gt_copy_reversecomplement(twl.rctransformedtag,twl.transformedtag,
-                               twl.taglen);
-        twl.tagptr = twl.transformedtag;
-        firstitem = true;
-        printf("#");
-        if (tageratoroptions->outputmode & TAGOUT_TAGNUM)
-        {
-          printf("\t" Formatuint64_t,PRINTuint64_tcast(tagnumber));
-          firstitem = false;
-        }
-        if (tageratoroptions->outputmode & TAGOUT_TAGLENGTH)
-        {
-          ADDTABULATOR;
-          printf(""GT_WU"",twl.taglen);
-        }
-        if (tageratoroptions->outputmode & TAGOUT_TAGSEQ)
-        {
-          ADDTABULATOR;
-          gt_alphabet_decode_seq_to_fp(alpha,stdout,twl.transformedtag,
-                                       twl.taglen);
-        }
-        printf("\n");
-        storeoffline.nextfreeTgrSimplematch = 0;
-        storeonline.nextfreeTgrSimplematch = 0;
+        batchtag->taglen = taglen;
+        batchtag->tagnumber = tagnumber++;
+        batchtag->search = true;
         if (tageratoroptions->userdefinedmaxdistance > 0 &&
-            twl.taglen <= (GtUword)
-                          tageratoroptions->userdefinedmaxdistance)
+            taglen <= (GtUword) tageratoroptions->userdefinedmaxdistance)
         {
-          gt_error_set(err,"tag \"%*.*s\" of length "GT_WU"; "
-                       "tags must be longer than the allowed number of errors "
-                       "(which is "GT_WD")",
-                       (int) twl.taglen,
-                       (int) twl.taglen,currenttag,
-                       twl.taglen,
-                       tageratoroptions->userdefinedmaxdistance);
-          haserr = true;
-          gt_free(desc);
+          /* the header line of the tag is still shown */
+          batchtag->search = false;
+          tagtooshort = endofinput = true;
+          numoftags++;
           break;
         }
         gt_assert(tageratoroptions->userdefinedmaxdistance < 0 ||
-                  twl.taglen > (GtUword)
-                               tageratoroptions->userdefinedmaxdistance);
-        searchoverstrands(tageratoroptions,
-                          &twl,
-                          dfst,
-                          mor,
-                          limdfsresources,
-                          &showmatchinfo,
-                          &storeonline,
-                          &storeoffline);
+                  taglen > (GtUword)
+                           tageratoroptions->userdefinedmaxdistance);
       }
-      gt_seq_iterator_delete(seqit);
+      threadinfo.numoftags = numoftags;
+      threadinfo.nexttag = 0;
+      threadinfo.nextworker = 0;
+      if (numoftags > 0)
+      {
+        if (threadinfo.numofworkers == 1UL)
+        {
+          (void) tgr_processbatch(&threadinfo);
+        } else
+        {
+          if (gt_multithread(tgr_processbatch, &threadinfo, err) != 0)
+          {
+            haserr = true;
+          }
+        }
+      }
+      for (idx = 0; idx < numoftags; idx++)
+      {
+        GtStr *outbuf = threadinfo.batch[idx].outbuf;
+
+        gt_xfwrite(gt_str_get_mem(outbuf),sizeof (char),
+                   (size_t) gt_str_length(outbuf),stdout);
+        gt_str_reset(outbuf);
+      }
+    }
+    if (!haserr && tagtooshort)
+    {
+      gt_error_set(err,"tag \"%*.*s\" of length "GT_WU"; "
+                   "tags must be longer than the allowed number of errors "
+                   "(which is "GT_WD")",
+                   (int) taglen,
+                   (int) taglen,currenttag,
+                   taglen,
+                   tageratoroptions->userdefinedmaxdistance);
+      haserr = true;
+    } else
+    {
+      if (!haserr && gt_error_is_set(tagerr))
+      {
+        gt_error_set(err,"%s",gt_error_get(tagerr));
+        haserr = true;
+      }
+    }
+    gt_error_delete(tagerr);
+    gt_seq_iterator_delete(seqit);
+    gt_mutex_delete(threadinfo.mutex);
+    for (idx = 0; idx < TGR_BATCHSIZE; idx++)
+    {
+      gt_str_delete(threadinfo.batch[idx].outbuf);
     }
-    GT_FREEARRAY(&storeonline,TgrSimplematch);
-    GT_FREEARRAY(&storeoffline,TgrSimplematch);
-    gt_free(showmatchinfo.eqsvector);
-    if (limdfsresources != NULL)
+    gt_free(threadinfo.batch);
+    for (idx = 0; idx < threadinfo.numofworkers; idx++)
     {
-      gt_freeLimdfsresources(&limdfsresources,dfst);
+      tgr_freeworker(threadinfo.workers + idx,threadinfo.dfst);
     }
+    gt_free(threadinfo.workers);
   }
-  gt_freeMyersonlineresources(mor);
   if (genericindex == NULL)
   {
     if (encseq != NULL)
@@ -25,7 +25,7 @@
 #include "extended/gff3_in_stream.h"
 #include "extended/gff3_out_stream_api.h"
 #include "extended/gtdatahelp.h"
-#include "extended/sort_stream_api.h"
+#include "extended/sort_stream.h"
 #include "tools/gt_chseqids.h"
 
 #define DEFAULT_JOINLENGTH 300
@@ -33,6 +33,7 @@
 typedef struct {
   bool sort,
        verbose;
+  GtUword sortmemlimit;
   GtOutputFileInfo *ofi;
   GtFile *outfp;
 } ChseqidsArguments;
@@ -57,7 +58,7 @@ static GtOptionParser* gt_chseqids_option_parser_new(void *tool_arguments)
 {
   ChseqidsArguments *arguments = tool_arguments;
   GtOptionParser *op;
-  GtOption *option;
+  GtOption *option, *sort_option;
   gt_assert(arguments);
 
   /* init */
@@ -66,11 +67,20 @@ static GtOptionParser* gt_chseqids_option_parser_new(void *tool_arguments)
                          "mapping file.");
 
   /* -sort */
-  option = gt_option_new_bool("sort",
-                              "sort the GFF3 features after changing the "
-                              "sequence ids\n(memory consumption is "
-                              "proportional to the input file size)",
-                              &arguments->sort, false);
+  sort_option = gt_option_new_bool("sort",
+                                   "sort the GFF3 features after changing the "
+                                   "sequence ids\n(memory consumption is "
+                                   "proportional to the input file size)",
+                                   &arguments->sort, false);
+  gt_option_parser_add_option(op, sort_option);
+
+  /* -sortmemlimit */
+  option = gt_option_new_uword("sortmemlimit", "limit the memory used for "
+                               "sorting to about the given number of "
+                               "megabytes, by sorting parts of the input in "
+                               "temporary files (0 means no limit)",
+                               &arguments->sortmemlimit, 0);
+  gt_option_imply(option, sort_option);
   gt_option_parser_add_option(op, option);
 
   /* -v */
@@ -112,6 +122,8 @@ static int gt_chseqids_runnter(GT_UNUSED int argc, const char **argv,
   if (!had_err) {
     if (arguments->sort) {
       sort_stream = gt_sort_stream_new(chseqids_stream);
+      gt_sort_stream_set_memory_limit(sort_stream,
+                                      arguments->sortmemlimit << 20);
       gff3_out_stream = gt_gff3_out_stream_new(sort_stream, arguments->outfp);
     }
     else {
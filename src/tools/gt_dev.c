@@ -25,19 +25,25 @@
 #include "gth/gt_gthbssmprint.h"
 #include "gth/gt_gthbssmrmsd.h"
 #include "gth/gt_gthbssmtrain.h"
+#include "gth/gt_gthdpbench.h"
 #include "gth/gt_gthmkbssmfiles.h"
 #include "tools/gt_compressedbits.h"
 #include "tools/gt_consensus_sa.h"
 #include "tools/gt_dev.h"
 #include "tools/gt_extracttarget.h"
+#include "tools/gt_fastabench.h"
+#include "tools/gt_featureindexbench.h"
 #include "tools/gt_gdiffcalc.h"
+#include "tools/gt_gff3parsebench.h"
 #include "tools/gt_guessprot.h"
+#include "tools/gt_hashtablebench.h"
 #include "tools/gt_idxlocali.h"
 #include "tools/gt_magicmatch.h"
 #include "tools/gt_mergeesa.h"
 #include "tools/gt_paircmp.h"
 #include "tools/gt_patternmatch.h"
 #include "tools/gt_readreads.h"
+#include "tools/gt_refcountbench.h"
 #include "tools/gt_regioncov.h"
 #include "tools/gt_sain.h"
 #include "tools/gt_sam_interface.h"
@@ -58,6 +64,7 @@ static void* gt_dev_arguments_new(void)
   gt_toolbox_add(dev_toolbox, "gthbssmprint", gt_gthbssmprint);
   gt_toolbox_add_tool(dev_toolbox, "gthbssmrmsd", gt_gthbssmrmsd());
   gt_toolbox_add_tool(dev_toolbox, "gthbssmtrain", gt_gthbssmtrain());
+  gt_toolbox_add_tool(dev_toolbox, "gthdpbench", gt_gthdpbench());
   gt_toolbox_add(dev_toolbox, "gthmkbssmfiles", gt_gthmkbssmfiles);
   gt_toolbox_add(dev_toolbox, "guessprot", gt_guessprot);
   gt_toolbox_add(dev_toolbox, "mergeesa", gt_mergeesa);
@@ -68,10 +75,16 @@ static void* gt_dev_arguments_new(void)
   gt_toolbox_add_tool(dev_toolbox, "compbits", gt_compressedbits());
   gt_toolbox_add_tool(dev_toolbox, "consensus_sa", gt_consensus_sa_tool());
   gt_toolbox_add_tool(dev_toolbox, "extracttarget", gt_extracttarget());
+  gt_toolbox_add_tool(dev_toolbox, "fastabench", gt_fastabench());
+  gt_toolbox_add_tool(dev_toolbox, "featureindexbench",
+                      gt_featureindexbench());
   gt_toolbox_add_tool(dev_toolbox, "gdiffcalc", gt_gdiffcalc());
+  gt_toolbox_add_tool(dev_toolbox, "gff3parsebench", gt_gff3parsebench());
+  gt_toolbox_add_tool(dev_toolbox, "hashtablebench", gt_hashtablebench());
   gt_toolbox_add_tool(dev_toolbox, "idxlocali", gt_idxlocali());
   gt_toolbox_add_tool(dev_toolbox, "magicmatch", gt_magicmatch());
   gt_toolbox_add_tool(dev_toolbox, "readreads", gt_readreads());
+  gt_toolbox_add_tool(dev_toolbox, "refcountbench", gt_refcountbench());
   gt_toolbox_add_tool(dev_toolbox, "sain", gt_sain());
   gt_toolbox_add_tool(dev_toolbox, "sambam", gt_sam_interface());
   gt_toolbox_add_tool(dev_toolbox, "seqcorrect", gt_seqcorrect());
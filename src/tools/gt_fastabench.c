@@ -0,0 +1,196 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/fasta_reader_fsm.h"
+#include "core/fasta_reader_rec.h"
+#include "core/ma.h"
+#include "core/str_api.h"
+#include "core/timer_api.h"
+#include "core/unused_api.h"
+#include "tools/gt_fastabench.h"
+
+typedef struct {
+  GtStr *reader;
+  GtUword runs;
+  bool use_mmap,
+       verbose;
+} GtFastabenchArguments;
+
+typedef struct {
+  GtUword numofsequences,
+          totallength,
+          sequencechars,
+          descriptionchars;
+} GtFastabenchCounts;
+
+static void* gt_fastabench_arguments_new(void)
+{
+  GtFastabenchArguments *arguments = gt_calloc((size_t) 1, sizeof *arguments);
+  arguments->reader = gt_str_new();
+  return arguments;
+}
+
+static void gt_fastabench_arguments_delete(void *tool_arguments)
+{
+  GtFastabenchArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_str_delete(arguments->reader);
+  gt_free(arguments);
+}
+
+static GtOptionParser* gt_fastabench_option_parser_new(void *tool_arguments)
+{
+  GtFastabenchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option, *readeroption;
+  static const char *readers[] = {"fsm", "rec", NULL};
+
+  gt_assert(arguments);
+
+  /* init */
+  op = gt_option_parser_new("[option ...] [sequence_file]",
+                            "Measure the throughput of the fasta readers.");
+
+  readeroption = gt_option_new_choice("reader", "fasta reader\n"
+                                      "choose from fsm|rec",
+                                      arguments->reader, readers[0], readers);
+  gt_option_parser_add_option(op, readeroption);
+
+  option = gt_option_new_bool("mmap", "map uncompressed sequence file into "
+                              "memory (fsm reader only)",
+                              &arguments->use_mmap, false);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("runs", "number of times the sequence file "
+                                   "is read", &arguments->runs, 1UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_verbose(&arguments->verbose);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_max_args(op, 1U);
+  return op;
+}
+
+static int gt_fastabench_arguments_check(int rest_argc, void *tool_arguments,
+                                         GtError *err)
+{
+  GtFastabenchArguments *arguments = tool_arguments;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(arguments);
+  if (arguments->use_mmap && strcmp(gt_str_get(arguments->reader), "fsm")) {
+    gt_error_set(err, "option -mmap requires the fsm reader");
+    had_err = -1;
+  }
+  if (!had_err && rest_argc == 0 && arguments->runs > 1UL) {
+    gt_error_set(err, "option -runs requires a sequence file");
+    had_err = -1;
+  }
+  return had_err;
+}
+
+static int gt_fastabench_description(GT_UNUSED const char *description,
+                                     GtUword length, void *data,
+                                     GT_UNUSED GtError *err)
+{
+  GtFastabenchCounts *counts = data;
+  counts->numofsequences++;
+  counts->descriptionchars += length;
+  return 0;
+}
+
+static int gt_fastabench_sequence_part(GT_UNUSED const char *seqpart,
+                                       GtUword length, void *data,
+                                       GT_UNUSED GtError *err)
+{
+  GtFastabenchCounts *counts = data;
+  counts->sequencechars += length;
+  return 0;
+}
+
+static int gt_fastabench_sequence_length(GtUword length, void *data,
+                                         GT_UNUSED GtError *err)
+{
+  GtFastabenchCounts *counts = data;
+  counts->totallength += length;
+  return 0;
+}
+
+static int gt_fastabench_runner(int argc, const char **argv, int parsed_args,
+                                void *tool_arguments, GtError *err)
+{
+  GtFastabenchArguments *arguments = tool_arguments;
+  const char *readername = gt_str_get(arguments->reader);
+  GtFastaReader *fasta_reader;
+  GtFastabenchCounts counts;
+  GtStr *sequence_filename = NULL;
+  GtTimer *timer = NULL;
+  GtUword run;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  if (parsed_args < argc)
+    sequence_filename = gt_str_new_cstr(argv[parsed_args]);
+  if (arguments->verbose) {
+    timer = gt_timer_new();
+    gt_timer_start(timer);
+  }
+  /* the readers are created for each run, as not all of them can be rerun */
+  for (run = 0; !had_err && run < arguments->runs; run++) {
+    if (strcmp(readername, "rec") == 0)
+      fasta_reader = gt_fasta_reader_rec_new(sequence_filename);
+    else {
+      fasta_reader = gt_fasta_reader_fsm_new(sequence_filename);
+      if (arguments->use_mmap)
+        gt_fasta_reader_fsm_use_mmap(fasta_reader);
+    }
+    counts.numofsequences = counts.totallength = counts.sequencechars
+                          = counts.descriptionchars = 0;
+    had_err = gt_fasta_reader_run(fasta_reader, gt_fastabench_description,
+                                  gt_fastabench_sequence_part,
+                                  gt_fastabench_sequence_length, &counts, err);
+    gt_fasta_reader_delete(fasta_reader);
+  }
+  if (!had_err) {
+    printf("# number of sequences: "GT_WU"\n", counts.numofsequences);
+    printf("# total length: "GT_WU"\n", counts.totallength);
+    printf("# sequence characters: "GT_WU"\n", counts.sequencechars);
+    printf("# description characters: "GT_WU"\n", counts.descriptionchars);
+    if (timer != NULL) {
+      printf("# TIME %s reader, "GT_WU" run(s): ", readername,
+             arguments->runs);
+      gt_timer_show_formatted(timer, GT_WD".%06ld seconds real, "
+                              GT_WD"s user, "GT_WD"s system\n", stdout);
+    }
+  }
+  gt_timer_delete(timer);
+  gt_str_delete(sequence_filename);
+  return had_err;
+}
+
+GtTool* gt_fastabench(void)
+{
+  return gt_tool_new(gt_fastabench_arguments_new,
+                     gt_fastabench_arguments_delete,
+                     gt_fastabench_option_parser_new,
+                     gt_fastabench_arguments_check,
+                     gt_fastabench_runner);
+}
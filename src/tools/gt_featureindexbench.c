@@ -0,0 +1,307 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <sys/resource.h>
+#include "core/array_api.h"
+#include "core/fileutils_api.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/str_array_api.h"
+#include "core/timer_api.h"
+#include "core/unused_api.h"
+#include "core/xposix.h"
+#include "extended/anno_db_gfflike_api.h"
+#include "extended/feature_index_memory_api.h"
+#include "extended/feature_node_iterator_api.h"
+#include "extended/rdb_sqlite_api.h"
+#include "tools/gt_featureindexbench.h"
+
+typedef struct {
+  bool bulkload,
+       compact,
+       verbose;
+  GtUword queries,
+          width;
+  GtStr *sqlite;
+} GtFeatureindexbenchArguments;
+
+static void* gt_featureindexbench_arguments_new(void)
+{
+  GtFeatureindexbenchArguments *arguments = gt_calloc((size_t) 1,
+                                                      sizeof *arguments);
+  arguments->sqlite = gt_str_new();
+  return arguments;
+}
+
+static void gt_featureindexbench_arguments_delete(void *tool_arguments)
+{
+  GtFeatureindexbenchArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_str_delete(arguments->sqlite);
+  gt_free(arguments);
+}
+
+static GtOptionParser* gt_featureindexbench_option_parser_new(void
+                                                              *tool_arguments)
+{
+  GtFeatureindexbenchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option, *queries_option;
+#ifdef HAVE_SQLITE
+  GtOption *sqlite_option;
+#endif
+
+  gt_assert(arguments);
+
+  /* init */
+  op = gt_option_parser_new("[option ...] GFF3_file [...]",
+                            "Load GFF3 files into an in-memory (or SQLite) "
+                            "feature index and report its size.");
+
+  /* -queries */
+  queries_option = gt_option_new_uword("queries", "number of range queries "
+                                       "for random windows in the loaded "
+                                       "features", &arguments->queries, 0);
+  gt_option_parser_add_option(op, queries_option);
+
+  /* -width */
+  option = gt_option_new_uword_min("width", "maximal width of the random "
+                                   "query windows", &arguments->width,
+                                   10000UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  /* -compact */
+  option = gt_option_new_bool("compact", "build the compact interval index "
+                              "before the range queries", &arguments->compact,
+                              false);
+  gt_option_parser_add_option(op, option);
+
+#ifdef HAVE_SQLITE
+  /* -sqlite */
+  sqlite_option = gt_option_new_filename("sqlite", "load the features into a "
+                                         "new SQLite feature index in the "
+                                         "given file (which is overwritten)",
+                                         arguments->sqlite);
+  gt_option_parser_add_option(op, sqlite_option);
+
+  /* -bulkload */
+  option = gt_option_new_bool("bulkload", "load the SQLite feature index in "
+                              "bulk-load mode", &arguments->bulkload, false);
+  gt_option_parser_add_option(op, option);
+  gt_option_imply(option, sqlite_option);
+
+  /* the range queries only work on the in-memory feature index */
+  gt_option_exclude(sqlite_option, queries_option);
+#endif
+
+  option = gt_option_new_verbose(&arguments->verbose);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_min_args(op, 1U);
+  return op;
+}
+
+static GtUword gt_featureindexbench_count_nodes(GtArray *features)
+{
+  GtFeatureNodeIterator *fni;
+  GtUword i, numofnodes = 0;
+
+  for (i = 0; i < gt_array_size(features); i++) {
+    fni = gt_feature_node_iterator_new(*(GtFeatureNode**)
+                                       gt_array_get(features, i));
+    while (gt_feature_node_iterator_next(fni))
+      numofnodes++;
+    gt_feature_node_iterator_delete(fni);
+  }
+  return numofnodes;
+}
+
+static void gt_featureindexbench_delete_features(GtArray *features)
+{
+  GtUword i;
+  for (i = 0; i < gt_array_size(features); i++)
+    gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(features, i));
+}
+
+static int gt_featureindexbench_query(GtFeatureIndex *feature_index,
+                                      GtStrArray *seqids, GtUword queries,
+                                      GtUword width, GtUword *numofhits,
+                                      GtError *err)
+{
+  GtArray *results;
+  GtRange seqid_range, query_range;
+  const char *seqid;
+  GtUword i;
+  int had_err = 0;
+
+  gt_error_check(err);
+  if (!gt_str_array_size(seqids))
+    return 0;
+  results = gt_array_new(sizeof (GtFeatureNode*));
+  for (i = 0; !had_err && i < queries; i++) {
+    seqid = gt_str_array_get(seqids,
+                             gt_rand_max(gt_str_array_size(seqids) - 1));
+    had_err = gt_feature_index_get_range_for_seqid(feature_index, &seqid_range,
+                                                   seqid, err);
+    if (!had_err) {
+      query_range.start = seqid_range.start +
+                          gt_rand_max(gt_range_length(&seqid_range) - 1);
+      query_range.end = query_range.start + gt_rand_max(width - 1);
+      gt_array_reset(results);
+      had_err = gt_feature_index_get_features_for_range(feature_index,
+                                                        results, seqid,
+                                                        &query_range, err);
+    }
+    if (!had_err)
+      *numofhits += gt_array_size(results);
+  }
+  gt_array_delete(results);
+  return had_err;
+}
+
+static int gt_featureindexbench_runner(int argc, const char **argv,
+                                       int parsed_args, void *tool_arguments,
+                                       GtError *err)
+{
+  GtFeatureindexbenchArguments *arguments = tool_arguments;
+  GtFeatureIndex *feature_index = NULL;
+  GtAnnoDBSchema *adb = NULL;
+  GtRDB *rdb = NULL;
+  GtStrArray *seqids = NULL;
+  GtArray *features;
+  GtTimer *timer = NULL, *query_timer = NULL;
+  GtUword i, numoffeatures = 0, numofnodes = 0, numofhits = 0;
+  struct rusage ru;
+  int arg, had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  if (arguments->verbose) {
+    timer = gt_timer_new();
+    gt_timer_start(timer);
+  }
+#ifdef HAVE_SQLITE
+  if (gt_str_length(arguments->sqlite)) {
+    if (gt_file_exists(gt_str_get(arguments->sqlite)))
+      gt_xunlink(gt_str_get(arguments->sqlite));
+    if (!(rdb = gt_rdb_sqlite_new(gt_str_get(arguments->sqlite), err)))
+      had_err = -1;
+    else {
+      adb = arguments->bulkload ? gt_anno_db_gfflike_new_bulk_load()
+                                : gt_anno_db_gfflike_new();
+      if (!(feature_index = gt_anno_db_schema_get_feature_index(adb, rdb,
+                                                                err))) {
+        had_err = -1;
+      }
+    }
+  }
+  else
+#endif
+    feature_index = gt_feature_index_memory_new();
+  for (arg = parsed_args; !had_err && arg < argc; arg++)
+    had_err = gt_feature_index_add_gff3file(feature_index, argv[arg], err);
+  if (!had_err && adb)
+    had_err = gt_feature_index_gfflike_finish_bulk_load(feature_index, err);
+  if (timer)
+    gt_timer_stop(timer);
+#ifdef HAVE_SQLITE
+  if (!had_err && adb) {
+    /* count the features as they are read back from the database, the loading
+       index still caches the inserted nodes */
+    gt_feature_index_delete(feature_index);
+    gt_anno_db_schema_delete(adb);
+    adb = gt_anno_db_gfflike_new();
+    if (!(feature_index = gt_anno_db_schema_get_feature_index(adb, rdb, err)))
+      had_err = -1;
+  }
+#endif
+  if (!had_err) {
+    seqids = gt_feature_index_get_seqids(feature_index, err);
+    if (!seqids)
+      had_err = -1;
+  }
+  if (!had_err) {
+    for (i = 0; !had_err && i < gt_str_array_size(seqids); i++) {
+      features = gt_feature_index_get_features_for_seqid(feature_index,
+                                                 gt_str_array_get(seqids, i),
+                                                 err);
+      if (!features)
+        had_err = -1;
+      else {
+        numoffeatures += gt_array_size(features);
+        numofnodes += gt_featureindexbench_count_nodes(features);
+        /* the SQLite index hands out newly built features */
+        if (adb)
+          gt_featureindexbench_delete_features(features);
+        gt_array_delete(features);
+      }
+    }
+  }
+  if (!had_err && arguments->queries) {
+    if (arguments->verbose) {
+      query_timer = gt_timer_new();
+      gt_timer_start(query_timer);
+    }
+    if (arguments->compact)
+      gt_feature_index_memory_compact(feature_index);
+    had_err = gt_featureindexbench_query(feature_index, seqids,
+                                         arguments->queries, arguments->width,
+                                         &numofhits, err);
+    if (query_timer)
+      gt_timer_stop(query_timer);
+  }
+  if (!had_err) {
+    printf("# number of sequence regions: "GT_WU"\n",
+           gt_str_array_size(seqids));
+    printf("# number of top-level features: "GT_WU"\n", numoffeatures);
+    printf("# number of feature nodes: "GT_WU"\n", numofnodes);
+    if (arguments->queries)
+      printf("# number of features in query windows: "GT_WU"\n", numofhits);
+    if (arguments->verbose) {
+      /* the space peak is only recorded with GT_MEM_BOOKKEEPING=on */
+      if (gt_ma_bookkeeping_enabled())
+        printf("# SPACE peak: "GT_WU" bytes\n", gt_ma_get_space_peak());
+      gt_xgetrusage(RUSAGE_SELF, &ru);
+      printf("# SPACE maximal resident set size: "GT_WD" kilobytes\n",
+             (GtWord) ru.ru_maxrss);
+      printf("# TIME loading features: ");
+      gt_timer_show_formatted(timer, GT_WD".%06ld seconds real, "
+                              GT_WD"s user, "GT_WD"s system\n", stdout);
+      if (query_timer) {
+        printf("# TIME range queries: ");
+        gt_timer_show_formatted(query_timer, GT_WD".%06ld seconds real, "
+                                GT_WD"s user, "GT_WD"s system\n", stdout);
+      }
+    }
+  }
+  gt_str_array_delete(seqids);
+  gt_feature_index_delete(feature_index);
+  gt_anno_db_schema_delete(adb);
+  gt_rdb_delete(rdb);
+  gt_timer_delete(query_timer);
+  gt_timer_delete(timer);
+  return had_err;
+}
+
+GtTool* gt_featureindexbench(void)
+{
+  return gt_tool_new(gt_featureindexbench_arguments_new,
+                     gt_featureindexbench_arguments_delete,
+                     gt_featureindexbench_option_parser_new,
+                     NULL,
+                     gt_featureindexbench_runner);
+}
@@ -30,8 +30,9 @@
 #include "extended/gtdatahelp.h"
 #include "extended/load_stream.h"
 #include "extended/merge_feature_stream_api.h"
+#include "extended/prefetch_stream.h"
 #include "extended/set_source_visitor_api.h"
-#include "extended/sort_stream_api.h"
+#include "extended/sort_stream.h"
 #include "extended/typecheck_info.h"
 #include "extended/visitor_stream_api.h"
 #include "tools/gt_gff3.h"
@@ -48,10 +49,12 @@ typedef struct {
        strict,
        tidy,
        show,
-       fixboundaries;
+       fixboundaries,
+       prefetch;
   GtWord offset;
   GtStr *offsetfile, *newsource;
-  GtUword width;
+  GtUword width,
+          sortmemlimit;
   GtTypecheckInfo *tci;
   GtOutputFileInfo *ofi;
   GtFile *outfp;
@@ -99,6 +102,15 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
                                    &arguments->sort, false);
   gt_option_parser_add_option(op, sort_option);
 
+  /* -sortmemlimit */
+  option = gt_option_new_uword("sortmemlimit", "limit the memory used for "
+                               "sorting to about the given number of "
+                               "megabytes, by sorting parts of the input in "
+                               "temporary files (0 means no limit)",
+                               &arguments->sortmemlimit, 0);
+  gt_option_imply(option, sort_option);
+  gt_option_parser_add_option(op, option);
+
   /* -strict */
   strict_option = gt_option_new_bool("strict", "be very strict during GFF3 "
                                      "parsing (stricter than the specification "
@@ -194,6 +206,12 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
                               true);
   gt_option_parser_add_option(op, option);
 
+  /* -prefetch */
+  option = gt_option_new_bool("prefetch", "parse and process the input in a "
+                              "separate thread while the output is written",
+                              &arguments->prefetch, false);
+  gt_option_parser_add_option(op, option);
+
   /* -v */
   option = gt_option_new_verbose(&arguments->verbose);
   gt_option_parser_add_option(op, option);
@@ -222,6 +240,7 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
                *merge_feature_stream = NULL,
                *add_introns_stream = NULL,
                *set_source_stream = NULL,
+               *prefetch_stream = NULL,
                *gff3_out_stream = NULL,
                *last_stream;
   int had_err = 0;
@@ -279,6 +298,8 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
   /* create sort stream (if necessary) */
   if (!had_err && arguments->sort) {
     sort_stream = gt_sort_stream_new(last_stream);
+    gt_sort_stream_set_memory_limit(sort_stream,
+                                    arguments->sortmemlimit << 20);
     last_stream = sort_stream;
   }
 
@@ -304,6 +325,13 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
     last_stream = set_source_stream;
   }
 
+  /* create prefetch stream (if necessary) */
+  if (!had_err && arguments->prefetch) {
+    prefetch_stream = gt_prefetch_stream_new(last_stream,
+                                             GT_PREFETCH_STREAM_DEFAULT_SIZE);
+    last_stream = prefetch_stream;
+  }
+
   /* create gff3 output stream */
   if (!had_err && arguments->show) {
     gff3_out_stream = gt_gff3_out_stream_new(last_stream, arguments->outfp);
@@ -320,6 +348,7 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
 
   /* free */
   gt_node_stream_delete(gff3_out_stream);
+  gt_node_stream_delete(prefetch_stream);
   gt_node_stream_delete(sort_stream);
   gt_node_stream_delete(load_stream);
   gt_node_stream_delete(merge_feature_stream);
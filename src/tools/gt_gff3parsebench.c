@@ -0,0 +1,240 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/array_api.h"
+#include "core/fa.h"
+#include "core/ma.h"
+#include "core/str_api.h"
+#include "core/thread_api.h"
+#include "core/timer_api.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+#include "extended/feature_node_api.h"
+#include "extended/feature_node_iterator_api.h"
+#include "extended/gff3_in_stream.h"
+#include "tools/gt_gff3parsebench.h"
+
+#define GT_GFF3PARSEBENCH_NUMOFSEQIDS 16UL
+#define GT_GFF3PARSEBENCH_NUMOFEXONS  4UL
+
+typedef struct {
+  GtUword runs,
+          synthetic;
+  bool retain,
+       verbose;
+} GtGff3parsebenchArguments;
+
+static void* gt_gff3parsebench_arguments_new(void)
+{
+  GtGff3parsebenchArguments *arguments = gt_calloc((size_t) 1,
+                                                   sizeof *arguments);
+  return arguments;
+}
+
+static void gt_gff3parsebench_arguments_delete(void *tool_arguments)
+{
+  GtGff3parsebenchArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_free(arguments);
+}
+
+static GtOptionParser* gt_gff3parsebench_option_parser_new(void
+                                                           *tool_arguments)
+{
+  GtGff3parsebenchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+
+  gt_assert(arguments);
+
+  /* init */
+  op = gt_option_parser_new("[option ...] [GFF3_file ...]",
+                            "Measure the throughput of parsing GFF3 files and "
+                            "freeing the parsed nodes.");
+
+  option = gt_option_new_bool("retain", "free the nodes after all files have "
+                              "been parsed (instead of freeing each node "
+                              "after it has been parsed)", &arguments->retain,
+                              false);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("runs", "number of times the files are "
+                                   "parsed", &arguments->runs, 1UL, 1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword("synthetic", "parse a synthetic GFF3 file "
+                               "with the given number of genes (written to a "
+                               "temporary file) instead of the given files",
+                               &arguments->synthetic, 0);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_verbose(&arguments->verbose);
+  gt_option_parser_add_option(op, option);
+
+  return op;
+}
+
+static int gt_gff3parsebench_arguments_check(int rest_argc,
+                                             void *tool_arguments,
+                                             GtError *err)
+{
+  GtGff3parsebenchArguments *arguments = tool_arguments;
+  gt_error_check(err);
+  gt_assert(arguments);
+  if (rest_argc == 0 && arguments->synthetic == 0) {
+    gt_error_set(err, "missing GFF3 file (or option -synthetic)");
+    return -1;
+  }
+  if (rest_argc > 0 && arguments->synthetic > 0) {
+    gt_error_set(err, "option -synthetic excludes GFF3 files");
+    return -1;
+  }
+  return 0;
+}
+
+/* Write <numofgenes> genes (each with one mRNA, exons and CDS) to <fp>. The
+   genes are distributed over a few sequences and each gene is followed by a
+   terminator, as in the output of gt gff3 -sort. */
+static void gt_gff3parsebench_write_synthetic(FILE *fp, GtUword numofgenes)
+{
+  GtUword seqnum, gene, exon, genespersequence, start, end;
+
+  genespersequence = (numofgenes + GT_GFF3PARSEBENCH_NUMOFSEQIDS - 1) /
+                     GT_GFF3PARSEBENCH_NUMOFSEQIDS;
+  fprintf(fp, "##gff-version 3\n");
+  for (seqnum = 0; seqnum < GT_GFF3PARSEBENCH_NUMOFSEQIDS; seqnum++) {
+    fprintf(fp, "##sequence-region seq"GT_WU" 1 "GT_WU"\n", seqnum,
+            (genespersequence + 1) * 10000);
+  }
+  for (gene = 0; gene < numofgenes; gene++) {
+    seqnum = gene / genespersequence;
+    start = (gene % genespersequence + 1) * 10000;
+    end = start + 2000 * GT_GFF3PARSEBENCH_NUMOFEXONS - 1000;
+    fprintf(fp, "seq"GT_WU"\tbench\tgene\t"GT_WU"\t"GT_WU"\t.\t+\t.\t"
+            "ID=gene"GT_WU";Name=G"GT_WU"\n", seqnum, start, end, gene, gene);
+    fprintf(fp, "seq"GT_WU"\tbench\tmRNA\t"GT_WU"\t"GT_WU"\t.\t+\t.\t"
+            "ID=mRNA"GT_WU";Parent=gene"GT_WU"\n", seqnum, start, end, gene,
+            gene);
+    for (exon = 0; exon < GT_GFF3PARSEBENCH_NUMOFEXONS; exon++) {
+      fprintf(fp, "seq"GT_WU"\tbench\texon\t"GT_WU"\t"GT_WU"\t0.9\t+\t.\t"
+              "Parent=mRNA"GT_WU"\n", seqnum, start + 2000 * exon,
+              start + 2000 * exon + 999, gene);
+    }
+    for (exon = 0; exon < GT_GFF3PARSEBENCH_NUMOFEXONS; exon++) {
+      /* the length of each CDS is a multiple of three */
+      fprintf(fp, "seq"GT_WU"\tbench\tCDS\t"GT_WU"\t"GT_WU"\t.\t+\t0\t"
+              "ID=cds"GT_WU";Parent=mRNA"GT_WU"\n", seqnum,
+              start + 2000 * exon, start + 2000 * exon + 998, gene, gene);
+    }
+    fprintf(fp, "###\n");
+  }
+}
+
+static GtUword gt_gff3parsebench_count_feature_nodes(GtGenomeNode *gn)
+{
+  GtFeatureNode *fn;
+  GtFeatureNodeIterator *fni;
+  GtUword numofnodes = 0;
+
+  if ((fn = gt_feature_node_try_cast(gn)) != NULL) {
+    fni = gt_feature_node_iterator_new(fn);
+    while (gt_feature_node_iterator_next(fni))
+      numofnodes++;
+    gt_feature_node_iterator_delete(fni);
+  }
+  return numofnodes;
+}
+
+static int gt_gff3parsebench_runner(int argc, const char **argv,
+                                    int parsed_args, void *tool_arguments,
+                                    GtError *err)
+{
+  GtGff3parsebenchArguments *arguments = tool_arguments;
+  GtNodeStream *gff3_in_stream;
+  GtGenomeNode *gn;
+  GtArray *nodes = NULL;
+  GtTimer *timer = NULL;
+  GtStr *synthetic_file = NULL;
+  const char *synthetic_filename;
+  GtUword i, run, numofnodes = 0, numoffeaturenodes = 0;
+  int had_err = 0, numoffiles = argc - parsed_args;
+  const char **files = argv + parsed_args;
+
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  if (arguments->synthetic > 0) {
+    FILE *fp;
+    synthetic_file = gt_str_new();
+    fp = gt_xtmpfp(synthetic_file);
+    gt_gff3parsebench_write_synthetic(fp, arguments->synthetic);
+    gt_fa_xfclose(fp);
+    synthetic_filename = gt_str_get(synthetic_file);
+    files = &synthetic_filename;
+    numoffiles = 1;
+  }
+
+  if (arguments->verbose) {
+    timer = gt_timer_new();
+    gt_timer_start(timer);
+  }
+  if (arguments->retain)
+    nodes = gt_array_new(sizeof (GtGenomeNode*));
+  for (run = 0; !had_err && run < arguments->runs; run++) {
+    gff3_in_stream = gt_gff3_in_stream_new_unsorted(numoffiles, files);
+    numofnodes = numoffeaturenodes = 0;
+    while (!(had_err = gt_node_stream_next(gff3_in_stream, &gn, err)) && gn) {
+      numofnodes++;
+      numoffeaturenodes += gt_gff3parsebench_count_feature_nodes(gn);
+      if (nodes != NULL)
+        gt_array_add(nodes, gn);
+      else
+        gt_genome_node_delete(gn);
+    }
+    /* the nodes outlive the stream */
+    gt_node_stream_delete(gff3_in_stream);
+    if (nodes != NULL) {
+      for (i = 0; i < gt_array_size(nodes); i++)
+        gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(nodes, i));
+      gt_array_reset(nodes);
+    }
+  }
+  if (!had_err) {
+    printf("# number of nodes: "GT_WU"\n", numofnodes);
+    printf("# number of feature nodes: "GT_WU"\n", numoffeaturenodes);
+    if (timer != NULL) {
+      printf("# TIME %u job(s), "GT_WU" run(s): ", gt_jobs, arguments->runs);
+      gt_timer_show_formatted(timer, GT_WD".%06ld seconds real, "
+                              GT_WD"s user, "GT_WD"s system\n", stdout);
+    }
+  }
+  if (synthetic_file != NULL) {
+    gt_xremove(gt_str_get(synthetic_file));
+    gt_str_delete(synthetic_file);
+  }
+  gt_array_delete(nodes);
+  gt_timer_delete(timer);
+  return had_err;
+}
+
+GtTool* gt_gff3parsebench(void)
+{
+  return gt_tool_new(gt_gff3parsebench_arguments_new,
+                     gt_gff3parsebench_arguments_delete,
+                     gt_gff3parsebench_option_parser_new,
+                     gt_gff3parsebench_arguments_check,
+                     gt_gff3parsebench_runner);
+}
@@ -0,0 +1,222 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/atomic.h"
+#include "core/hashtable.h"
+#include "core/ma.h"
+#include "core/multithread_api.h"
+#include "core/str_api.h"
+#include "core/thread_api.h"
+#include "core/timer_api.h"
+#include "core/unused_api.h"
+#include "tools/gt_hashtablebench.h"
+
+/* scatters consecutive numbers over the key space (bijective, because the
+   factor is odd) */
+#define GT_HASHTABLEBENCH_KEY(I) ((GtUword) (I) * (GtUword) 2654435761UL)
+
+typedef struct {
+  GtStr *mode;
+  GtUword keys;
+  unsigned int startsize;
+  bool verbose;
+} GtHashtablebenchArguments;
+
+typedef struct {
+  GtHashtable *ht;
+  GtUword keys,
+          next_thread,
+          next_lookup_thread,
+          inserted,
+          found;
+} GtHashtablebenchData;
+
+static void* gt_hashtablebench_arguments_new(void)
+{
+  GtHashtablebenchArguments *arguments = gt_calloc((size_t) 1,
+                                                   sizeof *arguments);
+  arguments->mode = gt_str_new();
+  return arguments;
+}
+
+static void gt_hashtablebench_arguments_delete(void *tool_arguments)
+{
+  GtHashtablebenchArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_str_delete(arguments->mode);
+  gt_free(arguments);
+}
+
+static GtOptionParser* gt_hashtablebench_option_parser_new(void
+                                                           *tool_arguments)
+{
+  GtHashtablebenchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+  static const char *modes[] = {"concurrent", "locked", NULL};
+
+  gt_assert(arguments);
+
+  /* init */
+  op = gt_option_parser_new("[option ...]",
+                            "Measure the throughput of concurrent insertions "
+                            "into and lookups in a hashtable of GtUword keys "
+                            "in gt_jobs many threads.");
+
+  option = gt_option_new_choice("mode", "use a hashtable in concurrent mode "
+                                "or a hashtable protected by its lock\n"
+                                "choose from concurrent|locked",
+                                arguments->mode, modes[0], modes);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("keys", "number of keys inserted and "
+                                   "looked up per thread, half of them are "
+                                   "shared with the next thread",
+                                   &arguments->keys, 1000000UL, 2UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uint_max("startsize", "log2 of the initial table "
+                                  "size", &arguments->startsize, 4U, 30U);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_verbose(&arguments->verbose);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_max_args(op, 0U);
+  return op;
+}
+
+/* thread t inserts the keys t * keys/2, ..., t * keys/2 + keys - 1 */
+static void* gt_hashtablebench_insert_thread(void *data)
+{
+  GtHashtablebenchData *bench = data;
+  GtUword i, key, start, inserted = 0;
+
+  start = (gt_atomic_uword_add_fetch(&bench->next_thread, 1) - 1)
+          * (bench->keys / 2);
+  for (i = start; i < start + bench->keys; i++) {
+    key = GT_HASHTABLEBENCH_KEY(i);
+    inserted += gt_hashtable_add(bench->ht, &key);
+  }
+  (void) gt_atomic_uword_add_fetch(&bench->inserted, inserted);
+  return NULL;
+}
+
+/* looks up the keys of the next thread */
+static void* gt_hashtablebench_lookup_thread(void *data)
+{
+  GtHashtablebenchData *bench = data;
+  GtUword i, key, start, found = 0;
+
+  start = gt_atomic_uword_add_fetch(&bench->next_lookup_thread, 1)
+          % gt_jobs * (bench->keys / 2);
+  for (i = start; i < start + bench->keys; i++) {
+    key = GT_HASHTABLEBENCH_KEY(i);
+    if (gt_hashtable_get(bench->ht, &key))
+      found++;
+  }
+  (void) gt_atomic_uword_add_fetch(&bench->found, found);
+  return NULL;
+}
+
+static void gt_hashtablebench_show_time(GtTimer *timer, const char *phase,
+                                        const char *mode)
+{
+  printf("# TIME %s %s: ", phase, mode);
+  gt_timer_show_formatted(timer, GT_WD".%06ld seconds real, "
+                          GT_WD"s user, "GT_WD"s system\n", stdout);
+}
+
+static int gt_hashtablebench_runner(GT_UNUSED int argc,
+                                    GT_UNUSED const char **argv,
+                                    GT_UNUSED int parsed_args,
+                                    void *tool_arguments, GtError *err)
+{
+  GtHashtablebenchArguments *arguments = tool_arguments;
+  static const HashElemInfo hash_ul = {
+    gt_ht_ul_elem_hash, { NULL }, sizeof (GtUword), gt_ht_ul_elem_cmp, NULL,
+    NULL
+  };
+  GtHashtablebenchData bench;
+  GtTimer *timer = NULL;
+  GtUword distinct;
+  const char *mode;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  mode = gt_str_get(arguments->mode);
+  if (strcmp(mode, "concurrent") == 0) {
+    bench.ht = gt_hashtable_new_concurrent_with_start_size(hash_ul,
+                                                           arguments->
+                                                           startsize);
+  }
+  else {
+    bench.ht = gt_hashtable_new_with_start_size(hash_ul, arguments->startsize);
+  }
+  bench.keys = arguments->keys;
+  bench.next_thread = bench.next_lookup_thread = 0;
+  bench.inserted = bench.found = 0;
+  distinct = (gt_jobs - 1) * (bench.keys / 2) + bench.keys;
+
+  if (arguments->verbose) {
+    timer = gt_timer_new();
+    gt_timer_start(timer);
+  }
+  had_err = gt_multithread(gt_hashtablebench_insert_thread, &bench, err);
+  if (!had_err && timer != NULL)
+    gt_hashtablebench_show_time(timer, "insert", mode);
+  if (!had_err && (bench.inserted != distinct ||
+                   gt_hashtable_fill(bench.ht) != distinct)) {
+    gt_error_set(err, "inserted "GT_WU" keys, hashtable contains "GT_WU
+                 " keys, expected "GT_WU, bench.inserted,
+                 (GtUword) gt_hashtable_fill(bench.ht), distinct);
+    had_err = -1;
+  }
+  if (!had_err) {
+    if (timer != NULL)
+      gt_timer_start(timer);
+    had_err = gt_multithread(gt_hashtablebench_lookup_thread, &bench, err);
+    if (!had_err && timer != NULL)
+      gt_hashtablebench_show_time(timer, "lookup", mode);
+  }
+  if (!had_err && bench.found != bench.keys * gt_jobs) {
+    gt_error_set(err, "found "GT_WU" of "GT_WU" keys", bench.found,
+                 bench.keys * gt_jobs);
+    had_err = -1;
+  }
+  if (!had_err) {
+    printf("# threads: %u\n", gt_jobs);
+    printf("# insertions: "GT_WU"\n", bench.keys * gt_jobs);
+    printf("# distinct keys: "GT_WU"\n", distinct);
+    printf("# lookups: "GT_WU"\n", bench.keys * gt_jobs);
+  }
+
+  gt_hashtable_delete(bench.ht);
+  gt_timer_delete(timer);
+  return had_err;
+}
+
+GtTool* gt_hashtablebench(void)
+{
+  return gt_tool_new(gt_hashtablebench_arguments_new,
+                     gt_hashtablebench_arguments_delete,
+                     gt_hashtablebench_option_parser_new,
+                     NULL,
+                     gt_hashtablebench_runner);
+}
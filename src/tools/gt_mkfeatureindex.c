@@ -48,7 +48,8 @@ typedef struct {
         *input;
   int port;
   bool verbose,
-       force;
+       force,
+       bulkload;
 } GtMkfeatureindexArguments;
 
 static void* gt_mkfeatureindex_arguments_new(void)
@@ -121,6 +122,12 @@ static GtOptionParser* gt_mkfeatureindex_option_parser_new(void *tool_arguments)
                                         backends);
   gt_option_parser_add_option(op, backend_option);
 
+  /* -bulkload */
+  option = gt_option_new_bool("bulkload", "insert the features in large "
+                              "transactions and create the database indexes "
+                              "after loading", &arguments->bulkload, true);
+  gt_option_parser_add_option(op, option);
+
   /* -input */
   option = gt_option_new_choice("input", "input data format\n"
                                        "choose from gff|bed|gtf",
@@ -229,7 +236,10 @@ static int gt_mkfeatureindex_runner(int argc,
   }
 #endif
 
-  adb = gt_anno_db_gfflike_new();
+  if (arguments->bulkload)
+    adb = gt_anno_db_gfflike_new_bulk_load();
+  else
+    adb = gt_anno_db_gfflike_new();
   if (!had_err && !adb)
     had_err = -1;
 
@@ -264,6 +274,8 @@ static int gt_mkfeatureindex_runner(int argc,
     feature_stream = gt_feature_stream_new(in_stream, fis);
     had_err = gt_node_stream_pull(feature_stream, err);
   }
+  if (!had_err)
+    had_err = gt_feature_index_gfflike_finish_bulk_load(fis, err);
   gt_node_stream_delete(feature_stream);
   gt_node_stream_delete(in_stream);
   gt_feature_index_delete(fis);
@@ -0,0 +1,236 @@
+/*
+  Copyright (c) 2014 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/ma.h"
+#include "core/multithread_api.h"
+#include "core/str_api.h"
+#include "core/thread_api.h"
+#include "core/timer_api.h"
+#include "core/unused_api.h"
+#include "extended/region_node_api.h"
+#include "tools/gt_refcountbench.h"
+
+typedef struct {
+  GtStr *type,
+        *mode;
+  GtUword pairs,
+          objects;
+  bool verbose;
+} GtRefcountbenchArguments;
+
+typedef struct {
+  GtGenomeNode **nodes;
+  GtStr **strs;
+  GtRWLock **locks;
+  unsigned int *counts;
+  GtUword pairs,
+          objects;
+} GtRefcountbenchData;
+
+static void* gt_refcountbench_arguments_new(void)
+{
+  GtRefcountbenchArguments *arguments = gt_calloc((size_t) 1,
+                                                  sizeof *arguments);
+  arguments->type = gt_str_new();
+  arguments->mode = gt_str_new();
+  return arguments;
+}
+
+static void gt_refcountbench_arguments_delete(void *tool_arguments)
+{
+  GtRefcountbenchArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_str_delete(arguments->type);
+  gt_str_delete(arguments->mode);
+  gt_free(arguments);
+}
+
+static GtOptionParser* gt_refcountbench_option_parser_new(void *tool_arguments)
+{
+  GtRefcountbenchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+  static const char *types[] = {"node", "str", NULL},
+                    *modes[] = {"atomic", "rwlock", NULL};
+
+  gt_assert(arguments);
+
+  /* init */
+  op = gt_option_parser_new("[option ...]",
+                            "Measure the throughput of reference counting "
+                            "in gt_jobs many threads.");
+
+  option = gt_option_new_choice("type", "type of the referenced objects\n"
+                                "choose from node|str",
+                                arguments->type, types[0], types);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_choice("mode", "use the atomic reference counting "
+                                "of the objects or protect a counter by a "
+                                "read/write lock per object (as genome nodes "
+                                "did before)\n"
+                                "choose from atomic|rwlock",
+                                arguments->mode, modes[0], modes);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("pairs", "number of ref/unref pairs per "
+                                   "thread", &arguments->pairs, 1000000UL,
+                                   1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("objects", "number of objects shared by "
+                                   "the threads", &arguments->objects, 1UL,
+                                   1UL);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_verbose(&arguments->verbose);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_max_args(op, 0U);
+  return op;
+}
+
+static void* gt_refcountbench_node_thread(void *data)
+{
+  GtRefcountbenchData *bench = data;
+  GtGenomeNode *gn;
+  GtUword i;
+
+  for (i = 0; i < bench->pairs; i++) {
+    gn = gt_genome_node_ref(bench->nodes[i % bench->objects]);
+    gt_genome_node_delete(gn);
+  }
+  return NULL;
+}
+
+static void* gt_refcountbench_str_thread(void *data)
+{
+  GtRefcountbenchData *bench = data;
+  GtStr *s;
+  GtUword i;
+
+  for (i = 0; i < bench->pairs; i++) {
+    s = gt_str_ref(bench->strs[i % bench->objects]);
+    gt_str_delete(s);
+  }
+  return NULL;
+}
+
+static void* gt_refcountbench_rwlock_thread(void *data)
+{
+  GtRefcountbenchData *bench = data;
+  GtUword i, j;
+
+  for (i = 0; i < bench->pairs; i++) {
+    j = i % bench->objects;
+    gt_rwlock_wrlock(bench->locks[j]);
+    bench->counts[j]++;
+    gt_rwlock_unlock(bench->locks[j]);
+    gt_rwlock_wrlock(bench->locks[j]);
+    bench->counts[j]--;
+    gt_rwlock_unlock(bench->locks[j]);
+  }
+  return NULL;
+}
+
+static int gt_refcountbench_runner(GT_UNUSED int argc,
+                                   GT_UNUSED const char **argv,
+                                   GT_UNUSED int parsed_args,
+                                   void *tool_arguments, GtError *err)
+{
+  GtRefcountbenchArguments *arguments = tool_arguments;
+  GtRefcountbenchData bench;
+  GtThreadFunc function;
+  GtStr *seqid;
+  GtTimer *timer = NULL;
+  GtUword i;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  bench.pairs = arguments->pairs;
+  bench.objects = arguments->objects;
+  bench.nodes = NULL;
+  bench.strs = NULL;
+  bench.locks = NULL;
+  bench.counts = NULL;
+  if (strcmp(gt_str_get(arguments->mode), "rwlock") == 0) {
+    bench.locks = gt_malloc(sizeof *bench.locks * bench.objects);
+    bench.counts = gt_calloc((size_t) bench.objects, sizeof *bench.counts);
+    for (i = 0; i < bench.objects; i++)
+      bench.locks[i] = gt_rwlock_new();
+    function = gt_refcountbench_rwlock_thread;
+  }
+  else if (strcmp(gt_str_get(arguments->type), "node") == 0) {
+    seqid = gt_str_new_cstr("seqid");
+    bench.nodes = gt_malloc(sizeof *bench.nodes * bench.objects);
+    for (i = 0; i < bench.objects; i++)
+      bench.nodes[i] = gt_region_node_new(seqid, 1UL, 1000UL);
+    gt_str_delete(seqid);
+    function = gt_refcountbench_node_thread;
+  }
+  else {
+    bench.strs = gt_malloc(sizeof *bench.strs * bench.objects);
+    for (i = 0; i < bench.objects; i++)
+      bench.strs[i] = gt_str_new_cstr("refcountbench");
+    function = gt_refcountbench_str_thread;
+  }
+
+  if (arguments->verbose) {
+    timer = gt_timer_new();
+    gt_timer_start(timer);
+  }
+  had_err = gt_multithread(function, &bench, err);
+  if (!had_err) {
+    printf("# threads: %u\n", gt_jobs);
+    printf("# ref/unref pairs: "GT_WU"\n", bench.pairs * gt_jobs);
+    if (timer != NULL) {
+      printf("# TIME %s %s: ", gt_str_get(arguments->type),
+             gt_str_get(arguments->mode));
+      gt_timer_show_formatted(timer, GT_WD".%06ld seconds real, "
+                              GT_WD"s user, "GT_WD"s system\n", stdout);
+    }
+  }
+
+  for (i = 0; i < bench.objects; i++) {
+    if (bench.locks != NULL) {
+      gt_assert(bench.counts[i] == 0);
+      gt_rwlock_delete(bench.locks[i]);
+    }
+    /* all references have been released, so these free the objects */
+    if (bench.nodes != NULL)
+      gt_genome_node_delete(bench.nodes[i]);
+    if (bench.strs != NULL)
+      gt_str_delete(bench.strs[i]);
+  }
+  gt_free(bench.locks);
+  gt_free(bench.counts);
+  gt_free(bench.nodes);
+  gt_free(bench.strs);
+  gt_timer_delete(timer);
+  return had_err;
+}
+
+GtTool* gt_refcountbench(void)
+{
+  return gt_tool_new(gt_refcountbench_arguments_new,
+                     gt_refcountbench_arguments_delete,
+                     gt_refcountbench_option_parser_new,
+                     NULL,
+                     gt_refcountbench_runner);
+}
@@ -20,6 +20,8 @@
 #include "core/str_api.h"
 #include "core/logger.h"
 #include "core/ma_api.h"
+#include "core/multithread_api.h"
+#include "core/thread_api.h"
 #include "core/unused_api.h"
 #include "core/option_api.h"
 #include "core/tool_api.h"
@@ -92,14 +94,38 @@ typedef struct
   GtUword query_totallength;
 } GtXdropmatchinfo;
 
-static int gt_simplexdropselfmatchoutput(void *info,
-                                         const GtEncseq *encseq,
-                                         GtUword len,
-                                         GtUword pos1,
-                                         GtUword pos2,
-                                         GtError *err)
+static void gt_xdropmatchinfo_init(GtXdropmatchinfo *xdropmatchinfo)
+{
+  xdropmatchinfo->querymatchspaceptr = gt_querymatch_new();
+  xdropmatchinfo->useq = gt_seqabstract_new_empty();
+  xdropmatchinfo->vseq = gt_seqabstract_new_empty();
+  xdropmatchinfo->arbitscores.mat = 2;
+  xdropmatchinfo->arbitscores.mis = -2;
+  xdropmatchinfo->arbitscores.ins = -3;
+  xdropmatchinfo->arbitscores.del = -3;
+  xdropmatchinfo->frontresource = gt_frontresource_new(100UL);
+  xdropmatchinfo->res = gt_xdrop_resources_new(&xdropmatchinfo->arbitscores);
+  xdropmatchinfo->belowscore = 5L;
+}
+
+static void gt_xdropmatchinfo_delete(GtXdropmatchinfo *xdropmatchinfo)
+{
+  gt_querymatch_delete(xdropmatchinfo->querymatchspaceptr);
+  gt_seqabstract_delete(xdropmatchinfo->useq);
+  gt_seqabstract_delete(xdropmatchinfo->vseq);
+  gt_xdrop_resources_delete(xdropmatchinfo->res);
+  gt_frontresource_delete(xdropmatchinfo->frontresource);
+}
+
+/* extends the exact self match of length <len> at <pos1> and <pos2> to both
+   sides and stores the result in <querymatch> */
+static void gt_xdropselfmatchextend(GtXdropmatchinfo *xdropmatchinfo,
+                                    GtQuerymatch *querymatch,
+                                    const GtEncseq *encseq,
+                                    GtUword len,
+                                    GtUword pos1,
+                                    GtUword pos2)
 {
-  GtXdropmatchinfo *xdropmatchinfo = (GtXdropmatchinfo *) info;
   GtXdropscore score;
   GtUword dbseqnum, dbseqstartpos, dbseqlength, dbstart, dblen,
                 querystart, queryseqnum, querylen, queryseqlength,
@@ -193,7 +219,7 @@ static int gt_simplexdropselfmatchoutput(void *info,
                                encseq,
                                querylen,
                                querystart);
-  gt_querymatch_fill(xdropmatchinfo->querymatchspaceptr,
+  gt_querymatch_fill(querymatch,
                      dblen,
                      dbstart,
                      GT_READMODE_FORWARD,
@@ -205,11 +231,177 @@ static int gt_simplexdropselfmatchoutput(void *info,
                      (uint64_t) queryseqnum,
                      querylen,
                      querystart - queryseqstartpos);
-  return gt_querymatch_output(info, encseq, xdropmatchinfo->querymatchspaceptr,
-                              NULL, gt_encseq_seqlength(encseq, queryseqnum),
+}
+
+static int gt_simplexdropselfmatchoutput(void *info,
+                                         const GtEncseq *encseq,
+                                         GtUword len,
+                                         GtUword pos1,
+                                         GtUword pos2,
+                                         GtError *err)
+{
+  GtXdropmatchinfo *xdropmatchinfo = (GtXdropmatchinfo *) info;
+  GtQuerymatch *querymatch = xdropmatchinfo->querymatchspaceptr;
+
+  gt_xdropselfmatchextend(xdropmatchinfo,querymatch,encseq,len,pos1,pos2);
+  return gt_querymatch_output(info, encseq, querymatch, NULL,
+                              gt_encseq_seqlength(encseq,
+                                      (GtUword)
+                                      gt_querymatch_queryseqnum(querymatch)),
                               err);
 }
 
+/* number of seeds collected before they are extended in parallel */
+#define GT_REPFIND_SEEDBATCHSIZE 4096UL
+
+typedef struct
+{
+  GtUword len, pos1, pos2;
+  GtQuerymatch *querymatch;
+} GtRepfindSeed;
+
+typedef struct
+{
+  const GtEncseq *encseq;
+  GtRepfindSeed *seeds;
+  GtXdropmatchinfo *xdropmatchinfo; /* one for each thread */
+  GtUword numofseeds,
+          nextseed,
+          nextxdropmatchinfo;
+  GtMutex *mutex;
+} GtRepfindSeedbatch;
+
+static GtRepfindSeedbatch *gt_repfind_seedbatch_new(void)
+{
+  GtUword idx;
+  GtRepfindSeedbatch *seedbatch = gt_malloc(sizeof (*seedbatch));
+
+  seedbatch->encseq = NULL;
+  seedbatch->seeds = gt_malloc(sizeof (*seedbatch->seeds) *
+                               GT_REPFIND_SEEDBATCHSIZE);
+  for (idx = 0; idx < GT_REPFIND_SEEDBATCHSIZE; idx++)
+  {
+    seedbatch->seeds[idx].querymatch = gt_querymatch_new();
+  }
+  seedbatch->xdropmatchinfo = gt_malloc(sizeof (*seedbatch->xdropmatchinfo) *
+                                        gt_jobs);
+  for (idx = 0; idx < (GtUword) gt_jobs; idx++)
+  {
+    gt_xdropmatchinfo_init(seedbatch->xdropmatchinfo + idx);
+  }
+  seedbatch->numofseeds = 0;
+  seedbatch->mutex = gt_mutex_new();
+  return seedbatch;
+}
+
+static void gt_repfind_seedbatch_delete(GtRepfindSeedbatch *seedbatch)
+{
+  GtUword idx;
+
+  if (seedbatch == NULL)
+  {
+    return;
+  }
+  for (idx = 0; idx < GT_REPFIND_SEEDBATCHSIZE; idx++)
+  {
+    gt_querymatch_delete(seedbatch->seeds[idx].querymatch);
+  }
+  gt_free(seedbatch->seeds);
+  for (idx = 0; idx < (GtUword) gt_jobs; idx++)
+  {
+    gt_xdropmatchinfo_delete(seedbatch->xdropmatchinfo + idx);
+  }
+  gt_free(seedbatch->xdropmatchinfo);
+  gt_mutex_delete(seedbatch->mutex);
+  gt_free(seedbatch);
+}
+
+/* each thread takes its own extension resources and then extends the seeds
+   of the batch one after the other */
+static void *gt_repfind_extendseeds_thread(void *data)
+{
+  GtRepfindSeedbatch *seedbatch = (GtRepfindSeedbatch *) data;
+  GtXdropmatchinfo *xdropmatchinfo;
+
+  gt_mutex_lock(seedbatch->mutex);
+  gt_assert(seedbatch->nextxdropmatchinfo < (GtUword) gt_jobs);
+  xdropmatchinfo = seedbatch->xdropmatchinfo +
+                   seedbatch->nextxdropmatchinfo++;
+  gt_mutex_unlock(seedbatch->mutex);
+  while (true)
+  {
+    GtRepfindSeed *seed;
+
+    gt_mutex_lock(seedbatch->mutex);
+    if (seedbatch->nextseed == seedbatch->numofseeds)
+    {
+      gt_mutex_unlock(seedbatch->mutex);
+      break;
+    }
+    seed = seedbatch->seeds + seedbatch->nextseed++;
+    gt_mutex_unlock(seedbatch->mutex);
+    gt_xdropselfmatchextend(xdropmatchinfo,seed->querymatch,seedbatch->encseq,
+                            seed->len,seed->pos1,seed->pos2);
+  }
+  return NULL;
+}
+
+/* extends the seeds of the batch in parallel and outputs the extended
+   matches in the order of the seeds */
+static int gt_repfind_extendseeds(GtRepfindSeedbatch *seedbatch,GtError *err)
+{
+  GtUword idx;
+
+  if (seedbatch->numofseeds == 0)
+  {
+    return 0;
+  }
+  seedbatch->nextseed = 0;
+  seedbatch->nextxdropmatchinfo = 0;
+  if (gt_multithread(gt_repfind_extendseeds_thread, seedbatch, err) != 0)
+  {
+    return -1;
+  }
+  for (idx = 0; idx < seedbatch->numofseeds; idx++)
+  {
+    const GtQuerymatch *querymatch = seedbatch->seeds[idx].querymatch;
+
+    if (gt_querymatch_output(NULL, seedbatch->encseq, querymatch, NULL,
+                             gt_encseq_seqlength(seedbatch->encseq,
+                                   (GtUword)
+                                   gt_querymatch_queryseqnum(querymatch)),
+                             err) != 0)
+    {
+      return -1;
+    }
+  }
+  seedbatch->numofseeds = 0;
+  return 0;
+}
+
+static int gt_batchxdropselfmatchoutput(void *info,
+                                        const GtEncseq *encseq,
+                                        GtUword len,
+                                        GtUword pos1,
+                                        GtUword pos2,
+                                        GtError *err)
+{
+  GtRepfindSeedbatch *seedbatch = (GtRepfindSeedbatch *) info;
+  GtRepfindSeed *seed;
+
+  gt_assert(seedbatch->encseq == NULL || seedbatch->encseq == encseq);
+  seedbatch->encseq = encseq;
+  seed = seedbatch->seeds + seedbatch->numofseeds++;
+  seed->len = len;
+  seed->pos1 = pos1;
+  seed->pos2 = pos2;
+  if (seedbatch->numofseeds == GT_REPFIND_SEEDBATCHSIZE)
+  {
+    return gt_repfind_extendseeds(seedbatch,err);
+  }
+  return 0;
+}
+
 static int gt_processxdropquerymatches(void *info,
                                        const GtEncseq *encseq,
                                        const GtQuerymatch *querymatch,
@@ -523,18 +715,10 @@ static int gt_repfind_runner(GT_UNUSED int argc,
   GtLogger *logger = NULL;
   GtQuerymatch *querymatchspaceptr = gt_querymatch_new();
   GtXdropmatchinfo xdropmatchinfo;
+  GtRepfindSeedbatch *seedbatch = NULL;
 
   gt_error_check(err);
-  xdropmatchinfo.querymatchspaceptr = querymatchspaceptr;
-  xdropmatchinfo.useq = gt_seqabstract_new_empty();
-  xdropmatchinfo.vseq = gt_seqabstract_new_empty();
-  xdropmatchinfo.arbitscores.mat = 2;
-  xdropmatchinfo.arbitscores.mis = -2;
-  xdropmatchinfo.arbitscores.ins = -3;
-  xdropmatchinfo.arbitscores.del = -3;
-  xdropmatchinfo.frontresource = gt_frontresource_new(100UL);
-  xdropmatchinfo.res = gt_xdrop_resources_new(&xdropmatchinfo.arbitscores);
-  xdropmatchinfo.belowscore = 5L;
+  gt_xdropmatchinfo_init(&xdropmatchinfo);
   logger = gt_logger_new(arguments->beverbose, GT_LOGGER_DEFLT_PREFIX, stdout);
   if (parsed_args < argc)
   {
@@ -549,22 +733,49 @@ static int gt_repfind_runner(GT_UNUSED int argc,
       {
         if (arguments->forward)
         {
+          Processmaxpairs processmaxpairs;
+          void *processmaxpairsinfo;
+
+          if (arguments->searchspm)
+          {
+            processmaxpairs = gt_simplesuffixprefixmatchoutput;
+            processmaxpairsinfo = NULL;
+          } else
+          {
+            if (arguments->extendseed)
+            {
+              /* with several jobs, the seeds are extended in batches */
+              if (gt_jobs > 1U)
+              {
+                seedbatch = gt_repfind_seedbatch_new();
+                processmaxpairs = gt_batchxdropselfmatchoutput;
+                processmaxpairsinfo = (void *) seedbatch;
+              } else
+              {
+                processmaxpairs = gt_simplexdropselfmatchoutput;
+                processmaxpairsinfo = (void *) &xdropmatchinfo;
+              }
+            } else
+            {
+              processmaxpairs = gt_simpleexactselfmatchoutput;
+              processmaxpairsinfo = (void *) querymatchspaceptr;
+            }
+          }
           if (callenummaxpairs(gt_str_get(arguments->indexname),
                                arguments->userdefinedleastlength,
                                arguments->scanfile,
-                               arguments->searchspm
-                                 ? gt_simplesuffixprefixmatchoutput
-                                 : (arguments->extendseed
-                                     ? gt_simplexdropselfmatchoutput
-                                     : gt_simpleexactselfmatchoutput),
-                               arguments->extendseed
-                                 ? (void *) &xdropmatchinfo
-                                 : (void *) querymatchspaceptr,
+                               processmaxpairs,
+                               processmaxpairsinfo,
                                logger,
                                err) != 0)
           {
             haserr = true;
           }
+          if (!haserr && seedbatch != NULL &&
+              gt_repfind_extendseeds(seedbatch,err) != 0)
+          {
+            haserr = true;
+          }
         }
         if (!haserr && arguments->reverse)
         {
@@ -619,10 +830,8 @@ static int gt_repfind_runner(GT_UNUSED int argc,
     }
   }
   gt_querymatch_delete(querymatchspaceptr);
-  gt_seqabstract_delete(xdropmatchinfo.useq);
-  gt_seqabstract_delete(xdropmatchinfo.vseq);
-  gt_xdrop_resources_delete(xdropmatchinfo.res);
-  gt_frontresource_delete(xdropmatchinfo.frontresource);
+  gt_xdropmatchinfo_delete(&xdropmatchinfo);
+  gt_repfind_seedbatch_delete(seedbatch);
   gt_logger_delete(logger);
   return haserr ? -1 : 0;
 }
@@ -21,12 +21,14 @@
 #include "core/timer_api.h"
 #include "core/showtime.h"
 #include "core/logger.h"
+#include "core/divmodmul.h"
+#include "core/thread_api.h"
 #include "tools/gt_sain.h"
 #include "match/sfx-sain.h"
 
 typedef struct
 {
-  bool icheck, fcheck, verbose, dommap;
+  bool icheck, fcheck, verbose, dommap, scaling;
   GtStr *encseqfile, *plainseqfile, *dir;
   GtReadmode readmode;
 } GtSainArguments;
@@ -98,6 +100,14 @@ static GtOptionParser* gt_sain_option_parser_new(void *tool_arguments)
   optionfcheck = gt_option_new_bool("fcheck", "final check of suffix array",
                                     &arguments->fcheck, false);
   gt_option_parser_add_option(op, optionfcheck);
+
+  /* -scaling */
+  option = gt_option_new_bool("scaling",
+                              "sort the suffixes with 1, 2, 4, ... threads "
+                              "up to the number of threads given by option "
+                              "-j and report the time of each phase",
+                              &arguments->scaling, false);
+  gt_option_parser_add_option(op, option);
   gt_option_imply(optionfcheck, optionesq);
   gt_option_exclude(optionesq,optionfile);
   gt_option_imply(optionmmap, optionfile);
@@ -160,13 +170,14 @@ typedef struct
   GtLogger *logger;
 } GtSainTimerandLogger;
 
-static GtSainTimerandLogger *gt_sain_timer_logger_new(bool verbose)
+static GtSainTimerandLogger *gt_sain_timer_logger_new(bool verbose,
+                                                      bool showphases)
 {
   GtSainTimerandLogger *tl = gt_malloc(sizeof (*tl));
 
   tl->timer = NULL;
   tl->logger = gt_logger_new(verbose,GT_LOGGER_DEFLT_PREFIX,stdout);
-  if (gt_showtime_enabled())
+  if (showphases || gt_showtime_enabled())
   {
     if (verbose)
     {
@@ -194,6 +205,25 @@ static void gt_sain_timer_logger_delete(GtSainTimerandLogger *tl)
   gt_free(tl);
 }
 
+/* Return the number of threads to use in the run following the run with
+   <jobs> threads, or 0 if there is no further run. */
+static unsigned int gt_sain_nextjobs(unsigned int jobs,unsigned int maxjobs,
+                                     bool scaling)
+{
+  if (!scaling || jobs >= maxjobs)
+  {
+    return 0;
+  }
+  return GT_MULT2(jobs) < maxjobs ? GT_MULT2(jobs) : maxjobs;
+}
+
+static void gt_sain_showscaling(unsigned int jobs,GtTimer *runtimer)
+{
+  printf("# threads=%u: ",jobs);
+  gt_timer_show_formatted(runtimer,"overall "GT_WD".%06ld seconds real, "
+                                   GT_WD"s user, "GT_WD"s system\n",stdout);
+}
+
 static int gt_sain_runner(int argc, GT_UNUSED const char **argv,
                           int parsed_args, void *tool_arguments, GtError *err)
 {
@@ -238,15 +268,34 @@ static int gt_sain_runner(int argc, GT_UNUSED const char **argv,
         }
         if (!had_err)
         {
-          GtSainTimerandLogger *tl
-            = gt_sain_timer_logger_new(arguments->verbose);
-          gt_sain_encseq_sortsuffixes(encseq,
-                                      arguments->readmode,
-                                      arguments->icheck,
-                                      arguments->fcheck,
-                                      tl->logger,
-                                      tl->timer);
-          gt_sain_timer_logger_delete(tl);
+          const unsigned int maxjobs = gt_jobs;
+          unsigned int jobs;
+
+          for (jobs = arguments->scaling ? 1U : maxjobs; jobs > 0;
+               jobs = gt_sain_nextjobs(jobs,maxjobs,arguments->scaling))
+          {
+            GtSainTimerandLogger *tl
+              = gt_sain_timer_logger_new(arguments->verbose ||
+                                         arguments->scaling,
+                                         arguments->scaling);
+            GtTimer *runtimer = gt_timer_new();
+
+            gt_jobs = jobs;
+            gt_timer_start(runtimer);
+            gt_sain_encseq_sortsuffixes(encseq,
+                                        arguments->readmode,
+                                        arguments->icheck,
+                                        arguments->fcheck,
+                                        tl->logger,
+                                        tl->timer);
+            gt_sain_timer_logger_delete(tl);
+            if (arguments->scaling)
+            {
+              gt_sain_showscaling(jobs,runtimer);
+            }
+            gt_timer_delete(runtimer);
+          }
+          gt_jobs = maxjobs;
         }
       }
       gt_encseq_delete(encseq);
@@ -284,14 +333,33 @@ static int gt_sain_runner(int argc, GT_UNUSED const char **argv,
         }
         if (!had_err)
         {
-          GtSainTimerandLogger *tl
-            = gt_sain_timer_logger_new(arguments->verbose);
-          gt_sain_plain_sortsuffixes(plainseq,
-                                     (GtUword) len,
-                                     arguments->icheck,
-                                     tl->logger,
-                                     tl->timer);
-          gt_sain_timer_logger_delete(tl);
+          const unsigned int maxjobs = gt_jobs;
+          unsigned int jobs;
+
+          for (jobs = arguments->scaling ? 1U : maxjobs; jobs > 0;
+               jobs = gt_sain_nextjobs(jobs,maxjobs,arguments->scaling))
+          {
+            GtSainTimerandLogger *tl
+              = gt_sain_timer_logger_new(arguments->verbose ||
+                                         arguments->scaling,
+                                         arguments->scaling);
+            GtTimer *runtimer = gt_timer_new();
+
+            gt_jobs = jobs;
+            gt_timer_start(runtimer);
+            gt_sain_plain_sortsuffixes(plainseq,
+                                       (GtUword) len,
+                                       arguments->icheck,
+                                       tl->logger,
+                                       tl->timer);
+            gt_sain_timer_logger_delete(tl);
+            if (arguments->scaling)
+            {
+              gt_sain_showscaling(jobs,runtimer);
+            }
+            gt_timer_delete(runtimer);
+          }
+          gt_jobs = maxjobs;
         }
       }
       if (arguments->dommap)
@@ -29,6 +29,7 @@
 #include "extended/gff3_parser.h"
 #include "extended/gff3_visitor.h"
 #include "extended/gtdatahelp.h"
+#include "extended/prefetch_stream.h"
 #include "extended/select_stream.h"
 #include "extended/targetbest_select_stream.h"
 #include "tools/gt_select.h"
@@ -39,7 +40,8 @@
 typedef struct {
   bool verbose,
        has_CDS,
-       targetbest;
+       targetbest,
+       prefetch;
   GtStr *seqid,
         *source,
         *gt_strand_char,
@@ -245,6 +247,12 @@ static GtOptionParser* gt_select_option_parser_new(void *tool_arguments)
                                              arguments->dropped_file);
   gt_option_parser_add_option(op, optiondroppedfile);
 
+  /* -prefetch */
+  option = gt_option_new_bool("prefetch", "parse and select the input in a "
+                              "separate thread while the output is written",
+                              &arguments->prefetch, false);
+  gt_option_parser_add_option(op, option);
+
   /* -v */
   option = gt_option_new_verbose(&arguments->verbose);
   gt_option_parser_add_option(op, option);
@@ -321,7 +329,8 @@ static int gt_select_runner(int argc, const char **argv, int parsed_args,
 {
   SelectArguments *arguments = tool_arguments;
   GtNodeStream *gff3_in_stream, *select_stream,
-               *targetbest_select_stream = NULL, *gff3_out_stream;
+               *targetbest_select_stream = NULL, *prefetch_stream = NULL,
+               *gff3_out_stream, *last_stream;
   int had_err;
   GtFile *drop_file = NULL;
   GtNodeVisitor *gff3outvis = NULL;
@@ -370,17 +379,25 @@ static int gt_select_runner(int argc, const char **argv, int parsed_args,
     if (arguments->targetbest)
       targetbest_select_stream = gt_targetbest_select_stream_new(select_stream);
 
+    last_stream = arguments->targetbest ? targetbest_select_stream
+                                        : select_stream;
+
+    /* create a prefetch stream (if necessary) */
+    if (arguments->prefetch) {
+      prefetch_stream = gt_prefetch_stream_new(last_stream,
+                                               GT_PREFETCH_STREAM_DEFAULT_SIZE);
+      last_stream = prefetch_stream;
+    }
+
     /* create a gff3 output stream */
-    gff3_out_stream = gt_gff3_out_stream_new(arguments->targetbest
-                                             ? targetbest_select_stream
-                                             : select_stream,
-                                             arguments->outfp);
+    gff3_out_stream = gt_gff3_out_stream_new(last_stream, arguments->outfp);
 
     /* pull the features through the stream and free them afterwards */
     had_err = gt_node_stream_pull(gff3_out_stream, err);
 
     /* free */
     gt_node_stream_delete(gff3_out_stream);
+    gt_node_stream_delete(prefetch_stream);
     gt_node_stream_delete(select_stream);
     gt_node_stream_delete(targetbest_select_stream);
   } else {
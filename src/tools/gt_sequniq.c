@@ -16,6 +16,7 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "core/bioseq.h"
 #include "core/fasta.h"
 #include "core/fileutils_api.h"
@@ -25,6 +26,7 @@
 #include "core/progressbar.h"
 #include "core/seq_iterator_sequence_buffer_api.h"
 #include "core/string_distri.h"
+#include "core/thread_api.h"
 #include "core/unused_api.h"
 #include "extended/md5set.h"
 #include "tools/gt_sequniq.h"
@@ -36,6 +38,113 @@ typedef struct {
   GtFile *outfp;
 } GtSequniqArguments;
 
+/* limits of a batch of sequences whose MD5 hashes are computed in parallel */
+#define GT_SEQUNIQ_BATCH_MAXSEQS    16384
+#define GT_SEQUNIQ_BATCH_MAXLENGTH  (4UL << 20)
+
+/* the sequences and descriptions of a batch are copied into one buffer */
+typedef struct {
+  char *chars;
+  const char **seqs;
+  GtUword *seqoffsets,
+          *descoffsets,
+          *seqlens,
+          nofseqs,
+          nofchars,
+          allocatedchars;
+  GtMD5SetStatus *status;
+} GtSequniqBatch;
+
+static GtSequniqBatch* gt_sequniq_batch_new(void)
+{
+  GtSequniqBatch *batch = gt_malloc(sizeof *batch);
+  batch->allocatedchars = GT_SEQUNIQ_BATCH_MAXLENGTH;
+  batch->chars = gt_malloc(sizeof *batch->chars * batch->allocatedchars);
+  batch->seqs = gt_malloc(sizeof *batch->seqs * GT_SEQUNIQ_BATCH_MAXSEQS);
+  batch->seqoffsets = gt_malloc(sizeof *batch->seqoffsets *
+                                GT_SEQUNIQ_BATCH_MAXSEQS);
+  batch->descoffsets = gt_malloc(sizeof *batch->descoffsets *
+                                 GT_SEQUNIQ_BATCH_MAXSEQS);
+  batch->seqlens = gt_malloc(sizeof *batch->seqlens *
+                             GT_SEQUNIQ_BATCH_MAXSEQS);
+  batch->status = gt_malloc(sizeof *batch->status * GT_SEQUNIQ_BATCH_MAXSEQS);
+  batch->nofseqs = batch->nofchars = 0;
+  return batch;
+}
+
+static void gt_sequniq_batch_delete(GtSequniqBatch *batch)
+{
+  if (!batch) return;
+  gt_free(batch->status);
+  gt_free(batch->seqlens);
+  gt_free(batch->descoffsets);
+  gt_free(batch->seqoffsets);
+  gt_free(batch->seqs);
+  gt_free(batch->chars);
+  gt_free(batch);
+}
+
+static GtUword gt_sequniq_batch_append(GtSequniqBatch *batch,
+                                       const char *chars, GtUword len)
+{
+  GtUword offset = batch->nofchars;
+  if (batch->nofchars + len > batch->allocatedchars) {
+    batch->allocatedchars = batch->nofchars + len +
+                            (batch->allocatedchars >> 1);
+    batch->chars = gt_realloc(batch->chars, sizeof *batch->chars *
+                                            batch->allocatedchars);
+  }
+  memcpy(batch->chars + batch->nofchars, chars, (size_t) len);
+  batch->nofchars += len;
+  return offset;
+}
+
+/* Copies <seq> and <desc> to <batch>. Returns true if <batch> is full. */
+static bool gt_sequniq_batch_add(GtSequniqBatch *batch, const char *seq,
+                                 GtUword seqlen, const char *desc)
+{
+  gt_assert(batch->nofseqs < GT_SEQUNIQ_BATCH_MAXSEQS);
+  batch->seqoffsets[batch->nofseqs] = gt_sequniq_batch_append(batch, seq,
+                                                              seqlen);
+  batch->seqlens[batch->nofseqs] = seqlen;
+  batch->descoffsets[batch->nofseqs] =
+    gt_sequniq_batch_append(batch, desc ? desc : "", desc ? strlen(desc) + 1
+                                                          : 1);
+  batch->nofseqs++;
+  return batch->nofseqs == GT_SEQUNIQ_BATCH_MAXSEQS ||
+         batch->nofchars >= GT_SEQUNIQ_BATCH_MAXLENGTH;
+}
+
+/* Adds the sequences of <batch> to <md5set>, shows the unique ones in order,
+   and empties <batch>. */
+static int gt_sequniq_batch_flush(GtSequniqBatch *batch, GtMD5Set *md5set,
+                                  const GtSequniqArguments *arguments,
+                                  GtUint64 *duplicates,
+                                  GtUint64 *num_of_sequences, GtError *err)
+{
+  GtUword i;
+  int had_err;
+  gt_error_check(err);
+  for (i = 0; i < batch->nofseqs; i++)
+    batch->seqs[i] = batch->chars + batch->seqoffsets[i];
+  had_err = gt_md5set_add_sequences(md5set, batch->seqs, batch->seqlens,
+                                    batch->nofseqs, arguments->rev,
+                                    batch->status, err);
+  for (i = 0; i < batch->nofseqs; i++) {
+    if (batch->status[i] == GT_MD5SET_ERROR && had_err)
+      break;
+    if (batch->status[i] == GT_MD5SET_NOT_FOUND)
+      gt_fasta_show_entry(batch->chars + batch->descoffsets[i],
+                          batch->seqs[i], batch->seqlens[i],
+                          arguments->width, arguments->outfp);
+    else
+      (*duplicates)++;
+    (*num_of_sequences)++;
+  }
+  batch->nofseqs = batch->nofchars = 0;
+  return had_err;
+}
+
 static void* gt_sequniq_arguments_new(void)
 {
   GtSequniqArguments *arguments = gt_calloc((size_t)1, sizeof *arguments);
@@ -108,10 +217,14 @@ static int gt_sequniq_runner(int argc, const char **argv, int parsed_args,
   GtUint64 duplicates = 0, num_of_sequences = 0;
   int i, had_err = 0;
   GtMD5Set *md5set;
+  GtSequniqBatch *batch = NULL;
 
   gt_error_check(err);
   gt_assert(arguments);
   md5set = gt_md5set_new(arguments->nofseqs);
+  /* with multiple threads the sequences are hashed in batches */
+  if (gt_jobs > 1)
+    batch = gt_sequniq_batch_new();
   if (!arguments->seqit) {
     GtUword j;
     GtBioseq *bs;
@@ -123,6 +236,17 @@ static int gt_sequniq_runner(int argc, const char **argv, int parsed_args,
         GtMD5SetStatus retval;
         for (j = 0; j < gt_bioseq_number_of_sequences(bs) && !had_err; j++) {
           char *seq = gt_bioseq_get_sequence(bs, j);
+          if (batch) {
+            if (gt_sequniq_batch_add(batch, seq,
+                                     gt_bioseq_get_sequence_length(bs, j),
+                                     gt_bioseq_get_description(bs, j))) {
+              had_err = gt_sequniq_batch_flush(batch, md5set, arguments,
+                                               &duplicates, &num_of_sequences,
+                                               err);
+            }
+            gt_free(seq);
+            continue;
+          }
           retval = gt_md5set_add_sequence(md5set, seq,
                                           gt_bioseq_get_sequence_length(bs, j),
                                           arguments->rev, err);
@@ -140,6 +264,10 @@ static int gt_sequniq_runner(int argc, const char **argv, int parsed_args,
         gt_bioseq_delete(bs);
       }
     }
+    if (batch && !had_err) {
+      had_err = gt_sequniq_batch_flush(batch, md5set, arguments, &duplicates,
+                                       &num_of_sequences, err);
+    }
   }
   else {
     GtSeqIterator *seqit;
@@ -168,6 +296,14 @@ static int gt_sequniq_runner(int argc, const char **argv, int parsed_args,
         if ((gt_seq_iterator_next(seqit, &sequence, &len, &desc, err)) != 1)
           break;
 
+        if (batch) {
+          if (gt_sequniq_batch_add(batch, (const char*) sequence, len, desc)) {
+            had_err = gt_sequniq_batch_flush(batch, md5set, arguments,
+                                             &duplicates, &num_of_sequences,
+                                             err);
+          }
+          continue;
+        }
         retval = gt_md5set_add_sequence(md5set, (const char*) sequence, len,
             arguments->rev, err);
         if (retval == GT_MD5SET_NOT_FOUND)
@@ -179,6 +315,10 @@ static int gt_sequniq_runner(int argc, const char **argv, int parsed_args,
           had_err = -1;
         num_of_sequences++;
       }
+      if (batch && !had_err && !gt_error_is_set(err)) {
+        had_err = gt_sequniq_batch_flush(batch, md5set, arguments,
+                                         &duplicates, &num_of_sequences, err);
+      }
       if (arguments->verbose)
         gt_progressbar_stop();
       gt_seq_iterator_delete(seqit);
@@ -194,6 +334,7 @@ static int gt_sequniq_runner(int argc, const char **argv, int parsed_args,
             ((double) duplicates / (double)num_of_sequences) * 100.0);
   }
 
+  gt_sequniq_batch_delete(batch);
   gt_md5set_delete(md5set);
   return had_err;
 }
@@ -75,6 +75,13 @@ Test do
   run "diff #{last_stdout} #{$testdata}gt_chseqids_test_5.sorted_out"
 end
 
+Name "gt chseqids test 5 (-sortmemlimit)"
+Keywords "gt_chseqids sortmemlimit"
+Test do
+  run_test "#{$bin}gt chseqids -sort -sortmemlimit 1 #{$testdata}gt_chseqids_test_5.chseqids #{$testdata}gt_chseqids_test_5.gff3"
+  run "diff #{last_stdout} #{$testdata}gt_chseqids_test_5.sorted_out"
+end
+
 Name "gt chseqids test 6"
 Keywords "gt_chseqids"
 Test do
@@ -396,6 +396,39 @@ end
   end
 end
 
+["yes", "no"].each do |yn|
+  Name "gt encseq encode multithreaded lossless #{yn}"
+  Keywords "gt_encseq encseq gt_encseq_encode md5 multithreaded"
+  Test do
+    (fastafiles + ["U89959_genomic.fas"]).each do |fn|
+      run_test "#{$bin}gt -j 1 encseq encode -lossless #{yn} -indexname seq " +
+               "#{$testdata}/#{fn}"
+      run_test "#{$bin}gt -j 3 encseq encode -lossless #{yn} -indexname par " +
+               "#{$testdata}/#{fn}"
+      run "for s in esq ssp des sds md5 ois; do " +
+          "test ! -e seq.$s || cmp seq.$s par.$s || exit 1; done"
+    end
+  end
+end
+
+Name "gt encseq encode multithreaded formats"
+Keywords "gt_encseq encseq gt_encseq_encode multithreaded"
+Test do
+  [fastafiles.join(" "), genbankfiles.join(" "), emblfiles.join(" "),
+   "csr_testcase.fastq csr_testcase_r0.fastq"].each do |fns|
+    files = fns.split(" ").collect { |fn| "#{$testdata}/#{fn}" }.join(" ")
+    ["", "-clipdesc"].each do |clip|
+      run_test "#{$bin}gt -j 1 encseq encode #{clip} -indexname seq #{files}"
+      run_test "#{$bin}gt -j 3 encseq encode #{clip} -indexname par #{files}"
+      run "for s in esq ssp des sds md5 ois; do " +
+          "test ! -e seq.$s || cmp seq.$s par.$s || exit 1; done"
+    end
+  end
+  run_test "#{$bin}gt -j 3 encseq encode -protein -indexname par " +
+           "#{$testdata}/Random.fna", :retval => 1
+  grep last_stderr, /illegal character 'n': file ".*Random.fna", line 2/
+end
+
 Name "gt encseq MD5 index w/o MD5 support"
 Keywords "encseq gt_encseq md5"
 Test do
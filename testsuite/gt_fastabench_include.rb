@@ -0,0 +1,61 @@
+fastabench_files = ["at1MB",
+                    "Atinsert.fna",
+                    "Random.fna",
+                    "sw100K1.fsa",
+                    "U89959_ests.fas",
+                    "U89959_genomic.fas",
+                    "fib25.fas.gz",
+                    "gt_extractfeat_succ_1.fas.gz"]
+
+Name "gt dev fastabench fsm reader equals rec reader"
+Keywords "gt_fastabench"
+Test do
+  fastabench_files.each do |filename|
+    run_test "#{$bin}gt dev fastabench -reader rec #{$testdata}#{filename}"
+    run "mv #{last_stdout} rec.out"
+    run_test "#{$bin}gt dev fastabench -reader fsm #{$testdata}#{filename}"
+    run "cmp #{last_stdout} rec.out"
+    if not filename.match(/\.gz$/)
+      run_test "#{$bin}gt dev fastabench -mmap #{$testdata}#{filename}"
+      run "cmp #{last_stdout} rec.out"
+      run_test "#{$bin}gt dev fastabench < #{$testdata}#{filename}"
+      run "cmp #{last_stdout} rec.out"
+    end
+  end
+end
+
+Name "gt dev fastabench fsm reader CR/LF"
+Keywords "gt_fastabench"
+Test do
+  File.open("crlf.fas", "w") do |f|
+    f.write(">seq1 description\r\nacgt\r\nac gt\r\n>seq2\r\nttt\r\n")
+  end
+  run_test "#{$bin}gt dev fastabench crlf.fas"
+  grep last_stdout, /number of sequences: 2/
+  grep last_stdout, /sequence characters: 11/
+  grep last_stdout, /description characters: 20/
+end
+
+Name "gt dev fastabench fsm reader errors"
+Keywords "gt_fastabench"
+Test do
+  File.open("nosep.fas", "w") { |f| f.write("acgt\n") }
+  run_test "#{$bin}gt dev fastabench nosep.fas", :retval => 1
+  grep last_stderr, /has to be '>'/
+  File.open("empty.fas", "w") { |f| f.write(">seq1\n>seq2\nacgt\n") }
+  run_test "#{$bin}gt dev fastabench empty.fas", :retval => 1
+  grep last_stderr, /empty sequence after description given in line 1/
+  File.open("unfinished.fas", "w") { |f| f.write(">seq1") }
+  run_test "#{$bin}gt dev fastabench unfinished.fas", :retval => 1
+  grep last_stderr, /unfinished fasta entry/
+end
+
+Name "gt dev fastabench throughput"
+Keywords "gt_fastabench benchmark"
+Test do
+  ["fsm", "fsm -mmap", "rec"].each do |reader|
+    run_test "#{$bin}gt dev fastabench -v -runs 10 -reader #{reader} " +
+             "#{$testdata}at1MB"
+    grep last_stdout, /TIME/
+  end
+end
@@ -42,6 +42,25 @@ if not $arguments["nordb"] then
     run "#{$bin}gt featureindex -filename corrupt.db", :retval => 1
   end
 
+  Name "gt featureindex (bulk load vs. default)"
+  Keywords "gt_featureindex"
+  Test do
+    file = "#{$testdata}/encode_known_genes_Mar07.gff3"
+    run "#{$bin}gt seqids #{file}"
+    seqids = File.open(last_stdout).readlines
+    run "#{$bin}gt mkfeatureindex -filename bulk.db #{file}"
+    run "#{$bin}gt mkfeatureindex -bulkload no -filename default.db #{file}",
+        :maxtime => 1200
+    seqids.each do |seqid|
+      seqid.chomp!
+      run "#{$bin}gt featureindex -seqid #{seqid} -filename bulk.db " +
+          "> bulk.gff3"
+      run "#{$bin}gt featureindex -seqid #{seqid} -filename default.db " +
+          "> default.gff3"
+      run "diff bulk.gff3 default.gff3"
+    end
+  end
+
   FEATUREINDEX_TEST_FILES = ["#{$testdata}/eden.gff3",
                              "#{$testdata}/standard_gene_simple.gff3",
                              "#{$testdata}/standard_gene_as_tree.gff3",
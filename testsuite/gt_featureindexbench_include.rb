@@ -0,0 +1,72 @@
+Name "gt dev featureindexbench"
+Keywords "gt_featureindexbench"
+Test do
+  run_test "#{$bin}gt dev featureindexbench " +
+           "#{$testdata}encode_known_genes_Mar07.gff3"
+  grep last_stdout, /number of sequence regions: 20$/
+  grep last_stdout, /number of top-level features: 2991$/
+  grep last_stdout, /number of feature nodes: 33217$/
+end
+
+Name "gt dev featureindexbench multiple files"
+Keywords "gt_featureindexbench"
+Test do
+  run_test "#{$bin}gt dev featureindexbench -v " +
+           "#{$testdata}standard_gene_as_tree.gff3 " +
+           "#{$testdata}encode_known_genes_Mar07.gff3"
+  grep last_stdout, /number of sequence regions: 21$/
+  grep last_stdout, /number of feature nodes: 33233$/
+  grep last_stdout, /resident set size/
+  grep last_stdout, /TIME/
+end
+
+Name "gt dev featureindexbench range queries"
+Keywords "gt_featureindexbench"
+Test do
+  run_test "#{$bin}gt dev featureindexbench -queries 20000 -width 50000 " +
+           "#{$testdata}encode_known_genes_Mar07.gff3"
+  run "grep 'query windows' #{last_stdout} > tree.out"
+  run_test "#{$bin}gt dev featureindexbench -queries 20000 -width 50000 " +
+           "-compact -v #{$testdata}encode_known_genes_Mar07.gff3"
+  grep last_stdout, /TIME range queries/
+  run "grep 'query windows' #{last_stdout} > compact.out"
+  run "diff tree.out compact.out"
+end
+
+Name "gt dev featureindexbench invalid file"
+Keywords "gt_featureindexbench"
+Test do
+  run_test "#{$bin}gt dev featureindexbench " +
+           "#{$testdata}gt_gff3_fail_1.gff3", :retval => 1
+end
+
+if not $arguments["nordb"] then
+  Name "gt dev featureindexbench SQLite"
+  Keywords "gt_featureindexbench"
+  Test do
+    run_test "#{$bin}gt dev featureindexbench -sqlite tmp.db " +
+             "#{$testdata}encode_known_genes_Mar07.gff3", :maxtime => 1200
+    grep last_stdout, /number of sequence regions: 20$/
+    grep last_stdout, /number of top-level features: 2991$/
+    grep last_stdout, /number of feature nodes: 33217$/
+  end
+
+  Name "gt dev featureindexbench SQLite bulk load"
+  Keywords "gt_featureindexbench"
+  Test do
+    run_test "#{$bin}gt dev featureindexbench -bulkload -v -sqlite tmp.db " +
+             "#{$testdata}standard_gene_as_tree.gff3 " +
+             "#{$testdata}encode_known_genes_Mar07.gff3"
+    grep last_stdout, /number of sequence regions: 21$/
+    grep last_stdout, /number of feature nodes: 33233$/
+    grep last_stdout, /TIME loading features/
+  end
+
+  Name "gt dev featureindexbench SQLite range queries"
+  Keywords "gt_featureindexbench"
+  Test do
+    run_test "#{$bin}gt dev featureindexbench -sqlite tmp.db -queries 10 " +
+             "#{$testdata}encode_known_genes_Mar07.gff3", :retval => 1
+    grep last_stderr, /exclude each other/
+  end
+end
@@ -655,6 +655,34 @@ Test do
   run "diff #{last_stdout} #{$testdata}minimal_fasta.gff3"
 end
 
+Name "gt gff3 lines longer than the read buffer"
+Keywords "gt_gff3 fasta"
+Test do
+  File.open("longlines.gff3", "w") do |f|
+    f.puts "##gff-version 3"
+    f.puts "##sequence-region seq1 1 1000"
+    1.upto(5) do |i|
+      f.puts "seq1\t.\tgene\t#{i}\t1000\t.\t+\t.\tID=gene#{i};" +
+             "Note=#{"acgt" * (10000 * i)}"
+    end
+    f.puts "##FASTA"
+    f.puts ">seq1"
+    f.puts "acgt" * 250
+  end
+  File.open("longlines_crlf.gff3", "w") do |f|
+    File.read("longlines.gff3").each_line do |line|
+      f.write(line.chomp + "\r\n")
+    end
+  end
+  run_test "#{$bin}gt gff3 longlines.gff3"
+  run "mv #{last_stdout} longlines.out"
+  grep "longlines.out", /\tNote=(acgt){50000}$/
+  run_test "#{$bin}gt gff3 longlines.out"
+  run "diff #{last_stdout} longlines.out"
+  run_test "#{$bin}gt gff3 - < longlines_crlf.gff3"
+  run "diff #{last_stdout} longlines.out"
+end
+
 Name "gt gff3 standard fasta example"
 Keywords "gt_gff3 fasta"
 Test do
@@ -894,6 +922,65 @@ Test do
   run "diff #{last_stdout} #{$testdata}sequence_region_joined.gff3"
 end
 
+Name "gt gff3 -sortmemlimit"
+Keywords "gt_gff3 sortmemlimit"
+Test do
+  run_test "#{$bin}gt gff3 -sort #{$testdata}encode_known_genes_Mar07.gff3"
+  run "mv #{last_stdout} sorted.gff3"
+  run_test "#{$bin}gt gff3 -sort -sortmemlimit 1 " +
+           "#{$testdata}encode_known_genes_Mar07.gff3"
+  run "diff #{last_stdout} sorted.gff3"
+end
+
+Name "gt gff3 -sortmemlimit (-retainids)"
+Keywords "gt_gff3 sortmemlimit"
+Test do
+  run_test "#{$bin}gt gff3 -sort -retainids " +
+           "#{$testdata}encode_known_genes_Mar07.gff3"
+  run "mv #{last_stdout} sorted.gff3"
+  run_test "#{$bin}gt gff3 -sort -sortmemlimit 1 -retainids " +
+           "#{$testdata}encode_known_genes_Mar07.gff3"
+  run "diff #{last_stdout} sorted.gff3"
+end
+
+Name "gt gff3 -sortmemlimit (FASTA)"
+Keywords "gt_gff3 sortmemlimit"
+Test do
+  run_test "#{$bin}gt gff3 -sort -sortmemlimit 1 " +
+           "#{$testdata}encode_known_genes_Mar07.gff3 " +
+           "#{$testdata}standard_fasta_example.gff3"
+  run "mv #{last_stdout} limited.gff3"
+  run_test "#{$bin}gt gff3 -sort " +
+           "#{$testdata}encode_known_genes_Mar07.gff3 " +
+           "#{$testdata}standard_fasta_example.gff3"
+  run "diff #{last_stdout} limited.gff3"
+end
+
+Name "gt gff3 join sequence regions with same ID (-sortmemlimit)"
+Keywords "gt_gff3 sortmemlimit"
+Test do
+  run_test "#{$bin}gt gff3 -sort -sortmemlimit 1 " +
+           "#{$testdata}sequence_region_1.gff3 " +
+           "#{$testdata}sequence_region_2.gff3 "
+  run "diff #{last_stdout} #{$testdata}sequence_region_joined.gff3"
+end
+
+Name "gt gff3 -sortmemlimit (many runs)"
+Keywords "gt_gff3 sortmemlimit"
+Test do
+  # seven copies of the genes with distinct IDs give more than 100 runs,
+  # which are merged in several passes
+  run "cp #{$testdata}encode_known_genes_Mar07.gff3 many.gff3"
+  ["B", "C", "D", "E", "F", "G"].each do |copy|
+    run "grep -v '^##' #{$testdata}encode_known_genes_Mar07.gff3 | " +
+        "sed 's/gene\\([0-9]\\)/gene#{copy}\\1/g' >> many.gff3"
+  end
+  run_test "#{$bin}gt gff3 -sort many.gff3"
+  run "mv #{last_stdout} sorted.gff3"
+  run_test "#{$bin}gt gff3 -sort -sortmemlimit 1 many.gff3"
+  run "diff #{last_stdout} sorted.gff3"
+end
+
 Name "gt gff3 print very long attributes"
 Keywords "gt_gff3"
 Test do
@@ -1269,6 +1356,85 @@ Test do
   grep last_stderr, "wrong separator"
 end
 
+Name "gt gff3 multithreaded"
+Keywords "gt_gff3 multithreaded"
+Test do
+  ["gff3 -sort -tidy", "stat", "eval"].each do |tool|
+    args = "#{$testdata}encode_known_genes_Mar07.gff3"
+    args = "#{args} #{args}" if tool == "eval"
+    run_test "#{$bin}gt -j 1 #{tool} #{args}"
+    run "mv #{last_stdout} single.out"
+    run_test "#{$bin}gt -j 3 #{tool} #{args}"
+    run "cmp #{last_stdout} single.out"
+  end
+end
+
+Name "gt gff3 multithreaded (FASTA section)"
+Keywords "gt_gff3 multithreaded"
+Test do
+  run "cat #{$testdata}encode_known_genes_Mar07.gff3 " +
+      "#{$testdata}standard_fasta_example.gff3 | grep -v '^##gff-version' " +
+      "| sed '1i ##gff-version 3' > with_fasta.gff3"
+  run_test "#{$bin}gt -j 1 gff3 -sort -tidy with_fasta.gff3"
+  run "mv #{last_stdout} single.out"
+  run_test "#{$bin}gt -j 3 gff3 -sort -tidy with_fasta.gff3"
+  run "cmp #{last_stdout} single.out"
+end
+
+Name "gt gff3 multithreaded (parse error)"
+Keywords "gt_gff3 multithreaded"
+Test do
+  run "cat #{$testdata}encode_known_genes_Mar07.gff3 " +
+      "#{$testdata}gt_gff3_fail_1.gff3 | grep -v '^##gff-version' " +
+      "| sed '1i ##gff-version 3' > with_error.gff3"
+  run_test "#{$bin}gt -j 1 gff3 with_error.gff3", :retval => 1
+  run "mv #{last_stdout} single.out"
+  run "mv #{last_stderr} single.err"
+  run_test "#{$bin}gt -j 3 gff3 with_error.gff3", :retval => 1
+  run "cmp #{last_stdout} single.out"
+  run "cmp #{last_stderr} single.err"
+end
+
+Name "gt gff3 multithreaded (unsorted before FASTA section)"
+Keywords "gt_gff3 multithreaded"
+Test do
+  run "cat #{$testdata}encode_known_genes_Mar07.gff3 " +
+      "#{$testdata}standard_fasta_example.gff3 | grep -v '^##gff-version' " +
+      "| sed '1i ##gff-version 3' > with_fasta.gff3"
+  # line 33275 starts the last block (with blocks of 256 KB), which contains
+  # the FASTA section and is parsed sequentially
+  run "sed '33275i chrX\tENCODE\tgene\t122525028\t122525033\t.\t+\t.\t" +
+      "ID=unsorted' with_fasta.gff3 > unsorted.gff3"
+  run_test "#{$bin}gt -j 1 merge unsorted.gff3", :retval => 1
+  grep last_stderr, "is not sorted"
+  run "mv #{last_stdout} single.out"
+  run "mv #{last_stderr} single.err"
+  run_test "#{$bin}gt -j 3 merge unsorted.gff3", :retval => 1
+  run "cmp #{last_stdout} single.out"
+  run "cmp #{last_stderr} single.err"
+end
+
+Name "gt gff3 -prefetch"
+Keywords "gt_gff3 prefetch"
+Test do
+  ["-tidy", "-sort -tidy", "-addintrons -setsource foo"].each do |opt|
+    run_test "#{$bin}gt gff3 #{opt} " +
+             "#{$testdata}encode_known_genes_Mar07.gff3"
+    run "mv #{last_stdout} unbuffered.out"
+    run_test "#{$bin}gt gff3 -prefetch #{opt} " +
+             "#{$testdata}encode_known_genes_Mar07.gff3"
+    run "cmp #{last_stdout} unbuffered.out"
+  end
+end
+
+Name "gt gff3 -prefetch (parse error)"
+Keywords "gt_gff3 prefetch"
+Test do
+  run_test "#{$bin}gt gff3 -prefetch #{$testdata}gt_gff3_fail_1.gff3",
+           :retval => 1
+  grep last_stderr, /has already been defined/
+end
+
 def large_gff3_test(name, file)
   Name "gt gff3 #{name}"
   Keywords "gt_gff3 large_gff3"
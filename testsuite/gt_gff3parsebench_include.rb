@@ -0,0 +1,42 @@
+Name "gt dev gff3parsebench retain equals streaming"
+Keywords "gt_gff3parsebench"
+Test do
+  ["encode_known_genes_Mar07.gff3", "standard_gene_as_tree.gff3",
+   "cds_feature_with_multiple_parents_tidied.gff3"].each do |filename|
+    run_test "#{$bin}gt dev gff3parsebench #{$testdata}#{filename}"
+    run "mv #{last_stdout} streaming.out"
+    ["-retain", "-runs 2", "-retain -runs 2"].each do |options|
+      run_test "#{$bin}gt dev gff3parsebench #{options} " +
+               "#{$testdata}#{filename}"
+      run "cmp #{last_stdout} streaming.out"
+    end
+  end
+end
+
+Name "gt dev gff3parsebench node counts"
+Keywords "gt_gff3parsebench"
+Test do
+  run_test "#{$bin}gt dev gff3parsebench " +
+           "#{$testdata}encode_known_genes_Mar07.gff3"
+  grep last_stdout, /number of nodes: 3012$/
+  grep last_stdout, /number of feature nodes: 33217$/
+end
+
+Name "gt dev gff3parsebench invalid file"
+Keywords "gt_gff3parsebench"
+Test do
+  run_test "#{$bin}gt dev gff3parsebench " +
+           "#{$testdata}gt_gff3_fail_1.gff3", :retval => 1
+end
+
+Name "gt dev gff3parsebench -synthetic multithreaded"
+Keywords "gt_gff3parsebench multithreaded"
+Test do
+  run_test "#{$bin}gt -j 1 dev gff3parsebench -synthetic 20000"
+  grep last_stdout, /number of nodes: 20017$/
+  run "mv #{last_stdout} single.out"
+  [2, 4].each do |jobs|
+    run_test "#{$bin}gt -j #{jobs} dev gff3parsebench -synthetic 20000"
+    run "cmp #{last_stdout} single.out"
+  end
+end
@@ -0,0 +1,118 @@
+Name "gt dev gthdpbench cDNA checkpointing"
+Keywords "gt_gthdpbench gth"
+Test do
+  run_test "#{$bin}gt dev gthdpbench -range 1000 8000 -refs 5 " +
+           "#{$testdata}U89959_genomic.fas #{$testdata}U89959_ests.fas"
+  run "mv #{last_stdout} full.out"
+  grep "full.out", /number of spliced alignments: 5$/
+  run_test "#{$bin}gt dev gthdpbench -checkpoint -range 1000 8000 -refs 5 " +
+           "#{$testdata}U89959_genomic.fas #{$testdata}U89959_ests.fas"
+  run "diff #{last_stdout} full.out"
+end
+
+Name "gt dev gthdpbench protein checkpointing"
+Keywords "gt_gthdpbench gth"
+Test do
+  run_test "#{$bin}gt dev gthdpbench -protein -scorematrix " +
+           "#{$testdata}BLOSUM62 -range 1 12000 -refs 3 " +
+           "#{$testdata}U89959_genomic.fas #{$testdata}U89959_cds.fas"
+  run "mv #{last_stdout} full.out"
+  grep "full.out", /^\(1075,1170\)\(1258,1353\)\(1431,1538\)$/
+  run_test "#{$bin}gt dev gthdpbench -checkpoint -protein -scorematrix " +
+           "#{$testdata}BLOSUM62 -range 1 12000 -refs 3 " +
+           "#{$testdata}U89959_genomic.fas #{$testdata}U89959_cds.fas"
+  run "diff #{last_stdout} full.out"
+end
+
+Name "gt dev gthdpbench cDNA workspace"
+Keywords "gt_gthdpbench gth"
+Test do
+  run_test "#{$bin}gt dev gthdpbench -range 1000 8000 -refs 5 " +
+           "#{$testdata}U89959_genomic.fas #{$testdata}U89959_ests.fas"
+  run "mv #{last_stdout} full.out"
+  run_test "#{$bin}gt dev gthdpbench -workspace -range 1000 8000 -refs 5 " +
+           "#{$testdata}U89959_genomic.fas #{$testdata}U89959_ests.fas"
+  run "diff #{last_stdout} full.out"
+end
+
+Name "gt dev gthdpbench protein workspace"
+Keywords "gt_gthdpbench gth"
+Test do
+  run_test "#{$bin}gt dev gthdpbench -protein -scorematrix " +
+           "#{$testdata}BLOSUM62 -range 1 12000 -refs 3 " +
+           "#{$testdata}U89959_genomic.fas #{$testdata}U89959_cds.fas"
+  run "mv #{last_stdout} full.out"
+  run_test "#{$bin}gt dev gthdpbench -workspace -protein -scorematrix " +
+           "#{$testdata}BLOSUM62 -range 1 12000 -refs 3 " +
+           "#{$testdata}U89959_genomic.fas #{$testdata}U89959_cds.fas"
+  run "diff #{last_stdout} full.out"
+end
+
+Name "gt dev gthdpbench verbose"
+Keywords "gt_gthdpbench gth benchmark"
+Test do
+  run_test "#{$bin}gt dev gthdpbench -checkpoint -v -range 1000 3000 " +
+           "-refs 1 #{$testdata}U89959_genomic.fas " +
+           "#{$testdata}U89959_ests.fas"
+  grep last_stdout, /^\(1102,1116\)\(1239,1261\)\(1321,1338\)\(2297,2326\)$/
+  grep last_stdout, /SPACE maximal resident set size/
+  grep last_stdout, /TIME DP/
+end
+
+Name "gt dev gthdpbench verbose workspace"
+Keywords "gt_gthdpbench gth benchmark"
+Test do
+  run_test "#{$bin}gt dev gthdpbench -workspace -v -range 1000 3000 " +
+           "-refs 3 #{$testdata}U89959_genomic.fas " +
+           "#{$testdata}U89959_ests.fas"
+  grep last_stdout, /DP workspace: 3 backtrace matrices, 2 reused/
+end
+
+Name "gt dev gthdpbench range outside of sequence"
+Keywords "gt_gthdpbench gth"
+Test do
+  run_test "#{$bin}gt dev gthdpbench -range 1000 200000 " +
+           "#{$testdata}U89959_genomic.fas #{$testdata}U89959_ests.fas",
+           :retval => 1
+  grep last_stderr, /lies outside of the genomic sequence/
+end
+
+Name "gt dev gthdpbench chains multithreaded"
+Keywords "gt_gthdpbench gth"
+Test do
+  run_test "#{$bin}gt -j 1 dev gthdpbench -chains -range 1000 8000 " +
+           "#{$testdata}U89959_genomic.fas #{$testdata}U89959_ests.fas"
+  run "grep -v 'date finished' #{last_stdout} > j1.out"
+  grep "j1.out", /^# number of spliced alignments: 24$/
+  grep "j1.out", /^>8721428 \+\+ call 19 score 1.000$/
+  grep "j1.out", /^\(1073,1170\)\(1258,1353\)\(1431,1539\)$/
+  grep "j1.out", /^>8732878 -- call 21 score 0.996$/
+  run_test "#{$bin}gt -j 4 dev gthdpbench -chains -range 1000 8000 " +
+           "#{$testdata}U89959_genomic.fas #{$testdata}U89959_ests.fas"
+  run "grep -v 'date finished' #{last_stdout} > j4.out"
+  run "diff j4.out j1.out"
+end
+
+Name "gt dev gthdpbench chains multithreaded first"
+Keywords "gt_gthdpbench gth"
+Test do
+  run_test "#{$bin}gt -j 1 dev gthdpbench -chains -first 2 -checkpoint " +
+           "-range 1000 8000 -refs 50 " +
+           "#{$testdata}U89959_genomic.fas #{$testdata}U89959_ests.fas"
+  run "grep -v 'date finished' #{last_stdout} > j1.out"
+  grep "j1.out", /^# number of spliced alignments: 2$/
+  run_test "#{$bin}gt -j 3 dev gthdpbench -chains -first 2 -checkpoint " +
+           "-range 1000 8000 -refs 50 " +
+           "#{$testdata}U89959_genomic.fas #{$testdata}U89959_ests.fas"
+  run "grep -v 'date finished' #{last_stdout} > j3.out"
+  run "diff j3.out j1.out"
+end
+
+Name "gt dev gthdpbench chains and protein"
+Keywords "gt_gthdpbench gth"
+Test do
+  run_test "#{$bin}gt dev gthdpbench -chains -protein " +
+           "#{$testdata}U89959_genomic.fas #{$testdata}U89959_cds.fas",
+           :retval => 1
+  grep last_stderr, /exclude each other/
+end
@@ -0,0 +1,27 @@
+Name "gt dev hashtablebench"
+Keywords "gt_hashtablebench threads"
+Test do
+  ["concurrent", "locked"].each do |mode|
+    [1, 4].each do |jobs|
+      run_test "#{$bin}gt -j #{jobs} dev hashtablebench -keys 20000 " +
+               "-mode #{mode}"
+      grep last_stdout, /distinct keys: #{10000 * (jobs - 1) + 20000}$/
+      grep last_stdout, /lookups: #{20000 * jobs}$/
+    end
+  end
+end
+
+Name "gt dev hashtablebench small start size"
+Keywords "gt_hashtablebench threads"
+Test do
+  run_test "#{$bin}gt -j 3 dev hashtablebench -keys 5000 -startsize 4"
+  grep last_stdout, /distinct keys: 10000$/
+end
+
+Name "gt dev hashtablebench verbose"
+Keywords "gt_hashtablebench benchmark"
+Test do
+  run_test "#{$bin}gt -j 2 dev hashtablebench -keys 1000 -v"
+  grep last_stdout, /TIME insert concurrent/
+  grep last_stdout, /TIME lookup concurrent/
+end
@@ -125,6 +125,28 @@ def checkrepfindwithquery(reffile,queryfile)
   run "cmp -s #{last_stdout} #{$gttestdata}repfind-result/#{reffile}-#{queryfile}.result"
 end
 
+Name "gt tagerator multithreaded"
+Keywords "gt_tagerator"
+Test do
+  run "#{$bin}gt shredder -minlength 12 -maxlength 20 " +
+      "#{$testdata}Random.fna | #{$bin}gt seqfilter -minlength 12 - | " +
+      "sed -e \'s/^>.*/>/\' > patternfile"
+  run_test "#{$bin}gt suffixerator -indexname sfx -tis -suf -ssp -dna " +
+           "-db #{$testdata}Random.fna"
+  run_test "#{$bin}gt packedindex mkindex -tis -ssp -indexname pck " +
+           "-db #{$testdata}Random.fna -sprank -dna -pl -bsize 10 " +
+           "-locfreq 32 -dir rev", :maxtime => 180
+  ["-e 0 -esa sfx", "-e 1 -esa sfx -output tagnum dbstartpos strand edist",
+   "-e 1 -pck pck -output tagnum dbsequence", "-pck pck -maxocc 10",
+   "-e 1 -best -esa sfx"].each do |args|
+    run_test "#{$bin}gt tagerator -rw #{args} -q patternfile", :maxtime => 240
+    run "mv #{last_stdout} tagerator.j1"
+    run_test "#{$bin}gt -j 3 tagerator -rw #{args} -q patternfile",
+             :maxtime => 240
+    run "cmp #{last_stdout} tagerator.j1"
+  end
+end
+
 Name "gt paircmp"
 Keywords "gt_paircmp"
 Test do
@@ -155,6 +177,21 @@ Test do
   run_test "#{$bin}gt repfind -samples 40 -l 6 -ii sfx",:maxtime => 600
 end
 
+Name "gt repfind multithreaded"
+Keywords "gt_repfind"
+Test do
+  run_test "#{$bin}gt suffixerator -db #{$testdata}at1MB " +
+           "-indexname sfx -dna -tis -suf -lcp -ssp"
+  ["-l 14", "-l 300", "-l 20 -extend", "-l 16 -spm"].each do |args|
+    run_test "#{$bin}gt repfind #{args} -ii sfx", :maxtime => 300
+    run "mv #{last_stdout} repfind.j1"
+    run_test "#{$bin}gt -j 3 repfind #{args} -ii sfx", :maxtime => 300
+    run "cmp #{last_stdout} repfind.j1"
+  end
+  run_test "#{$bin}gt -j 3 repfind -l 20 -extend -ii sfx", :maxtime => 300
+  run "diff #{last_stdout} #{$testdata}repfind-20-extend.txt"
+end
+
 if $gttestdata then
   Name "gt repfind extend at1MB"
   Keywords "gt_repfind extend"
@@ -268,6 +268,24 @@ Test do
            " -gff3 out.gff3"
 end
 
+Name "gt ltrharvest multithreaded"
+Keywords "gt_ltrharvest"
+Test do
+  ["at1MB", "U89959_genomic.fas"].each do |file|
+    run_test "#{$bin}gt suffixerator -db #{$testdata}#{file} -dna -suf -sds " +
+             "-lcp -tis -des -ssp"
+    ["", "-overlaps all", "-overlaps no", "-mintsd 4 -maxtsd 20",
+     "-tabout no"].each do |args|
+      run_test "#{$bin}gt ltrharvest -index #{file} -seed 20 -minlenltr 30 " +
+               "-mindistltr 100 -similar 60 #{args}"
+      run "mv #{last_stdout} ltrharvest.j1"
+      run_test "#{$bin}gt -j 3 ltrharvest -index #{file} -seed 20 " +
+               "-minlenltr 30 -mindistltr 100 -similar 60 #{args}"
+      run "cmp #{last_stdout} ltrharvest.j1"
+    end
+  end
+end
+
 Name "gt ltrharvest missing tables (lcp)"
 Keywords "gt_ltrharvest"
 Test do
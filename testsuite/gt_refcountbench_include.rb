@@ -0,0 +1,20 @@
+Name "gt dev refcountbench"
+Keywords "gt_refcountbench threads"
+Test do
+  ["node", "str"].each do |type|
+    ["atomic", "rwlock"].each do |mode|
+      [1, 4].each do |jobs|
+        run_test "#{$bin}gt -j #{jobs} dev refcountbench -pairs 100000 " +
+                 "-objects 3 -type #{type} -mode #{mode}"
+        grep last_stdout, /ref\/unref pairs: #{100000 * jobs}$/
+      end
+    end
+  end
+end
+
+Name "gt dev refcountbench verbose"
+Keywords "gt_refcountbench benchmark"
+Test do
+  run_test "#{$bin}gt -j 2 dev refcountbench -v"
+  grep last_stdout, /TIME node atomic/
+end
@@ -366,3 +366,26 @@ Test do
            :retval => 1
   grep last_stderr, /error/
 end
+
+Name "gt select -prefetch"
+Keywords "gt_select prefetch"
+Test do
+  ["-seqid chr1", "-targetbest", "-contain 1 150000000 -strand +"].each do |opt|
+    run_test "#{$bin}gt select #{opt} " +
+             "#{$testdata}encode_known_genes_Mar07.gff3"
+    run "mv #{last_stdout} unbuffered.out"
+    run_test "#{$bin}gt select -prefetch #{opt} " +
+             "#{$testdata}encode_known_genes_Mar07.gff3"
+    run "cmp #{last_stdout} unbuffered.out"
+  end
+end
+
+Name "gt select -prefetch (dropped to file)"
+Keywords "gt_select prefetch"
+Test do
+  run_test "#{$bin}gt select -prefetch -dropped_file nh_file04.gff3 " +
+           "-rule_files " +
+           "#{$testdata}gtscripts/filter_test_frame_attribute.lua -- " +
+           "#{$testdata}filter_luafilter_test_no_frame_attribute.gff3"
+  run "diff nh_file04.gff3 #{$testdata}filter_nh_file04.gff3"
+end
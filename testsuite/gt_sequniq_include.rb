@@ -43,3 +43,30 @@ end
     run "diff #{last_stdout} #{$testdata}foo.fas"
   end
 end
+
+["", " -rev", " -seqit", " -seqit -rev"].each do |opt|
+  Name "gt sequniq#{opt} multithreaded"
+  Keywords "gt_sequniq multithreaded"
+  Test do
+    files = "#{$testdata}U89959_ests.fas #{$testdata}U89959_ests.fas " +
+            "#{$testdata}foorcfoofoo.fas"
+    run_test "#{$bin}gt -j 1 sequniq#{opt} #{files}"
+    run "mv #{last_stdout} j1.out"
+    run "mv #{last_stderr} j1.err"
+    run_test "#{$bin}gt -j 3 sequniq#{opt} #{files}"
+    run "cmp #{last_stdout} j1.out"
+    run "cmp #{last_stderr} j1.err"
+  end
+end
+
+Name "gt sequniq -rev multithreaded (non-DNA sequence)"
+Keywords "gt_sequniq multithreaded"
+Test do
+  files = "#{$testdata}U89959_ests.fas #{$testdata}sw100K1.fsa"
+  run_test "#{$bin}gt -j 1 sequniq -rev #{files}", :retval => 1
+  run "mv #{last_stdout} j1.out"
+  run "mv #{last_stderr} j1.err"
+  run_test "#{$bin}gt -j 3 sequniq -rev #{files}", :retval => 1
+  run "cmp #{last_stdout} j1.out"
+  run "cmp #{last_stderr} j1.err"
+end
@@ -14,6 +14,71 @@ Test do
   run "test -e out.png"
 end
 
+Name "gt sketch -benchmark"
+Keywords "gt_sketch"
+Test do
+  run_test "#{$bin}gt sketch -benchmark 3 out.png #{$testdata}eden.gff3", \
+           :maxtime => 600
+  grep last_stdout, /TIME rendering 3 times/
+  run "test -e out.png"
+end
+
+Name "gt sketch -tiles"
+Keywords "gt_sketch tiles"
+Test do
+  tiles = [["chr1", 147971134, 148100000], ["chr1", 148100001, 148468994],
+           ["chr11", 1710216, 2000000], ["chr16", 4043, 26056510],
+           ["chr18", 23784928, 59823258]]
+  File.open("tiles.txt", "w") do |f|
+    f.puts "# seqid\tstart\tend\tfile"
+    tiles.each_with_index do |t, i|
+      f.puts "#{t[0]}\t#{t[1]}\t#{t[2]}\ttile#{i}.png"
+    end
+  end
+  run_test "#{$bin}gt -j 4 sketch -tiles tiles.txt " + \
+           "#{$testdata}encode_known_genes_Mar07.gff3", :maxtime => 600
+  tiles.each_with_index do |t, i|
+    run_test "#{$bin}gt sketch -seqid #{t[0]} -start #{t[1]} -end #{t[2]} " + \
+             "single#{i}.png #{$testdata}encode_known_genes_Mar07.gff3", \
+             :maxtime => 600
+    run "cmp tile#{i}.png single#{i}.png"
+  end
+end
+
+Name "gt sketch -tiles (stdin)"
+Keywords "gt_sketch tiles"
+Test do
+  File.open("tiles.txt", "w") do |f|
+    f.puts "ctg123\t1000\t9000\ttile0.png"
+  end
+  run_test "#{$bin}gt sketch -tiles tiles.txt < #{$testdata}eden.gff3", \
+           :maxtime => 600
+  # the track captions contain the file name, read the single image from stdin
+  # as well
+  run_test "#{$bin}gt sketch -seqid ctg123 -start 1000 -end 9000 " + \
+           "single0.png < #{$testdata}eden.gff3", :maxtime => 600
+  run "cmp tile0.png single0.png"
+end
+
+Name "gt sketch (missing image file)"
+Keywords "gt_sketch"
+Test do
+  run_test "#{$bin}gt sketch", :retval => 1
+  grep last_stderr, /missing image_file argument/
+end
+
+Name "gt sketch -tiles (unknown sequence region)"
+Keywords "gt_sketch tiles"
+Test do
+  File.open("tiles.txt", "w") do |f|
+    f.puts "ctg123\t1000\t9000\ttile0.png"
+    f.puts "ctg124\t1000\t9000\ttile1.png"
+  end
+  run_test "#{$bin}gt sketch -tiles tiles.txt #{$testdata}eden.gff3", \
+           :retval => 1, :maxtime => 600
+  grep last_stderr, /sequence region 'ctg124' \(line 2/
+end
+
 Name "gt sketch short test (unknown output format)"
 Keywords "gt_sketch"
 Test do
@@ -211,6 +211,40 @@ Test do
   run "cmp u8.reads.esq u8.reads2.esq"
 end
 
+Name "gt suffixerator multithreaded bucket sort"
+Keywords "gt_suffixerator threads"
+Test do
+  all_fastafiles.each do |filename|
+    ["fwd","rcl"].each do |dirarg|
+      ["1","3"].each do |parts|
+        run_test "#{$bin}gt suffixerator -tis -suf -bwt -dir #{dirarg} " +
+                 "-parts #{parts} -indexname sfx1 " +
+                 "-db #{$testdata}#{filename}"
+        run_test "#{$bin}gt -j 4 suffixerator -tis -suf -bwt -dir #{dirarg} " +
+                 "-parts #{parts} -indexname sfx4 " +
+                 "-db #{$testdata}#{filename}"
+        run "cmp sfx1.suf sfx4.suf"
+        run "cmp sfx1.bwt sfx4.bwt"
+        run_test "#{$bin}gt dev sfxmap -suf -tis -esa sfx4"
+      end
+    end
+  end
+end
+
+Name "gt dev sain multithreaded"
+Keywords "gt_suffixerator gt_sain threads"
+Test do
+  run_test "#{$bin}gt suffixerator -tis -indexname at1MB " +
+           "-db #{$testdata}at1MB"
+  ["1","2","4"].each do |jobs|
+    run_test "#{$bin}gt -j #{jobs} dev sain -esq at1MB -fcheck -icheck"
+    run_test "#{$bin}gt -j #{jobs} dev sain -file #{$testdata}at1MB -icheck"
+  end
+  run_test "#{$bin}gt -j 4 dev sain -esq at1MB -scaling"
+  run "grep -c '^# threads=' #{last_stdout}"
+  run "grep -q '^3$' #{last_stdout}"
+end
+
 Name "gt suffixerator -dc 64 -dccheck -lcp -parts 1+3"
 Keywords "gt_suffixerator dc"
 Test do
@@ -119,12 +119,17 @@ require 'gt_csr_include.rb'
 require 'gt_encseq_include'
 require 'gt_eval_include'
 require 'gt_extractfeat_include'
+require 'gt_fastabench_include'
+require 'gt_featureindexbench_include'
 require 'gt_featureindex_include'
 require 'gt_fingerprint_include'
 require 'gt_genomediff_include'
 require 'gt_gff3_include'
+require 'gt_gff3parsebench_include'
 require 'gt_gff3validator_include'
+require 'gt_gthdpbench_include'
 require 'gt_gtf_to_gff3_include'
+require 'gt_hashtablebench_include'
 require 'gt_hop_include'
 require 'gt_id_to_md5_include'
 require 'gt_include'
@@ -143,6 +148,7 @@ require 'gt_orffinder_include'
 require 'gt_python_include'
 require 'gt_readjoiner_include'
 require 'gt_readreads_include'
+require 'gt_refcountbench_include'
 require 'gt_regioncov_include'
 require 'gt_ruby_include'
 require 'gt_sambam_include'